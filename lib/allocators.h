@@ -0,0 +1,419 @@
+/**
+ *  @brief      Pool and arena allocators for the Queue and Stack containers
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_ALLOCATORS_H_
+#define _INCLUDE_ALLOCATORS_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+
+/*
+ * @brief  Per-thread pools of fixed-size blocks backing PoolAllocator
+ *
+ * Requests up to kMaxBlock bytes are rounded up to a multiple of
+ * kGranularity and served from the calling thread's free list for that
+ * size class, without any locking. Free lists are refilled by carving
+ * kSlabSize slabs into blocks. A block freed by another thread joins
+ * that thread's free list, which holds at most a slab's worth of
+ * blocks per size class: past that, half of it spills to a shared list
+ * under a mutex. Threads refill from the shared list, half a slab's
+ * worth at a time, before carving new slabs, so blocks which one
+ * thread allocates and another frees, as in a producer and consumer,
+ * find their way back. When a thread exits, its free blocks are handed
+ * to the shared list too.
+ *
+ * Slabs are recycled but never returned to the system, so the pools
+ * stay as large as the peak demand, plus at most a slab and a half per
+ * thread and size class held in the free lists.
+ */
+class BlockPool {
+ public:
+    static const std::size_t kGranularity = 16;
+    static const std::size_t kMaxBlock = 1024;
+    static const std::size_t kClasses = kMaxBlock / kGranularity;
+    static const std::size_t kSlabSize = 64 * 1024;
+
+ private:
+    struct Block {
+        Block* next;
+    };
+
+    /// thread-local free lists, trivially destructible so they stay
+    /// usable while other thread-local objects are torn down
+    struct Cache {
+        Block* free[kClasses];
+        std::size_t count[kClasses];
+        bool registered;
+        bool retired;
+    };
+
+    /// shared state, intentionally never destroyed
+    struct Shared {
+        std::mutex lock;
+        Block* free[kClasses];
+        std::atomic<std::size_t> slabs;
+    };
+
+    /// returns a thread's free blocks to the shared lists when it exits
+    struct Flusher {
+        ~Flusher() {
+            Cache& c = cache();
+            std::lock_guard<std::mutex> guard(shared().lock);
+            for (std::size_t i = 0; i < kClasses; ++i) {
+                shared().free[i] = splice(c.free[i], shared().free[i]);
+                c.free[i] = 0;
+                c.count[i] = 0;
+            }
+            c.retired = true;
+        }
+    };
+
+    static Cache& cache() {
+        static thread_local Cache c;
+        return c;
+    }
+
+    static Shared& shared() {
+        static Shared* s = new Shared();
+        return *s;
+    }
+
+    /// most blocks a thread keeps free per size class, a slab's worth
+    static std::size_t cached_max(std::size_t cls) {
+        return kSlabSize / ((cls + 1) * kGranularity);
+    }
+
+    /// detaches the first n blocks of list, which must hold that many,
+    /// and returns them; list is left with the rest
+    static Block* cut(Block*& list, std::size_t n) {
+        Block* head = list;
+        Block* last = list;
+        while (--n) {
+            last = last->next;
+        }
+        list = last->next;
+        last->next = 0;
+        return head;
+    }
+
+    static Block* splice(Block* list, Block* tail) {
+        if (!list) {
+            return tail;
+        }
+        Block* last = list;
+        while (last->next) {
+            last = last->next;
+        }
+        last->next = tail;
+        return list;
+    }
+
+    __attribute__((noinline))
+    static void* allocate_slow(std::size_t cls) {
+        Cache& c = cache();
+        if (c.retired) {
+            std::lock_guard<std::mutex> guard(shared().lock);
+            Block* b = shared().free[cls];
+            if (b) {
+                shared().free[cls] = b->next;
+                return b;
+            }
+            return ::operator new((cls + 1) * kGranularity);
+        }
+        if (!c.registered) {
+            c.registered = true;
+            static thread_local Flusher flusher;
+            (void)flusher;
+        }
+        Block* list = 0;
+        std::size_t count = 0;
+        {
+            std::lock_guard<std::mutex> guard(shared().lock);
+            Block*& shared_list = shared().free[cls];
+            for (Block* b = shared_list; b && count < cached_max(cls) / 2;
+                 b = b->next) {
+                ++count;
+            }
+            if (count) {
+                list = cut(shared_list, count);
+            }
+        }
+        if (!list) {
+            std::size_t size = (cls + 1) * kGranularity;
+            char* slab = static_cast<char*>(::operator new(kSlabSize));
+            shared().slabs.fetch_add(1, std::memory_order_relaxed);
+            for (std::size_t off = kSlabSize / size * size; off >= size;
+                 off -= size) {
+                Block* b = reinterpret_cast<Block*>(slab + off - size);
+                b->next = list;
+                list = b;
+                ++count;
+            }
+        }
+        c.free[cls] = list->next;
+        c.count[cls] = count - 1;
+        return list;
+    }
+
+    __attribute__((noinline))
+    static void deallocate_slow(Block* b, std::size_t cls) {
+        Cache& c = cache();
+        if (c.retired) {
+            std::lock_guard<std::mutex> guard(shared().lock);
+            b->next = shared().free[cls];
+            shared().free[cls] = b;
+            return;
+        }
+        b->next = c.free[cls];
+        Block* spill = b;
+        std::size_t keep = cached_max(cls) / 2;
+        c.free[cls] = cut(spill, keep);
+        c.count[cls] = keep;
+        Block* last = spill;
+        while (last->next) {
+            last = last->next;
+        }
+        std::lock_guard<std::mutex> guard(shared().lock);
+        last->next = shared().free[cls];
+        shared().free[cls] = spill;
+    }
+
+ public:
+    static bool pooled(std::size_t bytes, std::size_t align) {
+        return bytes && bytes <= kMaxBlock && align <= kGranularity;
+    }
+
+    static std::size_t size_class(std::size_t bytes) {
+        return (bytes - 1) / kGranularity;
+    }
+
+    /// the slow paths are kept out of line (noinline) so that
+    /// containers inlining the allocator keep their push and pop loops
+    /// tight
+    static void* allocate(std::size_t cls) {
+        Cache& c = cache();
+        Block* b = c.free[cls];
+        if (!b) {
+            return allocate_slow(cls);
+        }
+        c.free[cls] = b->next;
+        --c.count[cls];
+        return b;
+    }
+
+    static void deallocate(void* p, std::size_t cls) {
+        Block* b = static_cast<Block*>(p);
+        Cache& c = cache();
+        if (c.retired || c.count[cls] == cached_max(cls)) {
+            deallocate_slow(b, cls);
+            return;
+        }
+        b->next = c.free[cls];
+        c.free[cls] = b;
+        ++c.count[cls];
+    }
+
+    /// number of slabs carved so far, by all threads
+    static std::size_t slabs() {
+        return shared().slabs.load(std::memory_order_relaxed);
+    }
+};
+
+/*
+ * @brief  The pool allocator class
+ *
+ * A stateless allocator drawing small blocks (list nodes, deque chunks
+ * and maps, small ring buffers) from BlockPool, so that threads churning
+ * through containers do not contend on the global malloc. Larger or
+ * over-aligned requests go to operator new. Any PoolAllocator can free
+ * memory from any other, on any thread.
+ */
+template < typename T >
+class PoolAllocator {
+ public:
+    typedef T value_type;
+
+    PoolAllocator() {}
+
+    template < typename U >
+    PoolAllocator(const PoolAllocator<U>&) {}
+
+    T* allocate(std::size_t n) {
+        std::size_t bytes = n * sizeof(T);
+        if (!BlockPool::pooled(bytes, alignof(T))) {
+            return static_cast<T*>(::operator new(bytes));
+        }
+        return static_cast<T*>(BlockPool::allocate(BlockPool::size_class(bytes)));
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        std::size_t bytes = n * sizeof(T);
+        if (!BlockPool::pooled(bytes, alignof(T))) {
+            ::operator delete(p);
+            return;
+        }
+        BlockPool::deallocate(p, BlockPool::size_class(bytes));
+    }
+};
+
+template < typename T, typename U >
+bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) {
+    return true;
+}
+
+template < typename T, typename U >
+bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) {
+    return false;
+}
+
+/*
+ * @brief  The pool memory resource class
+ *
+ * BlockPool behind the std::pmr::memory_resource interface, for code
+ * built on polymorphic allocators, such as Queue< T, std::pmr::deque<T> >
+ * given std::pmr::polymorphic_allocator<T>(&resource). Like
+ * PoolAllocator it is stateless: all instances share the pools and are
+ * equal. The arena's counterpart is std::pmr::monotonic_buffer_resource.
+ */
+class PoolResource : public std::pmr::memory_resource {
+ protected:
+    void* do_allocate(std::size_t bytes, std::size_t align) {
+        if (!BlockPool::pooled(bytes, align)) {
+            return ::operator new(bytes, std::align_val_t(align));
+        }
+        return BlockPool::allocate(BlockPool::size_class(bytes));
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) {
+        if (!BlockPool::pooled(bytes, align)) {
+            ::operator delete(p, std::align_val_t(align));
+            return;
+        }
+        BlockPool::deallocate(p, BlockPool::size_class(bytes));
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+        return dynamic_cast<const PoolResource*>(&other) != 0;
+    }
+};
+
+/*
+ * @brief  The monotonic arena class
+ *
+ * Hands out memory by bumping a pointer through chunks that double in
+ * size, and frees nothing until release() or destruction, which drop
+ * everything at once. Suited to containers that live for one request
+ * or one batch. An arena must not be shared between threads.
+ */
+class Arena {
+ private:
+    struct Chunk {
+        Chunk* next;
+        std::size_t size;
+    };
+
+    Chunk* chunks_;
+    char* cursor_;
+    char* end_;
+    std::size_t next_size_;
+    std::size_t initial_size_;
+
+    Arena(const Arena&);
+    Arena& operator=(const Arena&);
+
+    __attribute__((noinline))
+    void grow(std::size_t bytes, std::size_t align) {
+        std::size_t size = std::max(next_size_, bytes + align + sizeof(Chunk));
+        Chunk* chunk = static_cast<Chunk*>(::operator new(size));
+        chunk->next = chunks_;
+        chunk->size = size;
+        chunks_ = chunk;
+        cursor_ = reinterpret_cast<char*>(chunk + 1);
+        end_ = reinterpret_cast<char*>(chunk) + size;
+        next_size_ = size * 2;
+    }
+
+ public:
+    explicit Arena(std::size_t initial_size = 4096)
+        : chunks_(0), cursor_(0), end_(0), next_size_(initial_size),
+          initial_size_(initial_size) {
+    }
+
+    ~Arena() {
+        release();
+    }
+
+    void* allocate(std::size_t bytes, std::size_t align) {
+        std::uintptr_t p = reinterpret_cast<std::uintptr_t>(cursor_);
+        std::uintptr_t aligned = (p + align - 1) & ~std::uintptr_t(align - 1);
+        if (!cursor_ || aligned + bytes > reinterpret_cast<std::uintptr_t>(end_)) {
+            grow(bytes, align);
+            p = reinterpret_cast<std::uintptr_t>(cursor_);
+            aligned = (p + align - 1) & ~std::uintptr_t(align - 1);
+        }
+        cursor_ = reinterpret_cast<char*>(aligned + bytes);
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void release() {
+        while (chunks_) {
+            Chunk* next = chunks_->next;
+            ::operator delete(chunks_);
+            chunks_ = next;
+        }
+        cursor_ = 0;
+        end_ = 0;
+        next_size_ = initial_size_;
+    }
+};
+
+/*
+ * @brief  The arena allocator class
+ *
+ * Allocates from an Arena it refers to but does not own; deallocate is
+ * a no-op. Containers using it must be destroyed or cleared before the
+ * arena is released. Two arena allocators are equal if they share the
+ * same arena.
+ */
+template < typename T >
+class ArenaAllocator {
+ public:
+    typedef T value_type;
+
+    Arena* arena;
+
+    explicit ArenaAllocator(Arena& a) : arena(&a) {}
+
+    template < typename U >
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) {
+    }
+};
+
+template < typename T, typename U >
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+    return lhs.arena == rhs.arena;
+}
+
+template < typename T, typename U >
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+    return lhs.arena != rhs.arena;
+}
+
+#endif
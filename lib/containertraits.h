@@ -0,0 +1,295 @@
+/**
+ *  @brief      Traits shared by the containers backing Queue and Stack
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_CONTAINERTRAITS_H_
+#define _INCLUDE_CONTAINERTRAITS_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+ * @brief  Replace the allocator of a container type
+ *
+ * RebindContainer<C, A>::type is C with its allocator replaced by A.
+ * The primary specialization covers standard containers of the form
+ * C<T, Alloc>, like deque, list and vector; containers with other
+ * template parameters specialize it next to their definition.
+ */
+template < typename Container, typename Allocator >
+struct RebindContainer;
+
+template < template < typename, typename > class Container,
+           typename T, typename OldAllocator, typename Allocator >
+struct RebindContainer< Container<T, OldAllocator>, Allocator > {
+    typedef Container<T, Allocator> type;
+};
+
+/*
+ * @brief  Stands for the allocator of a container which declares none
+ */
+struct NoAllocator {
+};
+
+/*
+ * @brief  The allocator a container declares
+ *
+ * ContainerAllocator<C>::type is C::allocator_type, or NoAllocator for
+ * containers without one; it is the default Allocator of Queue and
+ * Stack.
+ */
+template < typename Container, typename = void >
+struct ContainerAllocator {
+    typedef NoAllocator type;
+};
+
+template < typename Container >
+struct ContainerAllocator< Container,
+                           std::void_t<typename Container::allocator_type> > {
+    typedef typename Container::allocator_type type;
+};
+
+/*
+ * @brief  The container Queue and Stack hold
+ *
+ * AdaptedContainer<C, A>::type is C itself when A is the allocator C
+ * already has, so that containers without allocator_type or without a
+ * RebindContainer specialization can still be used as they are, and
+ * RebindContainer<C, A>::type otherwise.
+ */
+template < typename Container, typename Allocator,
+           bool = std::is_same<Allocator,
+                               typename ContainerAllocator<Container>::type>::value >
+struct AdaptedContainer {
+    typedef typename RebindContainer<Container, Allocator>::type type;
+};
+
+template < typename Container, typename Allocator >
+struct AdaptedContainer< Container, Allocator, true > {
+    typedef Container type;
+};
+
+/*
+ * @brief  Single pushes into the containers backing Queue and Stack
+ *
+ * push_back and emplace_back forward to those of the container and
+ * return whether the item went in. Containers of fixed capacity, like
+ * StaticRing, return false from theirs when full; the push of any
+ * other container, returning void, always succeeds.
+ */
+struct ContainerPush {
+    template < typename Container, typename U >
+    static bool push_back(Container& c, U&& val) {
+        typedef decltype(c.push_back(std::forward<U>(val))) result;
+        if constexpr (std::is_same<result, bool>::value) {
+            return c.push_back(std::forward<U>(val));
+        } else {
+            c.push_back(std::forward<U>(val));
+            return true;
+        }
+    }
+
+    template < typename Container, typename... Args >
+    static bool emplace_back(Container& c, Args&&... args) {
+        typedef decltype(c.emplace_back(std::forward<Args>(args)...)) result;
+        if constexpr (std::is_same<result, bool>::value) {
+            return c.emplace_back(std::forward<Args>(args)...);
+        } else {
+            c.emplace_back(std::forward<Args>(args)...);
+            return true;
+        }
+    }
+};
+
+/*
+ * @brief  Bulk operations on the containers backing Queue and Stack
+ *
+ * append adds a range at the back, take_front and take_back move n
+ * items out from either end (take_back in pop order, last item first)
+ * and erase them. n must not exceed the size. copy copies every item,
+ * front first, leaving the container as it is. The primary template
+ * uses insert and erase, which deque, list and vector implement with
+ * one allocation and segment-wise copies; containers without them
+ * specialize it next to their definition.
+ */
+template < typename Container >
+struct ContainerBulk {
+    template < typename InputIterator >
+    static void append(Container& c, InputIterator first, InputIterator last) {
+        c.insert(c.end(), first, last);
+    }
+
+    template < typename OutputIterator >
+    static OutputIterator take_front(Container& c, std::size_t n,
+                                     OutputIterator out) {
+        typename Container::iterator mid = c.begin();
+        std::advance(mid, n);
+        out = std::move(c.begin(), mid, out);
+        c.erase(c.begin(), mid);
+        return out;
+    }
+
+    template < typename OutputIterator >
+    static OutputIterator take_back(Container& c, std::size_t n,
+                                    OutputIterator out) {
+        typename Container::reverse_iterator mid = c.rbegin();
+        std::advance(mid, n);
+        out = std::move(c.rbegin(), mid, out);
+        c.erase(mid.base(), c.end());
+        return out;
+    }
+
+    template < typename OutputIterator >
+    static OutputIterator copy(const Container& c, OutputIterator out) {
+        return std::copy(c.begin(), c.end(), out);
+    }
+};
+
+/*
+ * @brief  Single pass iterator counting the items read through it
+ */
+template < typename InputIterator >
+class CountingIterator {
+    typedef std::iterator_traits<InputIterator> traits;
+
+    InputIterator it_;
+    std::size_t* count_;
+
+ public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef typename traits::value_type value_type;
+    typedef typename traits::difference_type difference_type;
+    typedef typename traits::pointer pointer;
+    typedef typename traits::reference reference;
+
+    CountingIterator(InputIterator it, std::size_t* count)
+        : it_(it), count_(count) {}
+
+    reference operator*() const { return *it_; }
+    CountingIterator& operator++() {
+        ++it_;
+        ++*count_;
+        return *this;
+    }
+    CountingIterator operator++(int) {
+        CountingIterator old(*this);
+        ++*this;
+        return old;
+    }
+    bool operator==(const CountingIterator& other) const {
+        return it_ == other.it_;
+    }
+    bool operator!=(const CountingIterator& other) const {
+        return it_ != other.it_;
+    }
+};
+
+/*
+ * @brief        Add a range at the back with ContainerBulk::append, and
+ *               count its items
+ * @param        The container, and iterators to the first and past the
+ *               last item
+ * @return       The no. of items in the range, including those which
+ *               went in by overwriting older ones, as in a circular
+ *               queue; the size of the container may grow by less
+ */
+template < typename Container, typename InputIterator >
+std::size_t append_counted(Container& c, InputIterator first,
+                           InputIterator last, std::input_iterator_tag) {
+    typedef CountingIterator<InputIterator> counting;
+    std::size_t n = 0;
+    ContainerBulk<Container>::append(c, counting(first, &n),
+                                     counting(last, &n));
+    return n;
+}
+
+template < typename Container, typename ForwardIterator >
+std::size_t append_counted(Container& c, ForwardIterator first,
+                           ForwardIterator last, std::forward_iterator_tag) {
+    std::size_t n = std::distance(first, last);
+    ContainerBulk<Container>::append(c, first, last);
+    return n;
+}
+
+template < typename Container, typename InputIterator >
+std::size_t append_counted(Container& c, InputIterator first,
+                           InputIterator last) {
+    return append_counted(c, first, last,
+        typename std::iterator_traits<InputIterator>::iterator_category());
+}
+
+/*
+ * @brief  Cursor over the items of a container as at most two runs
+ *
+ * next hands out each contiguous run in turn, front first, and returns
+ * false once there are none left. Covers arrays (one run) and ring
+ * buffers (up to two, split where the ring wraps).
+ */
+template < typename T >
+class SplitCursor {
+    const T* items_[2];
+    std::size_t sizes_[2];
+    std::size_t run_;
+
+ public:
+    SplitCursor(const T* first, std::size_t n1, const T* second,
+                std::size_t n2)
+        : run_(0) {
+        items_[0] = first;
+        sizes_[0] = n1;
+        items_[1] = second;
+        sizes_[1] = n2;
+    }
+
+    bool next(const T*& items, std::size_t& n) {
+        if (run_ == 2) {
+            return false;
+        }
+        items = items_[run_];
+        n = sizes_[run_];
+        ++run_;
+        return true;
+    }
+};
+
+/*
+ * @brief  The items of a container as a sequence of contiguous runs
+ *
+ * Containers which keep their items in arrays specialize it next to
+ * their definition, with contiguous set to true, a cursor type with
+ * the next member of SplitCursor, and runs(c) returning a cursor over
+ * the items of c. Runs may be empty. The comparisons of Queue and
+ * Stack use it to hand whole runs of arithmetic items to the vector
+ * kernels of simdcompare.h; the primary template opts out.
+ */
+template < typename Container >
+struct ContainerSegments {
+    static const bool contiguous = false;
+};
+
+template < typename T, typename A >
+struct ContainerSegments< std::vector<T, A> > {
+    static const bool contiguous = true;
+    typedef SplitCursor<T> cursor;
+
+    static cursor runs(const std::vector<T, A>& c) {
+        return cursor(c.data(), c.size(), 0, 0);
+    }
+};
+
+/// vector<bool> packs its items into bits
+template < typename A >
+struct ContainerSegments< std::vector<bool, A> > {
+    static const bool contiguous = false;
+};
+
+#endif
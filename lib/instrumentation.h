@@ -0,0 +1,288 @@
+/**
+ *  @brief      Instrumentation policies for the Queue and Stack containers
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_INSTRUMENTATION_H_
+#define _INCLUDE_INSTRUMENTATION_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+/*
+ * @brief  The latency histogram class
+ *
+ * Counts nanosecond durations in log-linear buckets, the way HDR
+ * histograms do: durations below 16ns get a bucket each, and every
+ * power of two above is split into 8 buckets, so any recorded value is
+ * reported within 12.5% of its true value over the full 64-bit range.
+ */
+class LatencyHistogram {
+ public:
+    static const std::size_t kLinear = 16;
+    static const std::size_t kSubBuckets = 8;
+    static const std::size_t kBuckets = kLinear + (64 - 4) * kSubBuckets;
+
+    std::uint64_t counts[kBuckets];
+
+    LatencyHistogram() : counts() {}
+
+    /*
+     * @brief        Bucket holding a duration
+     * @param        The duration in ns
+     * @return       The bucket index
+     */
+    static std::size_t bucket(std::uint64_t ns) {
+        if (ns < kLinear) {
+            return ns;
+        }
+        std::size_t log2 = 63 - __builtin_clzll(ns);
+        return kLinear + (log2 - 4) * kSubBuckets + ((ns >> (log2 - 3)) & 7);
+    }
+
+    /*
+     * @brief        Largest duration falling in a bucket
+     * @param        The bucket index
+     * @return       The duration in ns
+     */
+    static std::uint64_t bucket_max(std::size_t i) {
+        if (i < kLinear) {
+            return i;
+        }
+        std::size_t log2 = (i - kLinear) / kSubBuckets + 4;
+        std::uint64_t low = (kSubBuckets + (i - kLinear) % kSubBuckets)
+                            << (log2 - 3);
+        return low + (std::uint64_t(1) << (log2 - 3)) - 1;
+    }
+
+    void record(std::uint64_t ns) { ++counts[bucket(ns)]; }
+
+    /*
+     * @brief        Number of recorded durations
+     */
+    std::uint64_t count() const {
+        std::uint64_t total = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            total += counts[i];
+        }
+        return total;
+    }
+
+    /*
+     * @brief        Duration at or below which a share of durations fall
+     * @param        The percentile, between 0 and 100
+     * @return       The upper bound of its bucket in ns, 0 if empty
+     */
+    std::uint64_t percentile(double p) const {
+        std::uint64_t total = count();
+        if (total == 0) {
+            return 0;
+        }
+        std::uint64_t rank = std::uint64_t(p / 100 * (total - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return bucket_max(i);
+            }
+        }
+        return bucket_max(kBuckets - 1);
+    }
+};
+
+/*
+ * @brief  Counters read from an instrumented container
+ *
+ * latency is only filled in by queues, with the time each popped item
+ * spent queued.
+ */
+struct InstrumentationSnapshot {
+    std::uint64_t pushes;
+    std::uint64_t pops;
+    std::uint64_t empty_pops;
+    std::uint64_t peak_size;
+    LatencyHistogram latency;
+
+    InstrumentationSnapshot()
+        : pushes(0), pops(0), empty_pops(0), peak_size(0) {}
+};
+
+/*
+ * @brief  The instrumentation policy that records nothing
+ *
+ * The default policy of Queue and Stack. It is an empty base class
+ * whose hooks are empty inline functions, so it adds neither size nor
+ * code to the containers.
+ */
+struct NoInstrumentation {
+    void pushed(std::size_t, std::size_t) {}
+    void popped(std::size_t) {}
+    void enqueued(std::size_t, std::size_t) {}
+    void dequeued(std::size_t) {}
+    void empty_pop() {}
+    void copied(const NoInstrumentation&) {}
+    void moved(NoInstrumentation&) {}
+    void swapped(NoInstrumentation&) {}
+    InstrumentationSnapshot snapshot() const { return InstrumentationSnapshot(); }
+    InstrumentationSnapshot reset() { return InstrumentationSnapshot(); }
+};
+
+/*
+ * @brief  The counting instrumentation policy
+ *
+ * Records pushes, pops, pops attempted on an empty container and the
+ * peak size. Queues also record how long each item waited, in a
+ * LatencyHistogram, by keeping the push time of every queued item in
+ * a parallel FIFO.
+ *
+ * Updates assume the pushes and pops are serialized, as they must be
+ * for Queue and Stack anyway, and use plain relaxed stores rather than
+ * locked read-modify-writes. snapshot and reset only touch the atomic
+ * counters, so one metrics thread can call them while producers and
+ * consumers keep running. reset does not clear the counters but
+ * remembers their values, which later snapshots subtract, and returns
+ * the counts since the previous reset from the same reads, so a
+ * scraper summing its results never loses or double counts an update.
+ *
+ * The counters belong to a container and are neither copied nor
+ * swapped with its items; the push times are.
+ */
+class CountingInstrumentation {
+ private:
+    typedef std::chrono::steady_clock clock;
+
+    std::atomic<std::uint64_t> pushes_;
+    std::atomic<std::uint64_t> pops_;
+    std::atomic<std::uint64_t> empty_pops_;
+    std::atomic<std::uint64_t> peak_size_;
+    std::atomic<std::uint64_t> latency_[LatencyHistogram::kBuckets];
+    InstrumentationSnapshot baseline_;
+    std::deque<clock::time_point> pushed_at_;
+
+    static void add(std::atomic<std::uint64_t>& counter, std::uint64_t n) {
+        counter.store(counter.load(std::memory_order_relaxed) + n,
+                      std::memory_order_relaxed);
+    }
+
+    void observe(std::size_t size) {
+        if (size > peak_size_.load(std::memory_order_relaxed)) {
+            peak_size_.store(size, std::memory_order_relaxed);
+        }
+    }
+
+    InstrumentationSnapshot totals() const {
+        InstrumentationSnapshot s;
+        s.pushes = pushes_.load(std::memory_order_relaxed);
+        s.pops = pops_.load(std::memory_order_relaxed);
+        s.empty_pops = empty_pops_.load(std::memory_order_relaxed);
+        s.peak_size = peak_size_.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < LatencyHistogram::kBuckets; ++i) {
+            s.latency.counts[i] = latency_[i].load(std::memory_order_relaxed);
+        }
+        return s;
+    }
+
+    InstrumentationSnapshot since_baseline(InstrumentationSnapshot s) const {
+        s.pushes -= baseline_.pushes;
+        s.pops -= baseline_.pops;
+        s.empty_pops -= baseline_.empty_pops;
+        for (std::size_t i = 0; i < LatencyHistogram::kBuckets; ++i) {
+            s.latency.counts[i] -= baseline_.latency.counts[i];
+        }
+        return s;
+    }
+
+ public:
+    CountingInstrumentation()
+        : pushes_(0), pops_(0), empty_pops_(0), peak_size_(0), latency_() {}
+
+    /// a copy starts counting from scratch
+    CountingInstrumentation(const CountingInstrumentation&)
+        : pushes_(0), pops_(0), empty_pops_(0), peak_size_(0), latency_() {}
+
+    /// counters describe the container, they are not assigned
+    CountingInstrumentation& operator=(const CountingInstrumentation&) {
+        return *this;
+    }
+
+    void pushed(std::size_t n, std::size_t size) {
+        add(pushes_, n);
+        observe(size);
+    }
+
+    void popped(std::size_t n) {
+        add(pops_, n);
+    }
+
+    void enqueued(std::size_t n, std::size_t size) {
+        pushed(n, size);
+        pushed_at_.insert(pushed_at_.end(), n, clock::now());
+        /// a circular queue drops its oldest items when full
+        while (pushed_at_.size() > size) {
+            pushed_at_.pop_front();
+        }
+    }
+
+    void dequeued(std::size_t n) {
+        popped(n);
+        clock::time_point now = clock::now();
+        for (std::size_t i = 0; i < n && !pushed_at_.empty(); ++i) {
+            std::uint64_t ns = std::chrono::duration_cast<
+                std::chrono::nanoseconds>(now - pushed_at_.front()).count();
+            add(latency_[LatencyHistogram::bucket(ns)], 1);
+            pushed_at_.pop_front();
+        }
+    }
+
+    void empty_pop() {
+        add(empty_pops_, 1);
+    }
+
+    /// push times follow the items when a queue is copied, moved or swapped
+    void copied(const CountingInstrumentation& other) {
+        pushed_at_ = other.pushed_at_;
+    }
+
+    void moved(CountingInstrumentation& other) {
+        pushed_at_ = std::move(other.pushed_at_);
+        other.pushed_at_.clear();
+    }
+
+    void swapped(CountingInstrumentation& other) {
+        pushed_at_.swap(other.pushed_at_);
+    }
+
+    /*
+     * @brief        Read the counters since the last reset
+     * @param        None
+     * @return       The counters
+     */
+    InstrumentationSnapshot snapshot() const {
+        return since_baseline(totals());
+    }
+
+    /*
+     * @brief        Start counting from zero; the peak restarts with the
+     *               next push
+     * @param        None
+     * @return       The counters since the previous reset, read in the
+     *               same pass, so that consecutive results add up to
+     *               every update exactly once
+     */
+    InstrumentationSnapshot reset() {
+        InstrumentationSnapshot now = totals();
+        InstrumentationSnapshot s = since_baseline(now);
+        baseline_ = now;
+        peak_size_.store(0, std::memory_order_relaxed);
+        return s;
+    }
+};
+
+#endif
@@ -0,0 +1,34 @@
+/**
+ *  @brief      Hook linking items into IntrusiveQueue and IntrusiveStack
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_INTRUSIVEHOOK_H_
+#define _INCLUDE_INTRUSIVEHOOK_H_
+
+/*
+ * @brief  The link an item embeds to be held by an intrusive container
+ *
+ * An item type declares one IntrusiveHook<T> member per container it
+ * may sit in at a time, and names it in the container's type, as in
+ * IntrusiveQueue<Message, &Message::hook>. The container links items
+ * through it, so pushing and popping never allocate nor copy the item.
+ *
+ * next belongs to the container the item is linked in, and must not be
+ * touched while it is. Copying an item does not copy its link: the
+ * copy starts unlinked, whatever the original was in.
+ */
+template < typename T >
+struct IntrusiveHook {
+    T* next;
+
+    IntrusiveHook() : next(0) {}
+    IntrusiveHook(const IntrusiveHook&) : next(0) {}
+    IntrusiveHook& operator=(const IntrusiveHook&) { return *this; }
+};
+
+#endif
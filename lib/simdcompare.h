@@ -0,0 +1,335 @@
+/**
+ *  @brief      Vectorized comparisons of arrays and containers of numbers
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_SIMDCOMPARE_H_
+#define _INCLUDE_SIMDCOMPARE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+#include "containertraits.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+    defined(__SSE2__)
+#define SIMDCOMPARE_X86 1
+#include <immintrin.h>
+#endif
+
+/*
+ * @brief  Instruction sets the kernels can use
+ *
+ * simd_level() picks the best one the running CPU supports, once; the
+ * kernels also take it explicitly, so tests can run each of them.
+ */
+enum SimdLevel { kSimdScalar = 0, kSimdSse2 = 1, kSimdAvx2 = 2 };
+
+inline SimdLevel simd_level() {
+#ifdef SIMDCOMPARE_X86
+    static const SimdLevel level =
+        (__builtin_cpu_init(), __builtin_cpu_supports("avx2")) ? kSimdAvx2
+                                                               : kSimdSse2;
+    return level;
+#else
+    return kSimdScalar;
+#endif
+}
+
+#ifdef SIMDCOMPARE_X86
+
+/*
+ * @brief        First byte at which two arrays differ, 16 bytes a step
+ * @param        The arrays and their length in bytes
+ * @return       Its index, or n if they are equal
+ */
+inline std::size_t sse2_first_unequal_byte(const unsigned char* a,
+                                           const unsigned char* b,
+                                           std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) ^ 0xffff;
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    for (; i < n && a[i] == b[i]; ++i) {
+    }
+    return i;
+}
+
+/*
+ * @brief        First byte at which two arrays differ, 64 bytes a step
+ * @param        The arrays and their length in bytes
+ * @return       Its index, or n if they are equal
+ */
+__attribute__((target("avx2")))
+inline std::size_t avx2_first_unequal_byte(const unsigned char* a,
+                                           const unsigned char* b,
+                                           std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        /// test two vectors at once and only locate the byte on a miss
+        const __m256i* x = reinterpret_cast<const __m256i*>(a + i);
+        const __m256i* y = reinterpret_cast<const __m256i*>(b + i);
+        __m256i x0 = _mm256_loadu_si256(x);
+        __m256i y0 = _mm256_loadu_si256(y);
+        __m256i x1 = _mm256_loadu_si256(x + 1);
+        __m256i y1 = _mm256_loadu_si256(y + 1);
+        __m256i eq0 = _mm256_cmpeq_epi8(x0, y0);
+        __m256i eq1 = _mm256_cmpeq_epi8(x1, y1);
+        if (unsigned(_mm256_movemask_epi8(_mm256_and_si256(eq0, eq1))) !=
+            0xffffffffu) {
+            unsigned mask0 = ~unsigned(_mm256_movemask_epi8(eq0));
+            if (mask0) {
+                return i + __builtin_ctz(mask0);
+            }
+            return i + 32 + __builtin_ctz(~unsigned(_mm256_movemask_epi8(eq1)));
+        }
+    }
+    return i + sse2_first_unequal_byte(a + i, b + i, n - i);
+}
+
+/*
+ * @brief        First index at which !(a[i] == b[i]), or, if equivalent
+ *               is set, at which a[i] < b[i] || b[i] < a[i]; the two
+ *               differ only on NaNs, which equal nothing but are
+ *               equivalent to everything
+ * @param        The arrays, their length, and the predicate
+ * @return       The index, or n if there is none
+ */
+inline std::size_t sse2_first_mismatch(const float* a, const float* b,
+                                       std::size_t n, bool equivalent) {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 x = _mm_loadu_ps(a + i);
+        __m128 y = _mm_loadu_ps(b + i);
+        __m128 miss = equivalent
+                          ? _mm_or_ps(_mm_cmplt_ps(x, y), _mm_cmplt_ps(y, x))
+                          : _mm_cmpneq_ps(x, y);
+        unsigned mask = _mm_movemask_ps(miss);
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i;
+}
+
+inline std::size_t sse2_first_mismatch(const double* a, const double* b,
+                                       std::size_t n, bool equivalent) {
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d x = _mm_loadu_pd(a + i);
+        __m128d y = _mm_loadu_pd(b + i);
+        __m128d miss = equivalent
+                           ? _mm_or_pd(_mm_cmplt_pd(x, y), _mm_cmplt_pd(y, x))
+                           : _mm_cmpneq_pd(x, y);
+        unsigned mask = _mm_movemask_pd(miss);
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+inline std::size_t avx2_first_mismatch(const float* a, const float* b,
+                                       std::size_t n, bool equivalent) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_loadu_ps(a + i);
+        __m256 y = _mm256_loadu_ps(b + i);
+        __m256 miss = equivalent ? _mm256_cmp_ps(x, y, _CMP_NEQ_OQ)
+                                 : _mm256_cmp_ps(x, y, _CMP_NEQ_UQ);
+        unsigned mask = _mm256_movemask_ps(miss);
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + sse2_first_mismatch(a + i, b + i, n - i, equivalent);
+}
+
+__attribute__((target("avx2")))
+inline std::size_t avx2_first_mismatch(const double* a, const double* b,
+                                       std::size_t n, bool equivalent) {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d x = _mm256_loadu_pd(a + i);
+        __m256d y = _mm256_loadu_pd(b + i);
+        __m256d miss = equivalent ? _mm256_cmp_pd(x, y, _CMP_NEQ_OQ)
+                                  : _mm256_cmp_pd(x, y, _CMP_NEQ_UQ);
+        unsigned mask = _mm256_movemask_pd(miss);
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + sse2_first_mismatch(a + i, b + i, n - i, equivalent);
+}
+
+#endif
+
+/*
+ * @brief  Mismatch search over arrays of an arithmetic type
+ *
+ * first_unequal finds the first i with !(a[i] == b[i]), which decides
+ * ==; first_inequivalent the first i with a[i] < b[i] || b[i] < a[i],
+ * which decides <. Integers are compared as bytes, like memcmp, and
+ * the byte found mapped back to its item; float and double use vector
+ * compares, so that NaN and -0.0 behave as they do with the operators.
+ * Other types, and tails shorter than a vector, use the scalar loop.
+ */
+template < typename T >
+struct SimdCompare {
+    static_assert(std::is_arithmetic<T>::value,
+                  "SimdCompare works on arithmetic types");
+
+    static std::size_t scalar_first_unequal(const T* a, const T* b,
+                                            std::size_t n) {
+        std::size_t i = 0;
+        for (; i < n && a[i] == b[i]; ++i) {
+        }
+        return i;
+    }
+
+    static std::size_t scalar_first_inequivalent(const T* a, const T* b,
+                                                 std::size_t n) {
+        std::size_t i = 0;
+        for (; i < n && !(a[i] < b[i]) && !(b[i] < a[i]); ++i) {
+        }
+        return i;
+    }
+
+    static std::size_t first_unequal(const T* a, const T* b, std::size_t n,
+                                     SimdLevel level = simd_level()) {
+        return first_mismatch(a, b, n, false, level);
+    }
+
+    static std::size_t first_inequivalent(const T* a, const T* b,
+                                          std::size_t n,
+                                          SimdLevel level = simd_level()) {
+        return first_mismatch(a, b, n, true, level);
+    }
+
+ private:
+    static std::size_t first_mismatch(const T* a, const T* b, std::size_t n,
+                                      bool equivalent, SimdLevel level) {
+        std::size_t i = 0;
+#ifdef SIMDCOMPARE_X86
+        if constexpr (std::is_integral<T>::value) {
+            typedef const unsigned char* bytes;
+            bytes x = reinterpret_cast<bytes>(a);
+            bytes y = reinterpret_cast<bytes>(b);
+            if (level == kSimdAvx2) {
+                return avx2_first_unequal_byte(x, y, n * sizeof(T)) / sizeof(T);
+            } else if (level == kSimdSse2) {
+                return sse2_first_unequal_byte(x, y, n * sizeof(T)) / sizeof(T);
+            }
+        } else if constexpr (std::is_same<T, float>::value ||
+                             std::is_same<T, double>::value) {
+            if (level == kSimdAvx2) {
+                i = avx2_first_mismatch(a, b, n, equivalent);
+            } else if (level == kSimdSse2) {
+                i = sse2_first_mismatch(a, b, n, equivalent);
+            }
+        }
+#else
+        (void)level;
+#endif
+        return i + (equivalent ? scalar_first_inequivalent(a + i, b + i, n - i)
+                               : scalar_first_unequal(a + i, b + i, n - i));
+    }
+};
+
+/*
+ * @brief  The comparisons Queue and Stack apply to their containers
+ *
+ * The primary template uses the container's own == and <. Containers
+ * of arithmetic items which describe their storage as contiguous runs
+ * (see ContainerSegments) are instead compared run by run with the
+ * SimdCompare kernels, pairing up runs of different lengths.
+ */
+template < typename Container,
+           bool = ContainerSegments<Container>::contiguous &&
+                  std::is_arithmetic<typename Container::value_type>::value >
+struct ContainerCompare {
+    static bool equal(const Container& lhs, const Container& rhs) {
+        return lhs == rhs;
+    }
+
+    static bool less(const Container& lhs, const Container& rhs) {
+        return lhs < rhs;
+    }
+};
+
+template < typename Container >
+struct ContainerCompare< Container, true > {
+    typedef typename Container::value_type T;
+    typedef ContainerSegments<Container> Segments;
+
+    static bool equal(const Container& lhs, const Container& rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        const T* a;
+        const T* b;
+        return !first_mismatch(lhs, rhs, false, a, b);
+    }
+
+    static bool less(const Container& lhs, const Container& rhs) {
+        const T* a;
+        const T* b;
+        if (first_mismatch(lhs, rhs, true, a, b)) {
+            return *a < *b;
+        }
+        return lhs.size() < rhs.size();
+    }
+
+ private:
+    /*
+     * @brief        Walk the runs of both containers up to the shorter
+     *               one's end, looking for a mismatch
+     * @param        The containers, the predicate (see SimdCompare), and
+     *               where to point at the mismatching items
+     * @return       true if a mismatch was found
+     */
+    static bool first_mismatch(const Container& lhs, const Container& rhs,
+                               bool equivalent, const T*& a, const T*& b) {
+        typename Segments::cursor left = Segments::runs(lhs);
+        typename Segments::cursor right = Segments::runs(rhs);
+        SimdLevel level = simd_level();
+        std::size_t na = 0;
+        std::size_t nb = 0;
+        for (;;) {
+            while (na == 0) {
+                if (!left.next(a, na)) {
+                    return false;
+                }
+            }
+            while (nb == 0) {
+                if (!right.next(b, nb)) {
+                    return false;
+                }
+            }
+            std::size_t n = std::min(na, nb);
+            std::size_t i =
+                equivalent ? SimdCompare<T>::first_inequivalent(a, b, n, level)
+                           : SimdCompare<T>::first_unequal(a, b, n, level);
+            a += i;
+            b += i;
+            if (i < n) {
+                return true;
+            }
+            na -= n;
+            nb -= n;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,587 @@
+/**
+ *  @brief      Ring buffer container with inline storage for small sizes
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_SMALLRING_H_
+#define _INCLUDE_SMALLRING_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "containertraits.h"
+
+/*
+ * @brief  The small ring buffer container class
+ *
+ * A circular buffer whose first N slots live inside the object itself,
+ * so a container that never holds more than N items never touches the
+ * heap. Once full it spills to a heap buffer of twice the capacity and
+ * stays there.
+ *
+ * It supports both the Queue container requirements (front, back,
+ * push_back, pop_front) and the Stack ones (back, push_back, pop_back),
+ * so it can back either; see SmallQueue and SmallStack.
+ *
+ * N must be a power of two so that slot indices wrap with a mask.
+ * The heap buffer comes from Allocator, which moves and swaps along
+ * with it.
+ */
+template < typename T, std::size_t N, typename Allocator = std::allocator<T> >
+class SmallRing {
+    static_assert(N > 0 && (N & (N - 1)) == 0,
+                  "SmallRing inline capacity must be a power of two");
+
+ public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef std::size_t size_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+
+ private:
+    typedef std::allocator_traits<Allocator> traits;
+
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type inline_[N];
+    Allocator alloc_;
+    T* data_;
+    size_type head_;
+    size_type size_;
+    size_type capacity_;
+
+    T* slot(size_type i) const { return data_ + ((head_ + i) & (capacity_ - 1)); }
+    bool spilled() const { return data_ != reinterpret_cast<const T*>(inline_); }
+    void take(SmallRing& other);
+    void relocate(T* data);
+    template < typename... Args >
+    void grow_and_emplace_back(Args&&... args);
+    void reallocate(size_type capacity);
+    template < typename InputIterator >
+    void append(InputIterator first, InputIterator last, std::input_iterator_tag);
+    template < typename ForwardIterator >
+    void append(ForwardIterator first, ForwardIterator last,
+                std::forward_iterator_tag);
+
+ public:
+    SmallRing();
+    explicit SmallRing(const Allocator& alloc);
+    SmallRing(const SmallRing& other);
+    SmallRing(SmallRing&& other)
+        noexcept(std::is_nothrow_move_constructible<T>::value);
+    SmallRing& operator=(const SmallRing& other);
+    SmallRing& operator=(SmallRing&& other)
+        noexcept(std::is_nothrow_move_constructible<T>::value);
+    ~SmallRing();
+
+    bool empty() const { return size_ == 0; }
+    size_type size() const { return size_; }
+    size_type capacity() const { return capacity_; }
+    bool is_inline() const { return !spilled(); }
+    T& operator[](size_type i) { return *slot(i); }
+    const T& operator[](size_type i) const { return *slot(i); }
+    T& front() { return *slot(0); }
+    const T& front() const { return *slot(0); }
+    T& back() { return *slot(size_ - 1); }
+    const T& back() const { return *slot(size_ - 1); }
+    /// no. of items from the front before the slots wrap around
+    size_type front_run() const { return std::min(size_, capacity_ - head_); }
+
+    void push_back(const T& val);
+    void push_back(T&& val);
+    template < typename... Args >
+    void emplace_back(Args&&... args);
+    void pop_front();
+    void pop_back();
+    template < typename InputIterator >
+    void append(InputIterator first, InputIterator last);
+    template < typename OutputIterator >
+    OutputIterator take_front(size_type n, OutputIterator out);
+    template < typename OutputIterator >
+    OutputIterator take_back(size_type n, OutputIterator out);
+    void clear();
+    void swap(SmallRing& other);
+    Allocator get_allocator() const { return alloc_; }
+};
+
+/*
+ * @brief        Default constructor, uses the inline slots
+ */
+template < typename T, std::size_t N, typename A >
+SmallRing<T, N, A>::SmallRing()
+    : alloc_(), data_(reinterpret_cast<T*>(inline_)), head_(0), size_(0),
+      capacity_(N) {
+}
+
+/*
+ * @brief        Constructor taking the allocator used once spilled
+ */
+template < typename T, std::size_t N, typename A >
+SmallRing<T, N, A>::SmallRing(const A& alloc)
+    : alloc_(alloc), data_(reinterpret_cast<T*>(inline_)), head_(0), size_(0),
+      capacity_(N) {
+}
+
+/*
+ * @brief        Copy constructor
+ */
+template < typename T, std::size_t N, typename A >
+SmallRing<T, N, A>::SmallRing(const SmallRing& other)
+    : alloc_(traits::select_on_container_copy_construction(other.alloc_)),
+      data_(reinterpret_cast<T*>(inline_)), head_(0), size_(0), capacity_(N) {
+    try {
+        for (size_type i = 0; i < other.size_; ++i) {
+            push_back(other[i]);
+        }
+    } catch (...) {
+        clear();
+        if (spilled()) {
+            traits::deallocate(alloc_, data_, capacity_);
+        }
+        throw;
+    }
+}
+
+/*
+ * @brief        Move constructor, steals a spilled buffer or moves items
+ */
+template < typename T, std::size_t N, typename A >
+SmallRing<T, N, A>::SmallRing(SmallRing&& other)
+    noexcept(std::is_nothrow_move_constructible<T>::value)
+    : alloc_(other.alloc_), data_(reinterpret_cast<T*>(inline_)), head_(0),
+      size_(0), capacity_(N) {
+    take(other);
+}
+
+/*
+ * @brief        Copy assignment
+ */
+template < typename T, std::size_t N, typename A >
+SmallRing<T, N, A>& SmallRing<T, N, A>::operator=(const SmallRing& other) {
+    if (this != &other) {
+        SmallRing copy(other);
+        clear();
+        take(copy);
+    }
+    return *this;
+}
+
+/*
+ * @brief        Move assignment, steals a spilled buffer or moves items
+ */
+template < typename T, std::size_t N, typename A >
+SmallRing<T, N, A>& SmallRing<T, N, A>::operator=(SmallRing&& other)
+    noexcept(std::is_nothrow_move_constructible<T>::value) {
+    if (this != &other) {
+        clear();
+        take(other);
+    }
+    return *this;
+}
+
+/*
+ * @brief        Destructor
+ */
+template < typename T, std::size_t N, typename A >
+SmallRing<T, N, A>::~SmallRing() {
+    clear();
+    if (spilled()) {
+        traits::deallocate(alloc_, data_, capacity_);
+    }
+}
+
+/*
+ * @brief        Move the items of other into this empty ring
+ * @param        The ring to move from, left empty
+ * @return       Nothing
+ */
+template < typename T, std::size_t N, typename A >
+void SmallRing<T, N, A>::take(SmallRing& other) {
+    if (other.spilled()) {
+        if (spilled()) {
+            traits::deallocate(alloc_, data_, capacity_);
+        }
+        alloc_ = other.alloc_;  // the buffer goes back to its own allocator
+        data_ = other.data_;
+        head_ = other.head_;
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+        other.data_ = reinterpret_cast<T*>(other.inline_);
+        other.head_ = 0;
+        other.size_ = 0;
+        other.capacity_ = N;
+        return;
+    }
+    for (size_type i = 0; i < other.size_; ++i) {
+        emplace_back(std::move(other[i]));
+    }
+    other.clear();
+}
+
+/*
+ * @brief        Add a new item at the back
+ * @param        The item
+ * @return       Nothing
+ */
+template < typename T, std::size_t N, typename A >
+void SmallRing<T, N, A>::push_back(const T& val) {
+    emplace_back(val);
+}
+
+/*
+ * @brief        Move a new item to the back
+ * @param        The item
+ * @return       Nothing
+ */
+template < typename T, std::size_t N, typename A >
+void SmallRing<T, N, A>::push_back(T&& val) {
+    emplace_back(std::move(val));
+}
+
+/*
+ * @brief        Construct a new item in place at the back
+ * @param        Arguments forwarded to the constructor of T
+ * @return       Nothing
+ */
+template < typename T, std::size_t N, typename A >
+template < typename... Args >
+void SmallRing<T, N, A>::emplace_back(Args&&... args) {
+    if (size_ == capacity_) {
+        grow_and_emplace_back(std::forward<Args>(args)...);
+        return;
+    }
+    ::new (static_cast<void*>(slot(size_))) T(std::forward<Args>(args)...);
+    ++size_;
+}
+
+/*
+ * @brief        Move the items, unwrapped, to uninitialized storage and
+ *               destroy the old ones
+ * @param        The new buffer, which is not freed
+ * @return       Nothing
+ *
+ * Items whose move may throw are copied instead, as std::vector does,
+ * so that if one throws the items built so far are destroyed and the
+ * ring is left as it was.
+ */
+template < typename T, std::size_t N, typename A >
+void SmallRing<T, N, A>::relocate(T* data) {
+    size_type i = 0;
+    try {
+        for (; i < size_; ++i) {
+            ::new (static_cast<void*>(data + i))
+                T(std::move_if_noexcept(*slot(i)));
+        }
+    } catch (...) {
+        while (i) {
+            data[--i].~T();
+        }
+        throw;
+    }
+    for (i = 0; i < size_; ++i) {
+        slot(i)->~T();
+    }
+}
+
+/*
+ * @brief        Slow path of emplace_back, moves to a heap buffer twice
+ *               as large with the items unwrapped
+ * @param        Arguments forwarded to the constructor of T
+ * @return       Nothing
+ *
+ * The new item is constructed before the old items move, so the
+ * arguments may refer to an item of this container.
+ */
+template < typename T, std::size_t N, typename A >
+template < typename... Args >
+void SmallRing<T, N, A>::grow_and_emplace_back(Args&&... args) {
+    size_type capacity = capacity_ * 2;
+    T* data = traits::allocate(alloc_, capacity);
+    try {
+        ::new (static_cast<void*>(data + size_)) T(std::forward<Args>(args)...);
+    } catch (...) {
+        traits::deallocate(alloc_, data, capacity);
+        throw;
+    }
+    try {
+        relocate(data);
+    } catch (...) {
+        data[size_].~T();
+        traits::deallocate(alloc_, data, capacity);
+        throw;
+    }
+    if (spilled()) {
+        traits::deallocate(alloc_, data_, capacity_);
+    }
+    data_ = data;
+    head_ = 0;
+    capacity_ = capacity;
+    ++size_;
+}
+
+/*
+ * @brief        Move the items, unwrapped, to a heap buffer
+ * @param        The new capacity, a power of two of at least size()
+ * @return       Nothing
+ */
+template < typename T, std::size_t N, typename A >
+void SmallRing<T, N, A>::reallocate(size_type capacity) {
+    T* data = traits::allocate(alloc_, capacity);
+    try {
+        relocate(data);
+    } catch (...) {
+        traits::deallocate(alloc_, data, capacity);
+        throw;
+    }
+    if (spilled()) {
+        traits::deallocate(alloc_, data_, capacity_);
+    }
+    data_ = data;
+    head_ = 0;
+    capacity_ = capacity;
+}
+
+/*
+ * @brief        Add a range of items at the back
+ * @param        Iterators to the first and past the last item, which
+ *               must not refer to this container
+ * @return       Nothing
+ *
+ * Ranges of known length grow the buffer at most once and are copied
+ * in at most two contiguous pieces.
+ */
+template < typename T, std::size_t N, typename A >
+template < typename InputIterator >
+void SmallRing<T, N, A>::append(InputIterator first, InputIterator last) {
+    append(first, last,
+           typename std::iterator_traits<InputIterator>::iterator_category());
+}
+
+/*
+ * @brief        append for single pass ranges, one item at a time
+ */
+template < typename T, std::size_t N, typename A >
+template < typename InputIterator >
+void SmallRing<T, N, A>::append(InputIterator first, InputIterator last,
+                                std::input_iterator_tag) {
+    for (; first != last; ++first) {
+        emplace_back(*first);
+    }
+}
+
+/*
+ * @brief        append for ranges of known length
+ */
+template < typename T, std::size_t N, typename A >
+template < typename ForwardIterator >
+void SmallRing<T, N, A>::append(ForwardIterator first, ForwardIterator last,
+                                std::forward_iterator_tag) {
+    size_type n = std::distance(first, last);
+    if (size_ + n > capacity_) {
+        size_type capacity = capacity_ * 2;
+        while (capacity < size_ + n) {
+            capacity *= 2;
+        }
+        reallocate(capacity);
+    }
+    size_type tail = (head_ + size_) & (capacity_ - 1);
+    size_type piece = std::min(n, capacity_ - tail);
+    ForwardIterator mid = first;
+    std::advance(mid, piece);
+    std::uninitialized_copy(first, mid, data_ + tail);
+    size_ += piece;
+    std::uninitialized_copy(mid, last, data_);
+    size_ += n - piece;
+}
+
+/*
+ * @brief        Move the first n items out and delete them
+ * @param        The no. of items, at most size(), and where to move them
+ * @return       The output iterator past the last item written
+ */
+template < typename T, std::size_t N, typename A >
+template < typename OutputIterator >
+OutputIterator SmallRing<T, N, A>::take_front(size_type n, OutputIterator out) {
+    size_type piece = std::min(n, capacity_ - head_);
+    out = std::move(data_ + head_, data_ + head_ + piece, out);
+    out = std::move(data_, data_ + (n - piece), out);
+    for (size_type i = 0; i < n; ++i) {
+        slot(i)->~T();
+    }
+    head_ = (head_ + n) & (capacity_ - 1);
+    size_ -= n;
+    return out;
+}
+
+/*
+ * @brief        Move the last n items out, last item first, and delete them
+ * @param        The no. of items, at most size(), and where to move them
+ * @return       The output iterator past the last item written
+ */
+template < typename T, std::size_t N, typename A >
+template < typename OutputIterator >
+OutputIterator SmallRing<T, N, A>::take_back(size_type n, OutputIterator out) {
+    for (size_type i = 0; i < n; ++i, ++out) {
+        *out = std::move(back());
+        pop_back();
+    }
+    return out;
+}
+
+/*
+ * @brief        Delete the front item, which must exist
+ * @param        None
+ * @return       Nothing
+ */
+template < typename T, std::size_t N, typename A >
+void SmallRing<T, N, A>::pop_front() {
+    data_[head_].~T();
+    head_ = (head_ + 1) & (capacity_ - 1);
+    --size_;
+}
+
+/*
+ * @brief        Delete the back item, which must exist
+ * @param        None
+ * @return       Nothing
+ */
+template < typename T, std::size_t N, typename A >
+void SmallRing<T, N, A>::pop_back() {
+    --size_;
+    slot(size_)->~T();
+}
+
+/*
+ * @brief        Delete all items, keeping the buffer
+ * @param        None
+ * @return       Nothing
+ */
+template < typename T, std::size_t N, typename A >
+void SmallRing<T, N, A>::clear() {
+    while (size_) {
+        pop_back();
+    }
+    head_ = 0;
+}
+
+/*
+ * @brief        Exchange the contents of two rings
+ * @param        The other ring
+ * @return       Nothing
+ */
+template < typename T, std::size_t N, typename A >
+void SmallRing<T, N, A>::swap(SmallRing& other) {
+    SmallRing tmp(std::move(other));
+    other.take(*this);
+    take(tmp);
+}
+
+/*
+ * @brief        Exchange the contents of two rings, found through ADL
+ */
+template < typename T, std::size_t N, typename A >
+void swap(SmallRing<T, N, A>& lhs, SmallRing<T, N, A>& rhs) {
+    lhs.swap(rhs);
+}
+
+/*
+ * @brief        Performs the equality test on operands
+ * @param        Two ring objects to be compared
+ * @return       true if equal
+ */
+template < typename T, std::size_t N, typename A >
+bool operator==(const SmallRing<T, N, A>& lhs, const SmallRing<T, N, A>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        if (!(lhs[i] == rhs[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * @brief        Performs the lexicographical less than test on operands
+ * @param        Two ring objects to be compared
+ * @return       true if left is less than right operand
+ */
+template < typename T, std::size_t N, typename A >
+bool operator<(const SmallRing<T, N, A>& lhs, const SmallRing<T, N, A>& rhs) {
+    for (std::size_t i = 0; i < lhs.size() && i < rhs.size(); ++i) {
+        if (lhs[i] < rhs[i]) {
+            return true;
+        }
+        if (rhs[i] < lhs[i]) {
+            return false;
+        }
+    }
+    return lhs.size() < rhs.size();
+}
+
+/*
+ * @brief        SmallRing with its allocator replaced
+ */
+template < typename T, std::size_t N, typename A, typename Allocator >
+struct RebindContainer< SmallRing<T, N, A>, Allocator > {
+    typedef SmallRing<T, N, Allocator> type;
+};
+
+/*
+ * @brief        Bulk operations on SmallRing, see ContainerBulk
+ */
+template < typename T, std::size_t N, typename A >
+struct ContainerBulk< SmallRing<T, N, A> > {
+    template < typename InputIterator >
+    static void append(SmallRing<T, N, A>& c, InputIterator first,
+                       InputIterator last) {
+        c.append(first, last);
+    }
+
+    template < typename OutputIterator >
+    static OutputIterator take_front(SmallRing<T, N, A>& c, std::size_t n,
+                                     OutputIterator out) {
+        return c.take_front(n, out);
+    }
+
+    template < typename OutputIterator >
+    static OutputIterator take_back(SmallRing<T, N, A>& c, std::size_t n,
+                                    OutputIterator out) {
+        return c.take_back(n, out);
+    }
+
+    template < typename OutputIterator >
+    static OutputIterator copy(const SmallRing<T, N, A>& c, OutputIterator out) {
+        for (std::size_t i = 0; i < c.size(); ++i) {
+            *out++ = c[i];
+        }
+        return out;
+    }
+};
+
+/*
+ * @brief        SmallRing as its two runs of slots, see ContainerSegments
+ */
+template < typename T, std::size_t N, typename A >
+struct ContainerSegments< SmallRing<T, N, A> > {
+    static const bool contiguous = true;
+    typedef SplitCursor<T> cursor;
+
+    static cursor runs(const SmallRing<T, N, A>& c) {
+        std::size_t first = c.front_run();
+        return first == c.size() ? cursor(&c[0], first, 0, 0)
+                                 : cursor(&c[0], first, &c[first],
+                                          c.size() - first);
+    }
+};
+
+#endif
@@ -0,0 +1,364 @@
+/**
+ *  @brief      Fixed-capacity ring buffer sized at compile time
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_STATICRING_H_
+#define _INCLUDE_STATICRING_H_
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "containertraits.h"
+
+/*
+ * @brief  Overflow policies of StaticRing, StaticQueue and StaticStack
+ *
+ *   OverflowError      push returns false and leaves the items as they are
+ *   OverflowAssert     a push when full fails an assert; in release builds
+ *                      it behaves like OverflowError
+ *   OverflowOverwrite  push drops the oldest item to make room
+ */
+struct OverflowError {};
+struct OverflowAssert {};
+struct OverflowOverwrite {};
+
+/*
+ * @brief  The fixed-capacity ring buffer class
+ *
+ * Keeps N items in a std::array inside the object, so it never touches
+ * the heap, and wraps indices around it. Every member is constexpr, so
+ * rings of literal types can be filled and drained at compile time.
+ *
+ * Slots hold default-constructed items when unused; a popped item that
+ * is not trivially destructible is reset to T() so that it releases
+ * what it owns right away.
+ *
+ * It also serves as the container of a Queue (see CircularQueue) or a
+ * Stack, whose push throws when a ring with the OverflowError or
+ * OverflowAssert policy is full; it never uses the allocator_type it
+ * declares.
+ */
+template < typename T, std::size_t N, typename Overflow = OverflowError >
+class StaticRing {
+    static_assert(N > 0, "StaticRing needs room for at least one item");
+
+ public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::allocator<T> allocator_type;
+
+    /// bidirectional iterator from the front item to the back one
+    class const_iterator {
+     public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        constexpr const_iterator() : ring_(0), i_(0) {}
+        constexpr reference operator*() const { return (*ring_)[i_]; }
+        constexpr pointer operator->() const { return &(*ring_)[i_]; }
+
+        constexpr const_iterator& operator++() {
+            ++i_;
+            return *this;
+        }
+
+        constexpr const_iterator operator++(int) {
+            const_iterator old(*this);
+            ++i_;
+            return old;
+        }
+
+        constexpr const_iterator& operator--() {
+            --i_;
+            return *this;
+        }
+
+        constexpr const_iterator operator--(int) {
+            const_iterator old(*this);
+            --i_;
+            return old;
+        }
+
+        constexpr bool operator==(const const_iterator& other) const {
+            return ring_ == other.ring_ && i_ == other.i_;
+        }
+
+        constexpr bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+     private:
+        friend class StaticRing;
+
+        constexpr const_iterator(const StaticRing* ring, size_type i)
+            : ring_(ring), i_(i) {}
+
+        const StaticRing* ring_;
+        size_type i_;
+    };
+
+ private:
+    std::array<T, N> items_;
+    size_type head_;
+    size_type size_;
+
+    constexpr size_type index(size_type i) const {
+        i += head_;
+        return i < N ? i : i - N;
+    }
+
+    constexpr void release(T& item) {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            item = T();
+        }
+    }
+
+    /// store a new item in a slot, without a temporary when given a T
+    template < typename... Args >
+    static constexpr void assign(T& slot, Args&&... args) {
+        if constexpr (sizeof...(Args) == 1 &&
+                      (std::is_same<std::decay_t<Args>, T>::value && ...)) {
+            slot = (std::forward<Args>(args), ...);
+        } else {
+            slot = T(std::forward<Args>(args)...);
+        }
+    }
+
+ public:
+    constexpr StaticRing() : items_(), head_(0), size_(0) {}
+
+    constexpr bool empty() const { return size_ == 0; }
+    constexpr bool full() const { return size_ == N; }
+    constexpr size_type size() const { return size_; }
+    static constexpr size_type capacity() { return N; }
+    constexpr T& operator[](size_type i) { return items_[index(i)]; }
+    constexpr const T& operator[](size_type i) const { return items_[index(i)]; }
+    constexpr T& front() { return items_[head_]; }
+    constexpr const T& front() const { return items_[head_]; }
+    constexpr T& back() { return items_[index(size_ - 1)]; }
+    constexpr const T& back() const { return items_[index(size_ - 1)]; }
+    /// no. of items from the front before the slots wrap around
+    constexpr size_type front_run() const { return std::min(size_, N - head_); }
+    constexpr const_iterator begin() const { return const_iterator(this, 0); }
+    constexpr const_iterator end() const { return const_iterator(this, size_); }
+
+    /*
+     * @brief        Construct an item and add it at the back
+     * @param        Arguments forwarded to the constructor of T
+     * @return       false if the ring was full and the policy rejected
+     *               it, in which case no item is constructed
+     */
+    template < typename... Args >
+    constexpr bool emplace_back(Args&&... args) {
+        if (size_ == N) {
+            if constexpr (std::is_same<Overflow, OverflowOverwrite>::value) {
+                /// the slot after the back is the front's: overwrite it
+                assign(items_[head_], std::forward<Args>(args)...);
+                head_ = index(1);
+                return true;
+            } else {
+                assert(!(std::is_same<Overflow, OverflowAssert>::value) &&
+                       "StaticRing full");
+                return false;
+            }
+        }
+        assign(items_[index(size_)], std::forward<Args>(args)...);
+        ++size_;
+        return true;
+    }
+
+    constexpr bool push_back(const T& val) { return emplace_back(val); }
+    constexpr bool push_back(T&& val) { return emplace_back(std::move(val)); }
+
+    /*
+     * @brief        Delete the front item, which must exist
+     */
+    constexpr void pop_front() {
+        release(items_[head_]);
+        head_ = index(1);
+        --size_;
+    }
+
+    /*
+     * @brief        Delete the back item, which must exist
+     */
+    constexpr void pop_back() {
+        release(back());
+        --size_;
+    }
+
+    constexpr void clear() {
+        while (size_) {
+            pop_back();
+        }
+        head_ = 0;
+    }
+
+    /*
+     * @brief        Add a range of items at the back, in order
+     * @param        The range
+     * @return       The no. of items added; it stops at the first item
+     *               the policy rejects
+     */
+    template < typename InputIterator >
+    constexpr size_type append(InputIterator first, InputIterator last) {
+        size_type added = 0;
+        for (; first != last && emplace_back(*first); ++first) {
+            ++added;
+        }
+        return added;
+    }
+
+    template < typename OutputIterator >
+    constexpr OutputIterator take_front(size_type n, OutputIterator out) {
+        for (; n; --n) {
+            *out++ = std::move(front());
+            pop_front();
+        }
+        return out;
+    }
+
+    template < typename OutputIterator >
+    constexpr OutputIterator take_back(size_type n, OutputIterator out) {
+        for (; n; --n) {
+            *out++ = std::move(back());
+            pop_back();
+        }
+        return out;
+    }
+
+    /*
+     * @brief        Copy every item out, front first, in at most two
+     *               contiguous pieces
+     * @param        Where to copy the items
+     * @return       The output iterator past the last item written
+     */
+    template < typename OutputIterator >
+    OutputIterator copy(OutputIterator out) const {
+        size_type first = front_run();
+        out = std::copy(items_.begin() + head_, items_.begin() + head_ + first,
+                        out);
+        return std::copy(items_.begin(), items_.begin() + (size_ - first), out);
+    }
+
+    constexpr void swap(StaticRing& other) {
+        std::swap(items_, other.items_);
+        std::swap(head_, other.head_);
+        std::swap(size_, other.size_);
+    }
+};
+
+/*
+ * @brief        Performs the equality test on operands
+ * @param        Two ring objects to be compared
+ * @return       true if equal
+ */
+template < typename T, std::size_t N, typename O >
+constexpr bool operator==(const StaticRing<T, N, O>& lhs,
+                          const StaticRing<T, N, O>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        if (!(lhs[i] == rhs[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * @brief        Performs the lexicographical less than test on operands
+ * @param        Two ring objects to be compared
+ * @return       true if left is less than right operand
+ */
+template < typename T, std::size_t N, typename O >
+constexpr bool operator<(const StaticRing<T, N, O>& lhs,
+                         const StaticRing<T, N, O>& rhs) {
+    for (std::size_t i = 0; i < lhs.size() && i < rhs.size(); ++i) {
+        if (lhs[i] < rhs[i]) {
+            return true;
+        }
+        if (rhs[i] < lhs[i]) {
+            return false;
+        }
+    }
+    return lhs.size() < rhs.size();
+}
+
+/*
+ * @brief        StaticRing keeps its items inline, any allocator is ignored
+ */
+template < typename T, std::size_t N, typename O, typename Allocator >
+struct RebindContainer< StaticRing<T, N, O>, Allocator > {
+    typedef StaticRing<T, N, O> type;
+};
+
+/*
+ * @brief        Bulk operations on StaticRing, see ContainerBulk
+ *
+ * append has no way to tell Queue and Stack that a full ring rejected
+ * items, so their push_range and push_bulk are only offered with the
+ * OverflowOverwrite policy, under which every item goes in.
+ */
+template < typename T, std::size_t N, typename O >
+struct ContainerBulk< StaticRing<T, N, O> > {
+    template < typename InputIterator >
+    static void append(StaticRing<T, N, O>& c, InputIterator first,
+                       InputIterator last) {
+        static_assert(std::is_same<O, OverflowOverwrite>::value,
+                      "bulk pushes to a StaticRing would drop items "
+                      "silently; push them one by one and check the result");
+        c.append(first, last);
+    }
+
+    template < typename OutputIterator >
+    static OutputIterator take_front(StaticRing<T, N, O>& c, std::size_t n,
+                                     OutputIterator out) {
+        return c.take_front(n, out);
+    }
+
+    template < typename OutputIterator >
+    static OutputIterator take_back(StaticRing<T, N, O>& c, std::size_t n,
+                                    OutputIterator out) {
+        return c.take_back(n, out);
+    }
+
+    template < typename OutputIterator >
+    static OutputIterator copy(const StaticRing<T, N, O>& c,
+                               OutputIterator out) {
+        return c.copy(out);
+    }
+};
+
+/*
+ * @brief        StaticRing as its two runs of slots, see ContainerSegments
+ */
+template < typename T, std::size_t N, typename O >
+struct ContainerSegments< StaticRing<T, N, O> > {
+    static const bool contiguous = true;
+    typedef SplitCursor<T> cursor;
+
+    static cursor runs(const StaticRing<T, N, O>& c) {
+        std::size_t first = c.front_run();
+        return first == c.size() ? cursor(&c[0], first, 0, 0)
+                                 : cursor(&c[0], first, &c[first],
+                                          c.size() - first);
+    }
+};
+
+#endif
@@ -0,0 +1,617 @@
+/**
+ *  @brief      Unrolled linked list of cache-line-sized blocks
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_UNROLLEDLIST_H_
+#define _INCLUDE_UNROLLEDLIST_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "containertraits.h"
+
+/*
+ * @brief  The unrolled linked list container class
+ *
+ * A doubly linked list of nodes, each holding a block of items in the
+ * rest of NodeBytes bytes, a multiple of the cache line; nodes of large
+ * items grow by whole lines until at least 8 items fit. Items of a node
+ * are contiguous, so walking the list misses the cache once per node
+ * instead of once per item, and allocates once per node.
+ *
+ * A node emptied by pop_front or pop_back goes to a free list inside
+ * the container, which push_back reuses before allocating; nodes are
+ * only returned to the allocator by shrink_to_fit and the destructor,
+ * so a queue or stack cycling around a steady size stops allocating.
+ * reserve fills the free list ahead of time.
+ *
+ * It supports both the Queue container requirements (front, back,
+ * push_back, pop_front) and the Stack ones (back, push_back, pop_back),
+ * so it can back either. Nodes come from Allocator, rebound to the node
+ * type, which moves and swaps along with them.
+ */
+template < typename T, std::size_t NodeBytes = 256,
+           typename Allocator = std::allocator<T> >
+class UnrolledList {
+    static_assert(NodeBytes > 0 && NodeBytes % 64 == 0,
+                  "UnrolledList nodes must be a multiple of the cache line");
+
+ public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef std::size_t size_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+
+ private:
+    struct Links {
+        Links* prev;
+        Links* next;
+        std::uint32_t begin;
+        std::uint32_t end;
+    };
+
+    static const size_type kCacheLine = 64;
+    static const size_type kMinItems = 8;
+    static const size_type kHeader =
+        (sizeof(Links) + alignof(T) - 1) / alignof(T) * alignof(T);
+    /// NodeBytes, grown by whole cache lines until kMinItems items fit
+    static const size_type kMinBytes =
+        (kHeader + kMinItems * sizeof(T) + kCacheLine - 1) / kCacheLine *
+        kCacheLine;
+    static const size_type kStorage =
+        (NodeBytes > kMinBytes ? NodeBytes : kMinBytes) - kHeader;
+
+ public:
+    /// no. of items in a node
+    static const size_type kPerNode = kStorage / sizeof(T);
+
+ private:
+    struct Node : Links {
+        alignas(T) unsigned char storage[kStorage];
+
+        T* items() { return reinterpret_cast<T*>(storage); }
+    };
+
+    typedef typename std::allocator_traits<Allocator>::template
+        rebind_alloc<Node> node_allocator;
+    typedef std::allocator_traits<node_allocator> node_traits;
+
+    node_allocator alloc_;
+    Node* head_;
+    Node* tail_;
+    Node* spare_;
+    size_type size_;
+
+    Node* allocate_node();
+    Node* new_node();
+    void free_nodes(Node* list);
+    void unlink_head();
+    void unlink_tail();
+    void take(UnrolledList& other);
+
+ public:
+    /// bidirectional iterator from the front item to the back one
+    class const_iterator {
+     public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        const_iterator() : node_(0), i_(0) {}
+        reference operator*() const { return node_->items()[i_]; }
+        pointer operator->() const { return &node_->items()[i_]; }
+
+        const_iterator& operator++() {
+            if (++i_ == node_->end && node_->next) {
+                node_ = static_cast<Node*>(node_->next);
+                i_ = node_->begin;
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old(*this);
+            ++*this;
+            return old;
+        }
+
+        const_iterator& operator--() {
+            if (i_ == node_->begin) {
+                node_ = static_cast<Node*>(node_->prev);
+                i_ = node_->end;
+            }
+            --i_;
+            return *this;
+        }
+
+        const_iterator operator--(int) {
+            const_iterator old(*this);
+            --*this;
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return node_ == other.node_ && i_ == other.i_;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+     private:
+        friend class UnrolledList;
+
+        const_iterator(Node* node, size_type i) : node_(node), i_(i) {}
+
+        Node* node_;
+        size_type i_;
+    };
+
+    /// cursor over the items node by node, see ContainerSegments
+    class run_cursor {
+     public:
+        explicit run_cursor(const UnrolledList& list) : node_(list.head_) {}
+
+        bool next(const T*& items, size_type& n) {
+            if (!node_) {
+                return false;
+            }
+            items = node_->items() + node_->begin;
+            n = node_->end - node_->begin;
+            node_ = static_cast<Node*>(node_->next);
+            return true;
+        }
+
+     private:
+        Node* node_;
+    };
+
+    UnrolledList();
+    explicit UnrolledList(const Allocator& alloc);
+    UnrolledList(const UnrolledList& other);
+    UnrolledList(UnrolledList&& other) noexcept;
+    UnrolledList& operator=(const UnrolledList& other);
+    UnrolledList& operator=(UnrolledList&& other) noexcept;
+    ~UnrolledList();
+
+    bool empty() const { return size_ == 0; }
+    size_type size() const { return size_; }
+    T& front() { return head_->items()[head_->begin]; }
+    const T& front() const { return head_->items()[head_->begin]; }
+    T& back() { return tail_->items()[tail_->end - 1]; }
+    const T& back() const { return tail_->items()[tail_->end - 1]; }
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    void push_back(const T& val) { emplace_back(val); }
+    void push_back(T&& val) { emplace_back(std::move(val)); }
+    template < typename... Args >
+    void emplace_back(Args&&... args);
+    void pop_front();
+    void pop_back();
+    void clear();
+    void reserve(size_type n);
+    void shrink_to_fit();
+    void swap(UnrolledList& other) noexcept;
+    Allocator get_allocator() const { return Allocator(alloc_); }
+};
+
+/*
+ * @brief        Default constructor, allocates nothing
+ */
+template < typename T, std::size_t B, typename A >
+UnrolledList<T, B, A>::UnrolledList()
+    : alloc_(), head_(0), tail_(0), spare_(0), size_(0) {
+}
+
+/*
+ * @brief        Constructor taking the allocator of the nodes
+ */
+template < typename T, std::size_t B, typename A >
+UnrolledList<T, B, A>::UnrolledList(const A& alloc)
+    : alloc_(alloc), head_(0), tail_(0), spare_(0), size_(0) {
+}
+
+/*
+ * @brief        Copy constructor
+ */
+template < typename T, std::size_t B, typename A >
+UnrolledList<T, B, A>::UnrolledList(const UnrolledList& other)
+    : alloc_(node_traits::select_on_container_copy_construction(other.alloc_)),
+      head_(0), tail_(0), spare_(0), size_(0) {
+    try {
+        for (const_iterator it = other.begin(); it != other.end(); ++it) {
+            push_back(*it);
+        }
+    } catch (...) {
+        clear();
+        shrink_to_fit();
+        throw;
+    }
+}
+
+/*
+ * @brief        Move constructor, steals the nodes
+ */
+template < typename T, std::size_t B, typename A >
+UnrolledList<T, B, A>::UnrolledList(UnrolledList&& other) noexcept
+    : alloc_(other.alloc_), head_(0), tail_(0), spare_(0), size_(0) {
+    take(other);
+}
+
+/*
+ * @brief        Copy assignment, reusing the nodes already held
+ */
+template < typename T, std::size_t B, typename A >
+UnrolledList<T, B, A>& UnrolledList<T, B, A>::operator=(
+        const UnrolledList& other) {
+    if (this != &other) {
+        clear();
+        for (const_iterator it = other.begin(); it != other.end(); ++it) {
+            push_back(*it);
+        }
+    }
+    return *this;
+}
+
+/*
+ * @brief        Move assignment, exchanges the nodes
+ */
+template < typename T, std::size_t B, typename A >
+UnrolledList<T, B, A>& UnrolledList<T, B, A>::operator=(
+        UnrolledList&& other) noexcept {
+    if (this != &other) {
+        clear();
+        swap(other);
+    }
+    return *this;
+}
+
+/*
+ * @brief        Destructor, returns every node to the allocator
+ */
+template < typename T, std::size_t B, typename A >
+UnrolledList<T, B, A>::~UnrolledList() {
+    clear();
+    shrink_to_fit();
+}
+
+/*
+ * @brief        Get raw memory for a node from the allocator
+ * @param        None
+ * @return       A node whose links are not set
+ */
+template < typename T, std::size_t B, typename A >
+typename UnrolledList<T, B, A>::Node* UnrolledList<T, B, A>::allocate_node() {
+    return ::new (static_cast<void*>(node_traits::allocate(alloc_, 1))) Node;
+}
+
+/*
+ * @brief        Take a node from the free list, or allocate one
+ * @param        None
+ * @return       An unlinked empty node
+ */
+template < typename T, std::size_t B, typename A >
+typename UnrolledList<T, B, A>::Node* UnrolledList<T, B, A>::new_node() {
+    Node* node = spare_;
+    if (node) {
+        spare_ = static_cast<Node*>(node->next);
+    } else {
+        node = allocate_node();
+    }
+    node->prev = 0;
+    node->next = 0;
+    node->begin = 0;
+    node->end = 0;
+    return node;
+}
+
+/*
+ * @brief        Return a chain of nodes to the allocator
+ * @param        The first node, linked through next
+ * @return       Nothing
+ */
+template < typename T, std::size_t B, typename A >
+void UnrolledList<T, B, A>::free_nodes(Node* list) {
+    while (list) {
+        Node* next = static_cast<Node*>(list->next);
+        node_traits::deallocate(alloc_, list, 1);
+        list = next;
+    }
+}
+
+/*
+ * @brief        Move the empty head node to the free list
+ */
+template < typename T, std::size_t B, typename A >
+void UnrolledList<T, B, A>::unlink_head() {
+    Node* node = head_;
+    head_ = static_cast<Node*>(node->next);
+    if (head_) {
+        head_->prev = 0;
+    } else {
+        tail_ = 0;
+    }
+    node->next = spare_;
+    spare_ = node;
+}
+
+/*
+ * @brief        Move the empty tail node to the free list
+ */
+template < typename T, std::size_t B, typename A >
+void UnrolledList<T, B, A>::unlink_tail() {
+    Node* node = tail_;
+    tail_ = static_cast<Node*>(node->prev);
+    if (tail_) {
+        tail_->next = 0;
+    } else {
+        head_ = 0;
+    }
+    node->next = spare_;
+    spare_ = node;
+}
+
+/*
+ * @brief        Move the nodes of other into this empty list
+ * @param        The list to move from, left empty
+ * @return       Nothing
+ */
+template < typename T, std::size_t B, typename A >
+void UnrolledList<T, B, A>::take(UnrolledList& other) {
+    head_ = other.head_;
+    tail_ = other.tail_;
+    spare_ = other.spare_;
+    size_ = other.size_;
+    other.head_ = 0;
+    other.tail_ = 0;
+    other.spare_ = 0;
+    other.size_ = 0;
+}
+
+/*
+ * @brief        Iterator to the front item
+ */
+template < typename T, std::size_t B, typename A >
+typename UnrolledList<T, B, A>::const_iterator
+UnrolledList<T, B, A>::begin() const {
+    return head_ ? const_iterator(head_, head_->begin) : end();
+}
+
+/*
+ * @brief        Iterator past the back item
+ */
+template < typename T, std::size_t B, typename A >
+typename UnrolledList<T, B, A>::const_iterator
+UnrolledList<T, B, A>::end() const {
+    return tail_ ? const_iterator(tail_, tail_->end) : const_iterator();
+}
+
+/*
+ * @brief        Construct a new item at the back, starting a node if the
+ *               last one is full
+ * @param        Arguments forwarded to the constructor of T
+ * @return       Nothing
+ */
+template < typename T, std::size_t B, typename A >
+template < typename... Args >
+void UnrolledList<T, B, A>::emplace_back(Args&&... args) {
+    if (!tail_ || tail_->end == kPerNode) {
+        Node* node = new_node();
+        try {
+            ::new (static_cast<void*>(node->items()))
+                T(std::forward<Args>(args)...);
+        } catch (...) {
+            node->next = spare_;
+            spare_ = node;
+            throw;
+        }
+        node->end = 1;
+        node->prev = tail_;
+        if (tail_) {
+            tail_->next = node;
+        } else {
+            head_ = node;
+        }
+        tail_ = node;
+    } else {
+        ::new (static_cast<void*>(tail_->items() + tail_->end))
+            T(std::forward<Args>(args)...);
+        ++tail_->end;
+    }
+    ++size_;
+}
+
+/*
+ * @brief        Delete the front item, which must exist
+ * @param        None
+ * @return       Nothing
+ */
+template < typename T, std::size_t B, typename A >
+void UnrolledList<T, B, A>::pop_front() {
+    head_->items()[head_->begin].~T();
+    if (++head_->begin == head_->end) {
+        unlink_head();
+    }
+    --size_;
+}
+
+/*
+ * @brief        Delete the back item, which must exist
+ * @param        None
+ * @return       Nothing
+ */
+template < typename T, std::size_t B, typename A >
+void UnrolledList<T, B, A>::pop_back() {
+    tail_->items()[--tail_->end].~T();
+    if (tail_->begin == tail_->end) {
+        unlink_tail();
+    }
+    --size_;
+}
+
+/*
+ * @brief        Delete all items, keeping the nodes on the free list
+ * @param        None
+ * @return       Nothing
+ */
+template < typename T, std::size_t B, typename A >
+void UnrolledList<T, B, A>::clear() {
+    while (size_) {
+        pop_back();
+    }
+}
+
+/*
+ * @brief        Fill the free list until n more items fit without
+ *               allocating
+ * @param        The no. of items
+ * @return       Nothing
+ */
+template < typename T, std::size_t B, typename A >
+void UnrolledList<T, B, A>::reserve(size_type n) {
+    size_type room = tail_ ? kPerNode - tail_->end : 0;
+    for (Node* node = spare_; node && room < n;
+         node = static_cast<Node*>(node->next)) {
+        room += kPerNode;
+    }
+    for (; room < n; room += kPerNode) {
+        Node* node = allocate_node();
+        node->next = spare_;
+        spare_ = node;
+    }
+}
+
+/*
+ * @brief        Return the nodes on the free list to the allocator
+ * @param        None
+ * @return       Nothing
+ */
+template < typename T, std::size_t B, typename A >
+void UnrolledList<T, B, A>::shrink_to_fit() {
+    free_nodes(spare_);
+    spare_ = 0;
+}
+
+/*
+ * @brief        Exchange the contents of two lists, with their allocators
+ * @param        The other list
+ * @return       Nothing
+ */
+template < typename T, std::size_t B, typename A >
+void UnrolledList<T, B, A>::swap(UnrolledList& other) noexcept {
+    using std::swap;
+    swap(alloc_, other.alloc_);
+    swap(head_, other.head_);
+    swap(tail_, other.tail_);
+    swap(spare_, other.spare_);
+    swap(size_, other.size_);
+}
+
+/*
+ * @brief        Exchange the contents of two lists, found through ADL
+ */
+template < typename T, std::size_t B, typename A >
+void swap(UnrolledList<T, B, A>& lhs, UnrolledList<T, B, A>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+/*
+ * @brief        Performs the equality test on operands
+ * @param        Two list objects to be compared
+ * @return       true if equal
+ */
+template < typename T, std::size_t B, typename A >
+bool operator==(const UnrolledList<T, B, A>& lhs,
+                const UnrolledList<T, B, A>& rhs) {
+    return lhs.size() == rhs.size() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+/*
+ * @brief        Performs the lexicographical less than test on operands
+ * @param        Two list objects to be compared
+ * @return       true if left is less than right operand
+ */
+template < typename T, std::size_t B, typename A >
+bool operator<(const UnrolledList<T, B, A>& lhs,
+               const UnrolledList<T, B, A>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                        rhs.end());
+}
+
+/*
+ * @brief        UnrolledList with its allocator replaced
+ */
+template < typename T, std::size_t B, typename A, typename Allocator >
+struct RebindContainer< UnrolledList<T, B, A>, Allocator > {
+    typedef UnrolledList<T, B, Allocator> type;
+};
+
+/*
+ * @brief        Bulk operations on UnrolledList, see ContainerBulk
+ */
+template < typename T, std::size_t B, typename A >
+struct ContainerBulk< UnrolledList<T, B, A> > {
+    template < typename InputIterator >
+    static void append(UnrolledList<T, B, A>& c, InputIterator first,
+                       InputIterator last) {
+        for (; first != last; ++first) {
+            c.push_back(*first);
+        }
+    }
+
+    template < typename OutputIterator >
+    static OutputIterator take_front(UnrolledList<T, B, A>& c, std::size_t n,
+                                     OutputIterator out) {
+        for (; n; --n) {
+            *out++ = std::move(c.front());
+            c.pop_front();
+        }
+        return out;
+    }
+
+    template < typename OutputIterator >
+    static OutputIterator take_back(UnrolledList<T, B, A>& c, std::size_t n,
+                                    OutputIterator out) {
+        for (; n; --n) {
+            *out++ = std::move(c.back());
+            c.pop_back();
+        }
+        return out;
+    }
+
+    template < typename OutputIterator >
+    static OutputIterator copy(const UnrolledList<T, B, A>& c,
+                               OutputIterator out) {
+        return std::copy(c.begin(), c.end(), out);
+    }
+};
+
+/*
+ * @brief        UnrolledList as one run per node, see ContainerSegments
+ */
+template < typename T, std::size_t B, typename A >
+struct ContainerSegments< UnrolledList<T, B, A> > {
+    static const bool contiguous = true;
+    typedef typename UnrolledList<T, B, A>::run_cursor cursor;
+
+    static cursor runs(const UnrolledList<T, B, A>& c) {
+        return cursor(c);
+    }
+};
+
+#endif
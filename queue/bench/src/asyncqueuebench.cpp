@@ -0,0 +1,112 @@
+/** 
+ *  @brief      Handoff between coroutines through AsyncQueue on an event
+ *              loop, against threads through BlockingQueue
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <optional>
+#include <thread>
+
+#include "asyncqueue.h"
+#include "blockingqueue.h"
+#include "executor.h"
+
+static const int kItems = 4096;
+
+static Task produce(AsyncQueue<int>& q, int items) {
+    for (int i = 0; i < items; ++i) {
+        co_await q.push(i);
+    }
+    q.close();
+}
+
+static Task consume(AsyncQueue<int>& q, long& sum) {
+    while (std::optional<int> item = co_await q.pop()) {
+        sum += *item;
+    }
+}
+
+/// Stream kItems from a producer coroutine to a consumer one, with
+/// state.range(0) items of buffer (0 for unbounded); capacity 1 makes
+/// them hand over every item in lockstep
+static void BM_AsyncStream(benchmark::State& state) {
+    EventLoop loop;
+    long sum = 0;
+    for (auto _ : state) {
+        AsyncQueue<int> q(loop, state.range(0) ? state.range(0)
+                                                : AsyncQueue<int>::size_type(-1));
+        Task consumer = consume(q, sum);
+        Task producer = produce(q, kItems);
+        consumer.start(loop);
+        producer.start(loop);
+        loop.run();
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * kItems);
+}
+
+BENCHMARK(BM_AsyncStream)->Arg(1)->Arg(64)->Arg(0);
+
+static Task ping(AsyncQueue<int>& out, AsyncQueue<int>& in, int rounds) {
+    for (int i = 0; i < rounds; ++i) {
+        co_await out.push(i);
+        co_await in.pop();
+    }
+    out.close();
+}
+
+static Task pong(AsyncQueue<int>& in, AsyncQueue<int>& out) {
+    while (std::optional<int> item = co_await in.pop()) {
+        co_await out.push(*item);
+    }
+}
+
+/// Round trips between two coroutines over a pair of queues: each
+/// trip is two handoffs, each a schedule and a resume on the loop
+static void BM_AsyncPingPong(benchmark::State& state) {
+    EventLoop loop;
+    for (auto _ : state) {
+        AsyncQueue<int> there(loop, 1);
+        AsyncQueue<int> back(loop, 1);
+        Task a = ping(there, back, kItems);
+        Task b = pong(there, back);
+        a.start(loop);
+        b.start(loop);
+        loop.run();
+    }
+    state.SetItemsProcessed(state.iterations() * kItems);
+}
+
+BENCHMARK(BM_AsyncPingPong);
+
+/// The same round trips between two threads, each handoff waking a
+/// thread sleeping on a condition variable
+static void BM_BlockingPingPong(benchmark::State& state) {
+    BlockingQueue<int> there;
+    BlockingQueue<int> back;
+    std::thread echo([&] {
+        int item;
+        while (there.wait_pop(item)) {
+            back.push(item);
+        }
+    });
+    for (auto _ : state) {
+        int item;
+        for (int i = 0; i < kItems; ++i) {
+            there.push(i);
+            back.wait_pop(item);
+        }
+    }
+    there.close();
+    echo.join();
+    state.SetItemsProcessed(state.iterations() * kItems);
+}
+
+BENCHMARK(BM_BlockingPingPong)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,74 @@
+/** 
+ *  @brief      Circular queue benchmarks for last-N event buffers
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <deque>
+#include <vector>
+
+#include "circularqueue.h"
+#include "queue.h"
+
+static const std::size_t kEvents = 1024;
+
+/// Plain 64-byte telemetry record
+struct Event {
+    long fields[8];
+};
+
+/// Keep the last kEvents events with size, pop and push on a deque
+static void BM_RecordDeque(benchmark::State& state) {
+    Queue<Event> events;
+    Event event = Event();
+    for (auto _ : state) {
+        if (events.size() == kEvents) {
+            events.pop();
+        }
+        event.fields[0]++;
+        events.push(event);
+        benchmark::ClobberMemory();
+    }
+}
+
+/// Keep the last kEvents events by overwriting the oldest
+static void BM_RecordCircular(benchmark::State& state) {
+    static CircularQueue<Event, kEvents> events;
+    Event event = Event();
+    for (auto _ : state) {
+        event.fields[0]++;
+        events.push(event);
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_RecordDeque);
+BENCHMARK(BM_RecordCircular);
+
+/// Copy a full, wrapped buffer out, oldest event first
+template < typename QueueType >
+static void BM_Snapshot(benchmark::State& state) {
+    static QueueType events;
+    for (std::size_t i = 0; i < kEvents + kEvents / 2; ++i) {
+        if (events.size() == kEvents) {
+            events.pop();
+        }
+        events.push(Event());
+    }
+    std::vector<Event> snapshot(kEvents);
+    for (auto _ : state) {
+        events.copy_to(snapshot.begin());
+        benchmark::DoNotOptimize(snapshot.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kEvents);
+}
+
+BENCHMARK_TEMPLATE(BM_Snapshot, Queue<Event>);
+BENCHMARK_TEMPLATE(BM_Snapshot, CircularQueue<Event, kEvents>);
+
+BENCHMARK_MAIN();
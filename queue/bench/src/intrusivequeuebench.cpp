@@ -0,0 +1,154 @@
+/** 
+ *  @brief      Intrusive queue benchmarks against the copying Queue
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "intrusivequeue.h"
+#include "queue.h"
+
+/// Pooled message, the size of a small network frame
+struct Message {
+    char payload[120];
+    IntrusiveHook<Message> hook;
+
+    Message() { payload[0] = 1; }
+};
+
+/// Every iteration queues range(0) pooled messages and dequeues them;
+/// Queue copies each one into its container, IntrusiveQueue links it
+template < typename Container >
+static void BM_copying(benchmark::State& state) {
+    std::vector<Message> pool(state.range(0));
+    Queue< Message, Container > q;
+    for (auto _ : state) {
+        for (Message& message : pool) {
+            q.push(message);
+        }
+        while (!q.empty()) {
+            benchmark::DoNotOptimize(q.front().payload[0]);
+            q.pop();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_intrusive(benchmark::State& state) {
+    std::vector<Message> pool(state.range(0));
+    IntrusiveQueue< Message > q;
+    for (auto _ : state) {
+        for (Message& message : pool) {
+            q.push(message);
+        }
+        while (Message* message = q.try_pop()) {
+            benchmark::DoNotOptimize(message->payload[0]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Queue< Message > behind a mutex, copying messages in and out
+class LockedQueue {
+ private:
+    std::mutex lock_;
+    Queue< Message > items_;
+
+ public:
+    void push(const Message& message) {
+        std::lock_guard<std::mutex> guard(lock_);
+        items_.push(message);
+    }
+
+    bool try_pop(Message& message) {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (items_.empty()) {
+            return false;
+        }
+        message = items_.front();
+        items_.pop();
+        return true;
+    }
+};
+
+static const int kMessagesPerProducer = 4096;
+
+/// range(0) producer threads hand their pooled messages to the calling
+/// thread, which consumes them all
+static void BM_mpsc_locked(benchmark::State& state) {
+    int producers = state.range(0);
+    std::vector< std::vector<Message> > pools(
+        producers, std::vector<Message>(kMessagesPerProducer));
+    for (auto _ : state) {
+        LockedQueue q;
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&q, &pools, p] {
+                for (Message& message : pools[p]) {
+                    q.push(message);
+                }
+            });
+        }
+        Message message;
+        for (int n = producers * kMessagesPerProducer; n > 0;) {
+            if (q.try_pop(message)) {
+                benchmark::DoNotOptimize(message.payload[0]);
+                --n;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * producers *
+                            kMessagesPerProducer);
+}
+
+static void BM_mpsc_intrusive(benchmark::State& state) {
+    int producers = state.range(0);
+    std::vector< std::vector<Message> > pools(
+        producers, std::vector<Message>(kMessagesPerProducer));
+    for (auto _ : state) {
+        IntrusiveMpscQueue< Message > q;
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&q, &pools, p] {
+                for (Message& message : pools[p]) {
+                    q.push(message);
+                }
+            });
+        }
+        for (int n = producers * kMessagesPerProducer; n > 0;) {
+            if (Message* message = q.try_pop()) {
+                benchmark::DoNotOptimize(message->payload[0]);
+                --n;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * producers *
+                            kMessagesPerProducer);
+}
+
+BENCHMARK_TEMPLATE(BM_copying, std::deque<Message>)->Range(8, 8 << 10);
+BENCHMARK_TEMPLATE(BM_copying, std::list<Message>)->Range(8, 8 << 10);
+BENCHMARK(BM_intrusive)->Range(8, 8 << 10);
+BENCHMARK(BM_mpsc_locked)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+BENCHMARK(BM_mpsc_intrusive)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,110 @@
+/** 
+ *  @brief      Memory-mapped queue benchmarks for message spooling
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "mappedqueue.h"
+#include "queue.h"
+
+static const std::size_t kCapacity = 1 << 18;  /// 16MB of records
+
+/// Outbound message record, as spooled
+struct Message {
+    long id;
+    char body[56];
+};
+
+static std::string spool_path() {
+    const char* dir = std::getenv("TMPDIR");
+    return std::string(dir ? dir : "/tmp") + "/mappedqueuebench.spool";
+}
+
+/// Append to a spool, flushing every range(0) records; a consumer
+/// drains it whenever it fills up
+static void BM_AppendMapped(benchmark::State& state) {
+    std::string path = spool_path();
+    std::remove(path.c_str());
+    std::size_t batch = state.range(0);
+    {
+        MappedQueue<Message> spool(path, kCapacity);
+        Message message = Message();
+        std::size_t unflushed = 0;
+        for (auto _ : state) {
+            message.id++;
+            if (!spool.push(message)) {
+                state.PauseTiming();
+                while (!spool.empty()) {
+                    spool.pop();
+                }
+                spool.flush();
+                unflushed = 0;
+                state.ResumeTiming();
+                spool.push(message);
+            }
+            if (++unflushed == batch) {
+                spool.flush();
+                unflushed = 0;
+            }
+        }
+    }
+    std::remove(path.c_str());
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * sizeof(Message));
+}
+
+BENCHMARK(BM_AppendMapped)->Arg(64)->Arg(1024)->Arg(16384)->UseRealTime();
+
+/// The same appends to an in-memory queue, which a restart loses
+static void BM_AppendQueue(benchmark::State& state) {
+    Queue<Message> queue;
+    Message message = Message();
+    for (auto _ : state) {
+        message.id++;
+        if (queue.size() == kCapacity) {
+            state.PauseTiming();
+            while (!queue.empty()) {
+                queue.pop();
+            }
+            state.ResumeTiming();
+        }
+        queue.push(message);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * sizeof(Message));
+}
+
+BENCHMARK(BM_AppendQueue);
+
+/// Reopen a full spool and read its front record; takes the same time
+/// whatever the size of the spool
+static void BM_Reopen(benchmark::State& state) {
+    std::string path = spool_path();
+    std::remove(path.c_str());
+    std::size_t capacity = state.range(0);
+    {
+        MappedQueue<Message> spool(path, capacity);
+        Message message = Message();
+        while (spool.push(message)) {
+            message.id++;
+        }
+    }
+    for (auto _ : state) {
+        MappedQueue<Message> spool(path, capacity);
+        benchmark::DoNotOptimize(spool.front().id);
+    }
+    std::remove(path.c_str());
+    state.counters["records"] = capacity;
+}
+
+BENCHMARK(BM_Reopen)->Arg(1 << 10)->Arg(1 << 14)->Arg(kCapacity);
+
+BENCHMARK_MAIN();
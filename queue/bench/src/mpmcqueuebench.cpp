@@ -0,0 +1,95 @@
+/** 
+ *  @brief      MPMC queue scaling benchmarks against a mutex guarded Queue
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "queue.h"
+#include "mpmcqueue.h"
+
+/// Queue< int > behind a mutex, the way services share it today
+class LockedQueue {
+ private:
+    std::mutex lock_;
+    Queue< int, std::deque<int> > items_;
+
+ public:
+    void push(int val) {
+        std::lock_guard<std::mutex> guard(lock_);
+        items_.push(val);
+    }
+
+    void pop(int& val) {
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> guard(lock_);
+                if (!items_.empty()) {
+                    val = items_.front();
+                    items_.pop();
+                    return;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+};
+
+static MpmcQueue< int > mpmc_queue(1024);
+static LockedQueue locked_queue;
+
+/// Every thread pushes then pops, so producers and consumers contend;
+/// p99_ns is the mean over threads of each thread's p99 push+pop latency
+template < typename Q >
+static void contended_push_pop(benchmark::State& state, Q& q) {
+    typedef std::chrono::steady_clock clock;
+    std::vector<double> samples;
+    samples.reserve(1 << 16);
+    int val = state.thread_index();
+
+    for (auto _ : state) {
+        clock::time_point start = clock::now();
+        q.push(val);
+        q.pop(val);
+        clock::time_point stop = clock::now();
+        if (samples.size() < samples.capacity()) {
+            samples.push_back(
+                std::chrono::duration<double, std::nano>(stop - start).count());
+        }
+    }
+
+    double p99 = 0;
+    if (!samples.empty()) {
+        size_t rank = samples.size() * 99 / 100;
+        std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+        p99 = samples[rank];
+    }
+    state.counters["ops"] = benchmark::Counter(
+        2.0 * state.iterations(), benchmark::Counter::kIsRate);
+    state.counters["p99_ns"] = benchmark::Counter(
+        p99, benchmark::Counter::kAvgThreads);
+}
+
+static void BM_MpmcQueue(benchmark::State& state) {
+    contended_push_pop(state, mpmc_queue);
+}
+
+static void BM_LockedQueue(benchmark::State& state) {
+    contended_push_pop(state, locked_queue);
+}
+
+BENCHMARK(BM_MpmcQueue)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_LockedQueue)->ThreadRange(1, 64)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,104 @@
+/** 
+ *  @brief      Pipeline throughput as stages, threads and batch sizes vary
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <thread>
+
+#include "pipeline.h"
+
+static const int kItems = 1 << 16;
+
+/// Some arithmetic per item, standing in for parsing or enriching
+static std::uint64_t work(std::uint64_t x, int rounds) {
+    for (int i = 0; i < rounds; ++i) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+    }
+    return x;
+}
+
+/// Build a pipeline of n identical stages of the given threads each
+static Pipeline<std::uint64_t> build(const PipelineOptions& options, int stages,
+                                     unsigned threads, int rounds) {
+    Pipeline<std::uint64_t> pipeline(options);
+    for (int i = 0; i < stages; ++i) {
+        pipeline = std::move(pipeline).stage("work", threads,
+            [rounds](std::uint64_t x) { return work(x, rounds); });
+    }
+    return pipeline;
+}
+
+/// Push kItems from a producer thread and pop them all
+static void run(Pipeline<std::uint64_t>& pipeline) {
+    std::thread producer([&] {
+        for (int i = 0; i < kItems; ++i) {
+            pipeline.push(i);
+        }
+        pipeline.close();
+    });
+    std::uint64_t sum = 0;
+    while (std::optional<std::uint64_t> x = pipeline.pop()) {
+        sum += *x;
+    }
+    producer.join();
+    benchmark::DoNotOptimize(sum);
+}
+
+/// Stages range(0), each with range(1) threads and some 50ns of work
+/// per item: throughput should grow with the threads per stage until
+/// the cores run out, and hold as stages are added while there are
+/// cores for them; the cores counter tells how many there were
+static void BM_PipelineScaling(benchmark::State& state) {
+    for (auto _ : state) {
+        Pipeline<std::uint64_t> pipeline =
+            build(PipelineOptions(), state.range(0), state.range(1), 32);
+        run(pipeline);
+    }
+    state.SetItemsProcessed(state.iterations() * kItems);
+    state.counters["cores"] = std::thread::hardware_concurrency();
+}
+
+BENCHMARK(BM_PipelineScaling)
+    ->ArgsProduct({{1, 2, 4}, {1, 2, 4}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+/// Two light stages with batches of range(0) bytes: one item a batch
+/// pays a lock and a wake-up per item and stage
+static void BM_PipelineBatchBytes(benchmark::State& state) {
+    PipelineOptions options;
+    options.batch_bytes = state.range(0);
+    for (auto _ : state) {
+        Pipeline<std::uint64_t> pipeline = build(options, 2, 1, 1);
+        run(pipeline);
+    }
+    state.SetItemsProcessed(state.iterations() * kItems);
+}
+
+BENCHMARK(BM_PipelineBatchBytes)
+    ->Arg(8)->Arg(512)->Arg(16 * 1024)->Arg(256 * 1024)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+/// The scaling run again with the ordered option, which reorders the
+/// batches of the multi-threaded stages before pop
+static void BM_PipelineOrdered(benchmark::State& state) {
+    PipelineOptions options;
+    options.ordered = true;
+    for (auto _ : state) {
+        Pipeline<std::uint64_t> pipeline = build(options, 2, state.range(0), 32);
+        run(pipeline);
+    }
+    state.SetItemsProcessed(state.iterations() * kItems);
+}
+
+BENCHMARK(BM_PipelineOrdered)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,149 @@
+/** 
+ *  @brief      Priority queue benchmarks against std::priority_queue
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <functional>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "priorityqueue.h"
+
+static const int kItems = 1 << 20;
+
+/// The same random keys for every benchmark
+static const std::vector<int>& keys() {
+    static std::vector<int> k;
+    if (k.empty()) {
+        std::mt19937 rng(1);
+        for (int i = 0; i < kItems; ++i) {
+            k.push_back(rng() >> 1);
+        }
+    }
+    return k;
+}
+
+/// Adapts std::priority_queue to pop_value
+template < typename T >
+struct StdPriorityQueue : std::priority_queue<T> {
+    StdPriorityQueue() {}
+
+    template < typename InputIterator >
+    StdPriorityQueue(InputIterator first, InputIterator last)
+        : std::priority_queue<T>(first, last) {}
+
+    T pop_value() {
+        T val = this->top();
+        this->pop();
+        return val;
+    }
+};
+
+/// Push 1M random keys one by one, then pop them all
+template < typename PQ >
+static void BM_PushThenPopAll(benchmark::State& state) {
+    const std::vector<int>& k = keys();
+    for (auto _ : state) {
+        PQ pq;
+        for (int i = 0; i < kItems; ++i) {
+            pq.push(k[i]);
+        }
+        while (!pq.empty()) {
+            benchmark::DoNotOptimize(pq.pop_value());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kItems);
+}
+
+/// Build a heap of 1M random keys from a range
+template < typename PQ >
+static void BM_Heapify(benchmark::State& state) {
+    const std::vector<int>& k = keys();
+    for (auto _ : state) {
+        PQ pq(k.begin(), k.end());
+        benchmark::DoNotOptimize(pq.top());
+    }
+    state.SetItemsProcessed(state.iterations() * kItems);
+}
+
+/// Hold model: pop the top of a 1M heap and push a later key, as a
+/// discrete event simulator does
+template < typename PQ >
+static void BM_Hold(benchmark::State& state) {
+    const std::vector<int>& k = keys();
+    PQ pq(k.begin(), k.end());
+    int i = 0;
+    for (auto _ : state) {
+        int top = pq.pop_value();
+        pq.push(top - (k[i++ & (kItems - 1)] & 0xff));
+    }
+}
+
+#define PRIORITY_QUEUE_BENCHMARKS(PQ)                                         \
+    BENCHMARK_TEMPLATE(BM_PushThenPopAll, PQ)->Unit(benchmark::kMillisecond); \
+    BENCHMARK_TEMPLATE(BM_Heapify, PQ)->Unit(benchmark::kMillisecond);        \
+    BENCHMARK_TEMPLATE(BM_Hold, PQ)
+
+typedef PriorityQueue<int, std::less<int>, std::vector<int>, 8> OctonaryHeap;
+
+PRIORITY_QUEUE_BENCHMARKS(StdPriorityQueue<int>);
+PRIORITY_QUEUE_BENCHMARKS(BinaryHeap<int>);
+PRIORITY_QUEUE_BENCHMARKS(PriorityQueue<int>);
+PRIORITY_QUEUE_BENCHMARKS(OctonaryHeap);
+
+/// Give 1M queued items a higher priority each, then pop them all:
+/// std::priority_queue pushes a second entry and skips stale ones
+static void BM_ReprioritizeLazyStd(benchmark::State& state) {
+    const std::vector<int>& k = keys();
+    typedef std::pair<int, int> Entry;  /// key, item
+    for (auto _ : state) {
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > pq;
+        std::vector<int> current(k);
+        for (int i = 0; i < kItems; ++i) {
+            pq.push(Entry(k[i], i));
+        }
+        for (int i = 0; i < kItems; ++i) {
+            current[i] -= k[(i * 7) & (kItems - 1)] & 0xffff;
+            pq.push(Entry(current[i], i));
+        }
+        while (!pq.empty()) {
+            Entry e = pq.top();
+            pq.pop();
+            benchmark::DoNotOptimize(e.first == current[e.second]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kItems);
+}
+
+/// The same with decrease_key on handles
+static void BM_ReprioritizeDecreaseKey(benchmark::State& state) {
+    const std::vector<int>& k = keys();
+    std::vector<IndexedPriorityQueue<int>::handle_type> handles(kItems);
+    for (auto _ : state) {
+        IndexedPriorityQueue<int, std::greater<int> > pq;
+        std::vector<int> current(k);
+        for (int i = 0; i < kItems; ++i) {
+            handles[i] = pq.push(k[i]);
+        }
+        for (int i = 0; i < kItems; ++i) {
+            current[i] -= k[(i * 7) & (kItems - 1)] & 0xffff;
+            pq.decrease_key(handles[i], current[i]);
+        }
+        while (!pq.empty()) {
+            benchmark::DoNotOptimize(pq.pop_value());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kItems);
+}
+
+BENCHMARK(BM_ReprioritizeLazyStd)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ReprioritizeDecreaseKey)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,76 @@
+/** 
+ *  @brief      Queue allocation churn benchmarks, default vs pool vs arena
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <deque>
+#include <list>
+
+#include "allocators.h"
+#include "queue.h"
+
+/// Short-lived queues, as built per request by a service: every thread
+/// fills a fresh queue with range(0) items and drains it, so the time
+/// goes to allocating and freeing nodes or chunks
+template < typename Q >
+static void churn(Q& q, int items) {
+    for (int i = 0; i < items; ++i) {
+        q.push(i);
+    }
+    while (!q.empty()) {
+        benchmark::DoNotOptimize(q.front());
+        q.pop();
+    }
+}
+
+template < typename Container >
+static void BM_churn_default(benchmark::State& state) {
+    for (auto _ : state) {
+        Queue< int, Container > q;
+        churn(q, state.range(0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template < typename Container >
+static void BM_churn_pool(benchmark::State& state) {
+    for (auto _ : state) {
+        Queue< int, Container, PoolAllocator<int> > q;
+        churn(q, state.range(0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template < typename Container >
+static void BM_churn_arena(benchmark::State& state) {
+    Arena arena;
+    for (auto _ : state) {
+        {
+            Queue< int, Container, ArenaAllocator<int> >
+                q((ArenaAllocator<int>(arena)));
+            churn(q, state.range(0));
+        }
+        arena.release();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_churn_default, std::list<int>)
+    ->Arg(64)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_churn_pool, std::list<int>)
+    ->Arg(64)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_churn_arena, std::list<int>)
+    ->Arg(64)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_churn_default, std::deque<int>)
+    ->Arg(1024)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_churn_pool, std::deque<int>)
+    ->Arg(1024)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_churn_arena, std::deque<int>)
+    ->Arg(1024)->ThreadRange(1, 4)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,150 @@
+/** 
+ *  @brief      Queue benchmarks across item types and container backends
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <deque>
+#include <list>
+#include <string>
+
+#include "queue.h"
+#include "smallring.h"
+#include "unrolledlist.h"
+
+static const int kDepth = 1024;
+
+/// Plain 64-byte record, like a message header
+struct Pod64 {
+    long fields[8];
+
+    bool operator==(const Pod64& other) const {
+        return std::memcmp(fields, other.fields, sizeof(fields)) == 0;
+    }
+    bool operator<(const Pod64& other) const {
+        return fields[0] < other.fields[0];
+    }
+};
+
+template < typename T >
+static T make_item(int i);
+
+template <>
+int make_item<int>(int i) {
+    return i;
+}
+
+template <>
+Pod64 make_item<Pod64>(int i) {
+    Pod64 item = {{i, i, i, i, i, i, i, i}};
+    return item;
+}
+
+template <>
+std::string make_item<std::string>(int i) {
+    return std::string(32, 'a' + i % 26);  /// too long for inline storage
+}
+
+/// Fill a fresh queue with kDepth items and tear it down
+template < typename T, typename Container >
+static void BM_Push(benchmark::State& state) {
+    T item = make_item<T>(7);
+    for (auto _ : state) {
+        Queue< T, Container > queue;
+        for (int i = 0; i < kDepth; ++i) {
+            queue.push(item);
+        }
+        benchmark::DoNotOptimize(queue.back());
+    }
+    state.SetItemsProcessed(state.iterations() * kDepth);
+}
+
+/// Push and pop kDepth items on a warm queue, like a BFS would
+template < typename T, typename Container >
+static void BM_PushPop(benchmark::State& state) {
+    T item = make_item<T>(7);
+    Queue< T, Container > queue;
+    for (auto _ : state) {
+        for (int i = 0; i < kDepth; ++i) {
+            queue.push(item);
+        }
+        for (int i = 0; i < kDepth; ++i) {
+            queue.pop();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kDepth * 2);
+}
+
+/// Repeated front() reads, like a consumer peeking before it commits
+template < typename T, typename Container >
+static void BM_Front(benchmark::State& state) {
+    Queue< T, Container > queue;
+    for (int i = 0; i < kDepth; ++i) {
+        queue.push(make_item<T>(i));
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(queue.front());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// Repeated size() reads, like a producer checking for backlog
+template < typename T, typename Container >
+static void BM_Size(benchmark::State& state) {
+    Queue< T, Container > queue;
+    for (int i = 0; i < kDepth; ++i) {
+        queue.push(make_item<T>(i));
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(queue.size());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// == and < on two equal queues of kDepth items, the worst case
+template < typename T, typename Container >
+static void BM_Compare(benchmark::State& state) {
+    Queue< T, Container > lhs, rhs;
+    for (int i = 0; i < kDepth; ++i) {
+        lhs.push(make_item<T>(i));
+        rhs.push(make_item<T>(i));
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lhs == rhs);
+        benchmark::DoNotOptimize(lhs < rhs);
+    }
+    state.SetItemsProcessed(state.iterations() * kDepth * 2);
+}
+
+/// SmallRing stands in for the inline storage of SmallQueue; vector
+/// cannot back a queue, it has no pop_front
+typedef SmallRing<int, 16> SmallRingInt;
+typedef SmallRing<Pod64, 16> SmallRingPod64;
+typedef SmallRing<std::string, 16> SmallRingString;
+
+#define QUEUE_BENCHMARKS(T, Container)              \
+    BENCHMARK_TEMPLATE(BM_Push, T, Container);      \
+    BENCHMARK_TEMPLATE(BM_PushPop, T, Container);   \
+    BENCHMARK_TEMPLATE(BM_Front, T, Container);     \
+    BENCHMARK_TEMPLATE(BM_Size, T, Container);      \
+    BENCHMARK_TEMPLATE(BM_Compare, T, Container)
+
+QUEUE_BENCHMARKS(int, std::deque<int>);
+QUEUE_BENCHMARKS(int, std::list<int>);
+QUEUE_BENCHMARKS(int, UnrolledList<int>);
+QUEUE_BENCHMARKS(int, SmallRingInt);
+QUEUE_BENCHMARKS(Pod64, std::deque<Pod64>);
+QUEUE_BENCHMARKS(Pod64, std::list<Pod64>);
+QUEUE_BENCHMARKS(Pod64, UnrolledList<Pod64>);
+QUEUE_BENCHMARKS(Pod64, SmallRingPod64);
+QUEUE_BENCHMARKS(std::string, std::deque<std::string>);
+QUEUE_BENCHMARKS(std::string, std::list<std::string>);
+QUEUE_BENCHMARKS(std::string, UnrolledList<std::string>);
+QUEUE_BENCHMARKS(std::string, SmallRingString);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,75 @@
+/** 
+ *  @brief      Queue batch push/pop benchmarks against single item calls
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <deque>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "queue.h"
+
+/// Groups of range(0) items go through the queue; per_item is the cost
+/// of pushing and popping one item
+static void per_item(benchmark::State& state) {
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["per_item"] = benchmark::Counter(
+        state.iterations() * state.range(0),
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+template < typename T >
+static std::vector<T> batch(int n);
+
+template <>
+std::vector<int> batch<int>(int n) {
+    return std::vector<int>(n, 42);
+}
+
+template <>
+std::vector<std::string> batch<std::string>(int n) {
+    return std::vector<std::string>(n, std::string(32, 'x'));
+}
+
+template < typename T, typename Container >
+static void BM_single(benchmark::State& state) {
+    std::vector<T> in = batch<T>(state.range(0)), out(state.range(0));
+    Queue< T, Container > q;
+    for (auto _ : state) {
+        for (size_t i = 0; i < in.size(); ++i) {
+            q.push(in[i]);
+        }
+        for (size_t i = 0; i < out.size(); ++i) {
+            out[i] = q.pop_value();
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    per_item(state);
+}
+
+template < typename T, typename Container >
+static void BM_bulk(benchmark::State& state) {
+    std::vector<T> in = batch<T>(state.range(0)), out(state.range(0));
+    Queue< T, Container > q;
+    for (auto _ : state) {
+        q.push_bulk(in.data(), in.size());
+        q.pop_n(out.size(), out.begin());
+        benchmark::DoNotOptimize(out.data());
+    }
+    per_item(state);
+}
+
+BENCHMARK_TEMPLATE(BM_single, int, std::deque<int>)->Arg(16)->Arg(256);
+BENCHMARK_TEMPLATE(BM_bulk, int, std::deque<int>)->Arg(16)->Arg(256);
+BENCHMARK_TEMPLATE(BM_single, int, std::list<int>)->Arg(16)->Arg(256);
+BENCHMARK_TEMPLATE(BM_bulk, int, std::list<int>)->Arg(16)->Arg(256);
+BENCHMARK_TEMPLATE(BM_single, std::string, std::deque<std::string>)->Arg(256);
+BENCHMARK_TEMPLATE(BM_bulk, std::string, std::deque<std::string>)->Arg(256);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,97 @@
+/** 
+ *  @brief      Queue polling benchmarks, throwing vs non-throwing accessors
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <optional>
+#include <stdexcept>
+
+#include "queue.h"
+
+/// Polls an empty queue the way a consumer loop does between bursts,
+/// relying on front() and pop() to throw
+static void BM_empty_poll_throwing(benchmark::State& state) {
+    Queue< int > q;
+    int val = 0;
+    for (auto _ : state) {
+        try {
+            val = q.front();
+            q.pop();
+        } catch (const std::runtime_error&) {
+        }
+        benchmark::DoNotOptimize(val);
+    }
+}
+
+/// Polls an empty queue checking empty() before front() and pop(),
+/// which still check again inside
+static void BM_empty_poll_checked(benchmark::State& state) {
+    Queue< int > q;
+    int val = 0;
+    for (auto _ : state) {
+        if (!q.empty()) {
+            val = q.front();
+            q.pop();
+        }
+        benchmark::DoNotOptimize(val);
+    }
+}
+
+static void BM_empty_poll_try_pop(benchmark::State& state) {
+    Queue< int > q;
+    for (auto _ : state) {
+        std::optional<int> val = q.try_pop();
+        benchmark::DoNotOptimize(val.has_value());
+    }
+}
+
+/// The same loops on a queue that always holds an item
+static void BM_full_poll_throwing(benchmark::State& state) {
+    Queue< int > q;
+    q.push(1);
+    int val = 0;
+    for (auto _ : state) {
+        try {
+            val = q.front();
+            q.pop();
+        } catch (const std::runtime_error&) {
+        }
+        q.push(val);
+        benchmark::DoNotOptimize(val);
+    }
+}
+
+static void BM_full_poll_try_pop(benchmark::State& state) {
+    Queue< int > q;
+    q.push(1);
+    for (auto _ : state) {
+        std::optional<int> val = q.try_pop();
+        q.push(*val);
+        benchmark::DoNotOptimize(*val);
+    }
+}
+
+static void BM_full_poll_unchecked(benchmark::State& state) {
+    Queue< int > q;
+    q.push(1);
+    for (auto _ : state) {
+        int val = q.front_unchecked();
+        q.pop();
+        q.push(val);
+        benchmark::DoNotOptimize(val);
+    }
+}
+
+BENCHMARK(BM_empty_poll_throwing);
+BENCHMARK(BM_empty_poll_checked);
+BENCHMARK(BM_empty_poll_try_pop);
+BENCHMARK(BM_full_poll_throwing);
+BENCHMARK(BM_full_poll_try_pop);
+BENCHMARK(BM_full_poll_unchecked);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,170 @@
+/** 
+ *  @brief      Sharded queue benchmarks with pinned threads against a
+ *              mutex guarded Queue
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "queue.h"
+#include "shardedqueue.h"
+
+/// Queue< int > behind a mutex, the way services share it today
+class LockedQueue {
+ private:
+    std::mutex lock_;
+    Queue< int, std::deque<int> > items_;
+
+ public:
+    void push(int val) {
+        std::lock_guard<std::mutex> guard(lock_);
+        items_.push(val);
+    }
+
+    std::optional<int> try_pop() {
+        std::lock_guard<std::mutex> guard(lock_);
+        return items_.try_pop();
+    }
+};
+
+/// CPUs the process may run on, in order
+static std::vector<int> allowed_cpus() {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    std::vector<int> cpus;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+    if (cpus.empty()) {
+        cpus.push_back(0);
+    }
+    return cpus;
+}
+
+static const std::vector<int> cpus = allowed_cpus();
+static const CpuTopology topology = CpuTopology::detect();
+
+/// Pin the calling benchmark thread, spreading threads over the CPUs
+static void pin_thread(int index) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpus[index % cpus.size()], &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+/// Restore the whole CPU set, so the next run starts unpinned
+static void unpin_thread() {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        CPU_SET(cpu, &set);
+    }
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+static LockedQueue locked_queue;
+static ShardedQueue<int> per_node_queue(kShardPerNode, topology);
+static ShardedQueue<int> per_cpu_queue(kShardPerCpu, topology);
+
+/// Sum of the counters of all shards
+static ShardStats totals(const ShardedQueue<int>& q) {
+    ShardStats sum;
+    for (std::size_t i = 0; i < q.shards(); ++i) {
+        ShardStats stats = q.stats(i);
+        sum.pops += stats.pops;
+        sum.stolen += stats.stolen;
+        sum.stolen_remote += stats.stolen_remote;
+    }
+    return sum;
+}
+
+/// Every pinned thread pushes then pops, retrying until it gets an item
+static void BM_LockedQueue(benchmark::State& state) {
+    pin_thread(state.thread_index());
+    for (auto _ : state) {
+        locked_queue.push(state.thread_index());
+        while (!locked_queue.try_pop()) {
+            std::this_thread::yield();
+        }
+    }
+    unpin_thread();
+    state.counters["ops"] = benchmark::Counter(
+        2.0 * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+/// As above on a sharded queue. With remote set, each thread pushes to
+/// the shard after its own, on another node where there is one, so
+/// every pop is a steal: the cost of items crossing shards and sockets
+/// shows against the local run. steal_ratio and remote_ratio are the
+/// shares of pops taken from another shard and from another node.
+static void sharded_push_pop(benchmark::State& state, ShardedQueue<int>& q,
+                             bool remote) {
+    pin_thread(state.thread_index());
+    std::size_t home = q.shard_of_cpu(cpus[state.thread_index() % cpus.size()]);
+    std::size_t target = home;
+    if (remote) {
+        const std::vector<std::size_t>& order = q.steal_order(home);
+        target = order.empty() ? home : order.back();
+    }
+    ShardStats before;
+    if (state.thread_index() == 0) {
+        before = totals(q);
+    }
+
+    for (auto _ : state) {
+        q.push_to(target, state.thread_index());
+        while (!q.try_pop_from(home)) {
+            std::this_thread::yield();
+        }
+    }
+
+    unpin_thread();
+    state.counters["ops"] = benchmark::Counter(
+        2.0 * state.iterations(), benchmark::Counter::kIsRate);
+    if (state.thread_index() == 0) {
+        ShardStats after = totals(q);
+        double pops = after.pops - before.pops;
+        state.counters["shards"] = q.shards();
+        state.counters["nodes"] = topology.nodes;
+        state.counters["steal_ratio"] =
+            pops ? (after.stolen - before.stolen) / pops : 0;
+        state.counters["remote_ratio"] =
+            pops ? (after.stolen_remote - before.stolen_remote) / pops : 0;
+    }
+}
+
+static void BM_ShardedPerNode(benchmark::State& state) {
+    sharded_push_pop(state, per_node_queue, false);
+}
+
+static void BM_ShardedPerCpu(benchmark::State& state) {
+    sharded_push_pop(state, per_cpu_queue, false);
+}
+
+static void BM_ShardedPerCpuRemote(benchmark::State& state) {
+    sharded_push_pop(state, per_cpu_queue, true);
+}
+
+BENCHMARK(BM_LockedQueue)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_ShardedPerNode)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_ShardedPerCpu)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_ShardedPerCpuRemote)->ThreadRange(1, 64)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,86 @@
+/** 
+ *  @brief      Vectorized comparison benchmarks, kernels and queues
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <deque>
+#include <vector>
+
+#include "queue.h"
+#include "simdcompare.h"
+#include "unrolledlist.h"
+
+static const std::size_t kItems = 1 << 16;
+
+/// Scan two equal arrays to the end, at the level given by the argument
+template < typename T >
+static void BM_FirstUnequal(benchmark::State& state) {
+    SimdLevel level = SimdLevel(state.range(0));
+    if (level > simd_level()) {
+        state.SkipWithError("level not supported by this CPU");
+        return;
+    }
+    std::vector<T> a(kItems, T(3)), b(kItems, T(3));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SimdCompare<T>::first_unequal(
+            a.data(), b.data(), kItems, level));
+    }
+    state.SetBytesProcessed(state.iterations() * kItems * sizeof(T) * 2);
+}
+
+template < typename T >
+static void BM_FirstInequivalent(benchmark::State& state) {
+    SimdLevel level = SimdLevel(state.range(0));
+    if (level > simd_level()) {
+        state.SkipWithError("level not supported by this CPU");
+        return;
+    }
+    std::vector<T> a(kItems, T(3)), b(kItems, T(3));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SimdCompare<T>::first_inequivalent(
+            a.data(), b.data(), kItems, level));
+    }
+    state.SetBytesProcessed(state.iterations() * kItems * sizeof(T) * 2);
+}
+
+#define KERNEL_BENCHMARKS(T)                                             \
+    BENCHMARK_TEMPLATE(BM_FirstUnequal, T)                               \
+        ->Arg(kSimdScalar)->Arg(kSimdSse2)->Arg(kSimdAvx2);              \
+    BENCHMARK_TEMPLATE(BM_FirstInequivalent, T)                          \
+        ->Arg(kSimdScalar)->Arg(kSimdSse2)->Arg(kSimdAvx2)
+
+KERNEL_BENCHMARKS(char);
+KERNEL_BENCHMARKS(int);
+KERNEL_BENCHMARKS(double);
+
+/// == and < on two equal queues, the worst case; deque takes the
+/// generic path, UnrolledList the vectorized one
+template < typename T, typename Container >
+static void BM_QueueCompare(benchmark::State& state) {
+    Queue< T, Container > lhs, rhs;
+    for (std::size_t i = 0; i < kItems; ++i) {
+        lhs.push(T(i % 100));
+        rhs.push(T(i % 100));
+    }
+    rhs.pop();  /// so that their runs do not line up
+    rhs.push(T(0));
+    lhs.pop();
+    lhs.push(T(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lhs == rhs);
+        benchmark::DoNotOptimize(lhs < rhs);
+    }
+    state.SetItemsProcessed(state.iterations() * kItems * 2);
+}
+
+BENCHMARK_TEMPLATE(BM_QueueCompare, int, std::deque<int>);
+BENCHMARK_TEMPLATE(BM_QueueCompare, int, UnrolledList<int>);
+BENCHMARK_TEMPLATE(BM_QueueCompare, double, std::deque<double>);
+BENCHMARK_TEMPLATE(BM_QueueCompare, double, UnrolledList<double>);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,65 @@
+/** 
+ *  @brief      Small queue benchmarks for short-lived per-request queues
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+/// GCC flags free() on memory from the replaced operator new below
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <deque>
+#include <list>
+#include <new>
+
+#include "queue.h"
+#include "smallqueue.h"
+
+/// Every heap allocation of the process goes through here and is counted
+static long allocations = 0;
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    void* p = std::malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+/// Construct, push a few items, pop them all and destroy; allocs is
+/// the no. of heap allocations per queue lifetime
+template < typename Container >
+static void BM_ShortLivedQueue(benchmark::State& state) {
+    const int items = state.range(0);
+    long before = allocations;
+    for (auto _ : state) {
+        Queue< int, Container > q;
+        for (int i = 0; i < items; ++i) {
+            q.push(i);
+        }
+        while (!q.empty()) {
+            benchmark::DoNotOptimize(q.front());
+            q.pop();
+        }
+    }
+    state.counters["allocs"] = double(allocations - before) / state.iterations();
+}
+
+BENCHMARK_TEMPLATE(BM_ShortLivedQueue, std::deque<int>)->Arg(8)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_ShortLivedQueue, std::list<int>)->Arg(8)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_ShortLivedQueue, SmallRing<int, 16>)->Arg(8)->Arg(16)->Arg(64);
+
+BENCHMARK_MAIN();
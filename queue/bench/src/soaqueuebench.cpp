@@ -0,0 +1,209 @@
+/** 
+ *  @brief      Column scans over a structure-of-arrays queue against
+ *              record scans over Queue of the same ticks
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <deque>
+#include <tuple>
+
+#include "queue.h"
+#include "soaqueue.h"
+#include "unrolledlist.h"
+
+/// The record as producers write it today
+struct Tick {
+    long timestamp;
+    double price;
+    int qty;
+    long id;
+};
+
+typedef SoaQueue< std::tuple<long, double, int, long> > TickColumns;
+
+static Tick make_tick(int i) {
+    Tick tick = {1000 + i, 1.5 * (i % 100), i % 7, i};
+    return tick;
+}
+
+/// Fill with n ticks, the head left mid-buffer so that rings wrap
+template < typename Q >
+static void fill(Q& q, int n) {
+    for (int i = 0; i < n / 2; ++i) {
+        q.push(make_tick(i));
+    }
+    for (int i = 0; i < n / 2; ++i) {
+        q.pop();
+    }
+    for (int i = 0; i < n; ++i) {
+        q.push(make_tick(i));
+    }
+}
+
+static void push_tick(TickColumns& q, const Tick& tick) {
+    q.emplace(tick.timestamp, tick.price, tick.qty, tick.id);
+}
+
+static void fill(TickColumns& q, int n) {
+    for (int i = 0; i < n / 2; ++i) {
+        push_tick(q, make_tick(i));
+    }
+    for (int i = 0; i < n / 2; ++i) {
+        q.pop();
+    }
+    for (int i = 0; i < n; ++i) {
+        push_tick(q, make_tick(i));
+    }
+}
+
+/// Sum one field over every record of Queue<Tick>
+template < typename Container >
+static void BM_AosScanPrice(benchmark::State& state) {
+    Queue< Tick, Container > q;
+    fill(q, state.range(0));
+    for (auto _ : state) {
+        double sum = 0;
+        for (const Tick& tick : q) {
+            sum += tick.price;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Sum one column of the queue, run by run
+static void BM_SoaScanPrice(benchmark::State& state) {
+    TickColumns q;
+    fill(q, state.range(0));
+    for (auto _ : state) {
+        SplitCursor<double> prices = q.column<1>();
+        const double* run;
+        std::size_t n;
+        double sum = 0;
+        while (prices.next(run, n)) {
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += run[i];
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Total quantity, an integer sum the compiler vectorizes over a column
+template < typename Container >
+static void BM_AosScanQty(benchmark::State& state) {
+    Queue< Tick, Container > q;
+    fill(q, state.range(0));
+    for (auto _ : state) {
+        long sum = 0;
+        for (const Tick& tick : q) {
+            sum += tick.qty;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_SoaScanQty(benchmark::State& state) {
+    TickColumns q;
+    fill(q, state.range(0));
+    for (auto _ : state) {
+        SplitCursor<int> qtys = q.column<2>();
+        const int* run;
+        std::size_t n;
+        long sum = 0;
+        while (qtys.next(run, n)) {
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += run[i];
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Traded value, price times quantity, over every record of Queue<Tick>
+template < typename Container >
+static void BM_AosScanValue(benchmark::State& state) {
+    Queue< Tick, Container > q;
+    fill(q, state.range(0));
+    for (auto _ : state) {
+        double sum = 0;
+        for (const Tick& tick : q) {
+            sum += tick.price * tick.qty;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Traded value from two columns, whose runs split at the same index
+static void BM_SoaScanValue(benchmark::State& state) {
+    TickColumns q;
+    fill(q, state.range(0));
+    for (auto _ : state) {
+        SplitCursor<double> prices = q.column<1>();
+        SplitCursor<int> qtys = q.column<2>();
+        const double* price;
+        const int* qty;
+        std::size_t n;
+        double sum = 0;
+        while (prices.next(price, n) && qtys.next(qty, n)) {
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += price[i] * qty[i];
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// One record in and one out of a warm queue, what producers pay
+template < typename Container >
+static void BM_AosPushPop(benchmark::State& state) {
+    Queue< Tick, Container > q;
+    fill(q, state.range(0));
+    Tick tick = make_tick(7);
+    for (auto _ : state) {
+        q.push(tick);
+        benchmark::DoNotOptimize(q.front());
+        q.pop();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_SoaPushPop(benchmark::State& state) {
+    TickColumns q;
+    fill(q, state.range(0));
+    Tick tick = make_tick(7);
+    for (auto _ : state) {
+        push_tick(q, tick);
+        benchmark::DoNotOptimize(std::get<0>(q.front()));
+        q.pop();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+#define SIZES Arg(1024)->Arg(65536)
+
+BENCHMARK_TEMPLATE(BM_AosScanPrice, std::deque<Tick>)->SIZES;
+BENCHMARK_TEMPLATE(BM_AosScanPrice, UnrolledList<Tick>)->SIZES;
+BENCHMARK(BM_SoaScanPrice)->SIZES;
+BENCHMARK_TEMPLATE(BM_AosScanQty, std::deque<Tick>)->SIZES;
+BENCHMARK_TEMPLATE(BM_AosScanQty, UnrolledList<Tick>)->SIZES;
+BENCHMARK(BM_SoaScanQty)->SIZES;
+BENCHMARK_TEMPLATE(BM_AosScanValue, std::deque<Tick>)->SIZES;
+BENCHMARK_TEMPLATE(BM_AosScanValue, UnrolledList<Tick>)->SIZES;
+BENCHMARK(BM_SoaScanValue)->SIZES;
+BENCHMARK_TEMPLATE(BM_AosPushPop, std::deque<Tick>)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_AosPushPop, UnrolledList<Tick>)->Arg(1024);
+BENCHMARK(BM_SoaPushPop)->Arg(1024);
+
+BENCHMARK_MAIN();
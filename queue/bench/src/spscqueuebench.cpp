@@ -0,0 +1,116 @@
+/** 
+ *  @brief      SPSC queue benchmarks against a mutex guarded Queue
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "queue.h"
+#include "spscqueue.h"
+
+/// Queue< int > behind a mutex, the way services share it today
+class LockedQueue {
+ private:
+    std::mutex lock_;
+    Queue< int, std::deque<int> > items_;
+
+ public:
+    bool try_push(int val) {
+        std::lock_guard<std::mutex> guard(lock_);
+        items_.push(val);
+        return true;
+    }
+
+    bool try_pop(int& val) {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (items_.empty()) {
+            return false;
+        }
+        val = items_.front();
+        items_.pop();
+        return true;
+    }
+};
+
+static SpscQueue< int > spsc_forward(1024);
+static SpscQueue< int > spsc_backward(1024);
+static LockedQueue locked_forward;
+static LockedQueue locked_backward;
+
+/// Thread 0 produces, thread 1 consumes; both run the same no. of iterations
+template < typename Q >
+static void throughput(benchmark::State& state, Q& q) {
+    int val = 0;
+    if (state.thread_index() == 0) {
+        for (auto _ : state) {
+            while (!q.try_push(val)) {
+                std::this_thread::yield();
+            }
+            ++val;
+        }
+    } else {
+        for (auto _ : state) {
+            while (!q.try_pop(val)) {
+                std::this_thread::yield();
+            }
+            benchmark::DoNotOptimize(val);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// Thread 0 sends a token, thread 1 echoes it back; time is one round trip
+template < typename Q >
+static void round_trip(benchmark::State& state, Q& forward, Q& backward) {
+    int val = 0;
+    if (state.thread_index() == 0) {
+        for (auto _ : state) {
+            while (!forward.try_push(val)) {
+                std::this_thread::yield();
+            }
+            while (!backward.try_pop(val)) {
+                std::this_thread::yield();
+            }
+        }
+    } else {
+        for (auto _ : state) {
+            while (!forward.try_pop(val)) {
+                std::this_thread::yield();
+            }
+            while (!backward.try_push(val)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+static void BM_SpscQueueThroughput(benchmark::State& state) {
+    throughput(state, spsc_forward);
+}
+
+static void BM_LockedQueueThroughput(benchmark::State& state) {
+    throughput(state, locked_forward);
+}
+
+static void BM_SpscQueueRoundTrip(benchmark::State& state) {
+    round_trip(state, spsc_forward, spsc_backward);
+}
+
+static void BM_LockedQueueRoundTrip(benchmark::State& state) {
+    round_trip(state, locked_forward, locked_backward);
+}
+
+BENCHMARK(BM_SpscQueueThroughput)->Threads(2)->UseRealTime();
+BENCHMARK(BM_LockedQueueThroughput)->Threads(2)->UseRealTime();
+BENCHMARK(BM_SpscQueueRoundTrip)->Threads(2)->UseRealTime();
+BENCHMARK(BM_LockedQueueRoundTrip)->Threads(2)->UseRealTime();
+
+BENCHMARK_MAIN();
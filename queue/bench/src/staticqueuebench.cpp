@@ -0,0 +1,82 @@
+/** 
+ *  @brief      Static queue benchmarks against the deque-backed Queue
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <deque>
+#include <string>
+
+#include "queue.h"
+#include "staticqueue.h"
+
+/// Construct, push a few items, pop them all and destroy
+template < typename QueueType >
+static void BM_ShortLivedQueue(benchmark::State& state) {
+    const int items = state.range(0);
+    for (auto _ : state) {
+        QueueType q;
+        for (int i = 0; i < items; ++i) {
+            q.push(i);
+        }
+        while (!q.empty()) {
+            benchmark::DoNotOptimize(q.front());
+            q.pop();
+        }
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_ShortLivedQueue, Queue<int>)->Arg(8)->Arg(64);
+BENCHMARK_TEMPLATE(BM_ShortLivedQueue, StaticQueue<int, 64>)->Arg(8)->Arg(64);
+
+/// One push and one pop on a long-lived half-full queue
+template < typename T, typename QueueType >
+static void BM_SteadyPushPop(benchmark::State& state) {
+    QueueType q;
+    T item = T();
+    for (int i = 0; i < 32; ++i) {
+        q.push(item);
+    }
+    for (auto _ : state) {
+        q.push(item);
+        benchmark::DoNotOptimize(q.front());
+        q.pop();
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_SteadyPushPop, int, Queue<int>);
+BENCHMARK_TEMPLATE(BM_SteadyPushPop, int, StaticQueue<int, 64>);
+BENCHMARK_TEMPLATE(BM_SteadyPushPop, int, StaticQueue<int, 64, OverflowOverwrite>);
+BENCHMARK_TEMPLATE(BM_SteadyPushPop, std::string, Queue<std::string>);
+BENCHMARK_TEMPLATE(BM_SteadyPushPop, std::string, StaticQueue<std::string, 64>);
+
+/// Keep the last 64 of a stream of items, overwriting the oldest
+static void BM_SlidingWindowDeque(benchmark::State& state) {
+    Queue<int> q;
+    int i = 0;
+    for (auto _ : state) {
+        if (q.size() == 64) {
+            q.pop();
+        }
+        q.push(i++);
+        benchmark::DoNotOptimize(q.back());
+    }
+}
+
+static void BM_SlidingWindowStatic(benchmark::State& state) {
+    StaticQueue<int, 64, OverflowOverwrite> q;
+    int i = 0;
+    for (auto _ : state) {
+        q.push(i++);
+        benchmark::DoNotOptimize(q.back());
+    }
+}
+
+BENCHMARK(BM_SlidingWindowDeque);
+BENCHMARK(BM_SlidingWindowStatic);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,373 @@
+/**
+ *  @brief      Queue channel awaited by coroutines, built on the generic
+ *              Queue
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ *  Needs C++20 coroutines (-std=gnu++20).
+ *
+ */
+
+#ifndef _INCLUDE_ASYNCQUEUE_H_
+#define _INCLUDE_ASYNCQUEUE_H_
+
+#include <coroutine>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include "executor.h"
+#include "queue.h"
+
+/*
+ * @brief  The asynchronous queue class
+ *
+ * A channel between coroutines: co_await q.pop() suspends the calling
+ * coroutine until an item arrives, and co_await q.push(x) suspends it
+ * while a bounded queue is full, which pushes back on fast producers.
+ * Neither blocks a thread. Suspended coroutines are woken up in FIFO
+ * order by handing them to the Executor given at construction, which
+ * decides where they resume (see executor.h).
+ *
+ * An item pushed while consumers are waiting goes straight to the
+ * first of them, without passing through the queue; a pop that frees
+ * a slot moves the first waiting producer's item in. When a push or
+ * pop can complete at once, co_await does not suspend.
+ *
+ * After close() no more items are accepted, and the coroutines waiting
+ * are woken up: pops yield an empty optional once the items already
+ * queued are drained, pushes throw runtime_error.
+ *
+ * It is not thread safe: the queue, its coroutines and the executor
+ * belong to one thread, as with EventLoop. A coroutine suspended on
+ * the queue must not be destroyed before it is resumed, and the queue
+ * must outlive the coroutines waiting on it.
+ *
+ * The Container requirements are the ones of Queue.
+ */
+template < typename T, typename Container = std::deque<T> >
+class AsyncQueue {
+ public:
+    typedef std::size_t size_type;
+
+    class PopAwaiter;
+    class PushAwaiter;
+
+ private:
+    /// intrusive FIFO of the awaiters of suspended coroutines, which
+    /// live in the coroutine frames
+    template < typename Awaiter >
+    struct WaitList {
+        Awaiter* head;
+        Awaiter* tail;
+
+        WaitList() : head(0), tail(0) {}
+
+        void append(Awaiter* awaiter) {
+            awaiter->next_ = 0;
+            if (tail) {
+                tail->next_ = awaiter;
+            } else {
+                head = awaiter;
+            }
+            tail = awaiter;
+        }
+
+        Awaiter* take() {
+            Awaiter* first = head;
+            if (first) {
+                head = first->next_;
+                if (!head) {
+                    tail = 0;
+                }
+            }
+            return first;
+        }
+    };
+
+    Executor& executor_;
+    Queue<T, Container> items_;
+    size_type capacity_;
+    WaitList<PopAwaiter> consumers_;
+    WaitList<PushAwaiter> producers_;
+    bool closed_;
+
+    AsyncQueue(const AsyncQueue&);
+    AsyncQueue& operator=(const AsyncQueue&);
+
+    bool offer(T& val);
+    std::optional<T> take();
+
+ public:
+    /*
+     * @brief  What co_await q.pop() waits on
+     */
+    class PopAwaiter {
+     public:
+        bool await_ready() {
+            item_ = queue_->take();
+            return item_ || queue_->closed_;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) {
+            handle_ = handle;
+            queue_->consumers_.append(this);
+        }
+
+        /// the item, or an empty optional if the queue is closed and
+        /// drained
+        std::optional<T> await_resume() { return std::move(item_); }
+
+     private:
+        friend class AsyncQueue;
+
+        explicit PopAwaiter(AsyncQueue* queue) : queue_(queue), next_(0) {}
+
+        AsyncQueue* queue_;
+        std::optional<T> item_;
+        std::coroutine_handle<> handle_;
+        PopAwaiter* next_;
+    };
+
+    /*
+     * @brief  What co_await q.push(x) waits on
+     */
+    class PushAwaiter {
+     public:
+        bool await_ready() {
+            if (queue_->closed_) {
+                return true;
+            }
+            accepted_ = queue_->offer(item_);
+            return accepted_;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) {
+            handle_ = handle;
+            queue_->producers_.append(this);
+        }
+
+        /// throws runtime_error if the queue was closed before the
+        /// item was taken
+        void await_resume() {
+            if (!accepted_) {
+                throw std::runtime_error("Queue closed");
+            }
+        }
+
+     private:
+        friend class AsyncQueue;
+
+        PushAwaiter(AsyncQueue* queue, T&& item)
+            : queue_(queue), item_(std::move(item)), accepted_(false),
+              next_(0) {}
+
+        AsyncQueue* queue_;
+        T item_;
+        bool accepted_;
+        std::coroutine_handle<> handle_;
+        PushAwaiter* next_;
+    };
+
+    explicit AsyncQueue(Executor& executor,
+                        size_type capacity = std::numeric_limits<size_type>::max());
+    ~AsyncQueue();
+    bool empty() const;
+    size_type size() const;
+    size_type capacity() const;
+    bool closed() const;
+    [[nodiscard]] PopAwaiter pop();
+    [[nodiscard]] PushAwaiter push(const T& val);
+    [[nodiscard]] PushAwaiter push(T&& val);
+    std::optional<T> try_pop();
+    bool try_push(const T& val);
+    bool try_push(T&& val);
+    void close();
+};
+
+/*
+ * @brief        Constructor
+ * @param        The executor resuming woken coroutines, and the most
+ *               items queued before push suspends; unbounded by default
+ * @throws       runtime_error if capacity is zero
+ */
+template < typename T, typename Container >
+AsyncQueue<T, Container>::AsyncQueue(Executor& executor, size_type capacity)
+    : executor_(executor), capacity_(capacity), closed_(false) {
+    if (capacity == 0) {
+        throw std::runtime_error("AsyncQueue capacity must not be zero");
+    }
+}
+
+/*
+ * @brief        Destructor, closes the queue so that no coroutine is
+ *               left waiting on it
+ */
+template < typename T, typename Container >
+AsyncQueue<T, Container>::~AsyncQueue() {
+    close();
+}
+
+/*
+ * @brief        Hand an item to the first waiting consumer, or queue it
+ *               if there is room
+ * @param        The item, moved from if taken
+ * @return       false if the queue is full
+ */
+template < typename T, typename Container >
+bool AsyncQueue<T, Container>::offer(T& val) {
+    if (PopAwaiter* consumer = consumers_.take()) {
+        consumer->item_.emplace(std::move(val));
+        executor_.schedule(consumer->handle_);
+        return true;
+    }
+    if (items_.size() < capacity_) {
+        items_.push(std::move(val));
+        return true;
+    }
+    return false;
+}
+
+/*
+ * @brief        Move the front item out, refilling its slot from the
+ *               first waiting producer
+ * @param        None
+ * @return       The item, or an empty optional if queue empty
+ */
+template < typename T, typename Container >
+std::optional<T> AsyncQueue<T, Container>::take() {
+    std::optional<T> val = items_.try_pop();
+    if (val) {
+        if (PushAwaiter* producer = producers_.take()) {
+            items_.push(std::move(producer->item_));
+            producer->accepted_ = true;
+            executor_.schedule(producer->handle_);
+        }
+    }
+    return val;
+}
+
+/*
+ * @brief        Test whether queue is empty
+ * @param        None
+ * @return       true if no item is queued
+ */
+template < typename T, typename Container >
+bool AsyncQueue<T, Container>::empty() const {
+    return items_.empty();
+}
+
+/*
+ * @brief        Get size of queue, i.e. no. of items queued, not
+ *               counting those of suspended producers
+ * @param        None
+ * @return       The number of items
+ */
+template < typename T, typename Container >
+typename AsyncQueue<T, Container>::size_type
+AsyncQueue<T, Container>::size() const {
+    return items_.size();
+}
+
+/*
+ * @brief        Get the most items queued before push suspends
+ * @param        None
+ * @return       The capacity
+ */
+template < typename T, typename Container >
+typename AsyncQueue<T, Container>::size_type
+AsyncQueue<T, Container>::capacity() const {
+    return capacity_;
+}
+
+/*
+ * @brief        Test whether queue has been closed
+ * @param        None
+ * @return       true if close() was called
+ */
+template < typename T, typename Container >
+bool AsyncQueue<T, Container>::closed() const {
+    return closed_;
+}
+
+/*
+ * @brief        Remove the front item, to be awaited
+ * @param        None
+ * @return       An awaiter yielding the item, or an empty optional once
+ *               the queue is closed and drained
+ */
+template < typename T, typename Container >
+typename AsyncQueue<T, Container>::PopAwaiter AsyncQueue<T, Container>::pop() {
+    return PopAwaiter(this);
+}
+
+/*
+ * @brief        Add a new item at end of queue, to be awaited
+ * @param        The item
+ * @return       An awaiter which completes once the item is taken in,
+ *               and throws runtime_error if the queue is closed
+ */
+template < typename T, typename Container >
+typename AsyncQueue<T, Container>::PushAwaiter AsyncQueue<T, Container>::push(
+        const T& val) {
+    return PushAwaiter(this, T(val));
+}
+
+template < typename T, typename Container >
+typename AsyncQueue<T, Container>::PushAwaiter AsyncQueue<T, Container>::push(
+        T&& val) {
+    return PushAwaiter(this, std::move(val));
+}
+
+/*
+ * @brief        Remove the front item without waiting
+ * @param        None
+ * @return       The item, or an empty optional if queue empty
+ */
+template < typename T, typename Container >
+std::optional<T> AsyncQueue<T, Container>::try_pop() {
+    return take();
+}
+
+/*
+ * @brief        Add a new item without waiting, for callers which are
+ *               not coroutines
+ * @param        The item
+ * @return       false if the queue is full
+ * @throws       runtime_error - if queue closed
+ */
+template < typename T, typename Container >
+bool AsyncQueue<T, Container>::try_push(const T& val) {
+    T copy(val);
+    return try_push(std::move(copy));
+}
+
+template < typename T, typename Container >
+bool AsyncQueue<T, Container>::try_push(T&& val) {
+    if (closed_) {
+        throw std::runtime_error("Queue closed");
+    }
+    return offer(val);
+}
+
+/*
+ * @brief        Stop accepting items and wake up all waiting coroutines
+ * @param        None
+ * @return       Nothing
+ */
+template < typename T, typename Container >
+void AsyncQueue<T, Container>::close() {
+    closed_ = true;
+    while (PopAwaiter* consumer = consumers_.take()) {
+        executor_.schedule(consumer->handle_);
+    }
+    while (PushAwaiter* producer = producers_.take()) {
+        executor_.schedule(producer->handle_);
+    }
+}
+
+#endif
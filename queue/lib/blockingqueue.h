@@ -0,0 +1,243 @@
+/**
+ *  @brief      Blocking thread-safe queue built on the generic Queue
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_BLOCKINGQUEUE_H_
+#define _INCLUDE_BLOCKINGQUEUE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+
+#include "queue.h"
+
+/*
+ * @brief  The blocking queue implementation class
+ *
+ * It guards a Queue with a mutex and lets consumers sleep on a
+ * condition variable until an item arrives, a timeout expires or the
+ * queue is closed. After close() no more items are accepted, all
+ * waiting consumers are woken up, and the items already queued can
+ * still be popped; wait_pop returns false only once the queue is both
+ * closed and drained.
+ *
+ * Consumers are only notified when some are actually waiting, and
+ * push_bulk wakes them once for the whole batch instead of once per
+ * item. Notifications are sent after the lock is released so that a
+ * woken consumer does not immediately block on it again.
+ *
+ * The Container requirements are the ones of Queue.
+ */
+template < typename T, typename Container = std::deque<T> >
+class BlockingQueue {
+ private:
+    typedef unsigned size_type;
+    mutable std::mutex lock_;
+    std::condition_variable not_empty_;
+    Queue<T, Container> items_;
+    size_type waiters_;
+    bool closed_;
+
+    BlockingQueue(const BlockingQueue&);
+    BlockingQueue& operator=(const BlockingQueue&);
+
+    void take(T& val);
+
+ public:
+    BlockingQueue();
+    bool empty() const;
+    size_type size() const;
+    bool closed() const;
+    void push(const T& val);
+    template < typename InputIterator >
+    void push_bulk(InputIterator first, InputIterator last);
+    bool wait_pop(T& val);
+    template < typename Rep, typename Period >
+    bool wait_pop_for(T& val, const std::chrono::duration<Rep, Period>& timeout);
+    bool try_pop(T& val);
+    void close();
+};
+
+/*
+ * @brief        Default constructor
+ */
+template < typename T, typename Container >
+BlockingQueue<T, Container>::BlockingQueue() : waiters_(0), closed_(false) {
+}
+
+/*
+ * @brief        Test whether queue is empty
+ * @param        None
+ * @return       true if queue empty at the time of the call
+ */
+template < typename T, typename Container >
+bool BlockingQueue<T, Container>::empty() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return items_.empty();
+}
+
+/*
+ * @brief        Get size of queue, i.e. no. of items
+ * @param        None
+ * @return       The number of items at the time of the call
+ */
+template < typename T, typename Container >
+typename BlockingQueue<T, Container>::size_type
+BlockingQueue<T, Container>::size() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return items_.size();
+}
+
+/*
+ * @brief        Test whether queue has been closed
+ * @param        None
+ * @return       true if close() was called
+ */
+template < typename T, typename Container >
+bool BlockingQueue<T, Container>::closed() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return closed_;
+}
+
+/*
+ * @brief        Add a new item at end of queue and wake one consumer
+ * @param        The item
+ * @return       Nothing
+ * @throws       runtime_error - if queue closed
+ */
+template < typename T, typename Container >
+void BlockingQueue<T, Container>::push(const T& val) {
+    std::unique_lock<std::mutex> guard(lock_);
+    if (closed_) {
+        throw std::runtime_error("Queue closed");
+    }
+    items_.push(val);
+    bool wake = waiters_ > 0;
+    guard.unlock();
+    if (wake) {
+        not_empty_.notify_one();
+    }
+}
+
+/*
+ * @brief        Add a range of items at end of queue, waking consumers once
+ * @param        Iterators to the first and past the last item
+ * @return       Nothing
+ * @throws       runtime_error - if queue closed
+ */
+template < typename T, typename Container >
+template < typename InputIterator >
+void BlockingQueue<T, Container>::push_bulk(InputIterator first,
+                                            InputIterator last) {
+    std::unique_lock<std::mutex> guard(lock_);
+    if (closed_) {
+        throw std::runtime_error("Queue closed");
+    }
+    size_type before = items_.size();
+    items_.push_range(first, last);
+    size_type count = items_.size() - before;
+    bool wake = waiters_ > 0 && count > 0;
+    guard.unlock();
+    if (wake) {
+        if (count == 1) {
+            not_empty_.notify_one();
+        } else {
+            not_empty_.notify_all();
+        }
+    }
+}
+
+/*
+ * @brief        Move the front item out, lock must be held
+ * @param        Destination of the item
+ * @return       Nothing
+ */
+template < typename T, typename Container >
+void BlockingQueue<T, Container>::take(T& val) {
+    val = items_.pop_value();
+}
+
+/*
+ * @brief        Remove the front item, waiting until one is available
+ * @param        Destination of the item
+ * @return       false if the queue is closed and drained
+ */
+template < typename T, typename Container >
+bool BlockingQueue<T, Container>::wait_pop(T& val) {
+    std::unique_lock<std::mutex> guard(lock_);
+    ++waiters_;
+    while (items_.empty() && !closed_) {
+        not_empty_.wait(guard);
+    }
+    --waiters_;
+    if (items_.empty()) {
+        return false;
+    }
+    take(val);
+    return true;
+}
+
+/*
+ * @brief        Remove the front item, waiting at most for a timeout
+ * @param        Destination of the item, and the maximum time to wait
+ * @return       false if the timeout expired or the queue is closed
+ *               and drained
+ */
+template < typename T, typename Container >
+template < typename Rep, typename Period >
+bool BlockingQueue<T, Container>::wait_pop_for(
+        T& val, const std::chrono::duration<Rep, Period>& timeout) {
+    std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + timeout;
+    std::unique_lock<std::mutex> guard(lock_);
+    ++waiters_;
+    while (items_.empty() && !closed_) {
+        if (not_empty_.wait_until(guard, deadline) == std::cv_status::timeout) {
+            break;
+        }
+    }
+    --waiters_;
+    if (items_.empty()) {
+        return false;
+    }
+    take(val);
+    return true;
+}
+
+/*
+ * @brief        Remove the front item without waiting
+ * @param        Destination of the item
+ * @return       false if the queue is empty
+ */
+template < typename T, typename Container >
+bool BlockingQueue<T, Container>::try_pop(T& val) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (items_.empty()) {
+        return false;
+    }
+    take(val);
+    return true;
+}
+
+/*
+ * @brief        Stop accepting items and wake up all waiting consumers
+ * @param        None
+ * @return       Nothing
+ */
+template < typename T, typename Container >
+void BlockingQueue<T, Container>::close() {
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        closed_ = true;
+    }
+    not_empty_.notify_all();
+}
+
+#endif
@@ -0,0 +1,34 @@
+/**
+ *  @brief      Fixed-capacity queue overwriting its oldest items
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_CIRCULARQUEUE_H_
+#define _INCLUDE_CIRCULARQUEUE_H_
+
+#include <cstddef>
+
+#include "queue.h"
+#include "staticring.h"
+
+/*
+ * @brief  Queue keeping the last N items pushed
+ *
+ * A Queue over a StaticRing of N items with the OverflowOverwrite
+ * policy: once N items are queued, push drops the front item, the
+ * oldest, to make room, in O(1) and without allocating. Items live
+ * inside the object, so a buffer of the last N events can sit in a
+ * global and still be read after a crash.
+ *
+ * It has the full Queue interface; begin and end iterate from the
+ * oldest item to the newest, and copy_to takes a snapshot in at most
+ * two bulk copies.
+ */
+template < typename T, std::size_t N >
+using CircularQueue = Queue< T, StaticRing<T, N, OverflowOverwrite> >;
+
+#endif
@@ -0,0 +1,156 @@
+/**
+ *  @brief      Executors resuming coroutines, and a single-threaded
+ *              event loop
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ *  Needs C++20 coroutines (-std=gnu++20).
+ *
+ */
+
+#ifndef _INCLUDE_EXECUTOR_H_
+#define _INCLUDE_EXECUTOR_H_
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+#include "queue.h"
+
+/*
+ * @brief  Where suspended coroutines are resumed
+ *
+ * AsyncQueue hands the coroutines it wakes up to an executor rather
+ * than resuming them inline, so a push never runs the consumer on the
+ * producer's stack. Implementations decide when and on which thread
+ * each one runs; schedule must eventually resume every handle exactly
+ * once.
+ */
+class Executor {
+ public:
+    virtual ~Executor() {}
+    virtual void schedule(std::coroutine_handle<> handle) = 0;
+};
+
+/*
+ * @brief  The event loop class, an executor running on one thread
+ *
+ * Keeps the coroutines scheduled on it in a Queue, and resumes them in
+ * order from run() or run_one() on the calling thread. Coroutines
+ * scheduled while it runs are resumed in the same run. It is not
+ * thread safe: everything using it must run on the loop's thread.
+ */
+class EventLoop : public Executor {
+ private:
+    typedef unsigned size_type;
+    Queue< std::coroutine_handle<> > ready_;
+
+ public:
+    void schedule(std::coroutine_handle<> handle) {
+        ready_.push(handle);
+    }
+
+    /*
+     * @brief        Resume the first scheduled coroutine, if any
+     * @param        None
+     * @return       false if none was scheduled
+     */
+    bool run_one() {
+        std::coroutine_handle<>* handle = ready_.try_front();
+        if (!handle) {
+            return false;
+        }
+        std::coroutine_handle<> next = *handle;
+        ready_.pop();
+        next.resume();
+        return true;
+    }
+
+    /*
+     * @brief        Resume coroutines until none is scheduled
+     * @param        None
+     * @return       The no. of coroutines resumed
+     */
+    size_type run() {
+        size_type resumed = 0;
+        while (run_one()) {
+            ++resumed;
+        }
+        return resumed;
+    }
+
+    bool empty() const { return ready_.empty(); }
+    size_type size() const { return ready_.size(); }
+};
+
+/*
+ * @brief  A coroutine started on an executor
+ *
+ * The smallest coroutine type that can await an AsyncQueue: it starts
+ * suspended, start() schedules it on an executor, and the Task object
+ * owns its frame, which stays until the Task is destroyed so done()
+ * and result() can be checked after it finishes. An exception escaping
+ * the coroutine is kept and rethrown by result().
+ *
+ * A Task must not be destroyed while its coroutine is suspended on
+ * something that will resume it.
+ */
+class Task {
+ public:
+    struct promise_type {
+        std::exception_ptr error;
+
+        Task get_return_object() {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+ private:
+    std::coroutine_handle<promise_type> handle_;
+
+    explicit Task(std::coroutine_handle<promise_type> handle)
+        : handle_(handle) {}
+
+    Task(const Task&);
+    Task& operator=(const Task&);
+
+ public:
+    Task(Task&& other) noexcept : handle_(other.handle_) {
+        other.handle_ = nullptr;
+    }
+
+    Task& operator=(Task&& other) noexcept {
+        std::swap(handle_, other.handle_);
+        return *this;
+    }
+
+    ~Task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    /// schedule the coroutine's first step on executor
+    void start(Executor& executor) { executor.schedule(handle_); }
+
+    bool done() const { return handle_.done(); }
+
+    /*
+     * @brief        Rethrow the exception which ended the coroutine
+     * @param        None
+     * @return       Nothing, if it ran to completion
+     */
+    void result() const {
+        if (handle_.promise().error) {
+            std::rethrow_exception(handle_.promise().error);
+        }
+    }
+};
+
+#endif
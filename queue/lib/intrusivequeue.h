@@ -0,0 +1,468 @@
+/**
+ *  @brief      Intrusive queues of items linked through an embedded hook
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_INTRUSIVEQUEUE_H_
+#define _INCLUDE_INTRUSIVEQUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "intrusivehook.h"
+
+/*
+ * @brief  The intrusive queue class
+ *
+ * A FIFO of items which the queue does not own: each item embeds an
+ * IntrusiveHook (see intrusivehook.h), and push links it in by its
+ * address, so items from a pool or an arena are queued with no
+ * allocation and no copy. size() is O(1), and so are splice and clear.
+ *
+ * The caller keeps every item alive, and at an unchanged address,
+ * while it is queued, and must not push an item already linked through
+ * the same hook; the queue never destroys items. front, back and pop
+ * throw runtime_error on an empty queue, try_front and try_pop return
+ * a null pointer instead.
+ *
+ * The queue cannot be copied, as its items cannot be in two queues
+ * through one hook; it can be moved and swapped. == and < compare the
+ * items' values in order, as those of Queue do.
+ */
+template < typename T, IntrusiveHook<T> T::*Hook = &T::hook >
+class IntrusiveQueue {
+ public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+
+    /*
+     * @brief  Forward iterator from front to back
+     */
+    template < typename Item >
+    class basic_iterator {
+     public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Item value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Item* pointer;
+        typedef Item& reference;
+
+        basic_iterator() : item_(0) {}
+        explicit basic_iterator(Item* item) : item_(item) {}
+
+        /// iterators convert to const_iterator
+        operator basic_iterator<const Item>() const {
+            return basic_iterator<const Item>(item_);
+        }
+
+        reference operator*() const { return *item_; }
+        pointer operator->() const { return item_; }
+        basic_iterator& operator++() {
+            item_ = (item_->*Hook).next;
+            return *this;
+        }
+        basic_iterator operator++(int) {
+            basic_iterator old(*this);
+            ++*this;
+            return old;
+        }
+        bool operator==(const basic_iterator& other) const {
+            return item_ == other.item_;
+        }
+        bool operator!=(const basic_iterator& other) const {
+            return item_ != other.item_;
+        }
+
+     private:
+        Item* item_;
+    };
+
+    typedef basic_iterator<T> iterator;
+    typedef basic_iterator<const T> const_iterator;
+
+ private:
+    T* head_;
+    T* tail_;
+    size_type size_;
+
+    IntrusiveQueue(const IntrusiveQueue&);
+    IntrusiveQueue& operator=(const IntrusiveQueue&);
+
+ public:
+    IntrusiveQueue();
+    IntrusiveQueue(IntrusiveQueue&& other) noexcept;
+    IntrusiveQueue& operator=(IntrusiveQueue&& other) noexcept;
+    bool empty() const;
+    size_type size() const;
+    T& front();
+    const T& front() const;
+    T& back();
+    const T& back() const;
+    T* try_front();
+    void push(T& item);
+    void pop();
+    T* try_pop();
+    void splice(IntrusiveQueue& other);
+    void clear();
+    void swap(IntrusiveQueue& other) noexcept;
+    iterator begin() { return iterator(head_); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(head_); }
+    const_iterator end() const { return const_iterator(); }
+};
+
+/*
+ * @brief        Default constructor, makes an empty queue
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+IntrusiveQueue<T, Hook>::IntrusiveQueue() : head_(0), tail_(0), size_(0) {
+}
+
+/*
+ * @brief        Move constructor, takes over the items of other
+ * @param        The queue to move from, left empty
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+IntrusiveQueue<T, Hook>::IntrusiveQueue(IntrusiveQueue&& other) noexcept
+    : head_(other.head_), tail_(other.tail_), size_(other.size_) {
+    other.clear();
+}
+
+/*
+ * @brief        Move assignment, unlinks the items held so far
+ * @param        The queue to move from, left empty
+ * @return       This queue
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+IntrusiveQueue<T, Hook>&
+IntrusiveQueue<T, Hook>::operator=(IntrusiveQueue&& other) noexcept {
+    clear();
+    swap(other);
+    return *this;
+}
+
+/*
+ * @brief        Test whether queue is empty
+ * @param        None
+ * @return       true if queue empty
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+bool IntrusiveQueue<T, Hook>::empty() const {
+    return size_ == 0;
+}
+
+/*
+ * @brief        Get size of queue, i.e. no. of items linked in
+ * @param        None
+ * @return       The number of items, kept as items come and go
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+typename IntrusiveQueue<T, Hook>::size_type
+IntrusiveQueue<T, Hook>::size() const {
+    return size_;
+}
+
+/*
+ * @brief        Access the front item in queue
+ * @param        None
+ * @return       Reference to the front item
+ * @throws       runtime_error - if queue empty
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+T& IntrusiveQueue<T, Hook>::front() {
+    if (!head_) {
+        throw std::runtime_error("Queue empty");
+    }
+    return *head_;
+}
+
+template < typename T, IntrusiveHook<T> T::*Hook >
+const T& IntrusiveQueue<T, Hook>::front() const {
+    if (!head_) {
+        throw std::runtime_error("Queue empty");
+    }
+    return *head_;
+}
+
+/*
+ * @brief        Access the back item in queue
+ * @param        None
+ * @return       Reference to the back item
+ * @throws       runtime_error - if queue empty
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+T& IntrusiveQueue<T, Hook>::back() {
+    if (!tail_) {
+        throw std::runtime_error("Queue empty");
+    }
+    return *tail_;
+}
+
+template < typename T, IntrusiveHook<T> T::*Hook >
+const T& IntrusiveQueue<T, Hook>::back() const {
+    if (!tail_) {
+        throw std::runtime_error("Queue empty");
+    }
+    return *tail_;
+}
+
+/*
+ * @brief        Access the front item without the empty check throwing
+ * @param        None
+ * @return       Pointer to the front item, or null if queue empty
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+T* IntrusiveQueue<T, Hook>::try_front() {
+    return head_;
+}
+
+/*
+ * @brief        Link an item in at the end of queue
+ * @param        The item, which must stay alive until popped
+ * @return       Nothing
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+void IntrusiveQueue<T, Hook>::push(T& item) {
+    (item.*Hook).next = 0;
+    if (tail_) {
+        (tail_->*Hook).next = &item;
+    } else {
+        head_ = &item;
+    }
+    tail_ = &item;
+    ++size_;
+}
+
+/*
+ * @brief        Unlink the front item
+ * @param        None
+ * @return       Nothing
+ * @throws       runtime_error - if queue empty
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+void IntrusiveQueue<T, Hook>::pop() {
+    if (!try_pop()) {
+        throw std::runtime_error("Queue empty");
+    }
+}
+
+/*
+ * @brief        Unlink the front item, if any
+ * @param        None
+ * @return       The item, now owned by the caller again, or null if
+ *               queue empty
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+T* IntrusiveQueue<T, Hook>::try_pop() {
+    T* item = head_;
+    if (item) {
+        head_ = (item->*Hook).next;
+        if (!head_) {
+            tail_ = 0;
+        }
+        (item->*Hook).next = 0;
+        --size_;
+    }
+    return item;
+}
+
+/*
+ * @brief        Move all items of other to the end of this queue
+ * @param        The queue to take from, left empty
+ * @return       Nothing
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+void IntrusiveQueue<T, Hook>::splice(IntrusiveQueue& other) {
+    if (&other == this || !other.head_) {
+        return;
+    }
+    if (tail_) {
+        (tail_->*Hook).next = other.head_;
+    } else {
+        head_ = other.head_;
+    }
+    tail_ = other.tail_;
+    size_ += other.size_;
+    other.clear();
+}
+
+/*
+ * @brief        Unlink all items at once; their hooks are reset when
+ *               they are pushed again
+ * @param        None
+ * @return       Nothing
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+void IntrusiveQueue<T, Hook>::clear() {
+    head_ = 0;
+    tail_ = 0;
+    size_ = 0;
+}
+
+/*
+ * @brief        Exchange the items of two queues
+ * @param        The other queue
+ * @return       Nothing
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+void IntrusiveQueue<T, Hook>::swap(IntrusiveQueue& other) noexcept {
+    std::swap(head_, other.head_);
+    std::swap(tail_, other.tail_);
+    std::swap(size_, other.size_);
+}
+
+/*
+ * @brief        Performs the equality test on operands
+ * @param        Two queue objects to be compared
+ * @return       true if they hold equal items in the same order
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+bool operator==(const IntrusiveQueue<T, Hook>& lhs,
+                const IntrusiveQueue<T, Hook>& rhs) {
+    return lhs.size() == rhs.size() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+/*
+ * @brief        Performs the inequality test on operands
+ * @param        Two queue objects to be compared
+ * @return       true if unequal
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+bool operator!=(const IntrusiveQueue<T, Hook>& lhs,
+                const IntrusiveQueue<T, Hook>& rhs) {
+    return !(lhs == rhs);
+}
+
+/*
+ * @brief        Performs the less-than test on operands
+ * @param        Two queue objects to be compared
+ * @return       true if lhs comes first, front to back
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+bool operator<(const IntrusiveQueue<T, Hook>& lhs,
+               const IntrusiveQueue<T, Hook>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(),
+                                        rhs.begin(), rhs.end());
+}
+
+/*
+ * @brief        Performs the less-than-or-equal test on operands
+ * @param        Two queue objects to be compared
+ * @return       true if lhs does not come after rhs
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+bool operator<=(const IntrusiveQueue<T, Hook>& lhs,
+                const IntrusiveQueue<T, Hook>& rhs) {
+    return !(rhs < lhs);
+}
+
+/*
+ * @brief        Performs the greater-than-or-equal test on operands
+ * @param        Two queue objects to be compared
+ * @return       true if lhs does not come before rhs
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+bool operator>=(const IntrusiveQueue<T, Hook>& lhs,
+                const IntrusiveQueue<T, Hook>& rhs) {
+    return !(lhs < rhs);
+}
+
+/*
+ * @brief        Performs the greater-than test on operands
+ * @param        Two queue objects to be compared
+ * @return       true if lhs comes after rhs
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+bool operator>(const IntrusiveQueue<T, Hook>& lhs,
+               const IntrusiveQueue<T, Hook>& rhs) {
+    return rhs < lhs;
+}
+
+/*
+ * @brief  The intrusive multi-producer, single-consumer queue class
+ *
+ * Links items through the same IntrusiveHook as IntrusiveQueue, from
+ * any number of threads, without allocating and without a lock: push
+ * puts the item on a shared list with one compare-and-swap, and the
+ * single consumer takes that whole list with one exchange when its own
+ * is empty, reversing it into FIFO order. Pushes from one thread are
+ * popped in the order they were made, and so are pushes ordered by
+ * synchronisation between threads.
+ *
+ * push may be called from any thread; try_pop and empty from one
+ * consumer thread at a time only. try_pop returns null when both lists
+ * are empty, so an item being pushed meanwhile may be seen only by the
+ * next call. The item's hook belongs to the queue from push until
+ * try_pop returns it. There is no size(): counting would add a shared
+ * atomic update to every push and pop.
+ */
+template < typename T, IntrusiveHook<T> T::*Hook = &T::hook >
+class IntrusiveMpscQueue {
+ private:
+    std::atomic<T*> pushed_;  /// newest first, shared with producers
+    T* popping_;              /// oldest first, owned by the consumer
+
+    IntrusiveMpscQueue(const IntrusiveMpscQueue&);
+    IntrusiveMpscQueue& operator=(const IntrusiveMpscQueue&);
+
+ public:
+    IntrusiveMpscQueue() : pushed_(0), popping_(0) {}
+
+    /*
+     * @brief        Link an item in, from any thread
+     * @param        The item, which must stay alive until popped
+     * @return       Nothing
+     */
+    void push(T& item) {
+        T* head = pushed_.load(std::memory_order_relaxed);
+        do {
+            (item.*Hook).next = head;
+        } while (!pushed_.compare_exchange_weak(head, &item,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed));
+    }
+
+    /*
+     * @brief        Unlink the oldest item, on the consumer thread
+     * @param        None
+     * @return       The item, or null if none was pushed yet
+     */
+    T* try_pop() {
+        if (!popping_) {
+            T* item = pushed_.exchange(0, std::memory_order_acquire);
+            while (item) {
+                T* next = (item->*Hook).next;
+                (item->*Hook).next = popping_;
+                popping_ = item;
+                item = next;
+            }
+            if (!popping_) {
+                return 0;
+            }
+        }
+        T* item = popping_;
+        popping_ = (item->*Hook).next;
+        (item->*Hook).next = 0;
+        return item;
+    }
+
+    /*
+     * @brief        Test whether queue is empty, on the consumer thread
+     * @param        None
+     * @return       true if no item was waiting when checked
+     */
+    bool empty() const {
+        return !popping_ && !pushed_.load(std::memory_order_acquire);
+    }
+};
+
+#endif
@@ -0,0 +1,435 @@
+/**
+ *  @brief      Queue kept in a memory-mapped file, surviving restarts
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_MAPPEDQUEUE_H_
+#define _INCLUDE_MAPPEDQUEUE_H_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * @brief  The memory-mapped queue class
+ *
+ * A ring of capacity records stored in a file which is mapped into
+ * memory: push copies a record straight into its slot in the mapping
+ * and front hands out a reference to it, so records are never
+ * serialized. T must be trivially copyable, and is read back as it was
+ * written, so the file is only meant for the same build on the same
+ * machine.
+ *
+ * The file starts with a page holding the layout and the head and tail
+ * counters, followed by the slots. Opening an existing file checks the
+ * layout and takes up the queue where the counters say, without reading
+ * any record, so a spool of many GB opens in constant time.
+ *
+ * Pushes and pops change the mapping only; flush() writes back the
+ * records pushed since the last flush with msync, then the counters.
+ * The file thus always holds the queue as of a flush: after a crash,
+ * items pushed since are lost and items popped since come back, so a
+ * consumer sees them again (at-least-once delivery). Flushing every
+ * batch rather than every push amortizes the msync. The destructor
+ * flushes as well.
+ *
+ * Since it can fill up, push and emplace return whether the item was
+ * added, as in StaticQueue. Slots freed by pops are only reused after
+ * the next flush, as the file may still count them as items until
+ * then.
+ */
+template < typename T >
+class MappedQueue {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "MappedQueue items must be trivially copyable");
+
+ public:
+    typedef std::size_t size_type;
+
+ private:
+    static const std::uint64_t kMagic = 0x4575657551706d4dULL;  /// "MmpQueuE"
+    static const std::uint32_t kVersion = 1;
+
+    /// layout and counters, in the first page of the file; head and
+    /// tail count the items ever popped and pushed
+    struct Header {
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t item_size;
+        std::uint64_t capacity;
+        std::uint64_t head;
+        std::uint64_t tail;
+    };
+
+    int fd_;
+    char* map_;
+    size_type map_size_;
+    size_type page_;
+    Header* header_;
+    T* slots_;
+    std::uint64_t capacity_;
+    std::uint64_t head_;
+    std::uint64_t tail_;
+    std::uint64_t flushed_head_;
+    std::uint64_t flushed_tail_;
+
+    MappedQueue(const MappedQueue&);
+    MappedQueue& operator=(const MappedQueue&);
+
+    T& slot(std::uint64_t count) { return slots_[count % capacity_]; }
+    void sync(const void* first, size_type bytes);
+    void close_file();
+
+ public:
+    MappedQueue(const std::string& path, size_type capacity);
+    ~MappedQueue();
+    bool empty() const;
+    bool full() const;
+    size_type size() const;
+    size_type capacity() const;
+    T& front();
+    T& back();
+    T* try_front();
+    bool push(const T& val);
+    template < typename... Args >
+    bool emplace(Args&&... args);
+    void pop();
+    T pop_value();
+    std::optional<T> try_pop();
+    void flush();
+};
+
+/*
+ * @brief        Constructor, opens the file at path or creates it
+ * @param        The path, and the no. of slots of a new file; an
+ *               existing file must have been created with the same
+ *               capacity and item size
+ * @throws       system_error if the file cannot be opened, sized or
+ *               mapped, runtime_error if it holds another layout
+ */
+template < typename T >
+MappedQueue<T>::MappedQueue(const std::string& path, size_type capacity)
+    : fd_(-1), map_(0), map_size_(0), page_(sysconf(_SC_PAGESIZE)),
+      header_(0), slots_(0), capacity_(capacity), head_(0), tail_(0),
+      flushed_head_(0), flushed_tail_(0) {
+    if (capacity == 0) {
+        throw std::runtime_error("MappedQueue capacity must not be zero");
+    }
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd_ < 0) {
+        throw std::system_error(errno, std::generic_category(),
+                                "MappedQueue open " + path);
+    }
+
+    /// slots start on the page after the header, so they are aligned
+    /// for any T and msync ranges never touch the header
+    map_size_ = page_ + capacity * sizeof(T);
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+        int error = errno;
+        close_file();
+        throw std::system_error(error, std::generic_category(),
+                                "MappedQueue stat " + path);
+    }
+    bool created = st.st_size == 0;
+    if (created && ::ftruncate(fd_, map_size_) != 0) {
+        int error = errno;
+        close_file();
+        throw std::system_error(error, std::generic_category(),
+                                "MappedQueue truncate " + path);
+    }
+    if (!created && size_type(st.st_size) != map_size_) {
+        close_file();
+        throw std::runtime_error("MappedQueue file size mismatch: " + path);
+    }
+
+    void* map = ::mmap(0, map_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_,
+                       0);
+    if (map == MAP_FAILED) {
+        int error = errno;
+        close_file();
+        throw std::system_error(error, std::generic_category(),
+                                "MappedQueue mmap " + path);
+    }
+    map_ = static_cast<char*>(map);
+    header_ = reinterpret_cast<Header*>(map_);
+    slots_ = reinterpret_cast<T*>(map_ + page_);
+
+    if (created) {
+        header_->magic = kMagic;
+        header_->version = kVersion;
+        header_->item_size = sizeof(T);
+        header_->capacity = capacity;
+        header_->head = 0;
+        header_->tail = 0;
+        sync(header_, sizeof(Header));
+    } else if (header_->magic != kMagic || header_->version != kVersion ||
+               header_->item_size != sizeof(T) ||
+               header_->capacity != capacity ||
+               header_->tail - header_->head > capacity) {
+        close_file();
+        throw std::runtime_error("MappedQueue layout mismatch: " + path);
+    }
+    head_ = header_->head;
+    tail_ = header_->tail;
+    flushed_head_ = head_;
+    flushed_tail_ = tail_;
+}
+
+/*
+ * @brief        Destructor, flushes and unmaps the file
+ */
+template < typename T >
+MappedQueue<T>::~MappedQueue() {
+    try {
+        flush();
+    } catch (...) {
+        /// the file keeps the state of the last successful flush
+    }
+    close_file();
+}
+
+/*
+ * @brief        Write back a range of the mapping and wait for it
+ * @param        The first byte and the no. of bytes
+ * @return       Nothing
+ * @throws       system_error if msync fails
+ */
+template < typename T >
+void MappedQueue<T>::sync(const void* first, size_type bytes) {
+    /// msync wants a page-aligned start
+    size_type offset = static_cast<const char*>(first) - map_;
+    size_type start = offset / page_ * page_;
+    if (::msync(map_ + start, offset + bytes - start, MS_SYNC) != 0) {
+        throw std::system_error(errno, std::generic_category(),
+                                "MappedQueue msync");
+    }
+}
+
+/*
+ * @brief        Unmap and close the file, if open
+ */
+template < typename T >
+void MappedQueue<T>::close_file() {
+    if (map_) {
+        ::munmap(map_, map_size_);
+        map_ = 0;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+/*
+ * @brief        Test whether queue is empty
+ * @param        None
+ * @return       true if queue empty, false otherwise
+ */
+template < typename T >
+bool MappedQueue<T>::empty() const {
+    return head_ == tail_;
+}
+
+/*
+ * @brief        Test whether every slot is taken, counting the slots
+ *               freed since the last flush as taken
+ * @param        None
+ * @return       true if the next push fails
+ */
+template < typename T >
+bool MappedQueue<T>::full() const {
+    return tail_ - flushed_head_ == capacity_;
+}
+
+/*
+ * @brief        Get size of queue, i.e. no. of items
+ * @param        None
+ * @return       The number of items in the queue
+ */
+template < typename T >
+typename MappedQueue<T>::size_type MappedQueue<T>::size() const {
+    return tail_ - head_;
+}
+
+/*
+ * @brief        Get the no. of slots in the file
+ * @param        None
+ * @return       The capacity
+ */
+template < typename T >
+typename MappedQueue<T>::size_type MappedQueue<T>::capacity() const {
+    return capacity_;
+}
+
+/*
+ * @brief        Access the front item in queue, in the mapping
+ * @param        None
+ * @return       Reference to the front item
+ * @throws       runtime_error if queue is empty
+ */
+template < typename T >
+T& MappedQueue<T>::front() {
+    if (empty()) {
+        throw std::runtime_error("Queue empty");
+    }
+    return slot(head_);
+}
+
+/*
+ * @brief        Access the back item in queue, in the mapping
+ * @param        None
+ * @return       Reference to the back item
+ * @throws       runtime_error if queue is empty
+ */
+template < typename T >
+T& MappedQueue<T>::back() {
+    if (empty()) {
+        throw std::runtime_error("Queue empty");
+    }
+    return slot(tail_ - 1);
+}
+
+/*
+ * @brief        Access the front item in queue if there is one
+ * @param        None
+ * @return       Pointer to the front item, or null if queue empty
+ */
+template < typename T >
+T* MappedQueue<T>::try_front() {
+    return empty() ? 0 : &slot(head_);
+}
+
+/*
+ * @brief        Copy a new item into the next slot
+ * @param        The item
+ * @return       false if queue was full
+ */
+template < typename T >
+bool MappedQueue<T>::push(const T& val) {
+    if (full()) {
+        return false;
+    }
+    slot(tail_) = val;
+    ++tail_;
+    return true;
+}
+
+/*
+ * @brief        Construct a new item in the next slot
+ * @param        Arguments forwarded to the constructor of the item
+ * @return       false if queue was full
+ */
+template < typename T >
+template < typename... Args >
+bool MappedQueue<T>::emplace(Args&&... args) {
+    if (full()) {
+        return false;
+    }
+    ::new (static_cast<void*>(&slot(tail_))) T(std::forward<Args>(args)...);
+    ++tail_;
+    return true;
+}
+
+/*
+ * @brief        Delete the front item in queue
+ * @param        None
+ * @return       Nothing
+ * @throws       runtime_error if queue is empty
+ */
+template < typename T >
+void MappedQueue<T>::pop() {
+    if (empty()) {
+        throw std::runtime_error("Queue empty");
+    }
+    ++head_;
+}
+
+/*
+ * @brief        Copy the front item out of queue and delete it
+ * @param        None
+ * @return       The front item
+ * @throws       runtime_error if queue is empty
+ */
+template < typename T >
+T MappedQueue<T>::pop_value() {
+    if (empty()) {
+        throw std::runtime_error("Queue empty");
+    }
+    return slot(head_++);
+}
+
+/*
+ * @brief        Copy the front item out of queue, if any, and delete it
+ * @param        None
+ * @return       The front item, or an empty optional if queue empty
+ */
+template < typename T >
+std::optional<T> MappedQueue<T>::try_pop() {
+    if (empty()) {
+        return std::nullopt;
+    }
+    return slot(head_++);
+}
+
+/*
+ * @brief        Make the file hold the queue as it is now
+ *
+ * Writes back the slots pushed since the last flush, then the
+ * counters, waiting for each; a crash in between leaves the previous
+ * counters, which do not cover the new slots.
+ *
+ * The mapping is shared, so a process dying between the two counter
+ * stores leaves the first one in the file. tail is stored first: with
+ * a new tail and the old head the file holds a valid queue, as slots
+ * from the flushed head on are not reused until this flush, and a
+ * crash there only brings back the items popped since. A new head with
+ * the old tail could pass it, and the file would no longer open.
+ *
+ * @param        None
+ * @return       Nothing
+ * @throws       system_error if msync fails
+ */
+template < typename T >
+void MappedQueue<T>::flush() {
+    if (!map_) {
+        return;
+    }
+    if (tail_ != flushed_tail_) {
+        size_type from = flushed_tail_ % capacity_;
+        size_type count = tail_ - flushed_tail_;
+        if (from + count <= capacity_) {
+            sync(slots_ + from, count * sizeof(T));
+        } else {
+            sync(slots_ + from, (capacity_ - from) * sizeof(T));
+            sync(slots_, (from + count - capacity_) * sizeof(T));
+        }
+        flushed_tail_ = tail_;
+    }
+    if (header_->head != head_ || header_->tail != tail_) {
+        header_->tail = tail_;
+        std::atomic_signal_fence(std::memory_order_release);
+        header_->head = head_;
+        sync(header_, sizeof(Header));
+        flushed_head_ = head_;
+    }
+}
+
+#endif
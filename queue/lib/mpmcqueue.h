@@ -0,0 +1,319 @@
+/**
+ *  @brief      Bounded lock-free multi-producer/multi-consumer queue
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_MPMCQUEUE_H_
+#define _INCLUDE_MPMCQUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+/*
+ * @brief  The MPMC ring buffer queue class
+ *
+ * Every slot of the power-of-two ring carries a sequence number that
+ * tells whether it is ready to be written for a given enqueue position
+ * or ready to be read for a given dequeue position (D. Vyukov's bounded
+ * MPMC queue). Producers and consumers claim positions with a single
+ * CAS on the enqueue/dequeue counters and never take a lock.
+ *
+ * Since another consumer may take the front item at any moment, front
+ * and pop are fused into pop(val), which moves the item out.
+ * push and pop spin (yielding) while the queue is full or empty; the
+ * try_ variants return false instead.
+ *
+ * A position is claimed before the item is copied or moved, so an
+ * exception from T's constructor or assignment still hands the slot
+ * on, and never stalls the threads reaching it later: a push which
+ * throws marks its slot empty, and the pop claiming that slot skips
+ * it; a pop whose assignment throws destroys the item, frees the slot
+ * and rethrows, losing that item. Until skipped, empty slots count in
+ * size().
+ *
+ * The requested capacity is rounded up to the next power of two.
+ */
+template < typename T >
+class MpmcQueue {
+ private:
+    typedef std::size_t size_type;
+    static const size_type kCacheLine = 64;
+
+    struct Cell {
+        std::atomic<size_type> sequence;
+        bool filled;  /// false if the push of this slot threw
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+        T* item() { return reinterpret_cast<T*>(&storage); }
+    };
+
+    alignas(kCacheLine) Cell* cells_;
+    size_type mask_;
+    alignas(kCacheLine) std::atomic<size_type> enqueue_pos_;
+    alignas(kCacheLine) std::atomic<size_type> dequeue_pos_;
+
+    MpmcQueue(const MpmcQueue&);
+    MpmcQueue& operator=(const MpmcQueue&);
+
+    Cell* claim_enqueue();
+    Cell* claim_dequeue(size_type& pos);
+    template < typename U >
+    bool emplace(U&& val);
+
+ public:
+    explicit MpmcQueue(size_type capacity);
+    ~MpmcQueue();
+    bool empty() const;
+    size_type size() const;
+    size_type capacity() const;
+    void push(const T& val);
+    void push(T&& val);
+    void pop(T& val);
+    bool try_push(const T& val);
+    bool try_push(T&& val);
+    bool try_pop(T& val);
+};
+
+/*
+ * @brief        Constructor, allocates the ring
+ * @param        Minimum number of items the queue can hold
+ * @throws       runtime_error if no power of two holds capacity items
+ */
+template < typename T >
+MpmcQueue<T>::MpmcQueue(size_type capacity)
+    : cells_(0), mask_(0), enqueue_pos_(0), dequeue_pos_(0) {
+    if (capacity > (~size_type(0) >> 1) + 1) {
+        throw std::runtime_error("MpmcQueue capacity too large");
+    }
+    size_type rounded = 2;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    mask_ = rounded - 1;
+    cells_ = new Cell[rounded];
+    for (size_type i = 0; i < rounded; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+/*
+ * @brief        Destructor, destroys remaining items and frees the ring
+ */
+template < typename T >
+MpmcQueue<T>::~MpmcQueue() {
+    size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+    size_type end = enqueue_pos_.load(std::memory_order_relaxed);
+    for (; pos != end; ++pos) {
+        if (cells_[pos & mask_].filled) {
+            cells_[pos & mask_].item()->~T();
+        }
+    }
+    delete[] cells_;
+}
+
+/*
+ * @brief        Test whether queue is empty
+ * @param        None
+ * @return       true if queue empty at the time of the call
+ */
+template < typename T >
+bool MpmcQueue<T>::empty() const {
+    return size() == 0;
+}
+
+/*
+ * @brief        Get approximate size of queue, i.e. no. of items
+ * @param        None
+ * @return       The number of claimed but not yet popped positions
+ */
+template < typename T >
+typename MpmcQueue<T>::size_type MpmcQueue<T>::size() const {
+    size_type tail = enqueue_pos_.load(std::memory_order_acquire);
+    size_type head = dequeue_pos_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+}
+
+/*
+ * @brief        Get the fixed capacity of the ring
+ * @param        None
+ * @return       The maximum number of items the queue can hold
+ */
+template < typename T >
+typename MpmcQueue<T>::size_type MpmcQueue<T>::capacity() const {
+    return mask_ + 1;
+}
+
+/*
+ * @brief        Claim the next free enqueue position
+ * @param        None
+ * @return       The claimed cell, or null if the queue is full
+ */
+template < typename T >
+typename MpmcQueue<T>::Cell* MpmcQueue<T>::claim_enqueue() {
+    size_type pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell* cell = &cells_[pos & mask_];
+        size_type seq = cell->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t dif = static_cast<std::ptrdiff_t>(seq - pos);
+        if (dif == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                   std::memory_order_relaxed)) {
+                return cell;
+            }
+        } else if (dif < 0) {
+            return 0;
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/*
+ * @brief        Claim the next filled dequeue position
+ * @param        Set to the claimed position
+ * @return       The claimed cell, or null if the queue is empty
+ */
+template < typename T >
+typename MpmcQueue<T>::Cell* MpmcQueue<T>::claim_dequeue(size_type& pos) {
+    pos = dequeue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell* cell = &cells_[pos & mask_];
+        size_type seq = cell->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t dif = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+        if (dif == 0) {
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                   std::memory_order_relaxed)) {
+                return cell;
+            }
+        } else if (dif < 0) {
+            return 0;
+        } else {
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/*
+ * @brief        Add a new item at end of queue, waits while full
+ * @param        The item
+ * @return       Nothing
+ */
+template < typename T >
+void MpmcQueue<T>::push(const T& val) {
+    while (!try_push(val)) {
+        std::this_thread::yield();
+    }
+}
+
+/*
+ * @brief        Move a new item to end of queue, waits while full
+ * @param        The item
+ * @return       Nothing
+ */
+template < typename T >
+void MpmcQueue<T>::push(T&& val) {
+    while (!try_push(std::move(val))) {
+        std::this_thread::yield();
+    }
+}
+
+/*
+ * @brief        Move the front item out of queue, waits while empty
+ * @param        Destination of the item
+ * @return       Nothing
+ */
+template < typename T >
+void MpmcQueue<T>::pop(T& val) {
+    while (!try_pop(val)) {
+        std::this_thread::yield();
+    }
+}
+
+/*
+ * @brief        Construct an item in the next free slot
+ * @param        The item, copied or moved
+ * @return       false if the queue is full
+ * @throws       what T's constructor throws, after publishing the slot
+ *               as empty
+ */
+template < typename T >
+template < typename U >
+bool MpmcQueue<T>::emplace(U&& val) {
+    Cell* cell = claim_enqueue();
+    if (!cell) {
+        return false;
+    }
+    size_type pos = cell->sequence.load(std::memory_order_relaxed);
+    try {
+        ::new (static_cast<void*>(cell->item())) T(std::forward<U>(val));
+    } catch (...) {
+        cell->filled = false;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        throw;
+    }
+    cell->filled = true;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+/*
+ * @brief        Add a new item at end of queue
+ * @param        The item
+ * @return       false if the queue is full
+ */
+template < typename T >
+bool MpmcQueue<T>::try_push(const T& val) {
+    return emplace(val);
+}
+
+/*
+ * @brief        Move a new item to end of queue
+ * @param        The item
+ * @return       false if the queue is full, val is left untouched
+ */
+template < typename T >
+bool MpmcQueue<T>::try_push(T&& val) {
+    return emplace(std::move(val));
+}
+
+/*
+ * @brief        Move the front item out of queue
+ * @param        Destination of the item
+ * @return       false if the queue is empty
+ * @throws       what T's assignment throws, after dropping the item
+ */
+template < typename T >
+bool MpmcQueue<T>::try_pop(T& val) {
+    for (;;) {
+        size_type pos = 0;
+        Cell* cell = claim_dequeue(pos);
+        if (!cell) {
+            return false;
+        }
+        if (!cell->filled) {
+            cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+            continue;
+        }
+        try {
+            val = std::move(*cell->item());
+        } catch (...) {
+            cell->item()->~T();
+            cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+            throw;
+        }
+        cell->item()->~T();
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+}
+
+#endif
@@ -0,0 +1,659 @@
+/**
+ *  @brief      Multi-stage pipeline of threads linked by bounded queues
+ *              of batches
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_PIPELINE_H_
+#define _INCLUDE_PIPELINE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "queue.h"
+
+/*
+ * @brief  Settings shared by the stages of a pipeline
+ *
+ * batch_bytes sizes the batches: the producer groups that many bytes
+ * of input items, at least one item, so that a batch stays in cache
+ * as it goes from stage to stage. queue_batches bounds each queue
+ * between stages, in batches. ordered makes pop return the items in
+ * the order they were pushed even when stages run several threads.
+ */
+struct PipelineOptions {
+    std::size_t batch_bytes;
+    std::size_t queue_batches;
+    bool ordered;
+
+    PipelineOptions() : batch_bytes(16 * 1024), queue_batches(4), ordered(false) {}
+};
+
+/*
+ * @brief  Counters of one stage, read with Pipeline::stats()
+ *
+ * Times are summed over the threads of the stage; elapsed_ns runs from
+ * the start of the stage until its last thread ends. A bottleneck stage
+ * is busy nearly all of elapsed_ns on every thread while its input
+ * queue stays full; the stages before it are blocked on it and the
+ * ones after it starve. queue describes the stage's input queue, in
+ * batches, with how long batches waited in it.
+ */
+struct StageStats {
+    std::string name;
+    unsigned threads;
+    std::uint64_t items;
+    std::uint64_t batches;
+    std::uint64_t busy_ns;      /// running the stage function
+    std::uint64_t starved_ns;   /// waiting for an input batch
+    std::uint64_t blocked_ns;   /// waiting for room in the output queue
+    std::uint64_t elapsed_ns;   /// since the pipeline started
+    std::size_t queue_depth;    /// batches queued at the time of the call
+    InstrumentationSnapshot queue;
+
+    StageStats()
+        : threads(0), items(0), batches(0), busy_ns(0), starved_ns(0),
+          blocked_ns(0), elapsed_ns(0), queue_depth(0) {}
+
+    double items_per_second() const {
+        return elapsed_ns ? items * 1e9 / elapsed_ns : 0;
+    }
+
+    /// share of the threads' time spent in the stage function
+    double utilization() const {
+        return elapsed_ns ? double(busy_ns) / (double(elapsed_ns) * threads) : 0;
+    }
+};
+
+/*
+ * @brief  The batch channel class, a bounded blocking queue of batches
+ *
+ * Links two stages. It counts its producers and ends once the last of
+ * them is done and the batches are drained. The vectors of consumed
+ * batches are kept and handed back to producers with their next push,
+ * so that batches stop allocating once the pipeline is warm.
+ */
+template < typename T >
+class BatchChannel {
+ public:
+    typedef std::size_t size_type;
+
+    struct Batch {
+        std::uint64_t seq;
+        std::vector<T> items;
+
+        Batch() : seq(0) {}
+    };
+
+ private:
+    mutable std::mutex lock_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    InstrumentedQueue<Batch> batches_;
+    std::vector< std::vector<T> > spares_;
+    size_type capacity_;
+    unsigned producers_;
+
+    BatchChannel(const BatchChannel&);
+    BatchChannel& operator=(const BatchChannel&);
+
+ public:
+    BatchChannel(size_type capacity, unsigned producers)
+        : capacity_(capacity ? capacity : 1), producers_(producers) {}
+
+    /*
+     * @brief        Queue a batch, waiting while the channel is full
+     * @param        The batch, whose items are replaced by an empty
+     *               recycled vector when there is one
+     * @return       Nothing
+     */
+    void push(Batch& batch) {
+        std::unique_lock<std::mutex> guard(lock_);
+        while (batches_.size() >= capacity_) {
+            not_full_.wait(guard);
+        }
+        batches_.push(std::move(batch));
+        batch.items.clear();
+        if (!spares_.empty()) {
+            batch.items.swap(spares_.back());
+            spares_.pop_back();
+        }
+        guard.unlock();
+        not_empty_.notify_one();
+    }
+
+    /*
+     * @brief        Take the front batch, waiting until there is one
+     * @param        Where to move it; the vector it holds is recycled
+     * @return       false once every producer is done and the channel
+     *               is drained
+     */
+    bool pop(Batch& batch) {
+        std::unique_lock<std::mutex> guard(lock_);
+        if (batch.items.capacity() && spares_.size() < capacity_) {
+            batch.items.clear();
+            spares_.push_back(std::move(batch.items));
+        }
+        while (batches_.empty() && producers_ > 0) {
+            not_empty_.wait(guard);
+        }
+        if (batches_.empty()) {
+            return false;
+        }
+        batch = batches_.pop_value();
+        guard.unlock();
+        not_full_.notify_one();
+        return true;
+    }
+
+    /*
+     * @brief        Record that a producer will push no more, ending the
+     *               channel after the last one
+     */
+    void producer_done() {
+        std::unique_lock<std::mutex> guard(lock_);
+        if (--producers_ == 0) {
+            guard.unlock();
+            not_empty_.notify_all();
+        }
+    }
+
+    size_type size() const {
+        std::lock_guard<std::mutex> guard(lock_);
+        return batches_.size();
+    }
+
+    InstrumentationSnapshot stats() const {
+        return batches_.stats();
+    }
+};
+
+/*
+ * @brief  A stage of a pipeline, whatever its item types
+ */
+class PipelineStage {
+ public:
+    virtual ~PipelineStage() {}
+    virtual void start() = 0;
+    virtual void join() = 0;
+    virtual StageStats stats() const = 0;
+};
+
+/*
+ * @brief  The stage class running F on every item from In to Out
+ *
+ * Each thread takes a batch from the input channel, applies its own
+ * copy of F to every item and pushes the results as one batch, with
+ * the input batch's sequence number, to the output channel.
+ */
+template < typename In, typename Out, typename F >
+class PipelineStageOf : public PipelineStage {
+ private:
+    typedef std::chrono::steady_clock clock;
+
+    std::string name_;
+    unsigned threads_;
+    F f_;
+    std::shared_ptr< BatchChannel<In> > in_;
+    std::shared_ptr< BatchChannel<Out> > out_;
+    std::vector<std::thread> workers_;
+    std::atomic<std::uint64_t> items_;
+    std::atomic<std::uint64_t> batches_;
+    std::atomic<std::uint64_t> busy_ns_;
+    std::atomic<std::uint64_t> starved_ns_;
+    std::atomic<std::uint64_t> blocked_ns_;
+    std::atomic<unsigned> running_;
+    std::atomic<std::uint64_t> finished_ns_;  /// 0 until the last thread ends
+    std::atomic<clock::rep> started_at_;      /// 0 until started
+
+    static std::uint64_t ns(clock::duration d) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    }
+
+    std::uint64_t since_start() const {
+        return ns(clock::now().time_since_epoch() -
+                  clock::duration(started_at_.load()));
+    }
+
+    void work() {
+        F f(f_);
+        typename BatchChannel<In>::Batch in;
+        typename BatchChannel<Out>::Batch out;
+        clock::time_point waited = clock::now();
+        while (in_->pop(in)) {
+            clock::time_point took = clock::now();
+            out.seq = in.seq;
+            out.items.reserve(in.items.size());
+            for (In& item : in.items) {
+                out.items.push_back(f(std::move(item)));
+            }
+            std::size_t n = in.items.size();
+            clock::time_point ran = clock::now();
+            out_->push(out);
+            clock::time_point pushed = clock::now();
+            items_.fetch_add(n, std::memory_order_relaxed);
+            batches_.fetch_add(1, std::memory_order_relaxed);
+            starved_ns_.fetch_add(ns(took - waited), std::memory_order_relaxed);
+            busy_ns_.fetch_add(ns(ran - took), std::memory_order_relaxed);
+            blocked_ns_.fetch_add(ns(pushed - ran), std::memory_order_relaxed);
+            waited = pushed;
+        }
+        if (running_.fetch_sub(1) == 1) {
+            finished_ns_.store(since_start());
+        }
+        out_->producer_done();
+    }
+
+ public:
+    PipelineStageOf(const std::string& name, unsigned threads, F f,
+                    std::shared_ptr< BatchChannel<In> > in,
+                    std::shared_ptr< BatchChannel<Out> > out)
+        : name_(name), threads_(threads), f_(std::move(f)), in_(in), out_(out),
+          items_(0), batches_(0), busy_ns_(0), starved_ns_(0), blocked_ns_(0),
+          running_(0), finished_ns_(0), started_at_(0) {}
+
+    void start() {
+        running_ = threads_;
+        started_at_ = clock::now().time_since_epoch().count();
+        for (unsigned i = 0; i < threads_; ++i) {
+            workers_.push_back(std::thread(&PipelineStageOf::work, this));
+        }
+    }
+
+    void join() {
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+        workers_.clear();
+    }
+
+    StageStats stats() const {
+        StageStats s;
+        s.name = name_;
+        s.threads = threads_;
+        s.items = items_.load(std::memory_order_relaxed);
+        s.batches = batches_.load(std::memory_order_relaxed);
+        s.busy_ns = busy_ns_.load(std::memory_order_relaxed);
+        s.starved_ns = starved_ns_.load(std::memory_order_relaxed);
+        s.blocked_ns = blocked_ns_.load(std::memory_order_relaxed);
+        if (started_at_.load()) {
+            std::uint64_t finished = finished_ns_.load();
+            s.elapsed_ns = finished ? finished : since_start();
+        }
+        s.queue_depth = in_->size();
+        s.queue = in_->stats();
+        return s;
+    }
+};
+
+/*
+ * @brief  The pipeline class
+ *
+ * Chains stages, each a function run on every item by its own threads,
+ * with bounded queues in between:
+ *
+ *     Pipeline<std::string>()
+ *         .stage("parse", 2, parse)
+ *         .stage("enrich", 4, enrich)
+ *         .stage("serialize", 1, serialize)
+ *
+ * makes a Pipeline<std::string, R>, R being what serialize returns.
+ * Each stage() consumes the pipeline it is called on. Stage functions
+ * take an item by value or reference and return one item; each thread
+ * runs a copy. An exception escaping one ends the program, as with any
+ * thread.
+ *
+ * push groups items into batches of batch_bytes, and only the batch
+ * moves through the queues, so the locking and waking cost is paid
+ * once per batch rather than once per item. A full queue blocks the
+ * stage pushing to it, and in the end push itself: backpressure.
+ * flush sends a partial batch early; close sends the last one and
+ * lets the stages finish. The threads start with the first push or
+ * pop, or start().
+ *
+ * pop returns the results, an empty optional once the pipeline is
+ * closed and drained. Batches leave a stage of several threads in the
+ * order they finish; with ordered set, pop puts them back in the order
+ * they were pushed.
+ *
+ * push, flush and close must be called from one thread, and pop from
+ * one thread, which should be another one unless everything pushed
+ * fits in the queues. stats() may be called from any thread, at any
+ * time. The destructor closes the pipeline, discards the results not
+ * popped and joins the threads.
+ */
+template < typename In, typename Out = In >
+class Pipeline {
+ private:
+    template < typename, typename > friend class Pipeline;
+
+    typedef std::chrono::steady_clock clock;
+    typedef typename BatchChannel<In>::Batch InBatch;
+    typedef typename BatchChannel<Out>::Batch OutBatch;
+
+    PipelineOptions options_;
+    std::size_t batch_items_;
+    std::vector< std::unique_ptr<PipelineStage> > stages_;
+    std::shared_ptr< BatchChannel<In> > input_;
+    std::shared_ptr< BatchChannel<Out> > output_;
+    InBatch pending_;
+    std::uint64_t next_seq_;
+    OutBatch current_;
+    std::size_t cursor_;
+    std::map< std::uint64_t, std::vector<Out> > reorder_;
+    std::uint64_t expected_seq_;
+    std::once_flag start_once_;
+    std::atomic<bool> started_;
+    bool closed_;
+
+    Pipeline(const Pipeline&);
+    Pipeline& operator=(const Pipeline&);
+
+    Pipeline(const PipelineOptions& options, std::size_t batch_items);
+
+    bool next_batch();
+
+ public:
+    explicit Pipeline(const PipelineOptions& options = PipelineOptions());
+    Pipeline(Pipeline&& other);
+    Pipeline& operator=(Pipeline&& other);
+    ~Pipeline();
+
+    template < typename F >
+    Pipeline<In, typename std::decay<
+        typename std::invoke_result<F&, Out&&>::type>::type>
+    stage(const std::string& name, unsigned threads, F f) &&;
+
+    void start();
+    void push(const In& val);
+    void push(In&& val);
+    void flush();
+    void close();
+    std::optional<Out> pop();
+    std::vector<StageStats> stats() const;
+    InstrumentationSnapshot output_stats() const;
+};
+
+/*
+ * @brief        Constructor, a pipeline without stages yet
+ * @param        The batch and queue settings of all stages
+ */
+template < typename In, typename Out >
+Pipeline<In, Out>::Pipeline(const PipelineOptions& options)
+    : options_(options),
+      batch_items_(std::max<std::size_t>(1, options.batch_bytes / sizeof(In))),
+      next_seq_(0), cursor_(0), expected_seq_(0), started_(false),
+      closed_(false) {
+    static_assert(std::is_same<In, Out>::value,
+                  "a pipeline without stages outputs its input");
+    input_ = std::make_shared< BatchChannel<In> >(options.queue_batches, 1);
+    output_ = input_;
+}
+
+/*
+ * @brief        Constructor of the pipeline stage() returns, whose
+ *               stages and channels it then fills in
+ */
+template < typename In, typename Out >
+Pipeline<In, Out>::Pipeline(const PipelineOptions& options,
+                            std::size_t batch_items)
+    : options_(options), batch_items_(batch_items), next_seq_(0), cursor_(0),
+      expected_seq_(0), started_(false), closed_(false) {
+}
+
+/*
+ * @brief        Move constructor, for a pipeline not started yet
+ * @throws       runtime_error - if other was started
+ */
+template < typename In, typename Out >
+Pipeline<In, Out>::Pipeline(Pipeline&& other)
+    : options_(other.options_), batch_items_(other.batch_items_),
+      stages_(std::move(other.stages_)), input_(std::move(other.input_)),
+      output_(std::move(other.output_)), next_seq_(0), cursor_(0),
+      expected_seq_(0), started_(false), closed_(false) {
+    if (other.started_) {
+        other.stages_.swap(stages_);
+        other.input_.swap(input_);
+        other.output_.swap(output_);
+        throw std::runtime_error("Pipeline started");
+    }
+}
+
+/*
+ * @brief        Move assignment, for pipelines not started yet, so that
+ *               stages can be added in a loop
+ * @param        The pipeline to take over
+ * @return       Reference to this pipeline
+ * @throws       runtime_error - if either was started
+ */
+template < typename In, typename Out >
+Pipeline<In, Out>& Pipeline<In, Out>::operator=(Pipeline&& other) {
+    if (started_ || other.started_) {
+        throw std::runtime_error("Pipeline started");
+    }
+    std::swap(options_, other.options_);
+    std::swap(batch_items_, other.batch_items_);
+    stages_.swap(other.stages_);
+    input_.swap(other.input_);
+    output_.swap(other.output_);
+    return *this;
+}
+
+/*
+ * @brief        Destructor, closes the pipeline, discards the results
+ *               left and joins the threads
+ */
+template < typename In, typename Out >
+Pipeline<In, Out>::~Pipeline() {
+    if (!started_) {
+        return;
+    }
+    if (!closed_) {
+        pending_.items.clear();
+        closed_ = true;
+        input_->producer_done();
+    }
+    OutBatch discard;
+    while (output_->pop(discard)) {
+    }
+    for (std::unique_ptr<PipelineStage>& s : stages_) {
+        s->join();
+    }
+}
+
+/*
+ * @brief        Append a stage to the pipeline
+ * @param        The name shown in stats, the no. of threads, and the
+ *               function applied to every item
+ * @return       The pipeline with the stage, taking over this one
+ * @throws       runtime_error - if the pipeline was started
+ */
+template < typename In, typename Out >
+template < typename F >
+Pipeline<In, typename std::decay<
+    typename std::invoke_result<F&, Out&&>::type>::type>
+Pipeline<In, Out>::stage(const std::string& name, unsigned threads, F f) && {
+    typedef typename std::decay<
+        typename std::invoke_result<F&, Out&&>::type>::type R;
+    if (started_) {
+        throw std::runtime_error("Pipeline started");
+    }
+    if (threads == 0) {
+        throw std::runtime_error("Pipeline stage needs a thread");
+    }
+    std::shared_ptr< BatchChannel<R> > out =
+        std::make_shared< BatchChannel<R> >(options_.queue_batches, threads);
+    std::unique_ptr<PipelineStage> s(new PipelineStageOf<Out, R, F>(
+        name, threads, std::move(f), output_, out));
+
+    Pipeline<In, R> next(options_, batch_items_);
+    next.stages_ = std::move(stages_);
+    next.stages_.push_back(std::move(s));
+    next.input_ = std::move(input_);
+    next.output_ = out;
+    return next;
+}
+
+/*
+ * @brief        Start the threads of every stage
+ * @param        None
+ * @return       Nothing
+ */
+template < typename In, typename Out >
+void Pipeline<In, Out>::start() {
+    /// the producer and the consumer thread may both get here first
+    std::call_once(start_once_, [this] {
+        for (std::unique_ptr<PipelineStage>& s : stages_) {
+            s->start();
+        }
+        started_ = true;
+    });
+}
+
+/*
+ * @brief        Add an item to the current batch, sending it once full
+ * @param        The item
+ * @return       Nothing
+ * @throws       runtime_error - if the pipeline was closed
+ */
+template < typename In, typename Out >
+void Pipeline<In, Out>::push(const In& val) {
+    In copy(val);
+    push(std::move(copy));
+}
+
+template < typename In, typename Out >
+void Pipeline<In, Out>::push(In&& val) {
+    if (closed_) {
+        throw std::runtime_error("Queue closed");
+    }
+    start();
+    if (pending_.items.capacity() < batch_items_) {
+        pending_.items.reserve(batch_items_);
+    }
+    pending_.items.push_back(std::move(val));
+    if (pending_.items.size() >= batch_items_) {
+        flush();
+    }
+}
+
+/*
+ * @brief        Send the current batch even if not full
+ * @param        None
+ * @return       Nothing
+ */
+template < typename In, typename Out >
+void Pipeline<In, Out>::flush() {
+    if (pending_.items.empty()) {
+        return;
+    }
+    start();
+    pending_.seq = next_seq_++;
+    input_->push(pending_);
+}
+
+/*
+ * @brief        Send the last batch and let the stages finish
+ * @param        None
+ * @return       Nothing
+ */
+template < typename In, typename Out >
+void Pipeline<In, Out>::close() {
+    if (closed_) {
+        return;
+    }
+    flush();
+    start();
+    closed_ = true;
+    input_->producer_done();
+}
+
+/*
+ * @brief        Make the next batch of results current
+ * @param        None
+ * @return       false once the pipeline is closed and drained
+ */
+template < typename In, typename Out >
+bool Pipeline<In, Out>::next_batch() {
+    cursor_ = 0;
+    if (!options_.ordered) {
+        return output_->pop(current_);
+    }
+    typename std::map< std::uint64_t, std::vector<Out> >::iterator early;
+    while ((early = reorder_.find(expected_seq_)) == reorder_.end()) {
+        if (!output_->pop(current_)) {
+            return false;
+        }
+        if (current_.seq == expected_seq_) {
+            ++expected_seq_;
+            return true;
+        }
+        reorder_[current_.seq].swap(current_.items);
+    }
+    current_.items.swap(early->second);
+    reorder_.erase(early);
+    ++expected_seq_;
+    return true;
+}
+
+/*
+ * @brief        Take the next result, waiting for it
+ * @param        None
+ * @return       The result, or an empty optional once the pipeline is
+ *               closed and drained
+ */
+template < typename In, typename Out >
+std::optional<Out> Pipeline<In, Out>::pop() {
+    start();
+    while (cursor_ == current_.items.size()) {
+        if (!next_batch()) {
+            return std::nullopt;
+        }
+    }
+    return std::move(current_.items[cursor_++]);
+}
+
+/*
+ * @brief        Read the counters of every stage, in order
+ * @param        None
+ * @return       The counters
+ */
+template < typename In, typename Out >
+std::vector<StageStats> Pipeline<In, Out>::stats() const {
+    std::vector<StageStats> all;
+    for (const std::unique_ptr<PipelineStage>& s : stages_) {
+        all.push_back(s->stats());
+    }
+    return all;
+}
+
+/*
+ * @brief        Read the counters of the queue of results
+ * @param        None
+ * @return       The counters, in batches
+ */
+template < typename In, typename Out >
+InstrumentationSnapshot Pipeline<In, Out>::output_stats() const {
+    return output_->stats();
+}
+
+#endif
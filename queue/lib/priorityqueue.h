@@ -0,0 +1,504 @@
+/**
+ *  @brief      Priority queue on a d-ary heap, with optional handles
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_PRIORITYQUEUE_H_
+#define _INCLUDE_PRIORITYQUEUE_H_
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "containertraits.h"
+
+/*
+ * @brief  The handle policy that tracks nothing
+ *
+ * The default policy of PriorityQueue: push returns 0 and decrease_key
+ * is not available. It is an empty base class and compiles away.
+ */
+struct NoHeapHandles {
+    static const bool tracked = false;
+
+    std::size_t added(std::size_t) { return 0; }
+    std::size_t id_at(std::size_t) const { return 0; }
+    void place(std::size_t, std::size_t) {}
+    void released(std::size_t) {}
+    void truncated(std::size_t) {}
+    void clear() {}
+};
+
+/*
+ * @brief  The handle policy that tracks where every item is
+ *
+ * Gives each item a handle when it is pushed, valid until the item is
+ * popped, after which the handle is reused. Keeps the handle of every
+ * heap slot and the slot of every handle, and updates both as items
+ * move, so that decrease_key can find an item in O(1).
+ */
+class TrackedHeapHandles {
+ private:
+    std::vector<std::size_t> id_at_;    /// heap slot to handle
+    std::vector<std::size_t> slot_of_;  /// handle to heap slot
+    std::vector<std::size_t> free_;     /// handles of popped items
+
+ public:
+    static const bool tracked = true;
+
+    std::size_t added(std::size_t slot) {
+        std::size_t id = slot_of_.size();
+        if (free_.empty()) {
+            slot_of_.push_back(slot);
+        } else {
+            id = free_.back();
+            free_.pop_back();
+        }
+        id_at_.resize(slot + 1);
+        place(slot, id);
+        return id;
+    }
+
+    std::size_t id_at(std::size_t slot) const { return id_at_[slot]; }
+
+    void place(std::size_t slot, std::size_t id) {
+        id_at_[slot] = id;
+        slot_of_[id] = slot;
+    }
+
+    void released(std::size_t id) { free_.push_back(id); }
+    void truncated(std::size_t size) { id_at_.resize(size); }
+    std::size_t slot_of(std::size_t id) const { return slot_of_[id]; }
+
+    void clear() {
+        id_at_.clear();
+        slot_of_.clear();
+        free_.clear();
+    }
+};
+
+/*
+ * @brief  The priority queue implementation class
+ *
+ * Keeps its items in a d-ary heap laid out in a random access
+ * container, so that top is O(1) and push and pop are O(log n). Like
+ * std::priority_queue, top is the item which is not less than any
+ * other according to Compare: the largest with the default std::less,
+ * the smallest with std::greater.
+ *
+ * The default Arity of 4 halves the depth of a binary heap, and the
+ * four children of an item are adjacent, often on one cache line, so
+ * pop touches fewer lines on large heaps; BinaryHeap selects Arity 2.
+ * The underlying container shall support the following operations:
+ *        empty
+ *        size
+ *        operator[]
+ *        back
+ *        push_back
+ *        pop_back
+ *        emplace_back (only if emplace is used)
+ *
+ * The suitable standard container classes are: vector and deque.
+ *
+ * heapify adds a range of items and rebuilds the heap bottom-up, in
+ * O(n) rather than the O(n log n) of pushing them one by one.
+ *
+ * With the TrackedHeapHandles policy (see IndexedPriorityQueue) push
+ * and emplace return a handle to the item, which decrease_key takes to
+ * move the item up; with the default NoHeapHandles they return 0.
+ */
+template < typename T, typename Compare = std::less<T>,
+           typename Container = std::vector<T>, std::size_t Arity = 4,
+           typename Handles = NoHeapHandles >
+class PriorityQueue : private Handles {
+    static_assert(Arity >= 2, "A heap needs at least two children per item");
+
+ private:
+    typedef std::size_t size_type;
+    Container items_;
+    Compare comp_;
+
+    void sift_up(size_type hole, T val, size_type id);
+    void sift_down(size_type hole, T val, size_type id);
+    void rebuild();
+
+ public:
+    typedef std::size_t handle_type;
+
+    PriorityQueue();
+    explicit PriorityQueue(const Compare& comp);
+    template < typename InputIterator >
+    PriorityQueue(InputIterator first, InputIterator last,
+                  const Compare& comp = Compare());
+    bool empty() const;
+    size_type size() const;
+    const T& top() const;
+    handle_type push(const T& val);
+    handle_type push(T&& val);
+    template < typename... Args >
+    handle_type emplace(Args&&... args);
+    void pop();
+    T pop_value();
+    std::optional<T> try_pop();
+    template < typename InputIterator >
+    void heapify(InputIterator first, InputIterator last);
+    void decrease_key(handle_type handle, const T& val);
+    void decrease_key(handle_type handle, T&& val);
+    void clear();
+    void swap(PriorityQueue& other);
+};
+
+/*
+ * @brief        Move an item up from a hole until its parent ranks higher
+ * @param        The hole, the item and its handle
+ * @return       Nothing
+ */
+template < typename T, typename Compare, typename Container,
+           std::size_t Arity, typename Handles >
+void PriorityQueue<T, Compare, Container, Arity, Handles>::sift_up(
+        size_type hole, T val, size_type id) {
+    while (hole > 0) {
+        size_type parent = (hole - 1) / Arity;
+        if (!comp_(items_[parent], val)) {
+            break;
+        }
+        items_[hole] = std::move(items_[parent]);
+        Handles::place(hole, Handles::id_at(parent));
+        hole = parent;
+    }
+    items_[hole] = std::move(val);
+    Handles::place(hole, id);
+}
+
+/*
+ * @brief        Move an item down from a hole until no child ranks higher
+ * @param        The hole, the item and its handle
+ * @return       Nothing
+ */
+template < typename T, typename Compare, typename Container,
+           std::size_t Arity, typename Handles >
+void PriorityQueue<T, Compare, Container, Arity, Handles>::sift_down(
+        size_type hole, T val, size_type id) {
+    const size_type n = items_.size();
+    for (;;) {
+        size_type first = hole * Arity + 1;
+        if (first >= n) {
+            break;
+        }
+        size_type last = first + Arity < n ? first + Arity : n;
+        size_type best = first;
+        for (size_type child = first + 1; child < last; ++child) {
+            best = comp_(items_[best], items_[child]) ? child : best;
+        }
+        if (!comp_(val, items_[best])) {
+            break;
+        }
+        items_[hole] = std::move(items_[best]);
+        Handles::place(hole, Handles::id_at(best));
+        hole = best;
+    }
+    items_[hole] = std::move(val);
+    Handles::place(hole, id);
+}
+
+/*
+ * @brief        Restore the heap order of all items, bottom-up
+ * @param        None
+ * @return       Nothing
+ */
+template < typename T, typename Compare, typename Container,
+           std::size_t Arity, typename Handles >
+void PriorityQueue<T, Compare, Container, Arity, Handles>::rebuild() {
+    const size_type n = items_.size();
+    if (n < 2) {
+        return;
+    }
+    for (size_type i = (n - 2) / Arity + 1; i-- > 0;) {
+        sift_down(i, std::move(items_[i]), Handles::id_at(i));
+    }
+}
+
+/*
+ * @brief        Default constructor
+ */
+template < typename T, typename Compare, typename Container,
+           std::size_t Arity, typename Handles >
+PriorityQueue<T, Compare, Container, Arity, Handles>::PriorityQueue() {
+}
+
+/*
+ * @brief        Constructor with a comparison object
+ * @param        The comparison object
+ */
+template < typename T, typename Compare, typename Container,
+           std::size_t Arity, typename Handles >
+PriorityQueue<T, Compare, Container, Arity, Handles>::PriorityQueue(
+        const Compare& comp)
+    : comp_(comp) {
+}
+
+/*
+ * @brief        Constructor building the heap from a range in O(n)
+ * @param        Iterators to the first and past the last item, and the
+ *               comparison object
+ */
+template < typename T, typename Compare, typename Container,
+           std::size_t Arity, typename Handles >
+template < typename InputIterator >
+PriorityQueue<T, Compare, Container, Arity, Handles>::PriorityQueue(
+        InputIterator first, InputIterator last, const Compare& comp)
+    : comp_(comp) {
+    heapify(first, last);
+}
+
+/*
+ * @brief        Test whether priority queue is empty
+ * @param        None
+ * @return       true if priority queue empty, false otherwise
+ */
+template < typename T, typename Compare, typename Container,
+           std::size_t Arity, typename Handles >
+bool PriorityQueue<T, Compare, Container, Arity, Handles>::empty() const {
+    return items_.empty();
+}
+
+/*
+ * @brief        Get size of priority queue, i.e. no. of items
+ * @param        None
+ * @return       The number of items
+ */
+template < typename T, typename Compare, typename Container,
+           std::size_t Arity, typename Handles >
+typename PriorityQueue<T, Compare, Container, Arity, Handles>::size_type
+PriorityQueue<T, Compare, Container, Arity, Handles>::size() const {
+    return items_.size();
+}
+
+/*
+ * @brief        Access the item of highest priority
+ * @param        None
+ * @return       Reference to the top item
+ * @throws       runtime_error if priority queue is empty
+ */
+template < typename T, typename Compare, typename Container,
+           std::size_t Arity, typename Handles >
+const T& PriorityQueue<T, Compare, Container, Arity, Handles>::top() const {
+    if (items_.empty()) {
+        throw std::runtime_error("PriorityQueue empty");
+    }
+    return items_[0];
+}
+
+/*
+ * @brief        Add a new item
+ * @param        The item
+ * @return       The handle of the item, 0 if handles are not tracked
+ */
+template < typename T, typename Compare, typename Container,
+           std::size_t Arity, typename Handles >
+typename PriorityQueue<T, Compare, Container, Arity, Handles>::handle_type
+PriorityQueue<T, Compare, Container, Arity, Handles>::push(const T& val) {
+    return emplace(val);
+}
+
+/*
+ * @brief        Move a new item in
+ * @param        The item
+ * @return       The handle of the item, 0 if handles are not tracked
+ */
+template < typename T, typename Compare, typename Container,
+           std::size_t Arity, typename Handles >
+typename PriorityQueue<T, Compare, Container, Arity, Handles>::handle_type
+PriorityQueue<T, Compare, Container, Arity, Handles>::push(T&& val) {
+    return emplace(std::move(val));
+}
+
+/*
+ * @brief        Construct a new item in place
+ * @param        Arguments forwarded to the constructor of T
+ * @return       The handle of the item, 0 if handles are not tracked
+ */
+template < typename T, typename Compare, typename Container,
+           std::size_t Arity, typename Handles >
+template < typename... Args >
+typename PriorityQueue<T, Compare, Container, Arity, Handles>::handle_type
+PriorityQueue<T, Compare, Container, Arity, Handles>::emplace(Args&&... args) {
+    items_.emplace_back(std::forward<Args>(args)...);
+    size_type slot = items_.size() - 1;
+    size_type id = Handles::added(slot);
+    sift_up(slot, std::move(items_[slot]), id);
+    return id;
+}
+
+/*
+ * @brief        Delete the item of highest priority
+ * @param        None
+ * @return       Nothing
+ * @throws       runtime_error if priority queue is empty
+ */
+template < typename T, typename Compare, typename Container,
+           std::size_t Arity, typename Handles >
+void PriorityQueue<T, Compare, Container, Arity, Handles>::pop() {
+    if (items_.empty()) {
+        throw std::runtime_error("PriorityQueue empty");
+    }
+    Handles::released(Handles::id_at(0));
+    size_type last = items_.size() - 1;
+    size_type id = Handles::id_at(last);
+    T val(std::move(items_.back()));
+    items_.pop_back();
+    Handles::truncated(last);
+    if (last > 0) {
+        sift_down(0, std::move(val), id);
+    }
+}
+
+/*
+ * @brief        Move the item of highest priority out and delete it
+ * @param        None
+ * @return       The top item
+ * @throws       runtime_error if priority queue is empty
+ */
+template < typename T, typename Compare, typename Container,
+           std::size_t Arity, typename Handles >
+T PriorityQueue<T, Compare, Container, Arity, Handles>::pop_value() {
+    if (items_.empty()) {
+        throw std::runtime_error("PriorityQueue empty");
+    }
+    T val(std::move(items_[0]));
+    pop();
+    return val;
+}
+
+/*
+ * @brief        Move the item of highest priority out, if any, and
+ *               delete it
+ * @param        None
+ * @return       The top item, or an empty optional if empty
+ */
+template < typename T, typename Compare, typename Container,
+           std::size_t Arity, typename Handles >
+std::optional<T> PriorityQueue<T, Compare, Container, Arity, Handles>::try_pop() {
+    if (items_.empty()) {
+        return std::nullopt;
+    }
+    std::optional<T> val(std::move(items_[0]));
+    pop();
+    return val;
+}
+
+/*
+ * @brief        Add a range of items and rebuild the heap in O(n)
+ * @param        Iterators to the first and past the last item
+ * @return       Nothing
+ *
+ * Tracked handles are given to the new items but not returned.
+ */
+template < typename T, typename Compare, typename Container,
+           std::size_t Arity, typename Handles >
+template < typename InputIterator >
+void PriorityQueue<T, Compare, Container, Arity, Handles>::heapify(
+        InputIterator first, InputIterator last) {
+    size_type before = items_.size();
+    ContainerBulk<Container>::append(items_, first, last);
+    for (size_type slot = before; slot < items_.size(); ++slot) {
+        Handles::added(slot);
+    }
+    rebuild();
+}
+
+/*
+ * @brief        Replace an item by one which ranks at least as high,
+ *               e.g. a smaller key with std::greater
+ * @param        The handle of the item, and its new value
+ * @return       Nothing
+ */
+template < typename T, typename Compare, typename Container,
+           std::size_t Arity, typename Handles >
+void PriorityQueue<T, Compare, Container, Arity, Handles>::decrease_key(
+        handle_type handle, const T& val) {
+    decrease_key(handle, T(val));
+}
+
+/*
+ * @brief        Replace an item by one which ranks at least as high,
+ *               moving the new value in
+ * @param        The handle of the item, and its new value
+ * @return       Nothing
+ */
+template < typename T, typename Compare, typename Container,
+           std::size_t Arity, typename Handles >
+void PriorityQueue<T, Compare, Container, Arity, Handles>::decrease_key(
+        handle_type handle, T&& val) {
+    static_assert(Handles::tracked,
+                  "decrease_key needs the TrackedHeapHandles policy");
+    size_type slot = Handles::slot_of(handle);
+    assert(!comp_(val, items_[slot]) && "decrease_key lowered the priority");
+    sift_up(slot, std::move(val), handle);
+}
+
+/*
+ * @brief        Delete all items; every handle becomes invalid
+ * @param        None
+ * @return       Nothing
+ */
+template < typename T, typename Compare, typename Container,
+           std::size_t Arity, typename Handles >
+void PriorityQueue<T, Compare, Container, Arity, Handles>::clear() {
+    items_.clear();
+    Handles::clear();
+}
+
+/*
+ * @brief        Exchange the contents of two priority queues; handles
+ *               follow their items
+ * @param        The other priority queue
+ * @return       Nothing
+ */
+template < typename T, typename Compare, typename Container,
+           std::size_t Arity, typename Handles >
+void PriorityQueue<T, Compare, Container, Arity, Handles>::swap(
+        PriorityQueue& other) {
+    using std::swap;
+    swap(items_, other.items_);
+    swap(comp_, other.comp_);
+    swap(static_cast<Handles&>(*this), static_cast<Handles&>(other));
+}
+
+/*
+ * @brief        Exchange the contents of two priority queues, found
+ *               through ADL
+ * @param        Two priority queue objects to be swapped
+ * @return       Nothing
+ */
+template < typename T, typename Compare, typename Container,
+           std::size_t Arity, typename Handles >
+void swap(PriorityQueue<T, Compare, Container, Arity, Handles>& lhs,
+          PriorityQueue<T, Compare, Container, Arity, Handles>& rhs) {
+    lhs.swap(rhs);
+}
+
+/*
+ * @brief        Priority queue on a binary heap
+ */
+template < typename T, typename Compare = std::less<T>,
+           typename Container = std::vector<T> >
+using BinaryHeap = PriorityQueue<T, Compare, Container, 2>;
+
+/*
+ * @brief        Priority queue whose push returns handles for decrease_key
+ */
+template < typename T, typename Compare = std::less<T>,
+           std::size_t Arity = 4 >
+using IndexedPriorityQueue = PriorityQueue<T, Compare, std::vector<T>, Arity,
+                                           TrackedHeapHandles>;
+
+#endif
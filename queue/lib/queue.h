@@ -5,16 +5,23 @@
  *  @version    1.0
  *  Copyright (C) 2015 Ashish, MIT license
  * 
- *     TODO         add more constructors,
- *                 provide emplace method,
- *                   provide swap method
+ *     TODO         add more constructors
  * 
  */
 
 #ifndef _INCLUDE_QUEUE_H_
 #define _INCLUDE_QUEUE_H_
 
+#include <cassert>
 #include <deque>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "containertraits.h"
+#include "instrumentation.h"
+#include "simdcompare.h"
 
 /*
  * @brief  The queue implementation class
@@ -30,37 +37,120 @@
  *        back
  *        push_back
  *        pop_front
+ *        emplace_back (only if emplace is used)
+ * 
+ * A container of fixed capacity, like StaticRing, may return bool from
+ * push_back and emplace_back, false when full; push and emplace then
+ * throw runtime_error rather than drop the item (see ContainerPush).
+ * 
+ * Items can be moved in with push(T&&) or constructed in place with
+ * emplace, and moved out with pop_value, so that pushing and popping
+ * items which own memory (strings, messages) never copies them.
+ * 
+ * try_front and try_pop report an empty queue with a null pointer and
+ * an empty optional instead of an exception, for polling loops where
+ * empty is the common case; front_unchecked skips the check, which is
+ * then only asserted in debug builds.
+ * 
+ * push_range, push_bulk, pop_n and drain move groups of items with a
+ * single size check; the container grows once per group and copies
+ * trivially copyable items in bulk (see ContainerBulk).
+ * 
+ * begin and end iterate over the items from front to back, and copy_to
+ * copies them all out, for containers which support it; neither
+ * changes the queue.
+ * 
+ * == and < compare queues of numbers with SSE2 or AVX2 kernels, picked
+ * at run time, when the container keeps its items in arrays: SmallRing,
+ * StaticRing and UnrolledList do, deque does not (see ContainerCompare
+ * in simdcompare.h).
  * 
  * The suitable standard container classes are: deque and list.
+ * UnrolledList keeps items in cache-line blocks and recycles emptied
+ * blocks, so a warm queue stops allocating (see unrolledlist.h).
  * 
  * By default, if no container class is specified deque is used.
+ * 
+ * The Allocator parameter is handed to the container, whose own
+ * allocator is replaced by it (see RebindContainer); it defaults to
+ * the container's allocator, which leaves the container as it is.
+ * Other allocators need a container of the form C<T, Alloc> or one
+ * which specializes RebindContainer. A container without
+ * allocator_type is used as it is and gives the queue no allocator
+ * (see AdaptedContainer). Stateful allocators, like the arena in
+ * allocators.h, are passed to the allocator constructor.
+ * 
+ * The Instrumentation policy is a private base told about every push
+ * and pop. The default, NoInstrumentation, is empty and compiles away;
+ * CountingInstrumentation records counters, the peak size and how long
+ * items waited, read with stats() (see instrumentation.h).
+ * InstrumentedQueue selects it.
  */
 
  ///  Forward declaration of class is required for making 
  ///  operators == and < friends of Queue class
-template < typename T, typename Container >
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
 class Queue;
 
-template < typename T, typename Container >
-bool operator==(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs);
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+bool operator==(const Queue<T, Container, Allocator, Instrumentation>& lhs,
+                const Queue<T, Container, Allocator, Instrumentation>& rhs);
 
-template < typename T, typename Container >
-bool operator<(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs);
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+bool operator<(const Queue<T, Container, Allocator, Instrumentation>& lhs,
+               const Queue<T, Container, Allocator, Instrumentation>& rhs);
 
-template < typename T, typename Container = std::deque<T> >
-class Queue {
+template < typename T, typename Container = std::deque<T>,
+           typename Allocator = typename ContainerAllocator<Container>::type,
+           typename Instrumentation = NoInstrumentation >
+class Queue : private Instrumentation {
  private:
     typedef unsigned size_type;
-    Container items_;
+    typedef typename AdaptedContainer<Container, Allocator>::type container_type;
+    container_type items_;
 
  public:
+    typedef Allocator allocator_type;
+
     Queue();
+    explicit Queue(const Allocator& alloc);
+    Queue(const Queue& other);
+    Queue(Queue&& other)
+        noexcept(std::is_nothrow_move_constructible<container_type>::value);
+    Queue& operator=(const Queue& other);
+    Queue& operator=(Queue&& other)
+        noexcept(std::is_nothrow_move_assignable<container_type>::value);
     bool empty() const;
     size_type size() const;
     T& front();
     T& back();
+    T* try_front();
+    T& front_unchecked();
     void push(const T& val);
+    void push(T&& val);
+    template < typename... Args >
+    void emplace(Args&&... args);
     void pop();
+    T pop_value();
+    std::optional<T> try_pop();
+    template < typename InputIterator >
+    void push_range(InputIterator first, InputIterator last);
+    void push_bulk(const T* items, size_type count);
+    template < typename OutputIterator >
+    OutputIterator pop_n(size_type n, OutputIterator out);
+    template < typename OutputIterator >
+    OutputIterator drain(OutputIterator out);
+    auto begin() const;
+    auto end() const;
+    template < typename OutputIterator >
+    OutputIterator copy_to(OutputIterator out) const;
+    void swap(Queue& other);
+    Allocator get_allocator() const;
+    InstrumentationSnapshot stats() const;
+    InstrumentationSnapshot reset_stats();
 
     friend bool operator== <> (const Queue& lhs, const Queue& rhs);
     friend bool operator< <> (const Queue& lhs, const Queue& rhs);
@@ -69,8 +159,68 @@ class Queue {
 /*
  * @brief        Default constructor
  */
-template < typename T, typename Container >
-Queue<T, Container>::Queue() {
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+Queue<T, Container, Allocator, Instrumentation>::Queue() {
+}
+
+/*
+ * @brief        Constructor taking the allocator handed to the container
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+Queue<T, Container, Allocator, Instrumentation>::Queue(const Allocator& alloc)
+    : items_(alloc) {
+}
+
+/*
+ * @brief        Copy constructor
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+Queue<T, Container, Allocator, Instrumentation>::Queue(const Queue& other)
+    : Instrumentation(), items_(other.items_) {
+    Instrumentation::copied(other);
+}
+
+/*
+ * @brief        Move constructor, takes over the items of other
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+Queue<T, Container, Allocator, Instrumentation>::Queue(Queue&& other)
+    noexcept(std::is_nothrow_move_constructible<container_type>::value)
+    : items_(std::move(other.items_)) {
+    Instrumentation::moved(other);
+}
+
+/*
+ * @brief        Copy assignment
+ * @param        The queue to copy
+ * @return       Reference to this queue
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+Queue<T, Container, Allocator, Instrumentation>&
+Queue<T, Container, Allocator, Instrumentation>::operator=(const Queue& other) {
+    items_ = other.items_;
+    Instrumentation::copied(other);
+    return *this;
+}
+
+/*
+ * @brief        Move assignment, takes over the items of other
+ * @param        The queue to move from
+ * @return       Reference to this queue
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+Queue<T, Container, Allocator, Instrumentation>&
+Queue<T, Container, Allocator, Instrumentation>::operator=(Queue&& other)
+    noexcept(std::is_nothrow_move_assignable<container_type>::value) {
+    items_ = std::move(other.items_);
+    Instrumentation::moved(other);
+    return *this;
 }
 
 /*
@@ -78,8 +228,9 @@ Queue<T, Container>::Queue() {
  * @param        None
  * @return       true if queue empty
  */
-template < typename T, typename Container >
-bool Queue<T, Container>::empty() const {
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+bool Queue<T, Container, Allocator, Instrumentation>::empty() const {
     return items_.empty();
 }
 
@@ -88,8 +239,10 @@ bool Queue<T, Container>::empty() const {
  * @param        None
  * @return       The number of items in the queue
  */
-template < typename T, typename Container >
-typename Queue<T, Container>::size_type Queue<T, Container>::size() const {
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+typename Queue<T, Container, Allocator, Instrumentation>::size_type
+Queue<T, Container, Allocator, Instrumentation>::size() const {
     return items_.size();
 }
 
@@ -99,8 +252,9 @@ typename Queue<T, Container>::size_type Queue<T, Container>::size() const {
  * @return       Reference to the front item in Queue
  * @throws       runtime_error - if Queue empty
  */
-template < typename T, typename Container >
-T& Queue<T, Container>::front() {
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+T& Queue<T, Container, Allocator, Instrumentation>::front() {
     if (items_.empty()) {
         throw std::runtime_error("Queue empty");
     } else {
@@ -114,8 +268,9 @@ T& Queue<T, Container>::front() {
  * @return       Reference to the back item in Queue
  * @throws       runtime_error - if Queue empty
  */
-template < typename T, typename Container >
-T& Queue<T, Container>::back() {
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+T& Queue<T, Container, Allocator, Instrumentation>::back() {
     if (items_.empty()) {
         throw std::runtime_error("Queue empty");
     } else {
@@ -123,14 +278,75 @@ T& Queue<T, Container>::back() {
     }
 }
 
+/*
+ * @brief        Access the front item in Queue without throwing
+ * @param        None
+ * @return       Pointer to the front item, or null if Queue empty
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+T* Queue<T, Container, Allocator, Instrumentation>::try_front() {
+    return items_.empty() ? 0 : &items_.front();
+}
+
+/*
+ * @brief        Access the front item in Queue, which must exist
+ * @param        None
+ * @return       Reference to the front item in Queue
+ *
+ * Emptiness is only checked, with assert, in debug builds.
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+T& Queue<T, Container, Allocator, Instrumentation>::front_unchecked() {
+    assert(!items_.empty());
+    return items_.front();
+}
+
 /*
  * @brief        Add a new item at end of Queue 
  * @param        The item
  * @return       Nothing
+ * @throws       runtime_error - if a container of fixed capacity is full
  */
-template < typename T, typename Container >
-void Queue<T, Container>::push(const T& val) {
-    items_.push_back(val);
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+void Queue<T, Container, Allocator, Instrumentation>::push(const T& val) {
+    if (!ContainerPush::push_back(items_, val)) {
+        throw std::runtime_error("Queue full");
+    }
+    Instrumentation::enqueued(1, items_.size());
+}
+
+/*
+ * @brief        Move a new item to end of Queue 
+ * @param        The item
+ * @return       Nothing
+ * @throws       runtime_error - if a container of fixed capacity is full
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+void Queue<T, Container, Allocator, Instrumentation>::push(T&& val) {
+    if (!ContainerPush::push_back(items_, std::move(val))) {
+        throw std::runtime_error("Queue full");
+    }
+    Instrumentation::enqueued(1, items_.size());
+}
+
+/*
+ * @brief        Construct a new item in place at end of Queue 
+ * @param        Arguments forwarded to the constructor of T
+ * @return       Nothing
+ * @throws       runtime_error - if a container of fixed capacity is full
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+template < typename... Args >
+void Queue<T, Container, Allocator, Instrumentation>::emplace(Args&&... args) {
+    if (!ContainerPush::emplace_back(items_, std::forward<Args>(args)...)) {
+        throw std::runtime_error("Queue full");
+    }
+    Instrumentation::enqueued(1, items_.size());
 }
 
 /*
@@ -139,24 +355,234 @@ void Queue<T, Container>::push(const T& val) {
  * @return       Nothing
  * @throws       runtime_error - if Queue empty
  */
-template < typename T, typename Container >
-void Queue<T, Container>::pop() {
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+void Queue<T, Container, Allocator, Instrumentation>::pop() {
     if (items_.empty()) {
+        Instrumentation::empty_pop();
         throw std::runtime_error("Queue empty");
     } else {
         items_.pop_front();
+        Instrumentation::dequeued(1);
     }
     return;
 }
 
+/*
+ * @brief        Move the front item out of Queue and delete it
+ * @param        None
+ * @return       The front item
+ * @throws       runtime_error - if Queue empty
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+T Queue<T, Container, Allocator, Instrumentation>::pop_value() {
+    if (items_.empty()) {
+        Instrumentation::empty_pop();
+        throw std::runtime_error("Queue empty");
+    }
+    T val(std::move(items_.front()));
+    items_.pop_front();
+    Instrumentation::dequeued(1);
+    return val;
+}
+
+/*
+ * @brief        Move the front item out of Queue and delete it, without
+ *               throwing
+ * @param        None
+ * @return       The front item, or nothing if Queue empty
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+std::optional<T> Queue<T, Container, Allocator, Instrumentation>::try_pop() {
+    if (items_.empty()) {
+        Instrumentation::empty_pop();
+        return std::nullopt;
+    }
+    std::optional<T> val(std::move(items_.front()));
+    items_.pop_front();
+    Instrumentation::dequeued(1);
+    return val;
+}
+
+/*
+ * @brief        Add a range of items at end of Queue, in order
+ * @param        Iterators to the first and past the last item, which
+ *               must not refer to this queue
+ * @return       Nothing
+ *
+ * The container makes room once for ranges of known length, and copies
+ * trivially copyable items in bulk.
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+template < typename InputIterator >
+void Queue<T, Container, Allocator, Instrumentation>::push_range(
+        InputIterator first, InputIterator last) {
+    std::size_t n = append_counted(items_, first, last);
+    Instrumentation::enqueued(n, items_.size());
+}
+
+/*
+ * @brief        Add an array of items at end of Queue, in order
+ * @param        Pointer to the first item, and the no. of items
+ * @return       Nothing
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+void Queue<T, Container, Allocator, Instrumentation>::push_bulk(
+        const T* items, size_type count) {
+    ContainerBulk<container_type>::append(items_, items, items + count);
+    Instrumentation::enqueued(count, items_.size());
+}
+
+/*
+ * @brief        Move n items out of Queue, front item first, and delete them
+ * @param        The no. of items, and where to move them
+ * @return       The output iterator past the last item written
+ * @throws       runtime_error - if Queue has fewer than n items, in which
+ *               case nothing is removed
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+template < typename OutputIterator >
+OutputIterator Queue<T, Container, Allocator, Instrumentation>::pop_n(
+        size_type n, OutputIterator out) {
+    if (items_.size() < n) {
+        Instrumentation::empty_pop();
+        throw std::runtime_error("Queue empty");
+    }
+    out = ContainerBulk<container_type>::take_front(items_, n, out);
+    Instrumentation::dequeued(n);
+    return out;
+}
+
+/*
+ * @brief        Move all items out of Queue, front item first, and delete them
+ * @param        Where to move the items
+ * @return       The output iterator past the last item written
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+template < typename OutputIterator >
+OutputIterator Queue<T, Container, Allocator, Instrumentation>::drain(
+        OutputIterator out) {
+    size_type n = items_.size();
+    out = ContainerBulk<container_type>::take_front(items_, n, out);
+    Instrumentation::dequeued(n);
+    return out;
+}
+
+/*
+ * @brief        Iterator to the front item, the oldest
+ * @param        None
+ * @return       The container's const_iterator
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+auto Queue<T, Container, Allocator, Instrumentation>::begin() const {
+    return items_.begin();
+}
+
+/*
+ * @brief        Iterator past the back item, the newest
+ * @param        None
+ * @return       The container's const_iterator
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+auto Queue<T, Container, Allocator, Instrumentation>::end() const {
+    return items_.end();
+}
+
+/*
+ * @brief        Copy all items out of Queue, front item first, keeping them
+ * @param        Where to copy the items
+ * @return       The output iterator past the last item written
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+template < typename OutputIterator >
+OutputIterator Queue<T, Container, Allocator, Instrumentation>::copy_to(
+        OutputIterator out) const {
+    return ContainerBulk<container_type>::copy(items_, out);
+}
+
+/*
+ * @brief        Exchange the contents of two queues
+ * @param        The other queue
+ * @return       Nothing
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+void Queue<T, Container, Allocator, Instrumentation>::swap(Queue& other) {
+    using std::swap;
+    swap(items_, other.items_);
+    Instrumentation::swapped(other);
+}
+
+/*
+ * @brief        Get a copy of the allocator handed to the container
+ * @param        None
+ * @return       The allocator
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+Allocator Queue<T, Container, Allocator, Instrumentation>::get_allocator() const {
+    return items_.get_allocator();
+}
+
+/*
+ * @brief        Read the counters of the instrumentation policy; may be
+ *               called from a metrics thread while the queue is in use
+ * @param        None
+ * @return       The counters since the last reset_stats
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+InstrumentationSnapshot
+Queue<T, Container, Allocator, Instrumentation>::stats() const {
+    return Instrumentation::snapshot();
+}
+
+/*
+ * @brief        Restart the counters of the instrumentation policy
+ * @param        None
+ * @return       The counters since the previous reset_stats; summing
+ *               the results counts every push and pop exactly once
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+InstrumentationSnapshot
+Queue<T, Container, Allocator, Instrumentation>::reset_stats() {
+    return Instrumentation::reset();
+}
+
+/*
+ * @brief        Exchange the contents of two queues, found through ADL
+ * @param        Two queue objects to be swapped
+ * @return       Nothing
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+void swap(Queue<T, Container, Allocator, Instrumentation>& lhs,
+          Queue<T, Container, Allocator, Instrumentation>& rhs) {
+    lhs.swap(rhs);
+}
+
 /*
  * @brief        Performs the equality test on operands
  * @param        Two queue objects to be compared
  * @return       true if equal
  */
-template < typename T, typename Container >
-bool operator==(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs) {
-    return lhs.items_ == rhs.items_;
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+bool operator==(const Queue<T, Container, Allocator, Instrumentation>& lhs,
+                const Queue<T, Container, Allocator, Instrumentation>& rhs) {
+    typedef typename Queue<T, Container, Allocator,
+                           Instrumentation>::container_type container_type;
+    return ContainerCompare<container_type>::equal(lhs.items_, rhs.items_);
 }
 
 /*
@@ -164,8 +590,10 @@ bool operator==(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs)
  * @param        Two queue objects to be compared
  * @return       true if unequal
  */
-template < typename T, typename Container >
-bool operator!=(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs) {
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+bool operator!=(const Queue<T, Container, Allocator, Instrumentation>& lhs,
+                const Queue<T, Container, Allocator, Instrumentation>& rhs) {
     return !(lhs == rhs);
 }
 
@@ -174,9 +602,13 @@ bool operator!=(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs)
  * @param        Two queue objects to be compared
  * @return       true if left is less than right operand
  */
-template < typename T, typename Container >
-bool operator<(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs) {
-    return lhs.items_ < rhs.items_;
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+bool operator<(const Queue<T, Container, Allocator, Instrumentation>& lhs,
+               const Queue<T, Container, Allocator, Instrumentation>& rhs) {
+    typedef typename Queue<T, Container, Allocator,
+                           Instrumentation>::container_type container_type;
+    return ContainerCompare<container_type>::less(lhs.items_, rhs.items_);
 }
 
 /*
@@ -184,8 +616,10 @@ bool operator<(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs) {
  * @param        Two queue objects to be compared
  * @return       true if left is less than or equal to right operand
  */
-template < typename T, typename Container >
-bool operator<=(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs) {
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+bool operator<=(const Queue<T, Container, Allocator, Instrumentation>& lhs,
+                const Queue<T, Container, Allocator, Instrumentation>& rhs) {
     return !(rhs < lhs);  // !(lhs > rhs)
 }
 
@@ -195,8 +629,10 @@ bool operator<=(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs)
  * @param        Two queue objects to be compared
  * @return       true if left is greater than or equal to right operand
  */
-template < typename T, typename Container >
-bool operator>=(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs) {
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+bool operator>=(const Queue<T, Container, Allocator, Instrumentation>& lhs,
+                const Queue<T, Container, Allocator, Instrumentation>& rhs) {
     return !(lhs < rhs);
 }
 
@@ -206,10 +642,19 @@ bool operator>=(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs)
  * @param        Two queue objects to be compared
  * @return       true if left is greater than right operand
  */
-template < typename T, typename Container >
-bool operator>(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs) {
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+bool operator>(const Queue<T, Container, Allocator, Instrumentation>& lhs,
+               const Queue<T, Container, Allocator, Instrumentation>& rhs) {
     return rhs < lhs;
 }
 
+/*
+ * @brief        Queue recording counters and latencies, see stats()
+ */
+template < typename T, typename Container = std::deque<T> >
+using InstrumentedQueue = Queue<T, Container,
+                                typename ContainerAllocator<Container>::type,
+                                CountingInstrumentation>;
 
 #endif
@@ -0,0 +1,507 @@
+/**
+ *  @brief      Queue sharded per CPU or per NUMA node, with stealing
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_SHARDEDQUEUE_H_
+#define _INCLUDE_SHARDEDQUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sched.h>
+#include <unistd.h>
+
+#include "queue.h"
+
+/*
+ * @brief  Which NUMA node each CPU belongs to
+ *
+ * detect() reads the nodes and their CPU lists from sysfs, which needs
+ * neither libnuma nor privileges; where sysfs has no nodes, all online
+ * CPUs form node 0. uniform() makes up a topology, for tests and for
+ * pinning experiments.
+ */
+struct CpuTopology {
+    std::vector<unsigned> node_of_cpu;  /// indexed by CPU number
+    unsigned nodes;
+
+    CpuTopology() : nodes(1) {}
+
+    /*
+     * @brief        Parse a kernel CPU list such as "0-3,8,10-11"
+     * @param        The list
+     * @return       The CPU numbers, in the order listed
+     */
+    static std::vector<unsigned> parse_cpulist(const std::string& list) {
+        std::vector<unsigned> cpus;
+        std::stringstream ranges(list);
+        std::string range;
+        while (std::getline(ranges, range, ',')) {
+            if (range.find_first_of("0123456789") == std::string::npos) {
+                continue;
+            }
+            std::size_t dash = range.find('-');
+            unsigned first = std::strtoul(range.c_str(), 0, 10);
+            unsigned last = dash == std::string::npos
+                                ? first
+                                : std::strtoul(range.c_str() + dash + 1, 0, 10);
+            for (unsigned cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        }
+        return cpus;
+    }
+
+    static CpuTopology detect() {
+        CpuTopology topology;
+        topology.nodes = 0;
+        for (unsigned node = 0;; ++node) {
+            std::ifstream file("/sys/devices/system/node/node" +
+                               std::to_string(node) + "/cpulist");
+            if (!file) {
+                break;
+            }
+            std::string list;
+            std::getline(file, list);
+            for (unsigned cpu : parse_cpulist(list)) {
+                if (cpu >= topology.node_of_cpu.size()) {
+                    topology.node_of_cpu.resize(cpu + 1, node);
+                }
+                topology.node_of_cpu[cpu] = node;
+            }
+            topology.nodes = node + 1;
+        }
+        if (topology.nodes == 0 || topology.node_of_cpu.empty()) {
+            long cpus = ::sysconf(_SC_NPROCESSORS_CONF);
+            return uniform(cpus > 0 ? cpus : 1, 1);
+        }
+        return topology;
+    }
+
+    /*
+     * @brief        Topology of cpus CPUs split evenly in nodes blocks
+     * @param        The no. of CPUs and of nodes
+     * @return       The topology
+     */
+    static CpuTopology uniform(unsigned cpus, unsigned nodes) {
+        if (cpus == 0 || nodes == 0 || nodes > cpus) {
+            throw std::runtime_error("CpuTopology needs a CPU per node");
+        }
+        CpuTopology topology;
+        topology.nodes = nodes;
+        for (unsigned cpu = 0; cpu < cpus; ++cpu) {
+            topology.node_of_cpu.push_back(cpu * nodes / cpus);
+        }
+        return topology;
+    }
+
+    /// CPU the calling thread runs on, or 0 if unknown
+    static unsigned current_cpu() {
+        int cpu = ::sched_getcpu();
+        return cpu < 0 ? 0 : cpu;
+    }
+};
+
+enum ShardPolicy { kShardPerNode, kShardPerCpu };
+
+/*
+ * @brief  Counters of one shard, read with ShardedQueue::stats()
+ *
+ * stolen counts the items taken by consumers of other shards, and
+ * stolen_remote those of them taken from another node: each one moved
+ * the item's cache lines, and the shard's, across sockets.
+ */
+struct ShardStats {
+    std::uint64_t pushes;
+    std::uint64_t pops;
+    std::uint64_t stolen;
+    std::uint64_t stolen_remote;
+
+    ShardStats() : pushes(0), pops(0), stolen(0), stolen_remote(0) {}
+};
+
+/*
+ * @brief  The sharded queue class
+ *
+ * A set of Queue shards, one per NUMA node or one per CPU, each with
+ * its own lock on its own cache lines, so that threads on different
+ * sockets stop contending for one lock and one queue. push adds to
+ * the shard of the CPU the caller runs on; try_pop takes from that
+ * shard first, and only when it is empty steals from the others: the
+ * shards of the same node first, then those of the other nodes. Each
+ * shard keeps a relaxed count of its items, so empty shards are
+ * skipped without taking their lock.
+ *
+ * Ordering is relaxed. Each shard is FIFO: items pushed to one shard
+ * are popped in the order they were pushed, whoever pops them. There
+ * is no order across shards, so an item may be popped after items
+ * pushed later to another shard, including later pushes of the same
+ * thread once it has moved to another CPU. Threads pinned to one CPU,
+ * or using push_to with a fixed shard, keep their items in order.
+ *
+ * try_pop returns an empty optional when every shard looked empty
+ * during its scan; an item pushed meanwhile may be missed. size() is
+ * likewise a sum of counts read at different times.
+ *
+ * The CPU is read with sched_getcpu on every push and try_pop, as the
+ * kernel may migrate threads; pinned threads can look their shard up
+ * once with local_shard() and use push_to and try_pop_from. Shard
+ * memory is allocated by the threads pushing to it, so with the
+ * kernel's default first-touch policy it ends up on their node.
+ *
+ * The Container requirements are the ones of Queue.
+ */
+template < typename T, typename Container = std::deque<T> >
+class ShardedQueue {
+ public:
+    typedef std::size_t size_type;
+    static const size_type kCacheLine = 64;
+
+ private:
+    struct alignas(kCacheLine) Shard {
+        std::mutex lock;
+        Queue<T, Container> items;
+        std::atomic<size_type> size;
+        std::atomic<std::uint64_t> pushes;
+        std::atomic<std::uint64_t> pops;
+        std::atomic<std::uint64_t> stolen;
+        std::atomic<std::uint64_t> stolen_remote;
+        unsigned node;
+
+        Shard()
+            : size(0), pushes(0), pops(0), stolen(0), stolen_remote(0),
+              node(0) {}
+    };
+
+    CpuTopology topology_;
+    ShardPolicy policy_;
+    size_type shard_count_;
+    std::unique_ptr<Shard[]> shards_;
+    std::vector<size_type> shard_of_cpu_;
+    std::vector< std::vector<size_type> > steal_order_;
+
+    ShardedQueue(const ShardedQueue&);
+    ShardedQueue& operator=(const ShardedQueue&);
+
+    static void add(std::atomic<std::uint64_t>& counter, std::uint64_t n) {
+        counter.store(counter.load(std::memory_order_relaxed) + n,
+                      std::memory_order_relaxed);
+    }
+
+    template < typename U >
+    void put(size_type shard, U&& val);
+    std::optional<T> take(size_type shard, size_type home);
+
+ public:
+    explicit ShardedQueue(ShardPolicy policy = kShardPerNode,
+                          const CpuTopology& topology = CpuTopology::detect());
+    size_type shards() const;
+    unsigned node_of_shard(size_type shard) const;
+    size_type shard_of_cpu(unsigned cpu) const;
+    size_type local_shard() const;
+    const std::vector<size_type>& steal_order(size_type shard) const;
+    bool empty() const;
+    size_type size() const;
+    size_type size(size_type shard) const;
+    void push(const T& val);
+    void push(T&& val);
+    void push_to(size_type shard, const T& val);
+    void push_to(size_type shard, T&& val);
+    std::optional<T> try_pop();
+    std::optional<T> try_pop_from(size_type shard);
+    ShardStats stats(size_type shard) const;
+};
+
+/*
+ * @brief        Constructor, lays out the shards and their steal order
+ * @param        One shard per node or per CPU, and the topology, by
+ *               default the machine's
+ */
+template < typename T, typename Container >
+ShardedQueue<T, Container>::ShardedQueue(ShardPolicy policy,
+                                         const CpuTopology& topology)
+    : topology_(topology), policy_(policy), shard_count_(0) {
+    if (topology.node_of_cpu.empty() || topology.nodes == 0) {
+        throw std::runtime_error("ShardedQueue topology has no CPU");
+    }
+    std::vector<unsigned> node_of_shard;
+    if (policy == kShardPerNode) {
+        for (unsigned node = 0; node < topology.nodes; ++node) {
+            node_of_shard.push_back(node);
+        }
+        shard_of_cpu_.assign(topology.node_of_cpu.begin(),
+                             topology.node_of_cpu.end());
+    } else {
+        for (unsigned cpu = 0; cpu < topology.node_of_cpu.size(); ++cpu) {
+            shard_of_cpu_.push_back(cpu);
+            node_of_shard.push_back(topology.node_of_cpu[cpu]);
+        }
+    }
+    shard_count_ = node_of_shard.size();
+    shards_.reset(new Shard[shard_count_]);
+    for (size_type i = 0; i < shard_count_; ++i) {
+        shards_[i].node = node_of_shard[i];
+    }
+
+    /// from each shard, visit the next ones on its node, then the
+    /// others, each time in ring order
+    steal_order_.resize(shard_count_);
+    for (size_type home = 0; home < shard_count_; ++home) {
+        for (int pass = 0; pass < 2; ++pass) {
+            for (size_type k = 1; k < shard_count_; ++k) {
+                size_type victim = (home + k) % shard_count_;
+                bool near = node_of_shard[victim] == node_of_shard[home];
+                if (near == (pass == 0)) {
+                    steal_order_[home].push_back(victim);
+                }
+            }
+        }
+    }
+}
+
+/*
+ * @brief        Get the no. of shards
+ * @param        None
+ * @return       The no. of nodes or of CPUs, as per the policy
+ */
+template < typename T, typename Container >
+typename ShardedQueue<T, Container>::size_type
+ShardedQueue<T, Container>::shards() const {
+    return shard_count_;
+}
+
+/*
+ * @brief        Get the node of a shard
+ * @param        The shard
+ * @return       Its NUMA node
+ */
+template < typename T, typename Container >
+unsigned ShardedQueue<T, Container>::node_of_shard(size_type shard) const {
+    return shards_[shard].node;
+}
+
+/*
+ * @brief        Get the shard of a CPU
+ * @param        The CPU number; CPUs missing from the topology, as
+ *               after a hotplug, are spread over the shards
+ * @return       The shard
+ */
+template < typename T, typename Container >
+typename ShardedQueue<T, Container>::size_type
+ShardedQueue<T, Container>::shard_of_cpu(unsigned cpu) const {
+    if (cpu < shard_of_cpu_.size()) {
+        return shard_of_cpu_[cpu];
+    }
+    return cpu % shard_count_;
+}
+
+/*
+ * @brief        Get the shard of the CPU the caller runs on
+ * @param        None
+ * @return       The shard, which may change if the thread is moved
+ */
+template < typename T, typename Container >
+typename ShardedQueue<T, Container>::size_type
+ShardedQueue<T, Container>::local_shard() const {
+    return shard_of_cpu(CpuTopology::current_cpu());
+}
+
+/*
+ * @brief        Get the shards try_pop_from visits after an empty shard
+ * @param        The shard
+ * @return       The other shards, those of the same node first
+ */
+template < typename T, typename Container >
+const std::vector<typename ShardedQueue<T, Container>::size_type>&
+ShardedQueue<T, Container>::steal_order(size_type shard) const {
+    return steal_order_[shard];
+}
+
+/*
+ * @brief        Test whether every shard is empty
+ * @param        None
+ * @return       true if no shard held items when read
+ */
+template < typename T, typename Container >
+bool ShardedQueue<T, Container>::empty() const {
+    for (size_type i = 0; i < shard_count_; ++i) {
+        if (shards_[i].size.load(std::memory_order_relaxed)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * @brief        Get size of queue, i.e. no. of items in all shards
+ * @param        None
+ * @return       The sum of the shard sizes, each read at its own time
+ */
+template < typename T, typename Container >
+typename ShardedQueue<T, Container>::size_type
+ShardedQueue<T, Container>::size() const {
+    size_type total = 0;
+    for (size_type i = 0; i < shard_count_; ++i) {
+        total += shards_[i].size.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+/*
+ * @brief        Get the no. of items in one shard
+ * @param        The shard
+ * @return       Its size
+ */
+template < typename T, typename Container >
+typename ShardedQueue<T, Container>::size_type
+ShardedQueue<T, Container>::size(size_type shard) const {
+    return shards_[shard].size.load(std::memory_order_relaxed);
+}
+
+/*
+ * @brief        Add an item at the end of a shard
+ * @param        The shard and the item
+ * @return       Nothing
+ */
+template < typename T, typename Container >
+template < typename U >
+void ShardedQueue<T, Container>::put(size_type shard, U&& val) {
+    Shard& s = shards_[shard];
+    std::lock_guard<std::mutex> guard(s.lock);
+    s.items.push(std::forward<U>(val));
+    s.size.store(s.size.load(std::memory_order_relaxed) + 1,
+                 std::memory_order_relaxed);
+    add(s.pushes, 1);
+}
+
+/*
+ * @brief        Take the front item of a shard, if any
+ * @param        The shard, and the home shard of the caller
+ * @return       The item, or an empty optional if the shard is empty
+ */
+template < typename T, typename Container >
+std::optional<T> ShardedQueue<T, Container>::take(size_type shard,
+                                                  size_type home) {
+    Shard& s = shards_[shard];
+    if (s.size.load(std::memory_order_relaxed) == 0) {
+        return std::nullopt;
+    }
+    std::lock_guard<std::mutex> guard(s.lock);
+    std::optional<T> val = s.items.try_pop();
+    if (val) {
+        s.size.store(s.size.load(std::memory_order_relaxed) - 1,
+                     std::memory_order_relaxed);
+        add(s.pops, 1);
+        if (shard != home) {
+            add(s.stolen, 1);
+            if (s.node != shards_[home].node) {
+                add(s.stolen_remote, 1);
+            }
+        }
+    }
+    return val;
+}
+
+/*
+ * @brief        Add an item to the shard of the caller's CPU
+ * @param        The item
+ * @return       Nothing
+ */
+template < typename T, typename Container >
+void ShardedQueue<T, Container>::push(const T& val) {
+    put(local_shard(), val);
+}
+
+template < typename T, typename Container >
+void ShardedQueue<T, Container>::push(T&& val) {
+    put(local_shard(), std::move(val));
+}
+
+/*
+ * @brief        Add an item to a given shard
+ * @param        The shard and the item
+ * @return       Nothing
+ * @throws       out_of_range if there is no such shard
+ */
+template < typename T, typename Container >
+void ShardedQueue<T, Container>::push_to(size_type shard, const T& val) {
+    if (shard >= shard_count_) {
+        throw std::out_of_range("ShardedQueue shard");
+    }
+    put(shard, val);
+}
+
+template < typename T, typename Container >
+void ShardedQueue<T, Container>::push_to(size_type shard, T&& val) {
+    if (shard >= shard_count_) {
+        throw std::out_of_range("ShardedQueue shard");
+    }
+    put(shard, std::move(val));
+}
+
+/*
+ * @brief        Take an item from the shard of the caller's CPU, or
+ *               else steal one
+ * @param        None
+ * @return       The item, or an empty optional if all shards looked
+ *               empty
+ */
+template < typename T, typename Container >
+std::optional<T> ShardedQueue<T, Container>::try_pop() {
+    return try_pop_from(local_shard());
+}
+
+/*
+ * @brief        Take an item from a given shard, or else steal one,
+ *               from the same node first
+ * @param        The shard to drain first
+ * @return       The item, or an empty optional if all shards looked
+ *               empty
+ * @throws       out_of_range if there is no such shard
+ */
+template < typename T, typename Container >
+std::optional<T> ShardedQueue<T, Container>::try_pop_from(size_type shard) {
+    if (shard >= shard_count_) {
+        throw std::out_of_range("ShardedQueue shard");
+    }
+    std::optional<T> val = take(shard, shard);
+    for (size_type i = 0; !val && i < steal_order_[shard].size(); ++i) {
+        val = take(steal_order_[shard][i], shard);
+    }
+    return val;
+}
+
+/*
+ * @brief        Read the counters of a shard
+ * @param        The shard
+ * @return       The counters
+ */
+template < typename T, typename Container >
+ShardStats ShardedQueue<T, Container>::stats(size_type shard) const {
+    const Shard& s = shards_[shard];
+    ShardStats stats;
+    stats.pushes = s.pushes.load(std::memory_order_relaxed);
+    stats.pops = s.pops.load(std::memory_order_relaxed);
+    stats.stolen = s.stolen.load(std::memory_order_relaxed);
+    stats.stolen_remote = s.stolen_remote.load(std::memory_order_relaxed);
+    return stats;
+}
+
+#endif
@@ -0,0 +1,28 @@
+/**
+ *  @brief      Queue with inline storage for a small number of items
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_SMALLQUEUE_H_
+#define _INCLUDE_SMALLQUEUE_H_
+
+#include <cstddef>
+
+#include "queue.h"
+#include "smallring.h"
+
+/*
+ * @brief  Queue keeping its first InlineN items inside the object
+ *
+ * Short-lived queues that stay within InlineN items are constructed,
+ * used and destroyed without any heap allocation; larger ones spill
+ * to the heap once. InlineN must be a power of two.
+ */
+template < typename T, std::size_t InlineN = 16 >
+using SmallQueue = Queue< T, SmallRing<T, InlineN> >;
+
+#endif
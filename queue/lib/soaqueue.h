@@ -0,0 +1,685 @@
+/**
+ *  @brief      Queue of records stored as one ring per field
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_SOAQUEUE_H_
+#define _INCLUDE_SOAQUEUE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "containertraits.h"
+
+/*
+ * @brief  The structure-of-arrays queue class
+ *
+ * Queues records given as a tuple of field types, say
+ * SoaQueue< std::tuple<long, double, int> >, keeping each field in
+ * its own ring buffer rather than the records side by side. A consumer
+ * scanning one field thus reads only that field's bytes, as contiguous
+ * arrays which vectorize: column<I>() hands out the live items of field
+ * I as at most two runs, split where the rings wrap (see SplitCursor).
+ *
+ * Records are pushed, read and popped whole as in Queue, except that
+ * front and back return a tuple of references into the rings rather
+ * than a reference to a record, and emplace takes one argument per
+ * field. Fields must be trivially copyable, so rings grow with memcpy.
+ *
+ * The rings share a capacity, a power of two starting at 16 and
+ * doubling when full; each comes from Allocator, rebound to its field.
+ */
+template < typename Record, typename Allocator = std::allocator<Record> >
+class SoaQueue;
+
+template < typename... Fields, typename Allocator >
+class SoaQueue< std::tuple<Fields...>, Allocator > {
+    static_assert(sizeof...(Fields) > 0, "SoaQueue records need a field");
+    static_assert(std::conjunction<std::is_trivially_copyable<Fields>...>::value,
+                  "SoaQueue fields must be trivially copyable");
+
+ public:
+    typedef std::tuple<Fields...> value_type;
+    typedef std::tuple<Fields&...> reference;
+    typedef std::tuple<const Fields&...> const_reference;
+    typedef Allocator allocator_type;
+    typedef std::size_t size_type;
+
+    template < std::size_t I >
+    using field_type = typename std::tuple_element<I, value_type>::type;
+
+    static const size_type kColumns = sizeof...(Fields);
+    static const size_type kMinCapacity = 16;
+
+ private:
+    typedef std::index_sequence_for<Fields...> indices;
+    typedef std::allocator_traits<Allocator> traits;
+
+    Allocator alloc_;
+    std::tuple<Fields*...> columns_;
+    size_type head_;
+    size_type size_;
+    size_type capacity_;
+
+    size_type slot(size_type i) const { return (head_ + i) & (capacity_ - 1); }
+    size_type front_run() const { return std::min(size_, capacity_ - head_); }
+
+    static size_type capacity_for(size_type n);
+    template < std::size_t I >
+    field_type<I>* allocate_column(size_type n);
+    template < std::size_t I >
+    void deallocate_column(field_type<I>* column, size_type n);
+    template < std::size_t... I >
+    std::tuple<Fields*...> allocate_columns(size_type n,
+                                            std::index_sequence<I...>);
+    template < std::size_t... I >
+    static void copy_columns(std::tuple<Fields*...>& to, const SoaQueue& from,
+                             std::index_sequence<I...>);
+    void reallocate(size_type capacity);
+    template < std::size_t... I >
+    void free_columns(std::tuple<Fields*...>& columns, size_type n,
+                      std::index_sequence<I...>);
+    template < typename Tuple, std::size_t... I >
+    static void store(std::tuple<Fields*...>& columns, size_type at,
+                      Tuple&& fields, std::index_sequence<I...>);
+    template < std::size_t... I >
+    reference record(size_type i, std::index_sequence<I...>);
+    template < std::size_t... I >
+    const_reference record(size_type i, std::index_sequence<I...>) const;
+    template < std::size_t... I >
+    value_type copy_record(size_type i, std::index_sequence<I...>) const;
+    template < typename Tuple >
+    void grow_and_store(Tuple&& fields);
+
+ public:
+    SoaQueue();
+    explicit SoaQueue(const Allocator& alloc);
+    SoaQueue(const SoaQueue& other);
+    SoaQueue(SoaQueue&& other) noexcept;
+    SoaQueue& operator=(const SoaQueue& other);
+    SoaQueue& operator=(SoaQueue&& other) noexcept;
+    ~SoaQueue();
+
+    bool empty() const { return size_ == 0; }
+    size_type size() const { return size_; }
+    size_type capacity() const { return capacity_; }
+    void reserve(size_type n);
+    reference front();
+    const_reference front() const;
+    reference back();
+    const_reference back() const;
+    /// the record i places behind the front, unchecked
+    reference operator[](size_type i) { return record(i, indices()); }
+    const_reference operator[](size_type i) const { return record(i, indices()); }
+    void push(const value_type& val);
+    template < typename... Args >
+    void emplace(Args&&... args);
+    void pop();
+    value_type pop_value();
+    std::optional<value_type> try_pop();
+    template < typename InputIterator >
+    void push_range(InputIterator first, InputIterator last);
+    template < typename OutputIterator >
+    OutputIterator pop_n(size_type n, OutputIterator out);
+    template < std::size_t I >
+    SplitCursor< field_type<I> > column() const;
+    void clear();
+    void swap(SoaQueue& other) noexcept;
+    Allocator get_allocator() const { return alloc_; }
+};
+
+/*
+ * @brief        Default constructor, allocates nothing
+ */
+template < typename... Fields, typename A >
+SoaQueue<std::tuple<Fields...>, A>::SoaQueue()
+    : alloc_(), columns_(), head_(0), size_(0), capacity_(0) {
+}
+
+/*
+ * @brief        Constructor taking the allocator, rebound per field
+ */
+template < typename... Fields, typename A >
+SoaQueue<std::tuple<Fields...>, A>::SoaQueue(const A& alloc)
+    : alloc_(alloc), columns_(), head_(0), size_(0), capacity_(0) {
+}
+
+/*
+ * @brief        Copy constructor
+ */
+template < typename... Fields, typename A >
+SoaQueue<std::tuple<Fields...>, A>::SoaQueue(const SoaQueue& other)
+    : alloc_(traits::select_on_container_copy_construction(other.alloc_)),
+      columns_(), head_(0), size_(0), capacity_(0) {
+    if (other.size_ == 0) {
+        return;
+    }
+    size_type capacity = capacity_for(other.size_);
+    columns_ = allocate_columns(capacity, indices());
+    copy_columns(columns_, other, indices());
+    size_ = other.size_;
+    capacity_ = capacity;
+}
+
+/*
+ * @brief        Move constructor, takes over the rings of other
+ */
+template < typename... Fields, typename A >
+SoaQueue<std::tuple<Fields...>, A>::SoaQueue(SoaQueue&& other) noexcept
+    : alloc_(other.alloc_), columns_(other.columns_), head_(other.head_),
+      size_(other.size_), capacity_(other.capacity_) {
+    other.columns_ = std::tuple<Fields*...>();
+    other.head_ = 0;
+    other.size_ = 0;
+    other.capacity_ = 0;
+}
+
+/*
+ * @brief        Copy assignment
+ * @param        The queue to copy
+ * @return       Reference to this queue
+ */
+template < typename... Fields, typename A >
+SoaQueue<std::tuple<Fields...>, A>&
+SoaQueue<std::tuple<Fields...>, A>::operator=(const SoaQueue& other) {
+    if (this != &other) {
+        SoaQueue copy(other);
+        swap(copy);
+    }
+    return *this;
+}
+
+/*
+ * @brief        Move assignment, takes over the rings of other
+ * @param        The queue to move from
+ * @return       Reference to this queue
+ */
+template < typename... Fields, typename A >
+SoaQueue<std::tuple<Fields...>, A>&
+SoaQueue<std::tuple<Fields...>, A>::operator=(SoaQueue&& other) noexcept {
+    swap(other);
+    return *this;
+}
+
+/*
+ * @brief        Destructor, frees the rings
+ */
+template < typename... Fields, typename A >
+SoaQueue<std::tuple<Fields...>, A>::~SoaQueue() {
+    free_columns(columns_, capacity_, indices());
+}
+
+/*
+ * @brief        Smallest capacity which holds n records
+ * @param        The no. of records
+ * @return       A power of two no less than kMinCapacity
+ */
+template < typename... Fields, typename A >
+typename SoaQueue<std::tuple<Fields...>, A>::size_type
+SoaQueue<std::tuple<Fields...>, A>::capacity_for(size_type n) {
+    size_type capacity = kMinCapacity;
+    while (capacity < n) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+template < typename... Fields, typename A >
+template < std::size_t I >
+typename SoaQueue<std::tuple<Fields...>, A>::template field_type<I>*
+SoaQueue<std::tuple<Fields...>, A>::allocate_column(size_type n) {
+    typename traits::template rebind_alloc< field_type<I> > alloc(alloc_);
+    return std::allocator_traits<decltype(alloc)>::allocate(alloc, n);
+}
+
+template < typename... Fields, typename A >
+template < std::size_t I >
+void SoaQueue<std::tuple<Fields...>, A>::deallocate_column(
+        field_type<I>* column, size_type n) {
+    if (column) {
+        typename traits::template rebind_alloc< field_type<I> > alloc(alloc_);
+        std::allocator_traits<decltype(alloc)>::deallocate(alloc, column, n);
+    }
+}
+
+/*
+ * @brief        Allocate a ring for every field
+ * @param        The no. of slots in each
+ * @return       The rings
+ * @throws       Whatever the allocator throws, having freed the rings
+ *               already allocated
+ */
+template < typename... Fields, typename A >
+template < std::size_t... I >
+std::tuple<Fields*...> SoaQueue<std::tuple<Fields...>, A>::allocate_columns(
+        size_type n, std::index_sequence<I...>) {
+    std::tuple<Fields*...> columns;
+    try {
+        ((std::get<I>(columns) = allocate_column<I>(n)), ...);
+    } catch (...) {
+        (deallocate_column<I>(std::get<I>(columns), n), ...);
+        throw;
+    }
+    return columns;
+}
+
+/*
+ * @brief        Copy the live items of every ring of a queue to the
+ *               start of other rings
+ * @param        The rings to copy to, and the queue
+ * @return       Nothing
+ */
+template < typename... Fields, typename A >
+template < std::size_t... I >
+void SoaQueue<std::tuple<Fields...>, A>::copy_columns(
+        std::tuple<Fields*...>& to, const SoaQueue& from,
+        std::index_sequence<I...>) {
+    size_type first = from.front_run();
+    (std::memcpy(std::get<I>(to), std::get<I>(from.columns_) + from.head_,
+                 first * sizeof(field_type<I>)), ...);
+    (std::memcpy(std::get<I>(to) + first, std::get<I>(from.columns_),
+                 (from.size_ - first) * sizeof(field_type<I>)), ...);
+}
+
+/*
+ * @brief        Move the items into rings of a new capacity, front first
+ * @param        The capacity, a power of two no less than size
+ * @return       Nothing
+ * @throws       Whatever the allocator throws, leaving the queue as it was
+ */
+template < typename... Fields, typename A >
+void SoaQueue<std::tuple<Fields...>, A>::reallocate(size_type capacity) {
+    std::tuple<Fields*...> fresh = allocate_columns(capacity, indices());
+    if (size_) {
+        copy_columns(fresh, *this, indices());
+    }
+    free_columns(columns_, capacity_, indices());
+    columns_ = fresh;
+    head_ = 0;
+    capacity_ = capacity;
+}
+
+template < typename... Fields, typename A >
+template < std::size_t... I >
+void SoaQueue<std::tuple<Fields...>, A>::free_columns(
+        std::tuple<Fields*...>& columns, size_type n,
+        std::index_sequence<I...>) {
+    (deallocate_column<I>(std::get<I>(columns), n), ...);
+}
+
+/*
+ * @brief        Double the capacity, or allocate the first rings, and
+ *               store a record behind the items
+ * @param        A tuple of the fields of the record
+ * @return       Nothing
+ * @throws       Whatever the allocator or the fields throw, leaving the
+ *               queue as it was
+ *
+ * The record is stored in the new rings before the old ones are freed,
+ * as its fields may refer to items of the queue.
+ */
+template < typename... Fields, typename A >
+template < typename Tuple >
+void SoaQueue<std::tuple<Fields...>, A>::grow_and_store(Tuple&& fields) {
+    size_type capacity = capacity_ ? 2 * capacity_ : kMinCapacity;
+    std::tuple<Fields*...> fresh = allocate_columns(capacity, indices());
+    try {
+        store(fresh, size_, std::forward<Tuple>(fields), indices());
+    } catch (...) {
+        free_columns(fresh, capacity, indices());
+        throw;
+    }
+    if (size_) {
+        copy_columns(fresh, *this, indices());
+    }
+    free_columns(columns_, capacity_, indices());
+    columns_ = fresh;
+    head_ = 0;
+    capacity_ = capacity;
+}
+
+/*
+ * @brief        Construct each field of a record in its slot
+ * @param        The rings, the slot, and a tuple of the fields
+ * @return       Nothing
+ */
+template < typename... Fields, typename A >
+template < typename Tuple, std::size_t... I >
+void SoaQueue<std::tuple<Fields...>, A>::store(std::tuple<Fields*...>& columns,
+                                               size_type at, Tuple&& fields,
+                                               std::index_sequence<I...>) {
+    (::new (static_cast<void*>(std::get<I>(columns) + at))
+         field_type<I>(std::get<I>(std::forward<Tuple>(fields))),
+     ...);
+}
+
+template < typename... Fields, typename A >
+template < std::size_t... I >
+typename SoaQueue<std::tuple<Fields...>, A>::reference
+SoaQueue<std::tuple<Fields...>, A>::record(size_type i,
+                                           std::index_sequence<I...>) {
+    size_type at = slot(i);
+    return reference(std::get<I>(columns_)[at]...);
+}
+
+template < typename... Fields, typename A >
+template < std::size_t... I >
+typename SoaQueue<std::tuple<Fields...>, A>::const_reference
+SoaQueue<std::tuple<Fields...>, A>::record(size_type i,
+                                           std::index_sequence<I...>) const {
+    size_type at = slot(i);
+    return const_reference(std::get<I>(columns_)[at]...);
+}
+
+template < typename... Fields, typename A >
+template < std::size_t... I >
+typename SoaQueue<std::tuple<Fields...>, A>::value_type
+SoaQueue<std::tuple<Fields...>, A>::copy_record(
+        size_type i, std::index_sequence<I...>) const {
+    size_type at = slot(i);
+    return value_type(std::get<I>(columns_)[at]...);
+}
+
+/*
+ * @brief        Make room for n records without reallocating
+ * @param        The no. of records
+ * @return       Nothing
+ */
+template < typename... Fields, typename A >
+void SoaQueue<std::tuple<Fields...>, A>::reserve(size_type n) {
+    if (n > capacity_) {
+        reallocate(capacity_for(n));
+    }
+}
+
+/*
+ * @brief        Access the front record in queue
+ * @param        None
+ * @return       Tuple of references to its fields
+ * @throws       runtime_error - if Queue empty
+ */
+template < typename... Fields, typename A >
+typename SoaQueue<std::tuple<Fields...>, A>::reference
+SoaQueue<std::tuple<Fields...>, A>::front() {
+    if (empty()) {
+        throw std::runtime_error("Queue empty");
+    }
+    return record(0, indices());
+}
+
+template < typename... Fields, typename A >
+typename SoaQueue<std::tuple<Fields...>, A>::const_reference
+SoaQueue<std::tuple<Fields...>, A>::front() const {
+    if (empty()) {
+        throw std::runtime_error("Queue empty");
+    }
+    return record(0, indices());
+}
+
+/*
+ * @brief        Access the back record in queue
+ * @param        None
+ * @return       Tuple of references to its fields
+ * @throws       runtime_error - if Queue empty
+ */
+template < typename... Fields, typename A >
+typename SoaQueue<std::tuple<Fields...>, A>::reference
+SoaQueue<std::tuple<Fields...>, A>::back() {
+    if (empty()) {
+        throw std::runtime_error("Queue empty");
+    }
+    return record(size_ - 1, indices());
+}
+
+template < typename... Fields, typename A >
+typename SoaQueue<std::tuple<Fields...>, A>::const_reference
+SoaQueue<std::tuple<Fields...>, A>::back() const {
+    if (empty()) {
+        throw std::runtime_error("Queue empty");
+    }
+    return record(size_ - 1, indices());
+}
+
+/*
+ * @brief        Insert a new record at the end of queue
+ * @param        The record
+ * @return       Nothing
+ */
+template < typename... Fields, typename A >
+void SoaQueue<std::tuple<Fields...>, A>::push(const value_type& val) {
+    if (size_ == capacity_) {
+        grow_and_store(val);
+    } else {
+        store(columns_, slot(size_), val, indices());
+    }
+    ++size_;
+}
+
+/*
+ * @brief        Insert a new record at the end of queue, built from one
+ *               argument per field
+ * @param        Arguments forwarded to the constructors of the fields
+ * @return       Nothing
+ */
+template < typename... Fields, typename A >
+template < typename... Args >
+void SoaQueue<std::tuple<Fields...>, A>::emplace(Args&&... args) {
+    static_assert(sizeof...(Args) == kColumns,
+                  "SoaQueue emplace takes one argument per field");
+    if (size_ == capacity_) {
+        grow_and_store(std::forward_as_tuple(std::forward<Args>(args)...));
+    } else {
+        store(columns_, slot(size_),
+              std::forward_as_tuple(std::forward<Args>(args)...), indices());
+    }
+    ++size_;
+}
+
+/*
+ * @brief        Delete the front record in queue
+ * @param        None
+ * @return       Nothing
+ * @throws       runtime_error - if Queue empty
+ */
+template < typename... Fields, typename A >
+void SoaQueue<std::tuple<Fields...>, A>::pop() {
+    if (empty()) {
+        throw std::runtime_error("Queue empty");
+    }
+    head_ = slot(1);
+    --size_;
+}
+
+/*
+ * @brief        Copy the front record out of queue and delete it
+ * @param        None
+ * @return       The front record
+ * @throws       runtime_error - if Queue empty
+ */
+template < typename... Fields, typename A >
+typename SoaQueue<std::tuple<Fields...>, A>::value_type
+SoaQueue<std::tuple<Fields...>, A>::pop_value() {
+    if (empty()) {
+        throw std::runtime_error("Queue empty");
+    }
+    value_type val = copy_record(0, indices());
+    head_ = slot(1);
+    --size_;
+    return val;
+}
+
+/*
+ * @brief        Copy the front record out of queue, if any, and delete it
+ * @param        None
+ * @return       The front record, or an empty optional if Queue empty
+ */
+template < typename... Fields, typename A >
+std::optional<typename SoaQueue<std::tuple<Fields...>, A>::value_type>
+SoaQueue<std::tuple<Fields...>, A>::try_pop() {
+    if (empty()) {
+        return std::nullopt;
+    }
+    return pop_value();
+}
+
+/*
+ * @brief        Insert a range of records at the end of queue
+ * @param        The range, of records convertible to value_type
+ * @return       Nothing
+ */
+template < typename... Fields, typename A >
+template < typename InputIterator >
+void SoaQueue<std::tuple<Fields...>, A>::push_range(InputIterator first,
+                                                    InputIterator last) {
+    typedef typename std::iterator_traits<InputIterator>::iterator_category
+        category;
+    if (std::is_base_of<std::forward_iterator_tag, category>::value) {
+        reserve(size_ + std::distance(first, last));
+    }
+    for (; first != last; ++first) {
+        push(*first);
+    }
+}
+
+/*
+ * @brief        Copy the first n records out of queue and delete them
+ * @param        The no. of records, and where to write them
+ * @return       The output iterator past the last record written
+ * @throws       runtime_error - if Queue has fewer than n records, in
+ *               which case none is removed
+ */
+template < typename... Fields, typename A >
+template < typename OutputIterator >
+OutputIterator SoaQueue<std::tuple<Fields...>, A>::pop_n(size_type n,
+                                                         OutputIterator out) {
+    if (size_ < n) {
+        throw std::runtime_error("Queue empty");
+    }
+    for (size_type i = 0; i < n; ++i, ++out) {
+        *out = copy_record(i, indices());
+    }
+    head_ = slot(n);
+    size_ -= n;
+    return out;
+}
+
+/*
+ * @brief        The live items of one field, front first
+ * @param        None; I is the index of the field
+ * @return       A cursor over at most two contiguous runs
+ */
+template < typename... Fields, typename A >
+template < std::size_t I >
+SplitCursor< typename SoaQueue<std::tuple<Fields...>, A>::template field_type<I> >
+SoaQueue<std::tuple<Fields...>, A>::column() const {
+    const field_type<I>* items = std::get<I>(columns_);
+    size_type first = front_run();
+    return SplitCursor< field_type<I> >(items + head_, first, items,
+                                        size_ - first);
+}
+
+/*
+ * @brief        Delete every record, keeping the rings
+ */
+template < typename... Fields, typename A >
+void SoaQueue<std::tuple<Fields...>, A>::clear() {
+    head_ = 0;
+    size_ = 0;
+}
+
+/*
+ * @brief        Exchange the contents of two queues, with their allocators
+ * @param        The other queue
+ * @return       Nothing
+ */
+template < typename... Fields, typename A >
+void SoaQueue<std::tuple<Fields...>, A>::swap(SoaQueue& other) noexcept {
+    using std::swap;
+    swap(alloc_, other.alloc_);
+    swap(columns_, other.columns_);
+    swap(head_, other.head_);
+    swap(size_, other.size_);
+    swap(capacity_, other.capacity_);
+}
+
+/*
+ * @brief        Performs the equality test on operands, record by record
+ * @param        Two queue objects to be compared
+ * @return       true if equal
+ */
+template < typename Record, typename A >
+bool operator==(const SoaQueue<Record, A>& lhs, const SoaQueue<Record, A>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        if (!(lhs[i] == rhs[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * @brief        Performs the less than test on operands, comparing the
+ *               records front first as Queue does
+ * @param        Two queue objects to be compared
+ * @return       true if left is less than right operand
+ */
+template < typename Record, typename A >
+bool operator<(const SoaQueue<Record, A>& lhs, const SoaQueue<Record, A>& rhs) {
+    std::size_t n = std::min(lhs.size(), rhs.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        if (lhs[i] < rhs[i]) {
+            return true;
+        }
+        if (rhs[i] < lhs[i]) {
+            return false;
+        }
+    }
+    return lhs.size() < rhs.size();
+}
+
+template < typename Record, typename A >
+bool operator!=(const SoaQueue<Record, A>& lhs, const SoaQueue<Record, A>& rhs) {
+    return !(lhs == rhs);
+}
+
+template < typename Record, typename A >
+bool operator<=(const SoaQueue<Record, A>& lhs, const SoaQueue<Record, A>& rhs) {
+    return !(rhs < lhs);
+}
+
+template < typename Record, typename A >
+bool operator>(const SoaQueue<Record, A>& lhs, const SoaQueue<Record, A>& rhs) {
+    return rhs < lhs;
+}
+
+template < typename Record, typename A >
+bool operator>=(const SoaQueue<Record, A>& lhs, const SoaQueue<Record, A>& rhs) {
+    return !(lhs < rhs);
+}
+
+/*
+ * @brief        Exchange two queues, found through ADL
+ * @param        Two queue objects to be swapped
+ * @return       Nothing
+ */
+template < typename Record, typename A >
+void swap(SoaQueue<Record, A>& lhs, SoaQueue<Record, A>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+#endif
@@ -0,0 +1,212 @@
+/**
+ *  @brief      Bounded lock-free single-producer/single-consumer queue
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_SPSCQUEUE_H_
+#define _INCLUDE_SPSCQUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+/*
+ * @brief  The SPSC ring buffer queue class
+ *
+ * Elements are stored in a power-of-two ring allocated once at
+ * construction, so try_push and try_pop never allocate. Exactly one
+ * thread may act as producer (try_push) and exactly one thread as
+ * consumer (front, try_pop, pop); the two synchronize only through
+ * acquire/release on the head and tail indices.
+ *
+ * The head and tail indices live on separate cache lines, each next to
+ * a private copy of the other side's index, so that the producer and
+ * the consumer only touch each other's line when the ring looks full
+ * or empty.
+ *
+ * The requested capacity is rounded up to the next power of two.
+ */
+template < typename T >
+class SpscQueue {
+ private:
+    typedef std::size_t size_type;
+    static const size_type kCacheLine = 64;
+
+    /// consumer side: next slot to read and last tail seen
+    alignas(kCacheLine) std::atomic<size_type> head_;
+    size_type cached_tail_;
+
+    /// producer side: next slot to write and last head seen
+    alignas(kCacheLine) std::atomic<size_type> tail_;
+    size_type cached_head_;
+
+    /// read-only after construction
+    alignas(kCacheLine) size_type mask_;
+    T* slots_;
+
+    SpscQueue(const SpscQueue&);
+    SpscQueue& operator=(const SpscQueue&);
+
+ public:
+    explicit SpscQueue(size_type capacity);
+    ~SpscQueue();
+    bool empty() const;
+    size_type size() const;
+    size_type capacity() const;
+    bool try_push(const T& val);
+    bool try_push(T&& val);
+    T* front();
+    bool try_pop(T& val);
+    void pop();
+};
+
+/*
+ * @brief        Constructor, allocates the ring
+ * @param        Minimum number of items the queue can hold
+ * @throws       runtime_error if no power of two holds capacity items
+ */
+template < typename T >
+SpscQueue<T>::SpscQueue(size_type capacity)
+    : head_(0), cached_tail_(0), tail_(0), cached_head_(0), mask_(0), slots_(0) {
+    if (capacity > (~size_type(0) >> 1) + 1) {
+        throw std::runtime_error("SpscQueue capacity too large");
+    }
+    size_type rounded = 1;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    mask_ = rounded - 1;
+    slots_ = std::allocator<T>().allocate(rounded);
+}
+
+/*
+ * @brief        Destructor, destroys remaining items and frees the ring
+ */
+template < typename T >
+SpscQueue<T>::~SpscQueue() {
+    size_type head = head_.load(std::memory_order_relaxed);
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    for (; head != tail; ++head) {
+        slots_[head & mask_].~T();
+    }
+    std::allocator<T>().deallocate(slots_, mask_ + 1);
+}
+
+/*
+ * @brief        Test whether queue is empty
+ * @param        None
+ * @return       true if queue empty at the time of the call
+ */
+template < typename T >
+bool SpscQueue<T>::empty() const {
+    return head_.load(std::memory_order_acquire) ==
+           tail_.load(std::memory_order_acquire);
+}
+
+/*
+ * @brief        Get size of queue, i.e. no. of items
+ * @param        None
+ * @return       The number of items at the time of the call
+ */
+template < typename T >
+typename SpscQueue<T>::size_type SpscQueue<T>::size() const {
+    size_type head = head_.load(std::memory_order_acquire);
+    size_type tail = tail_.load(std::memory_order_acquire);
+    return tail - head;
+}
+
+/*
+ * @brief        Get the fixed capacity of the ring
+ * @param        None
+ * @return       The maximum number of items the queue can hold
+ */
+template < typename T >
+typename SpscQueue<T>::size_type SpscQueue<T>::capacity() const {
+    return mask_ + 1;
+}
+
+/*
+ * @brief        Add a new item at end of queue, producer only
+ * @param        The item
+ * @return       false if the queue is full
+ */
+template < typename T >
+bool SpscQueue<T>::try_push(const T& val) {
+    T copy(val);
+    return try_push(std::move(copy));
+}
+
+/*
+ * @brief        Move a new item to end of queue, producer only
+ * @param        The item
+ * @return       false if the queue is full, val is left untouched
+ */
+template < typename T >
+bool SpscQueue<T>::try_push(T&& val) {
+    const size_type tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cached_head_ > mask_) {
+        cached_head_ = head_.load(std::memory_order_acquire);
+        if (tail - cached_head_ > mask_) {
+            return false;
+        }
+    }
+    ::new (static_cast<void*>(&slots_[tail & mask_])) T(std::move(val));
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+/*
+ * @brief        Access the front item in queue, consumer only
+ * @param        None
+ * @return       Pointer to the front item, or null if queue empty
+ */
+template < typename T >
+T* SpscQueue<T>::front() {
+    const size_type head = head_.load(std::memory_order_relaxed);
+    if (head == cached_tail_) {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        if (head == cached_tail_) {
+            return 0;
+        }
+    }
+    return &slots_[head & mask_];
+}
+
+/*
+ * @brief        Move the front item out of queue, consumer only
+ * @param        Destination of the item
+ * @return       false if the queue is empty
+ */
+template < typename T >
+bool SpscQueue<T>::try_pop(T& val) {
+    T* item = front();
+    if (!item) {
+        return false;
+    }
+    val = std::move(*item);
+    pop();
+    return true;
+}
+
+/*
+ * @brief        Delete the front item in queue, consumer only
+ * @param        None
+ * @return       Nothing
+ *
+ * Must only be called after front() returned an item.
+ */
+template < typename T >
+void SpscQueue<T>::pop() {
+    const size_type head = head_.load(std::memory_order_relaxed);
+    slots_[head & mask_].~T();
+    head_.store(head + 1, std::memory_order_release);
+}
+
+#endif
@@ -0,0 +1,333 @@
+/**
+ *  @brief      Queue with a fixed capacity chosen at compile time
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_STATICQUEUE_H_
+#define _INCLUDE_STATICQUEUE_H_
+
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include "staticring.h"
+
+/*
+ * @brief  The fixed-capacity queue class
+ *
+ * Mirrors the Queue interface on a StaticRing of N items kept inside
+ * the object: it never allocates, and all of it is constexpr, so it can
+ * be used while building tables at compile time.
+ *
+ * Since it can fill up, push and emplace return whether the item was
+ * added. What a push does on a full queue is up to the Overflow policy:
+ *        OverflowError      return false (the default)
+ *        OverflowAssert     assert, and return false in release builds
+ *        OverflowOverwrite  drop the front item, the oldest, and return true
+ */
+
+ ///  Forward declaration of class is required for making
+ ///  operators == and < friends of StaticQueue class
+template < typename T, std::size_t N, typename Overflow >
+class StaticQueue;
+
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool operator==(const StaticQueue<T, N, Overflow>& lhs,
+                          const StaticQueue<T, N, Overflow>& rhs);
+
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool operator<(const StaticQueue<T, N, Overflow>& lhs,
+                         const StaticQueue<T, N, Overflow>& rhs);
+
+template < typename T, std::size_t N, typename Overflow = OverflowError >
+class StaticQueue {
+ private:
+    typedef std::size_t size_type;
+    StaticRing<T, N, Overflow> items_;
+
+ public:
+    constexpr StaticQueue() {}
+    constexpr bool empty() const;
+    constexpr bool full() const;
+    constexpr size_type size() const;
+    static constexpr size_type capacity();
+    constexpr T& front();
+    constexpr T& back();
+    constexpr T* try_front();
+    constexpr T& front_unchecked();
+    constexpr bool push(const T& val);
+    constexpr bool push(T&& val);
+    template < typename... Args >
+    constexpr bool emplace(Args&&... args);
+    constexpr void pop();
+    constexpr T pop_value();
+    constexpr std::optional<T> try_pop();
+    constexpr void swap(StaticQueue& other);
+
+    friend constexpr bool operator== <> (const StaticQueue& lhs,
+                                         const StaticQueue& rhs);
+    friend constexpr bool operator< <> (const StaticQueue& lhs,
+                                        const StaticQueue& rhs);
+};
+
+/*
+ * @brief        Test whether queue is empty
+ * @param        None
+ * @return       true if queue empty, false otherwise
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool StaticQueue<T, N, Overflow>::empty() const {
+    return items_.empty();
+}
+
+/*
+ * @brief        Test whether queue holds N items
+ * @param        None
+ * @return       true if the next push overflows
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool StaticQueue<T, N, Overflow>::full() const {
+    return items_.full();
+}
+
+/*
+ * @brief        Get size of queue, i.e. no. of items
+ * @param        None
+ * @return       The number of items in the queue
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr typename StaticQueue<T, N, Overflow>::size_type
+StaticQueue<T, N, Overflow>::size() const {
+    return items_.size();
+}
+
+/*
+ * @brief        Get the fixed capacity of queue
+ * @param        None
+ * @return       N
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr typename StaticQueue<T, N, Overflow>::size_type
+StaticQueue<T, N, Overflow>::capacity() {
+    return N;
+}
+
+/*
+ * @brief        Access the front item in queue
+ * @param        None
+ * @return       Reference to the front item
+ * @throws       runtime_error if queue is empty
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr T& StaticQueue<T, N, Overflow>::front() {
+    if (items_.empty()) {
+        throw std::runtime_error("Queue empty");
+    }
+    return items_.front();
+}
+
+/*
+ * @brief        Access the back item in queue
+ * @param        None
+ * @return       Reference to the back item
+ * @throws       runtime_error if queue is empty
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr T& StaticQueue<T, N, Overflow>::back() {
+    if (items_.empty()) {
+        throw std::runtime_error("Queue empty");
+    }
+    return items_.back();
+}
+
+/*
+ * @brief        Access the front item in queue if there is one
+ * @param        None
+ * @return       Pointer to the front item, or null if queue empty
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr T* StaticQueue<T, N, Overflow>::try_front() {
+    return items_.empty() ? 0 : &items_.front();
+}
+
+/*
+ * @brief        Access the front item in queue without checking
+ * @param        None
+ * @return       Reference to the front item; queue must not be empty
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr T& StaticQueue<T, N, Overflow>::front_unchecked() {
+    assert(!items_.empty() && "Queue empty");
+    return items_.front();
+}
+
+/*
+ * @brief        Add a new item at end of queue
+ * @param        The item
+ * @return       false if queue was full and the policy rejected the item
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool StaticQueue<T, N, Overflow>::push(const T& val) {
+    return items_.push_back(val);
+}
+
+/*
+ * @brief        Move a new item to end of queue
+ * @param        The item
+ * @return       false if queue was full and the policy rejected the item
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool StaticQueue<T, N, Overflow>::push(T&& val) {
+    return items_.push_back(std::move(val));
+}
+
+/*
+ * @brief        Construct a new item at end of queue
+ * @param        Arguments forwarded to the constructor of the item
+ * @return       false if queue was full and the policy rejected the item
+ */
+template < typename T, std::size_t N, typename Overflow >
+template < typename... Args >
+constexpr bool StaticQueue<T, N, Overflow>::emplace(Args&&... args) {
+    return items_.emplace_back(std::forward<Args>(args)...);
+}
+
+/*
+ * @brief        Delete the front item in queue
+ * @param        None
+ * @return       Nothing
+ * @throws       runtime_error if queue is empty
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr void StaticQueue<T, N, Overflow>::pop() {
+    if (items_.empty()) {
+        throw std::runtime_error("Queue empty");
+    }
+    items_.pop_front();
+}
+
+/*
+ * @brief        Move the front item out of queue and delete it
+ * @param        None
+ * @return       The front item
+ * @throws       runtime_error if queue is empty
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr T StaticQueue<T, N, Overflow>::pop_value() {
+    if (items_.empty()) {
+        throw std::runtime_error("Queue empty");
+    }
+    T val(std::move(items_.front()));
+    items_.pop_front();
+    return val;
+}
+
+/*
+ * @brief        Move the front item out of queue, if any, and delete it
+ * @param        None
+ * @return       The front item, or an empty optional if queue empty
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr std::optional<T> StaticQueue<T, N, Overflow>::try_pop() {
+    if (items_.empty()) {
+        return std::nullopt;
+    }
+    std::optional<T> val(std::move(items_.front()));
+    items_.pop_front();
+    return val;
+}
+
+/*
+ * @brief        Exchange the contents of two queues
+ * @param        The other queue
+ * @return       Nothing
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr void StaticQueue<T, N, Overflow>::swap(StaticQueue& other) {
+    items_.swap(other.items_);
+}
+
+/*
+ * @brief        Exchange the contents of two queues, found through ADL
+ * @param        Two queue objects to be swapped
+ * @return       Nothing
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr void swap(StaticQueue<T, N, Overflow>& lhs,
+                    StaticQueue<T, N, Overflow>& rhs) {
+    lhs.swap(rhs);
+}
+
+/*
+ * @brief        Performs the equality test on operands
+ * @param        Two queue objects to be compared
+ * @return       true if equal
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool operator==(const StaticQueue<T, N, Overflow>& lhs,
+                          const StaticQueue<T, N, Overflow>& rhs) {
+    return lhs.items_ == rhs.items_;
+}
+
+/*
+ * @brief        Performs the inequality test on operands
+ * @param        Two queue objects to be compared
+ * @return       true if unequal
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool operator!=(const StaticQueue<T, N, Overflow>& lhs,
+                          const StaticQueue<T, N, Overflow>& rhs) {
+    return !(lhs == rhs);
+}
+
+/*
+ * @brief        Performs the less than test on operands
+ * @param        Two queue objects to be compared
+ * @return       true if left is less than right operand
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool operator<(const StaticQueue<T, N, Overflow>& lhs,
+                         const StaticQueue<T, N, Overflow>& rhs) {
+    return lhs.items_ < rhs.items_;
+}
+
+/*
+ * @brief        Performs the less than or equal to test on operands
+ * @param        Two queue objects to be compared
+ * @return       true if left is less than or equal to right operand
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool operator<=(const StaticQueue<T, N, Overflow>& lhs,
+                          const StaticQueue<T, N, Overflow>& rhs) {
+    return !(rhs < lhs);
+}
+
+/*
+ * @brief        Performs the greater than or equal to test on operands
+ * @param        Two queue objects to be compared
+ * @return       true if left is greater than or equal to right operand
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool operator>=(const StaticQueue<T, N, Overflow>& lhs,
+                          const StaticQueue<T, N, Overflow>& rhs) {
+    return !(lhs < rhs);
+}
+
+/*
+ * @brief        Performs the greater than test on operands
+ * @param        Two queue objects to be compared
+ * @return       true if left is greater than right operand
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool operator>(const StaticQueue<T, N, Overflow>& lhs,
+                         const StaticQueue<T, N, Overflow>& rhs) {
+    return rhs < lhs;
+}
+
+#endif
@@ -0,0 +1,55 @@
+/** 
+ *  @brief      Asynchronous queue data structure testsuite header
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ * 
+ */
+
+#ifndef _INCLUDE_ASYNCQUEUETEST_H_
+#define _INCLUDE_ASYNCQUEUETEST_H_
+
+class AsyncQueueTestCase : public CppUnit::TestCase {
+ private:
+    CPPUNIT_TEST_SUITE(AsyncQueueTestCase);
+    CPPUNIT_TEST(test_pop_suspends_until_push);
+    CPPUNIT_TEST(test_ready_operations_do_not_suspend);
+    CPPUNIT_TEST(test_bounded_push_suspends_when_full);
+    CPPUNIT_TEST(test_consumers_woken_in_order);
+    CPPUNIT_TEST(test_close_wakes_waiters);
+    CPPUNIT_TEST(test_move_only_items);
+    CPPUNIT_TEST(test_resumes_through_given_executor);
+    CPPUNIT_TEST(test_event_loop_runs_in_order);
+    CPPUNIT_TEST_SUITE_END();
+
+    /// method to test that a consumer waits for a producer
+    void test_pop_suspends_until_push();
+
+    /// method to test that push and pop complete at once when they can
+    void test_ready_operations_do_not_suspend();
+
+    /// method to test the backpressure of a bounded queue
+    void test_bounded_push_suspends_when_full();
+
+    /// method to test that waiting consumers get items first come first
+    void test_consumers_woken_in_order();
+
+    /// method to test closing the queue with coroutines waiting
+    void test_close_wakes_waiters();
+
+    /// method to test handing over items which cannot be copied
+    void test_move_only_items();
+
+    /// method to test that woken coroutines go to the executor
+    void test_resumes_through_given_executor();
+
+    /// method to test the event loop on its own
+    void test_event_loop_runs_in_order();
+
+ public:
+    void setUp();
+    void tearDown();
+};
+
+#endif
@@ -0,0 +1,53 @@
+/** 
+ *  @brief      Blocking queue data structure testsuite header
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ * 
+ */
+
+#ifndef _INCLUDE_BLOCKINGQUEUETEST_H_
+#define _INCLUDE_BLOCKINGQUEUETEST_H_
+
+class BlockingQueueTestCase : public CppUnit::TestCase {
+ private:
+    CPPUNIT_TEST_SUITE(BlockingQueueTestCase);
+    CPPUNIT_TEST(test_push_and_pop_integers);
+    CPPUNIT_TEST(test_push_and_pop_strings_using_list);
+    CPPUNIT_TEST(test_push_bulk);
+    CPPUNIT_TEST(test_wait_pop_for_times_out);
+    CPPUNIT_TEST(test_wait_pop_wakes_on_push);
+    CPPUNIT_TEST(test_close_wakes_waiters);
+    CPPUNIT_TEST(test_close_drains_remaining_items);
+    CPPUNIT_TEST(test_push_after_close_throws);
+    CPPUNIT_TEST(test_producers_and_consumers);
+    CPPUNIT_TEST_SUITE_END();
+
+    /// method to test the push and pop of integers
+    void test_push_and_pop_integers();
+
+    /// method to test the push and pop of strings, using list
+    void test_push_and_pop_strings_using_list();
+
+    /// method to test pushing a batch of items
+    void test_push_bulk();
+
+    /// methods to test waiting for items
+    void test_wait_pop_for_times_out();
+    void test_wait_pop_wakes_on_push();
+
+    /// methods to test closing the queue
+    void test_close_wakes_waiters();
+    void test_close_drains_remaining_items();
+    void test_push_after_close_throws();
+
+    /// method to test a thread pool style hand-off
+    void test_producers_and_consumers();
+
+ public:
+    void setUp();
+    void tearDown();
+};
+
+#endif
@@ -0,0 +1,47 @@
+/** 
+ *  @brief      Circular queue data structure testsuite header
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ * 
+ */
+
+#ifndef _INCLUDE_CIRCULARQUEUETEST_H_
+#define _INCLUDE_CIRCULARQUEUETEST_H_
+
+class CircularQueueTestCase : public CppUnit::TestCase {
+ private:
+    CPPUNIT_TEST_SUITE(CircularQueueTestCase);
+    CPPUNIT_TEST(test_push_overwrites_oldest);
+    CPPUNIT_TEST(test_iterates_oldest_to_newest);
+    CPPUNIT_TEST(test_copy_to_across_wrap);
+    CPPUNIT_TEST(test_bulk_operations);
+    CPPUNIT_TEST(test_instrumented_latency_skips_dropped_items);
+    CPPUNIT_TEST(test_instrumented_push_range_counts_overwrites);
+    CPPUNIT_TEST_SUITE_END();
+
+    /// method to test that a full queue drops its front item on push
+    void test_push_overwrites_oldest();
+
+    /// method to test the iteration from the front item to the back one
+    void test_iterates_oldest_to_newest();
+
+    /// method to test the bulk snapshot when the items wrap around
+    void test_copy_to_across_wrap();
+
+    /// method to test push_range and pop_n on a circular queue
+    void test_bulk_operations();
+
+    /// method to test that dropped items leave no push time behind
+    void test_instrumented_latency_skips_dropped_items();
+
+    /// method to test that push_range counts the items it overwrites
+    void test_instrumented_push_range_counts_overwrites();
+
+ public:
+    void setUp();
+    void tearDown();
+};
+
+#endif
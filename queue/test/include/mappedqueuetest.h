@@ -0,0 +1,54 @@
+/** 
+ *  @brief      Memory-mapped queue data structure testsuite header
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ * 
+ */
+
+#ifndef _INCLUDE_MAPPEDQUEUETEST_H_
+#define _INCLUDE_MAPPEDQUEUETEST_H_
+
+#include <string>
+
+class MappedQueueTestCase : public CppUnit::TestCase {
+ private:
+    CPPUNIT_TEST_SUITE(MappedQueueTestCase);
+    CPPUNIT_TEST(test_push_and_pop_records);
+    CPPUNIT_TEST(test_records_live_in_the_mapping);
+    CPPUNIT_TEST(test_pop_throws_when_empty);
+    CPPUNIT_TEST(test_freed_slots_reused_after_flush);
+    CPPUNIT_TEST(test_reopen_recovers_flushed_state);
+    CPPUNIT_TEST(test_crash_keeps_last_flush);
+    CPPUNIT_TEST(test_reopen_after_half_written_header);
+    CPPUNIT_TEST(test_reopen_rejects_other_layout);
+    CPPUNIT_TEST_SUITE_END();
+
+    /// path of the spool file of each test, removed by tearDown
+    std::string path_;
+
+    /// method to test the push and pop of records, around the ring
+    void test_push_and_pop_records();
+
+    /// method to test that front and emplace work on the mapped slots
+    void test_records_live_in_the_mapping();
+
+    /// method to test the empty queue errors
+    void test_pop_throws_when_empty();
+
+    /// method to test that popped slots are not reused before a flush
+    void test_freed_slots_reused_after_flush();
+
+    /// methods to test that reopening a file takes up its queue
+    void test_reopen_recovers_flushed_state();
+    void test_crash_keeps_last_flush();
+    void test_reopen_after_half_written_header();
+    void test_reopen_rejects_other_layout();
+
+ public:
+    void setUp();
+    void tearDown();
+};
+
+#endif
@@ -0,0 +1,55 @@
+/** 
+ *  @brief      MPMC queue data structure testsuite header
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ * 
+ */
+
+#ifndef _INCLUDE_MPMCQUEUETEST_H_
+#define _INCLUDE_MPMCQUEUETEST_H_
+
+class MpmcQueueTestCase : public CppUnit::TestCase {
+ private:
+    CPPUNIT_TEST_SUITE(MpmcQueueTestCase);
+    CPPUNIT_TEST(test_push_and_pop_integers);
+    CPPUNIT_TEST(test_push_and_pop_strings);
+    CPPUNIT_TEST(test_capacity_rounded_to_power_of_two);
+    CPPUNIT_TEST(test_push_fails_when_full);
+    CPPUNIT_TEST(test_pop_fails_when_empty);
+    CPPUNIT_TEST(test_wrap_around);
+    CPPUNIT_TEST(test_many_producers_many_consumers);
+    CPPUNIT_TEST(test_throwing_push_does_not_stall);
+    CPPUNIT_TEST(test_throwing_pop_does_not_stall);
+    CPPUNIT_TEST_SUITE_END();
+
+    /// method to test the push and pop of integers
+    void test_push_and_pop_integers();
+
+    /// method to test the push and pop of strings
+    void test_push_and_pop_strings();
+
+    /// method to test the capacity rounding
+    void test_capacity_rounded_to_power_of_two();
+
+    /// methods to test the full and empty conditions
+    void test_push_fails_when_full();
+    void test_pop_fails_when_empty();
+
+    /// method to test the indices wrapping around the ring
+    void test_wrap_around();
+
+    /// method to test that no item is lost or duplicated under contention
+    void test_many_producers_many_consumers();
+
+    /// methods to test that exceptions from T hand the slot on
+    void test_throwing_push_does_not_stall();
+    void test_throwing_pop_does_not_stall();
+
+ public:
+    void setUp();
+    void tearDown();
+};
+
+#endif
@@ -0,0 +1,55 @@
+/** 
+ *  @brief      Pipeline testsuite header
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ * 
+ */
+
+#ifndef _INCLUDE_PIPELINETEST_H_
+#define _INCLUDE_PIPELINETEST_H_
+
+class PipelineTestCase : public CppUnit::TestCase {
+ private:
+    CPPUNIT_TEST_SUITE(PipelineTestCase);
+    CPPUNIT_TEST(test_pipeline_without_stages);
+    CPPUNIT_TEST(test_stages_change_item_types);
+    CPPUNIT_TEST(test_ordered_output_with_many_threads);
+    CPPUNIT_TEST(test_batches_sized_by_bytes);
+    CPPUNIT_TEST(test_backpressure_bounds_queues);
+    CPPUNIT_TEST(test_stats_show_bottleneck);
+    CPPUNIT_TEST(test_move_only_items);
+    CPPUNIT_TEST(test_misuse_throws_and_destructor_drains);
+    CPPUNIT_TEST_SUITE_END();
+
+    /// method to test that a pipeline without stages passes items through
+    void test_pipeline_without_stages();
+
+    /// method to test a chain of stages of different item types
+    void test_stages_change_item_types();
+
+    /// method to test the ordered option when stages run several threads
+    void test_ordered_output_with_many_threads();
+
+    /// method to test the no. of items per batch
+    void test_batches_sized_by_bytes();
+
+    /// method to test that a slow consumer holds back the producer
+    void test_backpressure_bounds_queues();
+
+    /// method to test the per-stage counters
+    void test_stats_show_bottleneck();
+
+    /// method to test items which cannot be copied
+    void test_move_only_items();
+
+    /// method to test errors and tearing down a busy pipeline
+    void test_misuse_throws_and_destructor_drains();
+
+ public:
+    void setUp();
+    void tearDown();
+};
+
+#endif
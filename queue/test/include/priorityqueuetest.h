@@ -0,0 +1,71 @@
+/** 
+ *  @brief      Priority queue data structure testsuite header
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ * 
+ */
+
+#ifndef _INCLUDE_PRIORITYQUEUETEST_H_
+#define _INCLUDE_PRIORITYQUEUETEST_H_
+
+class PriorityQueueTestCase : public CppUnit::TestCase {
+ private:
+    CPPUNIT_TEST_SUITE(PriorityQueueTestCase);
+    CPPUNIT_TEST(test_push_and_pop_chars);
+    CPPUNIT_TEST(test_push_and_pop_integers);
+    CPPUNIT_TEST(test_push_and_pop_strings);
+    CPPUNIT_TEST(test_push_and_pop_integers_using_deque);
+    CPPUNIT_TEST(test_push_and_pop_using_greater);
+    CPPUNIT_TEST(test_emplace_and_pop_value_move_only_items);
+    CPPUNIT_TEST(test_pop_throws_when_empty);
+    CPPUNIT_TEST(test_try_pop);
+    CPPUNIT_TEST(test_heapify_from_range);
+    CPPUNIT_TEST(test_heapify_adds_to_existing_items);
+    CPPUNIT_TEST(test_arities_match_std_priority_queue);
+    CPPUNIT_TEST(test_decrease_key_moves_item_up);
+    CPPUNIT_TEST(test_handles_follow_items_and_are_reused);
+    CPPUNIT_TEST(test_swap);
+    CPPUNIT_TEST_SUITE_END();
+
+    /// method to test the push and pop of chars
+    void test_push_and_pop_chars();
+
+    /// method to test the push and pop of integers
+    void test_push_and_pop_integers();
+
+    /// method to test the push and pop of strings
+    void test_push_and_pop_strings();
+
+    /// method to test the push and pop of integers, using deque
+    void test_push_and_pop_integers_using_deque();
+
+    /// method to test a min-heap, using std::greater
+    void test_push_and_pop_using_greater();
+
+    /// methods to test moving items in and out, and the empty cases
+    void test_emplace_and_pop_value_move_only_items();
+    void test_pop_throws_when_empty();
+    void test_try_pop();
+
+    /// methods to test the bottom-up construction of the heap
+    void test_heapify_from_range();
+    void test_heapify_adds_to_existing_items();
+
+    /// method to test binary, 4-ary and 8-ary heaps against the standard one
+    void test_arities_match_std_priority_queue();
+
+    /// methods to test decrease_key and the handles it takes
+    void test_decrease_key_moves_item_up();
+    void test_handles_follow_items_and_are_reused();
+
+    /// method to test swapping priority queues
+    void test_swap();
+
+ public:
+    void setUp();
+    void tearDown();
+};
+
+#endif
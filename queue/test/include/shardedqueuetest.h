@@ -0,0 +1,55 @@
+/** 
+ *  @brief      Sharded queue testsuite header
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ * 
+ */
+
+#ifndef _INCLUDE_SHARDEDQUEUETEST_H_
+#define _INCLUDE_SHARDEDQUEUETEST_H_
+
+class ShardedQueueTestCase : public CppUnit::TestCase {
+ private:
+    CPPUNIT_TEST_SUITE(ShardedQueueTestCase);
+    CPPUNIT_TEST(test_parse_cpulist);
+    CPPUNIT_TEST(test_detected_topology);
+    CPPUNIT_TEST(test_shards_per_policy);
+    CPPUNIT_TEST(test_fifo_per_shard);
+    CPPUNIT_TEST(test_steal_same_node_first);
+    CPPUNIT_TEST(test_local_push_and_pop);
+    CPPUNIT_TEST(test_bad_shard_throws);
+    CPPUNIT_TEST(test_concurrent_producers_and_consumers);
+    CPPUNIT_TEST_SUITE_END();
+
+    /// method to test reading kernel CPU lists
+    void test_parse_cpulist();
+
+    /// method to test that the machine's topology is usable
+    void test_detected_topology();
+
+    /// method to test the shard layout of each policy
+    void test_shards_per_policy();
+
+    /// method to test that items of one shard come out in order
+    void test_fifo_per_shard();
+
+    /// method to test the steal order and its counters
+    void test_steal_same_node_first();
+
+    /// method to test push and try_pop on the caller's CPU
+    void test_local_push_and_pop();
+
+    /// method to test that unknown shards are refused
+    void test_bad_shard_throws();
+
+    /// method to test many threads pushing and popping
+    void test_concurrent_producers_and_consumers();
+
+ public:
+    void setUp();
+    void tearDown();
+};
+
+#endif
@@ -0,0 +1,42 @@
+/** 
+ *  @brief      Vectorized comparisons testsuite header
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ * 
+ */
+
+#ifndef _INCLUDE_SIMDCOMPARETEST_H_
+#define _INCLUDE_SIMDCOMPARETEST_H_
+
+class SimdCompareTestCase : public CppUnit::TestCase {
+ private:
+    CPPUNIT_TEST_SUITE(SimdCompareTestCase);
+    CPPUNIT_TEST(test_kernels_match_scalar_on_integers);
+    CPPUNIT_TEST(test_kernels_match_scalar_on_floats);
+    CPPUNIT_TEST(test_kernels_handle_nan_and_signed_zero);
+    CPPUNIT_TEST(test_ring_queue_comparisons_match_generic);
+    CPPUNIT_TEST(test_unrolled_queue_comparisons_match_generic);
+    CPPUNIT_TEST(test_float_queue_comparisons_with_nan);
+    CPPUNIT_TEST_SUITE_END();
+
+    /// methods to test every kernel level against the scalar loop, with
+    /// the mismatch at every position of arrays of every length
+    void test_kernels_match_scalar_on_integers();
+    void test_kernels_match_scalar_on_floats();
+
+    /// method to test the float kernels follow == and < on NaN and -0.0
+    void test_kernels_handle_nan_and_signed_zero();
+
+    /// methods to test the vectorized Queue comparisons against deque's
+    void test_ring_queue_comparisons_match_generic();
+    void test_unrolled_queue_comparisons_match_generic();
+    void test_float_queue_comparisons_with_nan();
+
+ public:
+    void setUp();
+    void tearDown();
+};
+
+#endif
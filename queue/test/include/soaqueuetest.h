@@ -0,0 +1,59 @@
+/** 
+ *  @brief      Structure-of-arrays queue data structure testsuite header
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ * 
+ */
+
+#ifndef _INCLUDE_SOAQUEUETEST_H_
+#define _INCLUDE_SOAQUEUETEST_H_
+
+class SoaQueueTestCase : public CppUnit::TestCase {
+ private:
+    CPPUNIT_TEST_SUITE(SoaQueueTestCase);
+    CPPUNIT_TEST(test_push_and_pop_records);
+    CPPUNIT_TEST(test_emplace_and_update_through_front);
+    CPPUNIT_TEST(test_emplace_own_fields_while_growing);
+    CPPUNIT_TEST(test_growth_keeps_order_across_wrap);
+    CPPUNIT_TEST(test_columns_cover_live_records);
+    CPPUNIT_TEST(test_copy_move_and_swap);
+    CPPUNIT_TEST(test_relational_operators_match_queue);
+    CPPUNIT_TEST(test_push_range_pop_n_and_reserve);
+    CPPUNIT_TEST(test_push_and_pop_using_arena_allocator);
+    CPPUNIT_TEST_SUITE_END();
+
+    /// method to test the push and pop of whole records
+    void test_push_and_pop_records();
+
+    /// method to test emplace and writing fields through front
+    void test_emplace_and_update_through_front();
+
+    /// method to test emplacing fields of a full queue's own records
+    void test_emplace_own_fields_while_growing();
+
+    /// method to test that growing a wrapped ring keeps the records in order
+    void test_growth_keeps_order_across_wrap();
+
+    /// method to test that column runs hold exactly the live fields
+    void test_columns_cover_live_records();
+
+    /// method to test copy, move and swap
+    void test_copy_move_and_swap();
+
+    /// method to test the relational operators against those of Queue
+    void test_relational_operators_match_queue();
+
+    /// method to test the bulk operations and reserve
+    void test_push_range_pop_n_and_reserve();
+
+    /// method to test rings allocated from an arena
+    void test_push_and_pop_using_arena_allocator();
+
+ public:
+    void setUp();
+    void tearDown();
+};
+
+#endif
@@ -0,0 +1,51 @@
+/** 
+ *  @brief      Static queue data structure testsuite header
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ * 
+ */
+
+#ifndef _INCLUDE_STATICQUEUETEST_H_
+#define _INCLUDE_STATICQUEUETEST_H_
+
+class StaticQueueTestCase : public CppUnit::TestCase {
+ private:
+    CPPUNIT_TEST_SUITE(StaticQueueTestCase);
+    CPPUNIT_TEST(test_push_and_pop_integers);
+    CPPUNIT_TEST(test_push_and_pop_strings);
+    CPPUNIT_TEST(test_overflow_returns_false);
+    CPPUNIT_TEST(test_overflow_overwrites_oldest);
+    CPPUNIT_TEST(test_rejected_push_constructs_nothing);
+    CPPUNIT_TEST(test_ring_append_stops_when_full);
+    CPPUNIT_TEST(test_queue_over_full_ring_throws);
+    CPPUNIT_TEST(test_usable_in_constant_expressions);
+    CPPUNIT_TEST(test_relational_operators);
+    CPPUNIT_TEST_SUITE_END();
+
+    /// method to test the push and pop of integers
+    void test_push_and_pop_integers();
+
+    /// method to test the push and pop of strings across the end of the ring
+    void test_push_and_pop_strings();
+
+    /// methods to test the overflow policies
+    void test_overflow_returns_false();
+    void test_overflow_overwrites_oldest();
+    void test_rejected_push_constructs_nothing();
+    void test_ring_append_stops_when_full();
+    void test_queue_over_full_ring_throws();
+
+    /// method to test filling and draining a queue at compile time
+    void test_usable_in_constant_expressions();
+
+    /// method to test the relational operators on queues of integers
+    void test_relational_operators();
+
+ public:
+    void setUp();
+    void tearDown();
+};
+
+#endif
@@ -0,0 +1,318 @@
+/** 
+ *  @brief      Asynchronous queue data structure testsuite
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "asyncqueue.h"
+#include "executor.h"
+#include "asyncqueuetest.h"
+
+/// Pop until the queue is closed and drained, recording the items
+static Task consume(AsyncQueue<int>& q, std::vector<int>& out) {
+    while (std::optional<int> item = co_await q.pop()) {
+        out.push_back(*item);
+    }
+}
+
+/// Pop a single item
+static Task consume_one(AsyncQueue<int>& q, std::vector<int>& out, int tag) {
+    std::optional<int> item = co_await q.pop();
+    out.push_back(item ? tag * 100 + *item : -tag);
+}
+
+/// Push first..last-1, counting the pushes that completed
+static Task produce(AsyncQueue<int>& q, int first, int last, int& pushed) {
+    for (int i = first; i < last; ++i) {
+        co_await q.push(i);
+        ++pushed;
+    }
+}
+
+/// Executor counting the coroutines it is given, run by an event loop
+class CountingExecutor : public Executor {
+ public:
+    EventLoop loop;
+    int scheduled;
+
+    CountingExecutor() : scheduled(0) {}
+
+    void schedule(std::coroutine_handle<> handle) {
+        ++scheduled;
+        loop.schedule(handle);
+    }
+};
+
+void AsyncQueueTestCase::setUp() {
+}
+
+void AsyncQueueTestCase::tearDown() {
+}
+
+void AsyncQueueTestCase::test_pop_suspends_until_push() {
+    EventLoop loop;
+    AsyncQueue<int> q(loop);
+    std::vector<int> out;
+
+    Task consumer = consume(q, out);
+    consumer.start(loop);
+    CPPUNIT_ASSERT(1 == loop.run());
+    CPPUNIT_ASSERT(!consumer.done());
+    CPPUNIT_ASSERT(out.empty());
+
+    /// handed straight to the waiting consumer, not queued
+    CPPUNIT_ASSERT(q.try_push(7));
+    CPPUNIT_ASSERT(q.empty());
+    CPPUNIT_ASSERT(1 == loop.size());
+    loop.run();
+    CPPUNIT_ASSERT(std::vector<int>({7}) == out);
+
+    q.close();
+    loop.run();
+    CPPUNIT_ASSERT(consumer.done());
+    consumer.result();
+}
+
+void AsyncQueueTestCase::test_ready_operations_do_not_suspend() {
+    EventLoop loop;
+    AsyncQueue<int> q(loop);
+    int pushed = 0;
+    std::vector<int> out;
+
+    Task producer = produce(q, 0, 100, pushed);
+    producer.start(loop);
+    CPPUNIT_ASSERT(1 == loop.run());
+    CPPUNIT_ASSERT(producer.done());
+    CPPUNIT_ASSERT(100 == q.size());
+
+    q.close();
+    Task consumer = consume(q, out);
+    consumer.start(loop);
+    CPPUNIT_ASSERT(1 == loop.run());
+    CPPUNIT_ASSERT(consumer.done());
+    CPPUNIT_ASSERT(100 == out.size());
+    CPPUNIT_ASSERT(99 == out.back());
+}
+
+void AsyncQueueTestCase::test_bounded_push_suspends_when_full() {
+    EventLoop loop;
+    AsyncQueue<int> q(loop, 2);
+    int pushed = 0;
+    std::vector<int> out;
+
+    CPPUNIT_ASSERT_THROW(AsyncQueue<int>(loop, 0), std::runtime_error);
+    CPPUNIT_ASSERT(2 == q.capacity());
+
+    Task producer = produce(q, 0, 5, pushed);
+    producer.start(loop);
+    loop.run();
+    CPPUNIT_ASSERT(2 == pushed);
+    CPPUNIT_ASSERT(2 == q.size());
+    CPPUNIT_ASSERT(!producer.done());
+    CPPUNIT_ASSERT(!q.try_push(99));
+
+    /// each pop takes the suspended producer's item in
+    CPPUNIT_ASSERT(0 == *q.try_pop());
+    CPPUNIT_ASSERT(2 == q.size());
+    loop.run();
+    CPPUNIT_ASSERT(3 == pushed);
+
+    Task consumer = consume(q, out);
+    consumer.start(loop);
+    loop.run();
+    CPPUNIT_ASSERT(producer.done());
+    CPPUNIT_ASSERT(5 == pushed);
+    CPPUNIT_ASSERT(std::vector<int>({1, 2, 3, 4}) == out);
+    CPPUNIT_ASSERT(!consumer.done());
+    q.close();
+    loop.run();
+    CPPUNIT_ASSERT(consumer.done());
+}
+
+void AsyncQueueTestCase::test_consumers_woken_in_order() {
+    EventLoop loop;
+    AsyncQueue<int> q(loop);
+    std::vector<int> out;
+
+    std::vector<Task> consumers;
+    for (int tag = 1; tag <= 3; ++tag) {
+        consumers.push_back(consume_one(q, out, tag));
+        consumers.back().start(loop);
+    }
+    loop.run();
+
+    CPPUNIT_ASSERT(q.try_push(5));
+    CPPUNIT_ASSERT(q.try_push(6));
+    loop.run();
+    CPPUNIT_ASSERT(std::vector<int>({105, 206}) == out);
+
+    q.close();
+    loop.run();
+    CPPUNIT_ASSERT(std::vector<int>({105, 206, -3}) == out);
+    for (const Task& consumer : consumers) {
+        CPPUNIT_ASSERT(consumer.done());
+    }
+}
+
+void AsyncQueueTestCase::test_close_wakes_waiters() {
+    EventLoop loop;
+    AsyncQueue<int> q(loop, 1);
+    int pushed = 0;
+
+    Task producer = produce(q, 0, 3, pushed);
+    producer.start(loop);
+    loop.run();
+    CPPUNIT_ASSERT(1 == pushed);
+
+    q.close();
+    CPPUNIT_ASSERT(q.closed());
+    loop.run();
+    CPPUNIT_ASSERT(producer.done());
+    CPPUNIT_ASSERT(1 == pushed);
+    CPPUNIT_ASSERT_THROW(producer.result(), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(q.try_push(1), std::runtime_error);
+
+    /// the item queued before the close is still delivered
+    std::vector<int> out;
+    Task consumer = consume(q, out);
+    consumer.start(loop);
+    loop.run();
+    CPPUNIT_ASSERT(consumer.done());
+    CPPUNIT_ASSERT(std::vector<int>({0}) == out);
+}
+
+/// Receive one move-only item into result
+static Task receive(AsyncQueue< std::unique_ptr<std::string> >& q,
+                    std::string& result) {
+    std::optional< std::unique_ptr<std::string> > item = co_await q.pop();
+    result = **item;
+}
+
+/// Send one move-only item
+static Task send(AsyncQueue< std::unique_ptr<std::string> >& q,
+                 const char* text) {
+    co_await q.push(std::unique_ptr<std::string>(new std::string(text)));
+}
+
+void AsyncQueueTestCase::test_move_only_items() {
+    EventLoop loop;
+    AsyncQueue< std::unique_ptr<std::string> > q(loop, 1);
+    std::string first;
+    std::string second;
+
+    Task a = send(q, "Red");
+    Task b = send(q, "Green");
+    a.start(loop);
+    b.start(loop);
+    loop.run();
+    CPPUNIT_ASSERT(a.done());
+    CPPUNIT_ASSERT(!b.done());
+
+    Task c = receive(q, first);
+    Task d = receive(q, second);
+    c.start(loop);
+    d.start(loop);
+    loop.run();
+    CPPUNIT_ASSERT(b.done() && c.done() && d.done());
+    CPPUNIT_ASSERT(std::string("Red") == first);
+    CPPUNIT_ASSERT(std::string("Green") == second);
+}
+
+void AsyncQueueTestCase::test_resumes_through_given_executor() {
+    CountingExecutor executor;
+    AsyncQueue<int> q(executor, 1);
+    std::vector<int> out;
+    int pushed = 0;
+
+    Task consumer = consume(q, out);
+    Task producer = produce(q, 0, 3, pushed);
+    consumer.start(executor);
+    executor.loop.run();
+    producer.start(executor);
+    CPPUNIT_ASSERT(2 == executor.scheduled);
+    executor.loop.run();
+
+    CPPUNIT_ASSERT(producer.done());
+    CPPUNIT_ASSERT(std::vector<int>({0, 1, 2}) == out);
+    /// every wake-up went through the executor, none ran inline
+    CPPUNIT_ASSERT(executor.scheduled > 2);
+    q.close();
+    executor.loop.run();
+    CPPUNIT_ASSERT(consumer.done());
+}
+
+/// Record tag, yield to the loop, and record it again
+static Task step_twice(std::vector<int>& out, int tag) {
+    out.push_back(tag);
+    co_await std::suspend_always();
+    out.push_back(tag);
+}
+
+void AsyncQueueTestCase::test_event_loop_runs_in_order() {
+    EventLoop loop;
+    std::vector<int> out;
+
+    CPPUNIT_ASSERT(!loop.run_one());
+    Task a = step_twice(out, 1);
+    Task b = step_twice(out, 2);
+    a.start(loop);
+    b.start(loop);
+    CPPUNIT_ASSERT(2 == loop.size());
+    CPPUNIT_ASSERT(loop.run_one());
+    CPPUNIT_ASSERT(std::vector<int>({1}) == out);
+    CPPUNIT_ASSERT(1 == loop.run());
+    CPPUNIT_ASSERT(loop.empty());
+
+    /// after a suspend_always, resuming is up to the caller
+    a.start(loop);
+    b.start(loop);
+    loop.run();
+    CPPUNIT_ASSERT(std::vector<int>({1, 2, 1, 2}) == out);
+    CPPUNIT_ASSERT(a.done() && b.done());
+}
+
+CppUnit::Test *suite() {
+    CppUnit::TestFactoryRegistry &registry =
+                      CppUnit::TestFactoryRegistry::getRegistry();
+
+    return registry.makeTest();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(AsyncQueueTestCase);
+
+int main(int argc, char* argv[]) {
+    CppUnit::TestResult controller;
+
+    CppUnit::TestResultCollector result;
+    controller.addListener(&result);
+
+    CppUnit::BriefTestProgressListener progressListener;
+    controller.addListener(&progressListener);
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite());  /// Add the top suite to the test runner
+
+    /// Run the test
+    runner.run(controller);
+
+    /// Return error code 1 if any tests failed
+    return result.wasSuccessful() ? 0 : 1;
+}
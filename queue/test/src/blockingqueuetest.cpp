@@ -0,0 +1,229 @@
+/** 
+ *  @brief      Blocking queue data structure testsuite
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "blockingqueue.h"
+#include "blockingqueuetest.h"
+
+void BlockingQueueTestCase::setUp() {
+}
+
+void BlockingQueueTestCase::tearDown() {
+}
+
+void BlockingQueueTestCase::test_push_and_pop_integers() {
+    BlockingQueue< int > q_of_ints;
+    int val = 0;
+
+    q_of_ints.push(10);
+    q_of_ints.push(20);
+    q_of_ints.push(30);
+    CPPUNIT_ASSERT(3 == q_of_ints.size());
+
+    CPPUNIT_ASSERT(q_of_ints.wait_pop(val));
+    CPPUNIT_ASSERT(10 == val);
+
+    CPPUNIT_ASSERT(q_of_ints.try_pop(val));
+    CPPUNIT_ASSERT(20 == val);
+
+    CPPUNIT_ASSERT(q_of_ints.wait_pop_for(val, std::chrono::milliseconds(1)));
+    CPPUNIT_ASSERT(30 == val);
+
+    CPPUNIT_ASSERT(q_of_ints.empty());
+    CPPUNIT_ASSERT(!q_of_ints.try_pop(val));
+}
+
+void BlockingQueueTestCase::test_push_and_pop_strings_using_list() {
+    BlockingQueue< std::string, std::list<std::string> > q_of_strings;
+    std::string val;
+
+    q_of_strings.push("Red");
+    q_of_strings.push("Green");
+
+    CPPUNIT_ASSERT(q_of_strings.wait_pop(val));
+    CPPUNIT_ASSERT("Red" == val);
+
+    CPPUNIT_ASSERT(q_of_strings.wait_pop(val));
+    CPPUNIT_ASSERT("Green" == val);
+}
+
+void BlockingQueueTestCase::test_push_bulk() {
+    BlockingQueue< int > q_of_ints;
+    int items[] = { 10, 20, 30, 40 };
+    int val = 0;
+
+    q_of_ints.push_bulk(items, items + 4);
+    CPPUNIT_ASSERT(4 == q_of_ints.size());
+
+    for (int i = 0; i < 4; ++i) {
+        CPPUNIT_ASSERT(q_of_ints.wait_pop(val));
+        CPPUNIT_ASSERT(items[i] == val);
+    }
+}
+
+void BlockingQueueTestCase::test_wait_pop_for_times_out() {
+    BlockingQueue< int > q_of_ints;
+    int val = -1;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    CPPUNIT_ASSERT(!q_of_ints.wait_pop_for(val, std::chrono::milliseconds(20)));
+    CPPUNIT_ASSERT(std::chrono::steady_clock::now() - start >=
+                   std::chrono::milliseconds(20));
+    CPPUNIT_ASSERT(-1 == val);  /// untouched
+}
+
+void BlockingQueueTestCase::test_wait_pop_wakes_on_push() {
+    BlockingQueue< int > q_of_ints;
+    int val = 0;
+
+    std::thread producer([&q_of_ints]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        q_of_ints.push(42);
+    });
+
+    CPPUNIT_ASSERT(q_of_ints.wait_pop(val));
+    CPPUNIT_ASSERT(42 == val);
+    producer.join();
+}
+
+void BlockingQueueTestCase::test_close_wakes_waiters() {
+    BlockingQueue< int > q_of_ints;
+    std::atomic<int> woken(0);
+    std::vector<std::thread> consumers;
+
+    for (int i = 0; i < 4; ++i) {
+        consumers.push_back(std::thread([&q_of_ints, &woken]() {
+            int val = 0;
+            if (!q_of_ints.wait_pop(val)) {
+                ++woken;
+            }
+        }));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    q_of_ints.close();
+    for (size_t i = 0; i < consumers.size(); ++i) {
+        consumers[i].join();
+    }
+
+    CPPUNIT_ASSERT(4 == woken.load());
+    CPPUNIT_ASSERT(q_of_ints.closed());
+}
+
+void BlockingQueueTestCase::test_close_drains_remaining_items() {
+    BlockingQueue< int > q_of_ints;
+    int val = 0;
+
+    q_of_ints.push(10);
+    q_of_ints.push(20);
+    q_of_ints.close();
+
+    CPPUNIT_ASSERT(q_of_ints.wait_pop(val));
+    CPPUNIT_ASSERT(10 == val);
+    CPPUNIT_ASSERT(q_of_ints.wait_pop_for(val, std::chrono::seconds(1)));
+    CPPUNIT_ASSERT(20 == val);
+
+    CPPUNIT_ASSERT(!q_of_ints.wait_pop(val));  /// closed and drained
+}
+
+void BlockingQueueTestCase::test_push_after_close_throws() {
+    BlockingQueue< int > q_of_ints;
+    int items[] = { 10, 20 };
+
+    q_of_ints.close();
+
+    CPPUNIT_ASSERT_THROW(q_of_ints.push(10), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(q_of_ints.push_bulk(items, items + 2), std::runtime_error);
+    CPPUNIT_ASSERT(q_of_ints.empty());
+}
+
+void BlockingQueueTestCase::test_producers_and_consumers() {
+    const int threads = 4;
+    const int per_thread = 10000;
+    BlockingQueue< int > q_of_ints;
+    std::atomic<long> sum(0);
+    std::atomic<int> count(0);
+    std::vector<std::thread> producers;
+    std::vector<std::thread> consumers;
+
+    for (int t = 0; t < threads; ++t) {
+        consumers.push_back(std::thread([&]() {
+            int val = 0;
+            while (q_of_ints.wait_pop(val)) {
+                sum += val;
+                ++count;
+            }
+        }));
+    }
+    for (int t = 0; t < threads; ++t) {
+        producers.push_back(std::thread([&q_of_ints, per_thread]() {
+            int batch[10];
+            for (int i = 0; i < per_thread; i += 10) {
+                for (int j = 0; j < 10; ++j) {
+                    batch[j] = i + j;
+                }
+                q_of_ints.push_bulk(batch, batch + 10);
+            }
+        }));
+    }
+    for (size_t i = 0; i < producers.size(); ++i) {
+        producers[i].join();
+    }
+    q_of_ints.close();
+    for (size_t i = 0; i < consumers.size(); ++i) {
+        consumers[i].join();
+    }
+
+    long expected = long(threads) * per_thread * (per_thread - 1) / 2;
+    CPPUNIT_ASSERT(threads * per_thread == count.load());
+    CPPUNIT_ASSERT(expected == sum.load());
+}
+
+CppUnit::Test *suite() {
+    CppUnit::TestFactoryRegistry &registry =
+                      CppUnit::TestFactoryRegistry::getRegistry();
+
+    return registry.makeTest();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(BlockingQueueTestCase);
+
+int main(int argc, char* argv[]) {
+    CppUnit::TestResult controller;
+
+    CppUnit::TestResultCollector result;
+    controller.addListener(&result);
+
+    CppUnit::BriefTestProgressListener progressListener;
+    controller.addListener(&progressListener);
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite());  /// Add the top suite to the test runner
+
+    /// Run the test
+    runner.run(controller);
+
+    /// Return error code 1 if any tests failed
+    return result.wasSuccessful() ? 0 : 1;
+}
@@ -0,0 +1,175 @@
+/** 
+ *  @brief      Circular queue data structure testsuite
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "circularqueue.h"
+#include "circularqueuetest.h"
+
+void CircularQueueTestCase::setUp() {
+}
+
+void CircularQueueTestCase::tearDown() {
+}
+
+void CircularQueueTestCase::test_push_overwrites_oldest() {
+    CircularQueue< std::string, 3 > events;
+
+    events.push("start");
+    events.push("connect");
+    CPPUNIT_ASSERT(2 == events.size());
+    CPPUNIT_ASSERT("start" == events.front());
+
+    events.push("send");
+    events.push("timeout");  /// drops "start"
+    events.emplace(5, 'x');  /// drops "connect"
+    CPPUNIT_ASSERT(3 == events.size());
+    CPPUNIT_ASSERT("send" == events.front());
+    CPPUNIT_ASSERT("xxxxx" == events.back());
+
+    CPPUNIT_ASSERT("send" == events.pop_value());
+    events.push("retry");
+    CPPUNIT_ASSERT("timeout" == events.front());
+    CPPUNIT_ASSERT(3 == events.size());
+}
+
+void CircularQueueTestCase::test_iterates_oldest_to_newest() {
+    CircularQueue< int, 4 > q_of_ints;
+    CPPUNIT_ASSERT(q_of_ints.begin() == q_of_ints.end());
+
+    for (int i = 1; i <= 10; ++i) {
+        q_of_ints.push(i);
+    }
+
+    int expected = 7;
+    for (int item : q_of_ints) {
+        CPPUNIT_ASSERT(expected++ == item);
+    }
+    CPPUNIT_ASSERT(11 == expected);
+    CPPUNIT_ASSERT(4 == std::distance(q_of_ints.begin(), q_of_ints.end()));
+    CPPUNIT_ASSERT(10 == *--q_of_ints.end());
+}
+
+void CircularQueueTestCase::test_copy_to_across_wrap() {
+    CircularQueue< int, 5 > q_of_ints;
+    int snapshot[5];
+
+    for (int i = 0; i < 8; ++i) {
+        q_of_ints.push(i);
+    }
+    q_of_ints.pop();  /// items 4..7 are split across the end of the ring
+
+    int* last = q_of_ints.copy_to(snapshot);
+    CPPUNIT_ASSERT(snapshot + 4 == last);
+    CPPUNIT_ASSERT(4 == snapshot[0] && 5 == snapshot[1]);
+    CPPUNIT_ASSERT(6 == snapshot[2] && 7 == snapshot[3]);
+    CPPUNIT_ASSERT(4 == q_of_ints.size());
+
+    std::vector<int> copy;
+    q_of_ints.copy_to(std::back_inserter(copy));
+    CPPUNIT_ASSERT(std::vector<int>(q_of_ints.begin(), q_of_ints.end()) == copy);
+}
+
+void CircularQueueTestCase::test_bulk_operations() {
+    CircularQueue< int, 4 > q_of_ints;
+    int in[] = {1, 2, 3, 4, 5, 6};
+    int out[4];
+
+    q_of_ints.push_range(in, in + 6);
+    CPPUNIT_ASSERT(4 == q_of_ints.size());
+    CPPUNIT_ASSERT(3 == q_of_ints.front());
+
+    q_of_ints.pop_n(2, out);
+    CPPUNIT_ASSERT(3 == out[0] && 4 == out[1]);
+
+    q_of_ints.push_bulk(in, 3);  /// drops 5
+    int* last = q_of_ints.drain(out);
+    CPPUNIT_ASSERT(out + 4 == last);
+    CPPUNIT_ASSERT(6 == out[0] && 1 == out[1] && 3 == out[3]);
+    CPPUNIT_ASSERT(q_of_ints.empty());
+}
+
+void CircularQueueTestCase::test_instrumented_latency_skips_dropped_items() {
+    InstrumentedQueue< int, StaticRing<int, 4, OverflowOverwrite> > q_of_ints;
+
+    for (int i = 0; i < 100; ++i) {
+        q_of_ints.push(i);
+    }
+    while (!q_of_ints.empty()) {
+        q_of_ints.pop();
+    }
+
+    InstrumentationSnapshot stats = q_of_ints.stats();
+    CPPUNIT_ASSERT(100 == stats.pushes);
+    CPPUNIT_ASSERT(4 == stats.pops);
+    CPPUNIT_ASSERT(4 == stats.peak_size);
+    CPPUNIT_ASSERT(4 == stats.latency.count());
+}
+
+void CircularQueueTestCase::test_instrumented_push_range_counts_overwrites() {
+    InstrumentedQueue< int, StaticRing<int, 4, OverflowOverwrite> > q_of_ints;
+    int in[] = {1, 2, 3, 4, 5, 6, 7};
+
+    q_of_ints.push_range(in, in + 4);
+    q_of_ints.push_range(in + 4, in + 7);  /// full, overwrites 1 to 3
+    CPPUNIT_ASSERT(7 == q_of_ints.stats().pushes);
+
+    std::istringstream more("8 9");  /// single pass range
+    q_of_ints.push_range(std::istream_iterator<int>(more),
+                         std::istream_iterator<int>());
+    CPPUNIT_ASSERT(9 == q_of_ints.stats().pushes);
+    CPPUNIT_ASSERT(6 == q_of_ints.front());
+
+    while (!q_of_ints.empty()) {
+        q_of_ints.pop();
+    }
+    InstrumentationSnapshot stats = q_of_ints.stats();
+    CPPUNIT_ASSERT(4 == stats.pops);
+    CPPUNIT_ASSERT(4 == stats.latency.count());
+}
+
+CppUnit::Test *suite() {
+    CppUnit::TestFactoryRegistry &registry =
+                      CppUnit::TestFactoryRegistry::getRegistry();
+
+    return registry.makeTest();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(CircularQueueTestCase);
+
+int main(int argc, char* argv[]) {
+    CppUnit::TestResult controller;
+
+    CppUnit::TestResultCollector result;
+    controller.addListener(&result);
+
+    CppUnit::BriefTestProgressListener progressListener;
+    controller.addListener(&progressListener);
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite());  /// Add the top suite to the test runner
+
+    /// Run the test
+    runner.run(controller);
+
+    /// Return error code 1 if any tests failed
+    return result.wasSuccessful() ? 0 : 1;
+}
@@ -0,0 +1,402 @@
+/** 
+ *  @brief      Intrusive queue testsuite
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "intrusivequeue.h"
+#include "intrusivequeuetest.h"
+
+/// Count of operator new calls, to show pushes do not allocate
+static std::atomic<long> allocations(0);
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+/// Pooled message embedding its queue hook
+template < typename T >
+struct Item {
+    static int copies;
+    T value;
+    IntrusiveHook<Item> hook;
+
+    explicit Item(const T& v = T()) : value(v) {}
+    Item(const Item& other) : value(other.value), hook(other.hook) {
+        ++copies;
+    }
+
+    bool operator==(const Item& other) const { return value == other.value; }
+    bool operator<(const Item& other) const { return value < other.value; }
+};
+
+template < typename T >
+int Item<T>::copies = 0;
+
+/// Message which can sit in two queues at once
+struct Routed {
+    int id;
+    IntrusiveHook<Routed> by_arrival;
+    IntrusiveHook<Routed> by_priority;
+};
+
+/// Items with values from first, kept in a vector which never grows
+static std::vector< Item<int> > pool(int n, int first = 0) {
+    std::vector< Item<int> > items;
+    items.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        items.emplace_back(first + i);
+    }
+    return items;
+}
+
+void IntrusiveQueueTestCase::setUp() {
+}
+
+void IntrusiveQueueTestCase::tearDown() {
+}
+
+void IntrusiveQueueTestCase::test_push_and_pop_chars() {
+    Item<char> a('A'), b('B'), c('C'), z('Z');
+    IntrusiveQueue< Item<char> > q_of_chars;
+
+    q_of_chars.push(a);
+    q_of_chars.push(b);
+    q_of_chars.push(c);
+
+    CPPUNIT_ASSERT('A' == q_of_chars.front().value);
+
+    q_of_chars.pop();
+    CPPUNIT_ASSERT('B' == q_of_chars.front().value);
+
+    q_of_chars.pop();
+    CPPUNIT_ASSERT('C' == q_of_chars.front().value);
+    CPPUNIT_ASSERT('C' == q_of_chars.back().value);
+
+    q_of_chars.push(z);
+    CPPUNIT_ASSERT('Z' == q_of_chars.back().value);
+    CPPUNIT_ASSERT(2 == q_of_chars.size());
+}
+
+void IntrusiveQueueTestCase::test_push_and_pop_integers() {
+    std::vector< Item<int> > items = pool(100);
+    IntrusiveQueue< Item<int> > q_of_ints;
+
+    for (Item<int>& item : items) {
+        q_of_ints.push(item);
+    }
+    CPPUNIT_ASSERT(100 == q_of_ints.size());
+    CPPUNIT_ASSERT(99 == q_of_ints.back().value);
+
+    for (int i = 0; i < 100; ++i) {
+        CPPUNIT_ASSERT(i == q_of_ints.front().value);
+        CPPUNIT_ASSERT(&items[i] == &q_of_ints.front());
+        q_of_ints.pop();
+    }
+    CPPUNIT_ASSERT(q_of_ints.empty());
+    CPPUNIT_ASSERT_THROW(q_of_ints.pop(), std::runtime_error);
+}
+
+void IntrusiveQueueTestCase::test_push_and_pop_strings() {
+    Item<std::string> one("one"), two("two"), three("three");
+    IntrusiveQueue< Item<std::string> > q_of_strings;
+
+    q_of_strings.push(one);
+    q_of_strings.push(two);
+    q_of_strings.push(three);
+
+    std::string joined;
+    for (const Item<std::string>& item : q_of_strings) {
+        joined += item.value;
+    }
+    CPPUNIT_ASSERT("onetwothree" == joined);
+
+    q_of_strings.pop();
+    q_of_strings.push(one);
+    CPPUNIT_ASSERT("two" == q_of_strings.front().value);
+    CPPUNIT_ASSERT("one" == q_of_strings.back().value);
+}
+
+void IntrusiveQueueTestCase::test_equality_using_queue_of_integers() {
+    std::vector< Item<int> > left = pool(10), right = pool(10);
+    IntrusiveQueue< Item<int> > q1, q2;
+
+    CPPUNIT_ASSERT(q1 == q2);
+    for (int i = 0; i < 10; ++i) {
+        q1.push(left[i]);
+        q2.push(right[i]);
+    }
+    CPPUNIT_ASSERT(q1 == q2);
+    CPPUNIT_ASSERT(!(q1 != q2));
+
+    q2.pop();
+    CPPUNIT_ASSERT(q1 != q2);
+    q2.push(right[0]);
+    CPPUNIT_ASSERT(q1 != q2);
+}
+
+void IntrusiveQueueTestCase::test_ordering_using_queue_of_integers() {
+    std::vector< Item<int> > left = pool(5), right = pool(5, 1);
+    IntrusiveQueue< Item<int> > q1, q2;
+
+    for (int i = 0; i < 5; ++i) {
+        q1.push(left[i]);
+        q2.push(right[i]);
+    }
+    CPPUNIT_ASSERT(q1 < q2);
+    CPPUNIT_ASSERT(q1 <= q2);
+    CPPUNIT_ASSERT(q2 > q1);
+    CPPUNIT_ASSERT(q2 >= q1);
+    CPPUNIT_ASSERT(!(q2 < q1));
+
+    /// a prefix comes first
+    std::vector< Item<int> > prefix = pool(2);
+    q1.clear();
+    q2.clear();
+    q1.push(left[0]);
+    q2.push(prefix[0]);
+    q2.push(prefix[1]);
+    CPPUNIT_ASSERT(q1 < q2);
+    CPPUNIT_ASSERT(!(q2 <= q1));
+    q1.clear();
+    CPPUNIT_ASSERT(q1 < q2);
+    CPPUNIT_ASSERT(q1 <= q1);
+    CPPUNIT_ASSERT(q1 >= q1);
+}
+
+void IntrusiveQueueTestCase::test_push_and_pop_do_not_copy_or_allocate() {
+    std::vector< Item<std::string> > items;
+    items.reserve(1000);
+    for (int i = 0; i < 1000; ++i) {
+        items.emplace_back(std::string(32, 'a' + i % 26));
+    }
+    Item<std::string>::copies = 0;
+
+    IntrusiveQueue< Item<std::string> > q;
+    long before = allocations.load();
+    for (int round = 0; round < 3; ++round) {
+        for (Item<std::string>& item : items) {
+            q.push(item);
+        }
+        while (Item<std::string>* item = q.try_pop()) {
+            CPPUNIT_ASSERT(32 == item->value.size());
+        }
+    }
+    CPPUNIT_ASSERT(before == allocations.load());
+    CPPUNIT_ASSERT(0 == Item<std::string>::copies);
+
+    /// a copy of a queued item starts unlinked
+    q.push(items[0]);
+    q.push(items[1]);
+    Item<std::string> copy(items[0]);
+    CPPUNIT_ASSERT(!copy.hook.next);
+    CPPUNIT_ASSERT(&items[1] == items[0].hook.next);
+}
+
+void IntrusiveQueueTestCase::test_try_front_and_try_pop_when_empty() {
+    IntrusiveQueue< Item<int> > q;
+    const IntrusiveQueue< Item<int> >& cq = q;
+
+    CPPUNIT_ASSERT(!q.try_front());
+    CPPUNIT_ASSERT(!q.try_pop());
+    CPPUNIT_ASSERT(q.begin() == q.end());
+    CPPUNIT_ASSERT_THROW(q.front(), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(q.back(), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(cq.front(), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(cq.back(), std::runtime_error);
+
+    Item<int> item(7);
+    q.push(item);
+    CPPUNIT_ASSERT(&item == q.try_front());
+    CPPUNIT_ASSERT(7 == cq.front().value);
+    CPPUNIT_ASSERT(&item == q.try_pop());
+    CPPUNIT_ASSERT(!item.hook.next);
+    CPPUNIT_ASSERT(!q.try_pop());
+    CPPUNIT_ASSERT(0 == q.size());
+}
+
+void IntrusiveQueueTestCase::test_move_swap_splice_and_clear() {
+    std::vector< Item<int> > items = pool(6);
+    IntrusiveQueue< Item<int> > q1, q2;
+    q1.push(items[0]);
+    q1.push(items[1]);
+    q2.push(items[2]);
+    q2.push(items[3]);
+    q2.push(items[4]);
+
+    q1.swap(q2);
+    CPPUNIT_ASSERT(3 == q1.size());
+    CPPUNIT_ASSERT(2 == q1.front().value);
+    CPPUNIT_ASSERT(0 == q2.front().value);
+
+    q2.splice(q1);
+    CPPUNIT_ASSERT(q1.empty());
+    CPPUNIT_ASSERT(5 == q2.size());
+    q2.push(items[5]);
+    int expected = 0;
+    for (const Item<int>& item : q2) {
+        CPPUNIT_ASSERT(expected++ == item.value);
+    }
+    CPPUNIT_ASSERT(6 == expected);
+
+    q1.splice(q2);
+    CPPUNIT_ASSERT(6 == q1.size());
+    CPPUNIT_ASSERT(5 == q1.back().value);
+
+    IntrusiveQueue< Item<int> > q3(std::move(q1));
+    CPPUNIT_ASSERT(q1.empty());
+    CPPUNIT_ASSERT(6 == q3.size());
+    q2 = std::move(q3);
+    CPPUNIT_ASSERT(q3.empty());
+    CPPUNIT_ASSERT(0 == q2.front().value);
+
+    q2.clear();
+    CPPUNIT_ASSERT(q2.empty());
+    q2.push(items[3]);
+    CPPUNIT_ASSERT(1 == q2.size());
+    CPPUNIT_ASSERT(&items[3] == &q2.back());
+}
+
+void IntrusiveQueueTestCase::test_item_in_two_queues() {
+    Routed messages[4] = {{0, {}, {}}, {1, {}, {}}, {2, {}, {}}, {3, {}, {}}};
+    IntrusiveQueue<Routed, &Routed::by_arrival> arrivals;
+    IntrusiveQueue<Routed, &Routed::by_priority> urgent;
+
+    for (Routed& message : messages) {
+        arrivals.push(message);
+    }
+    urgent.push(messages[3]);
+    urgent.push(messages[1]);
+
+    CPPUNIT_ASSERT(3 == urgent.front().id);
+    CPPUNIT_ASSERT(0 == arrivals.front().id);
+    urgent.pop();
+    CPPUNIT_ASSERT(1 == urgent.front().id);
+    CPPUNIT_ASSERT(4 == arrivals.size());
+    CPPUNIT_ASSERT(3 == arrivals.back().id);
+}
+
+void IntrusiveQueueTestCase::test_mpsc_push_and_pop() {
+    std::vector< Item<int> > items = pool(10);
+    IntrusiveMpscQueue< Item<int> > q;
+
+    CPPUNIT_ASSERT(q.empty());
+    CPPUNIT_ASSERT(!q.try_pop());
+    for (int i = 0; i < 5; ++i) {
+        q.push(items[i]);
+    }
+    CPPUNIT_ASSERT(!q.empty());
+    CPPUNIT_ASSERT(0 == q.try_pop()->value);
+    CPPUNIT_ASSERT(1 == q.try_pop()->value);
+
+    /// items pushed while the consumer holds a batch come after it
+    for (int i = 5; i < 10; ++i) {
+        q.push(items[i]);
+    }
+    for (int i = 2; i < 10; ++i) {
+        Item<int>* item = q.try_pop();
+        CPPUNIT_ASSERT(item == &items[i]);
+        CPPUNIT_ASSERT(!item->hook.next);
+    }
+    CPPUNIT_ASSERT(!q.try_pop());
+    CPPUNIT_ASSERT(q.empty());
+}
+
+void IntrusiveQueueTestCase::test_mpsc_concurrent_producers() {
+    const int kProducers = 4, kItems = 20000;
+    std::vector< std::vector< Item<int> > > items;
+    for (int p = 0; p < kProducers; ++p) {
+        items.push_back(pool(kItems, p * kItems));
+    }
+    IntrusiveMpscQueue< Item<int> > q;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&q, &items, p] {
+            for (Item<int>& item : items[p]) {
+                q.push(item);
+            }
+        });
+    }
+
+    /// every item once, and each producer's in the order pushed
+    std::vector<int> last(kProducers, -1);
+    int popped = 0;
+    while (popped < kProducers * kItems) {
+        if (Item<int>* item = q.try_pop()) {
+            int p = item->value / kItems;
+            CPPUNIT_ASSERT(item->value > last[p]);
+            last[p] = item->value;
+            ++popped;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    for (int p = 0; p < kProducers; ++p) {
+        CPPUNIT_ASSERT((p + 1) * kItems - 1 == last[p]);
+    }
+    CPPUNIT_ASSERT(q.empty());
+}
+
+CppUnit::Test *suite() {
+    CppUnit::TestFactoryRegistry &registry =
+                      CppUnit::TestFactoryRegistry::getRegistry();
+
+    return registry.makeTest();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(IntrusiveQueueTestCase);
+
+int main(int argc, char* argv[]) {
+    CppUnit::TestResult controller;
+
+    CppUnit::TestResultCollector result;
+    controller.addListener(&result);
+
+    CppUnit::BriefTestProgressListener progressListener;
+    controller.addListener(&progressListener);
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite());  /// Add the top suite to the test runner
+
+    /// Run the test
+    runner.run(controller);
+
+    /// Return error code 1 if any tests failed
+    return result.wasSuccessful() ? 0 : 1;
+}
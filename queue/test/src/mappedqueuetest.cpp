@@ -0,0 +1,251 @@
+/** 
+ *  @brief      Memory-mapped queue data structure testsuite
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "mappedqueue.h"
+#include "mappedqueuetest.h"
+
+/// Outbound message record, as spooled
+struct Message {
+    long id;
+    int channel;
+    char body[52];
+
+    Message() {}
+    Message(long i, int c) : id(i), channel(c), body() {
+        body[0] = 'a' + i % 26;
+    }
+};
+
+void MappedQueueTestCase::setUp() {
+    char path[] = "/tmp/mappedqueuetest.XXXXXX";
+    int fd = mkstemp(path);
+    CPPUNIT_ASSERT(fd >= 0);
+    close(fd);
+    path_ = path;
+}
+
+void MappedQueueTestCase::tearDown() {
+    unlink(path_.c_str());
+}
+
+void MappedQueueTestCase::test_push_and_pop_records() {
+    MappedQueue<Message> spool(path_, 8);
+    CPPUNIT_ASSERT(spool.empty());
+    CPPUNIT_ASSERT(8 == spool.capacity());
+
+    /// go round the ring a few times
+    long next = 0;
+    for (long i = 0; i < 50; ++i) {
+        CPPUNIT_ASSERT(spool.push(Message(i, 1)));
+        if (spool.size() == 5) {
+            for (int j = 0; j < 3; ++j) {
+                Message m = spool.pop_value();
+                CPPUNIT_ASSERT(next++ == m.id);
+                CPPUNIT_ASSERT('a' + m.id % 26 == m.body[0]);
+            }
+            spool.flush();
+        }
+    }
+    CPPUNIT_ASSERT(49 == spool.back().id);
+    while (std::optional<Message> m = spool.try_pop()) {
+        CPPUNIT_ASSERT(next++ == m->id);
+    }
+    CPPUNIT_ASSERT(50 == next);
+}
+
+void MappedQueueTestCase::test_records_live_in_the_mapping() {
+    MappedQueue<Message> spool(path_, 4);
+
+    CPPUNIT_ASSERT(spool.emplace(7, 2));
+    Message* front = spool.try_front();
+    CPPUNIT_ASSERT(front == &spool.front());
+    CPPUNIT_ASSERT(7 == front->id && 2 == front->channel);
+
+    front->channel = 3;  /// updated in place
+    CPPUNIT_ASSERT(3 == spool.pop_value().channel);
+    CPPUNIT_ASSERT(0 == spool.try_front());
+}
+
+void MappedQueueTestCase::test_pop_throws_when_empty() {
+    MappedQueue<Message> spool(path_, 4);
+
+    CPPUNIT_ASSERT_THROW(spool.pop(), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(spool.pop_value(), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(spool.front(), std::runtime_error);
+    CPPUNIT_ASSERT(!spool.try_pop());
+}
+
+void MappedQueueTestCase::test_freed_slots_reused_after_flush() {
+    MappedQueue<long> spool(path_, 4);
+
+    for (long i = 0; i < 4; ++i) {
+        CPPUNIT_ASSERT(spool.push(i));
+    }
+    CPPUNIT_ASSERT(spool.full());
+    CPPUNIT_ASSERT(!spool.push(4));
+
+    /// the file still holds item 0 until the pop is flushed
+    spool.pop();
+    CPPUNIT_ASSERT(3 == spool.size());
+    CPPUNIT_ASSERT(!spool.push(4));
+
+    spool.flush();
+    CPPUNIT_ASSERT(spool.push(4));
+    CPPUNIT_ASSERT(spool.full());
+}
+
+void MappedQueueTestCase::test_reopen_recovers_flushed_state() {
+    {
+        MappedQueue<Message> spool(path_, 100);
+        for (long i = 0; i < 90; ++i) {
+            spool.push(Message(i, 1));
+        }
+        for (int i = 0; i < 10; ++i) {
+            spool.pop();
+        }
+    }  /// the destructor flushes
+
+    MappedQueue<Message> spool(path_, 100);
+    CPPUNIT_ASSERT(80 == spool.size());
+    CPPUNIT_ASSERT(10 == spool.front().id);
+    CPPUNIT_ASSERT(89 == spool.back().id);
+    CPPUNIT_ASSERT('a' + 89 % 26 == spool.back().body[0]);
+
+    /// and goes on from where it was
+    for (long i = 90; i < 110; ++i) {
+        CPPUNIT_ASSERT(spool.push(Message(i, 1)));
+    }
+    CPPUNIT_ASSERT(spool.full());
+    CPPUNIT_ASSERT(109 == spool.back().id);
+}
+
+void MappedQueueTestCase::test_crash_keeps_last_flush() {
+    pid_t child = fork();
+    CPPUNIT_ASSERT(child >= 0);
+    if (child == 0) {
+        MappedQueue<Message> spool(path_, 64);
+        for (long i = 0; i < 10; ++i) {
+            spool.push(Message(i, 1));
+        }
+        spool.flush();
+        for (long i = 10; i < 15; ++i) {
+            spool.push(Message(i, 1));
+        }
+        spool.pop();
+        _exit(0);  /// dies without flushing or unmapping
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    CPPUNIT_ASSERT(WIFEXITED(status) && 0 == WEXITSTATUS(status));
+
+    /// pushes since the flush are lost, the pop is undone
+    MappedQueue<Message> spool(path_, 64);
+    CPPUNIT_ASSERT(10 == spool.size());
+    CPPUNIT_ASSERT(0 == spool.front().id);
+    CPPUNIT_ASSERT(9 == spool.back().id);
+}
+
+void MappedQueueTestCase::test_reopen_after_half_written_header() {
+    {
+        MappedQueue<Message> spool(path_, 8);
+        for (long i = 0; i < 8; ++i) {
+            spool.push(Message(i, 1));
+        }
+        for (int i = 0; i < 6; ++i) {
+            spool.pop();
+        }
+        spool.flush();  /// head 6, tail 8
+        for (long i = 8; i < 14; ++i) {
+            CPPUNIT_ASSERT(spool.push(Message(i, 1)));
+        }
+        for (int i = 0; i < 4; ++i) {
+            spool.pop();
+        }
+    }  /// flushed on close: head 10, tail 14
+
+    /// a crash between the counter stores leaves the new tail only;
+    /// head is the 64-bit field after magic, version, item size and
+    /// capacity
+    int fd = open(path_.c_str(), O_WRONLY);
+    CPPUNIT_ASSERT(fd >= 0);
+    std::uint64_t old_head = 6;
+    CPPUNIT_ASSERT(sizeof(old_head) ==
+                   pwrite(fd, &old_head, sizeof(old_head), 24));
+    close(fd);
+
+    /// the file opens, and the items popped since come back
+    MappedQueue<Message> spool(path_, 8);
+    CPPUNIT_ASSERT(8 == spool.size());
+    for (long i = 6; i < 14; ++i) {
+        CPPUNIT_ASSERT(i == spool.pop_value().id);
+    }
+    CPPUNIT_ASSERT(spool.empty());
+}
+
+void MappedQueueTestCase::test_reopen_rejects_other_layout() {
+    {
+        MappedQueue<Message> spool(path_, 16);
+        spool.push(Message(1, 1));
+    }
+
+    CPPUNIT_ASSERT_THROW(MappedQueue<Message>(path_, 32), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(MappedQueue<long>(path_, 128), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(MappedQueue<long>("/nonexistent/dir/spool", 4),
+                         std::system_error);
+
+    MappedQueue<Message> spool(path_, 16);
+    CPPUNIT_ASSERT(1 == spool.size());
+}
+
+CppUnit::Test *suite() {
+    CppUnit::TestFactoryRegistry &registry =
+                      CppUnit::TestFactoryRegistry::getRegistry();
+
+    return registry.makeTest();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(MappedQueueTestCase);
+
+int main(int argc, char* argv[]) {
+    CppUnit::TestResult controller;
+
+    CppUnit::TestResultCollector result;
+    controller.addListener(&result);
+
+    CppUnit::BriefTestProgressListener progressListener;
+    controller.addListener(&progressListener);
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite());  /// Add the top suite to the test runner
+
+    /// Run the test
+    runner.run(controller);
+
+    /// Return error code 1 if any tests failed
+    return result.wasSuccessful() ? 0 : 1;
+}
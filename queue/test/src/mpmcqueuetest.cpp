@@ -0,0 +1,250 @@
+/** 
+ *  @brief      MPMC queue data structure testsuite
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mpmcqueue.h"
+#include "mpmcqueuetest.h"
+
+/// Item whose copy or move assignment throws while armed
+struct Fragile {
+    static bool throw_on_copy;
+    static bool throw_on_assign;
+    int value;
+
+    explicit Fragile(int v = 0) : value(v) {}
+    Fragile(const Fragile& other) : value(other.value) {
+        if (throw_on_copy) {
+            throw std::runtime_error("copy failed");
+        }
+    }
+    Fragile& operator=(Fragile&& other) {
+        if (throw_on_assign) {
+            throw std::runtime_error("assign failed");
+        }
+        value = other.value;
+        return *this;
+    }
+};
+
+bool Fragile::throw_on_copy = false;
+bool Fragile::throw_on_assign = false;
+
+void MpmcQueueTestCase::setUp() {
+}
+
+void MpmcQueueTestCase::tearDown() {
+}
+
+void MpmcQueueTestCase::test_push_and_pop_integers() {
+    MpmcQueue< int > q_of_ints(8);
+    int val = 0;
+
+    q_of_ints.push(10);
+    q_of_ints.push(20);
+    CPPUNIT_ASSERT(q_of_ints.try_push(30));
+    CPPUNIT_ASSERT(3 == q_of_ints.size());
+
+    q_of_ints.pop(val);
+    CPPUNIT_ASSERT(10 == val);
+
+    CPPUNIT_ASSERT(q_of_ints.try_pop(val));
+    CPPUNIT_ASSERT(20 == val);
+
+    CPPUNIT_ASSERT(q_of_ints.try_pop(val));
+    CPPUNIT_ASSERT(30 == val);
+    CPPUNIT_ASSERT(q_of_ints.empty());
+}
+
+void MpmcQueueTestCase::test_push_and_pop_strings() {
+    MpmcQueue< std::string > q_of_strings(4);
+    std::string val;
+
+    q_of_strings.push("Red");
+    q_of_strings.push(std::string("Green"));
+
+    q_of_strings.pop(val);
+    CPPUNIT_ASSERT("Red" == val);
+
+    /// remaining item is destroyed with the queue
+}
+
+void MpmcQueueTestCase::test_capacity_rounded_to_power_of_two() {
+    MpmcQueue< int > A(1), B(5), C(64);
+
+    CPPUNIT_ASSERT(2 == A.capacity());
+    CPPUNIT_ASSERT(8 == B.capacity());
+    CPPUNIT_ASSERT(64 == C.capacity());
+
+    /// no power of two holds more than half the range of size_t
+    std::size_t top = ~std::size_t(0);
+    CPPUNIT_ASSERT_THROW(MpmcQueue< int > D(top), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(MpmcQueue< int > E(top / 2 + 2),
+                         std::runtime_error);
+}
+
+void MpmcQueueTestCase::test_push_fails_when_full() {
+    MpmcQueue< int > q_of_ints(4);
+    int val = 0;
+
+    for (int i = 0; i < 4; ++i) {
+        CPPUNIT_ASSERT(q_of_ints.try_push(i));
+    }
+    CPPUNIT_ASSERT(!q_of_ints.try_push(99));  /// ring is full
+    CPPUNIT_ASSERT(4 == q_of_ints.size());
+
+    q_of_ints.pop(val);
+    CPPUNIT_ASSERT(q_of_ints.try_push(99));
+}
+
+void MpmcQueueTestCase::test_pop_fails_when_empty() {
+    MpmcQueue< int > q_of_ints(4);
+    int val = -1;
+
+    CPPUNIT_ASSERT(!q_of_ints.try_pop(val));
+    CPPUNIT_ASSERT(-1 == val);  /// untouched
+}
+
+void MpmcQueueTestCase::test_wrap_around() {
+    MpmcQueue< int > q_of_ints(4);
+    int val = 0;
+
+    for (int i = 0; i < 100; ++i) {
+        q_of_ints.push(i);
+        q_of_ints.push(i + 1000);
+        q_of_ints.pop(val);
+        CPPUNIT_ASSERT(i == val);
+        q_of_ints.pop(val);
+        CPPUNIT_ASSERT(i + 1000 == val);
+    }
+    CPPUNIT_ASSERT(q_of_ints.empty());
+}
+
+void MpmcQueueTestCase::test_many_producers_many_consumers() {
+    const int threads = 4;
+    const int per_thread = 20000;
+    MpmcQueue< int > q_of_ints(128);
+    std::vector<int> seen(threads * per_thread, 0);
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&q_of_ints, t, per_thread]() {
+            for (int i = 0; i < per_thread; ++i) {
+                q_of_ints.push(t * per_thread + i);
+            }
+        }));
+    }
+    for (int t = 0; t < threads; ++t) {
+        std::vector<int>* counts = &seen;
+        workers.push_back(std::thread([&q_of_ints, counts, per_thread]() {
+            int val = 0;
+            for (int i = 0; i < per_thread; ++i) {
+                q_of_ints.pop(val);
+                ++(*counts)[val];  /// values are unique, slots are disjoint
+            }
+        }));
+    }
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+
+    for (size_t i = 0; i < seen.size(); ++i) {
+        CPPUNIT_ASSERT(1 == seen[i]);  /// no loss, no duplicates
+    }
+    CPPUNIT_ASSERT(q_of_ints.empty());
+}
+
+void MpmcQueueTestCase::test_throwing_push_does_not_stall() {
+    MpmcQueue< Fragile > q(4);
+    Fragile val;
+
+    q.push(Fragile(1));
+    Fragile::throw_on_copy = true;
+    CPPUNIT_ASSERT_THROW(q.try_push(Fragile(2)), std::runtime_error);
+    Fragile::throw_on_copy = false;
+
+    /// the slot of the failed push is skipped, the ring keeps going
+    q.push(Fragile(3));
+    q.pop(val);
+    CPPUNIT_ASSERT(1 == val.value);
+    q.pop(val);
+    CPPUNIT_ASSERT(3 == val.value);
+    for (int i = 4; i < 20; ++i) {
+        q.push(Fragile(i));
+        q.pop(val);
+        CPPUNIT_ASSERT(i == val.value);
+    }
+    CPPUNIT_ASSERT(!q.try_pop(val));
+    CPPUNIT_ASSERT(q.empty());
+}
+
+void MpmcQueueTestCase::test_throwing_pop_does_not_stall() {
+    MpmcQueue< Fragile > q(4);
+    Fragile val;
+
+    for (int i = 0; i < 3; ++i) {
+        q.push(Fragile(i));
+    }
+    Fragile::throw_on_assign = true;
+    CPPUNIT_ASSERT_THROW(q.try_pop(val), std::runtime_error);
+    Fragile::throw_on_assign = false;
+
+    /// the item whose pop threw is dropped, the next ones come out
+    CPPUNIT_ASSERT(q.try_pop(val));
+    CPPUNIT_ASSERT(1 == val.value);
+    for (int i = 3; i < 20; ++i) {
+        q.push(Fragile(i));
+        q.pop(val);
+        CPPUNIT_ASSERT(i - 1 == val.value);
+    }
+    q.pop(val);
+    CPPUNIT_ASSERT(19 == val.value);
+    CPPUNIT_ASSERT(q.empty());
+}
+
+CppUnit::Test *suite() {
+    CppUnit::TestFactoryRegistry &registry =
+                      CppUnit::TestFactoryRegistry::getRegistry();
+
+    return registry.makeTest();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(MpmcQueueTestCase);
+
+int main(int argc, char* argv[]) {
+    CppUnit::TestResult controller;
+
+    CppUnit::TestResultCollector result;
+    controller.addListener(&result);
+
+    CppUnit::BriefTestProgressListener progressListener;
+    controller.addListener(&progressListener);
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite());  /// Add the top suite to the test runner
+
+    /// Run the test
+    runner.run(controller);
+
+    /// Return error code 1 if any tests failed
+    return result.wasSuccessful() ? 0 : 1;
+}
@@ -0,0 +1,291 @@
+/** 
+ *  @brief      Pipeline testsuite
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pipeline.h"
+#include "pipelinetest.h"
+
+/// Pop every result of a closed pipeline
+template < typename P, typename Out >
+static void drain(P& pipeline, std::vector<Out>& out) {
+    while (std::optional<Out> item = pipeline.pop()) {
+        out.push_back(std::move(*item));
+    }
+}
+
+/// Options for batches of n ints
+static PipelineOptions int_batches(std::size_t n, std::size_t queue_batches) {
+    PipelineOptions options;
+    options.batch_bytes = n * sizeof(int);
+    options.queue_batches = queue_batches;
+    return options;
+}
+
+void PipelineTestCase::setUp() {
+}
+
+void PipelineTestCase::tearDown() {
+}
+
+void PipelineTestCase::test_pipeline_without_stages() {
+    Pipeline<int> pipeline(int_batches(4, 8));
+    for (int i = 0; i < 10; ++i) {
+        pipeline.push(i);
+    }
+    pipeline.close();
+
+    std::vector<int> out;
+    drain(pipeline, out);
+    CPPUNIT_ASSERT(10 == out.size());
+    for (int i = 0; i < 10; ++i) {
+        CPPUNIT_ASSERT(i == out[i]);
+    }
+    CPPUNIT_ASSERT(!pipeline.pop());
+    CPPUNIT_ASSERT(pipeline.stats().empty());
+}
+
+void PipelineTestCase::test_stages_change_item_types() {
+    Pipeline<int, std::size_t> pipeline =
+        Pipeline<int>(int_batches(8, 2))
+            .stage("format", 2, [](int i) { return std::to_string(i); })
+            .stage("pad", 3, [](std::string s) { return s + "!"; })
+            .stage("measure", 1, [](const std::string& s) { return s.size(); });
+
+    std::thread producer([&] {
+        for (int i = 0; i < 1000; ++i) {
+            pipeline.push(i);
+        }
+        pipeline.close();
+    });
+    std::vector<std::size_t> out;
+    drain(pipeline, out);
+    producer.join();
+
+    CPPUNIT_ASSERT(1000 == out.size());
+    std::sort(out.begin(), out.end());
+    CPPUNIT_ASSERT(2 == out[0]);
+    CPPUNIT_ASSERT(2 == out[9]);
+    CPPUNIT_ASSERT(3 == out[10]);
+    CPPUNIT_ASSERT(4 == out[999]);
+    CPPUNIT_ASSERT(3 == pipeline.stats().size());
+}
+
+void PipelineTestCase::test_ordered_output_with_many_threads() {
+    PipelineOptions options = int_batches(4, 4);
+    options.ordered = true;
+    /// batches of some items take longer, so threads finish out of order
+    Pipeline<int> pipeline = Pipeline<int>(options).stage("jitter", 4, [](int i) {
+        if (i % 12 == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        return i * 2;
+    });
+
+    std::thread producer([&] {
+        for (int i = 0; i < 2000; ++i) {
+            pipeline.push(i);
+        }
+        pipeline.close();
+    });
+    std::vector<int> out;
+    drain(pipeline, out);
+    producer.join();
+
+    CPPUNIT_ASSERT(2000 == out.size());
+    for (int i = 0; i < 2000; ++i) {
+        CPPUNIT_ASSERT(2 * i == out[i]);
+    }
+}
+
+void PipelineTestCase::test_batches_sized_by_bytes() {
+    Pipeline<int> pipeline =
+        Pipeline<int>(int_batches(16, 16)).stage("id", 1, [](int i) { return i; });
+    for (int i = 0; i < 100; ++i) {
+        pipeline.push(i);
+    }
+    pipeline.close();
+    std::vector<int> out;
+    drain(pipeline, out);
+
+    std::vector<StageStats> stats = pipeline.stats();
+    CPPUNIT_ASSERT(100 == stats[0].items);
+    CPPUNIT_ASSERT(7 == stats[0].batches);
+    CPPUNIT_ASSERT(7 == stats[0].queue.pushes);
+    CPPUNIT_ASSERT(7 == pipeline.output_stats().pushes);
+
+    /// a batch never holds less than one item
+    PipelineOptions tiny;
+    tiny.batch_bytes = 1;
+    Pipeline<std::string> strings =
+        Pipeline<std::string>(tiny).stage("id", 1, [](std::string s) { return s; });
+    strings.push("a");
+    strings.push("b");
+    strings.close();
+    std::vector<std::string> words;
+    drain(strings, words);
+    CPPUNIT_ASSERT(2 == strings.stats()[0].batches);
+}
+
+void PipelineTestCase::test_backpressure_bounds_queues() {
+    Pipeline<int> pipeline = Pipeline<int>(int_batches(1, 2))
+                                 .stage("a", 1, [](int i) { return i + 1; })
+                                 .stage("b", 1, [](int i) { return i + 1; });
+    int pushed = 0;
+    std::thread producer([&] {
+        for (int i = 0; i < 50; ++i) {
+            pipeline.push(i);
+            ++pushed;
+        }
+        pipeline.close();
+    });
+
+    /// nothing popped: two batches per queue, one per thread and one pending
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::vector<StageStats> stats = pipeline.stats();
+    CPPUNIT_ASSERT(stats[0].queue_depth <= 2);
+    CPPUNIT_ASSERT(stats[1].queue_depth <= 2);
+
+    std::vector<int> out;
+    drain(pipeline, out);
+    producer.join();
+    CPPUNIT_ASSERT(50 == out.size());
+    CPPUNIT_ASSERT(50 == pushed);
+    stats = pipeline.stats();
+    CPPUNIT_ASSERT(stats[0].queue.peak_size <= 2);
+    CPPUNIT_ASSERT(stats[1].queue.peak_size <= 2);
+    CPPUNIT_ASSERT(pipeline.output_stats().peak_size <= 2);
+    CPPUNIT_ASSERT(stats[0].blocked_ns > 0);
+}
+
+void PipelineTestCase::test_stats_show_bottleneck() {
+    Pipeline<int> pipeline =
+        Pipeline<int>(int_batches(8, 2))
+            .stage("fast", 1, [](int i) { return i; })
+            .stage("slow", 1, [](int i) {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                return i;
+            })
+            .stage("after", 1, [](int i) { return i; });
+    std::thread producer([&] {
+        for (int i = 0; i < 400; ++i) {
+            pipeline.push(i);
+        }
+        pipeline.close();
+    });
+    std::vector<int> out;
+    drain(pipeline, out);
+    producer.join();
+
+    std::vector<StageStats> stats = pipeline.stats();
+    CPPUNIT_ASSERT(std::string("slow") == stats[1].name);
+    for (const StageStats& s : stats) {
+        CPPUNIT_ASSERT(400 == s.items);
+        CPPUNIT_ASSERT(50 == s.batches);
+        CPPUNIT_ASSERT(1 == s.threads);
+        CPPUNIT_ASSERT(s.elapsed_ns > 0);
+        CPPUNIT_ASSERT(s.items_per_second() > 0);
+    }
+    CPPUNIT_ASSERT(stats[1].utilization() > stats[0].utilization());
+    CPPUNIT_ASSERT(stats[1].utilization() > stats[2].utilization());
+    CPPUNIT_ASSERT(stats[1].busy_ns >= 400 * 50000ULL);
+    CPPUNIT_ASSERT(stats[2].starved_ns > stats[2].busy_ns);
+
+    /// a finished stage stops its clock
+    std::uint64_t elapsed = stats[1].elapsed_ns;
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    CPPUNIT_ASSERT(elapsed == pipeline.stats()[1].elapsed_ns);
+}
+
+void PipelineTestCase::test_move_only_items() {
+    typedef std::unique_ptr<int> Box;
+    Pipeline<Box, int> pipeline =
+        Pipeline<Box>(PipelineOptions())
+            .stage("bump", 2, [](Box b) { ++*b; return b; })
+            .stage("open", 1, [](Box b) { return *b; });
+    for (int i = 0; i < 100; ++i) {
+        pipeline.push(Box(new int(i)));
+    }
+    pipeline.close();
+    std::vector<int> out;
+    drain(pipeline, out);
+    std::sort(out.begin(), out.end());
+    CPPUNIT_ASSERT(100 == out.size());
+    CPPUNIT_ASSERT(1 == out.front());
+    CPPUNIT_ASSERT(100 == out.back());
+}
+
+void PipelineTestCase::test_misuse_throws_and_destructor_drains() {
+    Pipeline<int> started = Pipeline<int>().stage("id", 1, [](int i) { return i; });
+    started.start();
+    CPPUNIT_ASSERT_THROW(std::move(started).stage("late", 1, [](int i) { return i; }),
+                         std::runtime_error);
+    CPPUNIT_ASSERT_THROW(Pipeline<int>().stage("idle", 0, [](int i) { return i; }),
+                         std::runtime_error);
+    started.close();
+    CPPUNIT_ASSERT_THROW(started.push(1), std::runtime_error);
+
+    /// results never popped, stages blocked on full queues
+    {
+        Pipeline<int> busy = Pipeline<int>(int_batches(1, 1))
+                                 .stage("a", 2, [](int i) { return i; })
+                                 .stage("b", 1, [](int i) { return i; });
+        for (int i = 0; i < 5; ++i) {
+            busy.push(i);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    /// never started
+    {
+        Pipeline<int> idle = Pipeline<int>().stage("id", 1, [](int i) { return i; });
+    }
+}
+
+CppUnit::Test *suite() {
+    CppUnit::TestFactoryRegistry &registry =
+                      CppUnit::TestFactoryRegistry::getRegistry();
+
+    return registry.makeTest();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(PipelineTestCase);
+
+int main(int argc, char* argv[]) {
+    CppUnit::TestResult controller;
+
+    CppUnit::TestResultCollector result;
+    controller.addListener(&result);
+
+    CppUnit::BriefTestProgressListener progressListener;
+    controller.addListener(&progressListener);
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite());  /// Add the top suite to the test runner
+
+    /// Run the test
+    runner.run(controller);
+
+    /// Return error code 1 if any tests failed
+    return result.wasSuccessful() ? 0 : 1;
+}
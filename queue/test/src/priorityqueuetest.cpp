@@ -0,0 +1,298 @@
+/** 
+ *  @brief      Priority queue data structure testsuite
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "priorityqueue.h"
+#include "priorityqueuetest.h"
+
+/// Orders unique pointers by the integers they point to
+struct PointeeLess {
+    bool operator()(const std::unique_ptr<int>& lhs,
+                    const std::unique_ptr<int>& rhs) const {
+        return *lhs < *rhs;
+    }
+};
+
+void PriorityQueueTestCase::setUp() {
+}
+
+void PriorityQueueTestCase::tearDown() {
+}
+
+void PriorityQueueTestCase::test_push_and_pop_chars() {
+    PriorityQueue< char > pq_of_chars;
+
+    pq_of_chars.push('b');
+    pq_of_chars.push('d');
+    pq_of_chars.push('a');
+    pq_of_chars.push('c');
+
+    CPPUNIT_ASSERT('d' == pq_of_chars.top());
+    pq_of_chars.pop();
+    CPPUNIT_ASSERT('c' == pq_of_chars.top());
+    pq_of_chars.pop();
+    CPPUNIT_ASSERT('b' == pq_of_chars.top());
+    pq_of_chars.pop();
+    CPPUNIT_ASSERT('a' == pq_of_chars.top());
+    pq_of_chars.pop();
+    CPPUNIT_ASSERT(pq_of_chars.empty());
+}
+
+void PriorityQueueTestCase::test_push_and_pop_integers() {
+    PriorityQueue< int > pq_of_ints;
+
+    pq_of_ints.push(30);
+    pq_of_ints.push(10);
+    pq_of_ints.push(50);
+    pq_of_ints.push(20);
+    pq_of_ints.push(40);
+    CPPUNIT_ASSERT(5 == pq_of_ints.size());
+
+    CPPUNIT_ASSERT(50 == pq_of_ints.top());
+    pq_of_ints.pop();
+    CPPUNIT_ASSERT(40 == pq_of_ints.top());
+
+    pq_of_ints.push(45);
+    CPPUNIT_ASSERT(45 == pq_of_ints.top());
+    CPPUNIT_ASSERT(5 == pq_of_ints.size());
+}
+
+void PriorityQueueTestCase::test_push_and_pop_strings() {
+    PriorityQueue< std::string > pq_of_strings;
+
+    pq_of_strings.push("Green");
+    pq_of_strings.push("Red");
+    pq_of_strings.push("Blue");
+
+    CPPUNIT_ASSERT("Red" == pq_of_strings.pop_value());
+    CPPUNIT_ASSERT("Green" == pq_of_strings.pop_value());
+    CPPUNIT_ASSERT("Blue" == pq_of_strings.pop_value());
+    CPPUNIT_ASSERT(pq_of_strings.empty());
+}
+
+void PriorityQueueTestCase::test_push_and_pop_integers_using_deque() {
+    PriorityQueue< int, std::less<int>, std::deque<int> > pq_of_ints;
+
+    for (int i = 0; i < 100; ++i) {
+        pq_of_ints.push((i * 37) % 100);
+    }
+    for (int i = 99; i >= 0; --i) {
+        CPPUNIT_ASSERT(i == pq_of_ints.pop_value());
+    }
+    CPPUNIT_ASSERT(pq_of_ints.empty());
+}
+
+void PriorityQueueTestCase::test_push_and_pop_using_greater() {
+    PriorityQueue< int, std::greater<int> > deadlines;
+
+    deadlines.push(300);
+    deadlines.push(100);
+    deadlines.push(200);
+
+    CPPUNIT_ASSERT(100 == deadlines.pop_value());
+    CPPUNIT_ASSERT(200 == deadlines.pop_value());
+    CPPUNIT_ASSERT(300 == deadlines.pop_value());
+}
+
+void PriorityQueueTestCase::test_emplace_and_pop_value_move_only_items() {
+    PriorityQueue< std::unique_ptr<int>, PointeeLess > pq_of_ptrs;
+
+    pq_of_ptrs.emplace(new int(2));
+    pq_of_ptrs.emplace(new int(3));
+    pq_of_ptrs.push(std::unique_ptr<int>(new int(1)));
+
+    CPPUNIT_ASSERT(3 == *pq_of_ptrs.top());
+    CPPUNIT_ASSERT(3 == *pq_of_ptrs.pop_value());
+    CPPUNIT_ASSERT(2 == **pq_of_ptrs.try_pop());
+    CPPUNIT_ASSERT(1 == *pq_of_ptrs.pop_value());
+}
+
+void PriorityQueueTestCase::test_pop_throws_when_empty() {
+    PriorityQueue< int > pq_of_ints;
+
+    CPPUNIT_ASSERT_THROW(pq_of_ints.top(), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(pq_of_ints.pop(), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(pq_of_ints.pop_value(), std::runtime_error);
+
+    pq_of_ints.push(1);
+    pq_of_ints.pop();
+    CPPUNIT_ASSERT_THROW(pq_of_ints.pop(), std::runtime_error);
+}
+
+void PriorityQueueTestCase::test_try_pop() {
+    PriorityQueue< int > pq_of_ints;
+
+    CPPUNIT_ASSERT(!pq_of_ints.try_pop());
+
+    pq_of_ints.push(7);
+    pq_of_ints.push(9);
+    CPPUNIT_ASSERT(9 == *pq_of_ints.try_pop());
+    CPPUNIT_ASSERT(7 == *pq_of_ints.try_pop());
+    CPPUNIT_ASSERT(!pq_of_ints.try_pop());
+}
+
+void PriorityQueueTestCase::test_heapify_from_range() {
+    std::vector<int> items;
+    for (int i = 0; i < 1000; ++i) {
+        items.push_back((i * 7919) % 1000);
+    }
+
+    PriorityQueue< int > pq_of_ints(items.begin(), items.end());
+    CPPUNIT_ASSERT(1000 == pq_of_ints.size());
+    for (int i = 999; i >= 0; --i) {
+        CPPUNIT_ASSERT(i == pq_of_ints.pop_value());
+    }
+}
+
+void PriorityQueueTestCase::test_heapify_adds_to_existing_items() {
+    PriorityQueue< int, std::greater<int> > pq_of_ints;
+    int more[] = {8, 3, 9, 1};
+
+    pq_of_ints.push(5);
+    pq_of_ints.push(2);
+    pq_of_ints.heapify(more, more + 4);
+
+    int expected[] = {1, 2, 3, 5, 8, 9};
+    for (int i = 0; i < 6; ++i) {
+        CPPUNIT_ASSERT(expected[i] == pq_of_ints.pop_value());
+    }
+    CPPUNIT_ASSERT(pq_of_ints.empty());
+}
+
+void PriorityQueueTestCase::test_arities_match_std_priority_queue() {
+    std::mt19937 rng(42);
+    std::priority_queue<int> reference;
+    BinaryHeap< int > binary;
+    PriorityQueue< int > quaternary;
+    PriorityQueue< int, std::less<int>, std::vector<int>, 8 > octonary;
+
+    for (int round = 0; round < 5000; ++round) {
+        int val = rng() % 1000;
+        if (rng() % 3 == 0 && !reference.empty()) {
+            CPPUNIT_ASSERT(reference.top() == binary.pop_value());
+            CPPUNIT_ASSERT(reference.top() == quaternary.pop_value());
+            CPPUNIT_ASSERT(reference.top() == octonary.pop_value());
+            reference.pop();
+        } else {
+            reference.push(val);
+            binary.push(val);
+            quaternary.push(val);
+            octonary.push(val);
+        }
+    }
+    CPPUNIT_ASSERT(reference.size() == quaternary.size());
+}
+
+void PriorityQueueTestCase::test_decrease_key_moves_item_up() {
+    IndexedPriorityQueue< int, std::greater<int> > distances;
+
+    distances.push(10);
+    distances.push(20);
+    IndexedPriorityQueue< int, std::greater<int> >::handle_type far =
+        distances.push(90);
+    distances.push(30);
+    distances.push(40);
+
+    distances.decrease_key(far, 25);
+    CPPUNIT_ASSERT(10 == distances.pop_value());
+    CPPUNIT_ASSERT(20 == distances.pop_value());
+    CPPUNIT_ASSERT(25 == distances.pop_value());
+
+    distances.decrease_key(distances.push(50), 5);
+    CPPUNIT_ASSERT(5 == distances.top());
+}
+
+void PriorityQueueTestCase::test_handles_follow_items_and_are_reused() {
+    IndexedPriorityQueue< int, std::greater<int> > pq_of_ints;
+    std::vector<IndexedPriorityQueue< int, std::greater<int> >::handle_type>
+        handles;
+
+    for (int i = 0; i < 200; ++i) {
+        handles.push_back(pq_of_ints.push(1000 + i));
+    }
+    /// pop 100 items, then push 100 more which reuse their handles
+    for (int i = 0; i < 100; ++i) {
+        pq_of_ints.pop();
+    }
+    for (int i = 0; i < 100; ++i) {
+        handles[i] = pq_of_ints.push(2000 + i);
+    }
+    CPPUNIT_ASSERT(200 == pq_of_ints.size());
+
+    /// lower every key below all others, in reverse order
+    for (int i = 0; i < 200; ++i) {
+        pq_of_ints.decrease_key(handles[i], -i);
+    }
+    for (int i = 199; i >= 0; --i) {
+        CPPUNIT_ASSERT(-i == pq_of_ints.pop_value());
+    }
+    CPPUNIT_ASSERT(pq_of_ints.empty());
+}
+
+void PriorityQueueTestCase::test_swap() {
+    IndexedPriorityQueue< int > A, B;
+
+    IndexedPriorityQueue< int >::handle_type h = A.push(1);
+    A.push(5);
+    B.push(7);
+
+    A.swap(B);
+    CPPUNIT_ASSERT(1 == A.size());
+    CPPUNIT_ASSERT(7 == A.top());
+    CPPUNIT_ASSERT(5 == B.top());
+
+    B.decrease_key(h, 9);  /// the handle followed its item
+    CPPUNIT_ASSERT(9 == B.pop_value());
+    CPPUNIT_ASSERT(5 == B.pop_value());
+}
+
+CppUnit::Test *suite() {
+    CppUnit::TestFactoryRegistry &registry =
+                      CppUnit::TestFactoryRegistry::getRegistry();
+
+    return registry.makeTest();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(PriorityQueueTestCase);
+
+int main(int argc, char* argv[]) {
+    CppUnit::TestResult controller;
+
+    CppUnit::TestResultCollector result;
+    controller.addListener(&result);
+
+    CppUnit::BriefTestProgressListener progressListener;
+    controller.addListener(&progressListener);
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite());  /// Add the top suite to the test runner
+
+    /// Run the test
+    runner.run(controller);
+
+    /// Return error code 1 if any tests failed
+    return result.wasSuccessful() ? 0 : 1;
+}
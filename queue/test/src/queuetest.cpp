@@ -16,15 +16,120 @@
 #include <cppunit/TestResultCollector.h>
 #include <cppunit/extensions/HelperMacros.h>
  
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <deque>
 #include <list>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <exception>
+#include <iterator>
+#include <sstream>
 #include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
 
+#include "allocators.h"
 #include "queue.h"
 #include "queuetest.h"
+#include "unrolledlist.h"
+
+/// Item owning a heap buffer, counting buffer allocations and copies
+struct Payload {
+    static int allocations;
+    static int copies;
+    char* data;
+
+    explicit Payload(char c) : data(new char[64]) {
+        ++allocations;
+        data[0] = c;
+    }
+    Payload(char c, int fill) : data(new char[64]) {
+        ++allocations;
+        std::memset(data, fill, 64);
+        data[0] = c;
+    }
+    Payload(const Payload& other) : data(new char[64]) {
+        ++allocations;
+        ++copies;
+        std::memcpy(data, other.data, 64);
+    }
+    Payload(Payload&& other) noexcept : data(other.data) {
+        other.data = 0;
+    }
+    Payload& operator=(const Payload& other) {
+        ++copies;
+        std::memcpy(data, other.data, 64);
+        return *this;
+    }
+    Payload& operator=(Payload&& other) noexcept {
+        std::swap(data, other.data);
+        return *this;
+    }
+    ~Payload() {
+        delete[] data;
+    }
+
+    static void reset() {
+        allocations = 0;
+        copies = 0;
+    }
+};
+
+int Payload::allocations = 0;
+int Payload::copies = 0;
+
+/// Allocator counting the calls to allocate, across all its rebinds
+static int counted_allocations = 0;
+
+template < typename T >
+struct CountingAllocator {
+    typedef T value_type;
+
+    CountingAllocator() {}
+    template < typename U >
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(std::size_t n) {
+        ++counted_allocations;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, std::size_t n) {
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template < typename U >
+    bool operator==(const CountingAllocator<U>&) const { return true; }
+    template < typename U >
+    bool operator!=(const CountingAllocator<U>&) const { return false; }
+};
+
+/// Container with only the operations Queue requires, and no allocator
+template < typename T >
+class BareFifo {
+ public:
+    bool empty() const { return items_.empty(); }
+    std::size_t size() const { return items_.size(); }
+    T& front() { return items_.front(); }
+    const T& front() const { return items_.front(); }
+    T& back() { return items_.back(); }
+    const T& back() const { return items_.back(); }
+    void push_back(const T& val) { items_.push_back(val); }
+    void pop_front() { items_.pop_front(); }
+
+ private:
+    std::deque<T> items_;
+};
+
+/// 64-byte nodes, so that a few pushes cross node boundaries
+typedef UnrolledList< int, 64 > SmallNodeList;
 
 void QueueTestCase::setUp() {
 }
@@ -196,6 +301,572 @@ void QueueTestCase::test_less_than_using_queue_of_integers() {
     CPPUNIT_ASSERT(A < B);
 }
 
+void QueueTestCase::test_push_rvalue_does_not_copy() {
+    Queue< Payload > q_of_payloads;
+    Payload::reset();
+
+    q_of_payloads.push(Payload('A'));
+    Payload b('B');
+    q_of_payloads.push(std::move(b));
+
+    CPPUNIT_ASSERT(2 == Payload::allocations);  /// one per payload
+    CPPUNIT_ASSERT(0 == Payload::copies);
+    CPPUNIT_ASSERT('A' == q_of_payloads.front().data[0]);
+    CPPUNIT_ASSERT('B' == q_of_payloads.back().data[0]);
+}
+
+void QueueTestCase::test_emplace_constructs_in_place() {
+    Queue< Payload > q_of_payloads;
+    Payload::reset();
+
+    q_of_payloads.emplace('A');
+    q_of_payloads.emplace('B', 0);
+
+    CPPUNIT_ASSERT(2 == Payload::allocations);
+    CPPUNIT_ASSERT(0 == Payload::copies);
+    CPPUNIT_ASSERT('A' == q_of_payloads.front().data[0]);
+    CPPUNIT_ASSERT('B' == q_of_payloads.back().data[0]);
+}
+
+void QueueTestCase::test_pop_value_moves_out() {
+    Queue< Payload, std::list<Payload> > q_of_payloads;
+    q_of_payloads.emplace('A');
+    q_of_payloads.emplace('B');
+    Payload::reset();
+
+    Payload a = q_of_payloads.pop_value();
+    Payload b = q_of_payloads.pop_value();
+
+    CPPUNIT_ASSERT(0 == Payload::allocations);
+    CPPUNIT_ASSERT(0 == Payload::copies);
+    CPPUNIT_ASSERT('A' == a.data[0]);
+    CPPUNIT_ASSERT('B' == b.data[0]);
+    CPPUNIT_ASSERT(q_of_payloads.empty());
+}
+
+void QueueTestCase::test_pop_value_throws_when_empty() {
+    Queue< int > q_of_ints;
+
+    CPPUNIT_ASSERT_THROW(q_of_ints.pop_value(), std::runtime_error);
+}
+
+void QueueTestCase::test_move_and_swap_do_not_copy() {
+    Queue< Payload > A, B;
+    A.emplace('A');
+    B.emplace('B');
+    B.emplace('C');
+    Payload::reset();
+
+    Queue< Payload > C(std::move(A));
+    CPPUNIT_ASSERT(1 == C.size());
+
+    C.swap(B);
+    CPPUNIT_ASSERT(2 == C.size());
+    CPPUNIT_ASSERT('B' == C.front().data[0]);
+
+    swap(B, C);  /// found through ADL
+    CPPUNIT_ASSERT('A' == C.front().data[0]);
+
+    A = std::move(B);
+    CPPUNIT_ASSERT('B' == A.front().data[0]);
+
+    CPPUNIT_ASSERT(0 == Payload::allocations);
+    CPPUNIT_ASSERT(0 == Payload::copies);
+}
+
+void QueueTestCase::test_push_and_pop_using_pool_allocator() {
+    Queue< int, std::deque<int>, PoolAllocator<int> > q_of_ints;
+
+    for (int i = 0; i < 10000; ++i) {
+        q_of_ints.push(i);
+    }
+    for (int i = 0; i < 10000; ++i) {
+        CPPUNIT_ASSERT(i == q_of_ints.front());
+        q_of_ints.pop();
+    }
+    CPPUNIT_ASSERT(q_of_ints.empty());
+}
+
+void QueueTestCase::test_push_and_pop_using_list_and_pool_allocator() {
+    Queue< std::string, std::list<std::string>,
+           PoolAllocator<std::string> > A, B;
+
+    A.push("Red");
+    A.push("Green");
+    B = A;  /// copies allocate from the pool too
+
+    CPPUNIT_ASSERT(A == B);
+    CPPUNIT_ASSERT("Red" == B.pop_value());
+    CPPUNIT_ASSERT("Green" == B.front());
+}
+
+void QueueTestCase::test_push_and_pop_using_pool_resource() {
+    PoolResource pool;
+    std::pmr::polymorphic_allocator<std::string> alloc(&pool);
+    Queue< std::string, std::pmr::list<std::string>,
+           std::pmr::polymorphic_allocator<std::string> > A(alloc);
+
+    for (int i = 0; i < 1000; ++i) {
+        A.push(std::to_string(i));
+    }
+    CPPUNIT_ASSERT(A.get_allocator().resource()->is_equal(PoolResource()));
+    for (int i = 0; i < 1000; ++i) {
+        CPPUNIT_ASSERT(std::to_string(i) == A.pop_value());
+    }
+    CPPUNIT_ASSERT(A.empty());
+}
+
+void QueueTestCase::test_pool_allocator_across_threads() {
+    typedef Queue< int, std::list<int>, PoolAllocator<int> > IntQueue;
+    IntQueue q_of_ints;
+
+    /// nodes allocated by an exiting thread are freed by this one
+    std::thread producer([&q_of_ints]() {
+        for (int i = 0; i < 1000; ++i) {
+            q_of_ints.push(i);
+        }
+    });
+    producer.join();
+
+    for (int i = 0; i < 1000; ++i) {
+        CPPUNIT_ASSERT(i == q_of_ints.pop_value());
+    }
+    CPPUNIT_ASSERT(q_of_ints.empty());
+}
+
+void QueueTestCase::test_pool_allocator_producer_consumer_stays_flat() {
+    typedef Queue< int, std::list<int>, PoolAllocator<int> > IntQueue;
+    const int kRound = 20000;
+    const int kRounds = 5;
+    IntQueue q_of_ints;
+    std::mutex lock;
+    std::size_t slabs_after_first = 0;
+    bool in_order = true;
+
+    /// nodes allocated by one thread and freed by the other flow back
+    /// to the producer, so no slab is carved after the first round
+    std::thread producer([&]() {
+        for (int i = 0; i < kRound * kRounds;) {
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                for (; q_of_ints.size() < 100 && i < kRound * kRounds; ++i) {
+                    q_of_ints.push(i);
+                }
+            }
+            std::this_thread::yield();
+        }
+    });
+    std::thread consumer([&]() {
+        for (int i = 0; i < kRound * kRounds;) {
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                for (; !q_of_ints.empty(); ++i) {
+                    in_order = in_order && i == q_of_ints.pop_value();
+                    if (i + 1 == kRound) {
+                        slabs_after_first = BlockPool::slabs();
+                    }
+                }
+            }
+            std::this_thread::yield();
+        }
+    });
+    producer.join();
+    consumer.join();
+
+    CPPUNIT_ASSERT(in_order);
+    CPPUNIT_ASSERT(q_of_ints.empty());
+    CPPUNIT_ASSERT(slabs_after_first == BlockPool::slabs());
+}
+
+void QueueTestCase::test_container_without_allocator() {
+    Queue< int, BareFifo<int> > q_of_ints;
+    InstrumentedQueue< int, BareFifo<int> > counted;
+
+    q_of_ints.push(10);
+    q_of_ints.push(20);
+    CPPUNIT_ASSERT(2 == q_of_ints.size());
+    CPPUNIT_ASSERT(10 == q_of_ints.front());
+    CPPUNIT_ASSERT(20 == q_of_ints.back());
+    q_of_ints.pop();
+    CPPUNIT_ASSERT(20 == q_of_ints.front());
+
+    counted.push(1);
+    counted.pop();
+    CPPUNIT_ASSERT(1 == counted.stats().pushes);
+    CPPUNIT_ASSERT(counted.empty());
+}
+
+void QueueTestCase::test_push_and_pop_using_arena_allocator() {
+    Arena arena;
+    ArenaAllocator<int> alloc(arena);
+    Queue< int, std::deque<int>, ArenaAllocator<int> > q_of_ints(alloc);
+
+    q_of_ints.push(10);
+    q_of_ints.push(20);
+    q_of_ints.push(30);
+
+    CPPUNIT_ASSERT(q_of_ints.get_allocator() == alloc);
+    CPPUNIT_ASSERT(10 == q_of_ints.pop_value());
+    CPPUNIT_ASSERT(20 == q_of_ints.front());
+    CPPUNIT_ASSERT(30 == q_of_ints.back());
+}
+
+void QueueTestCase::test_push_range_and_pop_n() {
+    Queue< int > q_of_ints;
+    std::vector<int> in, out;
+    for (int i = 0; i < 1000; ++i) {
+        in.push_back(i);
+    }
+
+    q_of_ints.push(-1);
+    q_of_ints.push_range(in.begin(), in.end());
+    CPPUNIT_ASSERT(1001 == q_of_ints.size());
+
+    q_of_ints.pop_n(1, std::back_inserter(out));
+    CPPUNIT_ASSERT(-1 == out[0]);
+
+    out.clear();
+    q_of_ints.pop_n(600, std::back_inserter(out));
+    CPPUNIT_ASSERT(std::equal(out.begin(), out.end(), in.begin()));
+    CPPUNIT_ASSERT(400 == q_of_ints.size());
+    CPPUNIT_ASSERT(600 == q_of_ints.front());
+}
+
+void QueueTestCase::test_push_range_and_pop_n_using_list() {
+    Queue< int, std::list<int> > q_of_ints;
+    int in[] = {10, 20, 30, 40};
+    int out[3];
+
+    q_of_ints.push_range(in, in + 4);
+    int* last = q_of_ints.pop_n(3, out);
+
+    CPPUNIT_ASSERT(out + 3 == last);
+    CPPUNIT_ASSERT(10 == out[0] && 20 == out[1] && 30 == out[2]);
+    CPPUNIT_ASSERT(40 == q_of_ints.front());
+}
+
+void QueueTestCase::test_push_range_from_input_iterators() {
+    Queue< int > q_of_ints;
+    std::istringstream in("10 20 30");
+
+    q_of_ints.push_range(std::istream_iterator<int>(in),
+                         std::istream_iterator<int>());
+
+    CPPUNIT_ASSERT(3 == q_of_ints.size());
+    CPPUNIT_ASSERT(10 == q_of_ints.front());
+    CPPUNIT_ASSERT(30 == q_of_ints.back());
+}
+
+void QueueTestCase::test_push_bulk_and_drain() {
+    Queue< std::string > q_of_strings;
+    std::string in[] = {"Red", "Green", "Blue"};
+    std::vector<std::string> out;
+
+    q_of_strings.push_bulk(in, 3);
+    q_of_strings.push_bulk(in, 0);
+    q_of_strings.drain(std::back_inserter(out));
+
+    CPPUNIT_ASSERT(q_of_strings.empty());
+    CPPUNIT_ASSERT(3 == out.size());
+    CPPUNIT_ASSERT("Red" == out[0] && "Blue" == out[2]);
+}
+
+void QueueTestCase::test_pop_n_throws_when_too_few() {
+    Queue< int > q_of_ints;
+    std::vector<int> out;
+
+    q_of_ints.push(10);
+    q_of_ints.push(20);
+
+    CPPUNIT_ASSERT_THROW(q_of_ints.pop_n(3, std::back_inserter(out)),
+                         std::runtime_error);
+    CPPUNIT_ASSERT(2 == q_of_ints.size());  /// nothing removed
+    CPPUNIT_ASSERT(out.empty());
+}
+
+void QueueTestCase::test_pop_n_moves_out() {
+    Queue< Payload > q_of_payloads;
+    std::vector<Payload> out;
+    out.reserve(2);
+    q_of_payloads.emplace('A');
+    q_of_payloads.emplace('B');
+    q_of_payloads.emplace('C');
+    Payload::reset();
+
+    q_of_payloads.pop_n(2, std::back_inserter(out));
+
+    CPPUNIT_ASSERT(0 == Payload::copies);
+    CPPUNIT_ASSERT('A' == out[0].data[0]);
+    CPPUNIT_ASSERT('B' == out[1].data[0]);
+    CPPUNIT_ASSERT('C' == q_of_payloads.front().data[0]);
+}
+
+void QueueTestCase::test_try_front_and_try_pop_when_empty() {
+    Queue< int > q_of_ints;
+
+    CPPUNIT_ASSERT(0 == q_of_ints.try_front());
+    CPPUNIT_ASSERT(!q_of_ints.try_pop());
+}
+
+void QueueTestCase::test_try_front_and_try_pop() {
+    Queue< std::string, std::list<std::string> > q_of_strings;
+
+    q_of_strings.push("Red");
+    q_of_strings.push("Green");
+
+    CPPUNIT_ASSERT("Red" == *q_of_strings.try_front());
+    *q_of_strings.try_front() = "Cyan";
+
+    std::optional<std::string> val = q_of_strings.try_pop();
+    CPPUNIT_ASSERT(val && "Cyan" == *val);
+    CPPUNIT_ASSERT("Green" == *q_of_strings.try_pop());
+    CPPUNIT_ASSERT(!q_of_strings.try_pop());
+}
+
+void QueueTestCase::test_try_pop_moves_out() {
+    Queue< Payload > q_of_payloads;
+    q_of_payloads.emplace('A');
+    Payload::reset();
+
+    std::optional<Payload> a = q_of_payloads.try_pop();
+
+    CPPUNIT_ASSERT(0 == Payload::allocations);
+    CPPUNIT_ASSERT(0 == Payload::copies);
+    CPPUNIT_ASSERT('A' == a->data[0]);
+}
+
+void QueueTestCase::test_front_unchecked() {
+    Queue< int > q_of_ints;
+
+    q_of_ints.push(10);
+    q_of_ints.push(20);
+    q_of_ints.front_unchecked() = 30;
+
+    CPPUNIT_ASSERT(30 == q_of_ints.pop_value());
+    CPPUNIT_ASSERT(20 == q_of_ints.front_unchecked());
+}
+
+void QueueTestCase::test_no_instrumentation_adds_no_size() {
+    CPPUNIT_ASSERT(sizeof(Queue< int >) == sizeof(std::deque<int>));
+    CPPUNIT_ASSERT(sizeof(Queue< int, std::list<int> >) == sizeof(std::list<int>));
+}
+
+void QueueTestCase::test_instrumentation_counts() {
+    InstrumentedQueue< int > q_of_ints;
+    int in[] = {1, 2, 3, 4};
+    std::vector<int> out;
+
+    q_of_ints.push(10);
+    q_of_ints.emplace(20);
+    q_of_ints.push_bulk(in, 4);  /// peak of 6
+    q_of_ints.pop();
+    q_of_ints.pop_value();
+    q_of_ints.pop_n(2, std::back_inserter(out));
+    q_of_ints.drain(std::back_inserter(out));
+
+    CPPUNIT_ASSERT(!q_of_ints.try_pop());  /// empty pops
+    CPPUNIT_ASSERT_THROW(q_of_ints.pop(), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(q_of_ints.pop_n(1, std::back_inserter(out)),
+                         std::runtime_error);
+
+    InstrumentationSnapshot stats = q_of_ints.stats();
+    CPPUNIT_ASSERT(6 == stats.pushes);
+    CPPUNIT_ASSERT(6 == stats.pops);
+    CPPUNIT_ASSERT(3 == stats.empty_pops);
+    CPPUNIT_ASSERT(6 == stats.peak_size);
+    CPPUNIT_ASSERT(6 == stats.latency.count());
+}
+
+void QueueTestCase::test_instrumentation_reset() {
+    InstrumentedQueue< int, std::list<int> > q_of_ints;
+
+    q_of_ints.push(10);
+    q_of_ints.push(20);
+    q_of_ints.pop();
+    q_of_ints.reset_stats();
+
+    CPPUNIT_ASSERT(0 == q_of_ints.stats().pushes);
+    CPPUNIT_ASSERT(0 == q_of_ints.stats().latency.count());
+
+    q_of_ints.push(30);
+    q_of_ints.pop();
+
+    InstrumentationSnapshot stats = q_of_ints.stats();
+    CPPUNIT_ASSERT(1 == stats.pushes);
+    CPPUNIT_ASSERT(1 == stats.pops);
+    CPPUNIT_ASSERT(2 == stats.peak_size);  /// since the reset
+    CPPUNIT_ASSERT(1 == stats.latency.count());
+}
+
+void QueueTestCase::test_instrumentation_latency() {
+    InstrumentedQueue< int > q_of_ints;
+
+    q_of_ints.push(10);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    q_of_ints.push(20);
+    q_of_ints.pop();
+    q_of_ints.pop();
+
+    LatencyHistogram latency = q_of_ints.stats().latency;
+    CPPUNIT_ASSERT(2 == latency.count());
+    CPPUNIT_ASSERT(latency.percentile(100) >= 2000000);  /// the first item
+    CPPUNIT_ASSERT(latency.percentile(0) < 2000000);     /// the second one
+}
+
+void QueueTestCase::test_instrumentation_latency_follows_items() {
+    InstrumentedQueue< int > A, B;
+
+    A.push(10);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    A.swap(B);
+    B.push(20);
+    InstrumentedQueue< int > C(std::move(B));
+    C.pop();
+
+    CPPUNIT_ASSERT(1 == C.stats().latency.count());
+    CPPUNIT_ASSERT(C.stats().latency.percentile(100) >= 2000000);
+    CPPUNIT_ASSERT(0 == A.stats().latency.count());
+}
+
+void QueueTestCase::test_instrumentation_scraped_while_in_use() {
+    InstrumentedQueue< int > q_of_ints;
+    std::atomic<bool> done(false);
+    std::uint64_t scraped = 0;
+
+    std::thread worker([&q_of_ints, &done]() {
+        for (int i = 0; i < 100000; ++i) {
+            q_of_ints.push(i);
+            q_of_ints.pop();
+        }
+        done = true;
+    });
+    while (!done) {  /// never loses or double counts across resets
+        scraped += q_of_ints.reset_stats().pushes;
+        CPPUNIT_ASSERT(q_of_ints.stats().pushes <= 100000);
+    }
+    worker.join();
+    scraped += q_of_ints.reset_stats().pushes;
+
+    CPPUNIT_ASSERT(100000 == scraped);
+}
+
+void QueueTestCase::test_latency_histogram_buckets() {
+    for (std::uint64_t ns = 1; ns < (std::uint64_t(1) << 62); ns = ns * 3 + 1) {
+        std::uint64_t high = LatencyHistogram::bucket_max(LatencyHistogram::bucket(ns));
+        CPPUNIT_ASSERT(high >= ns);
+        CPPUNIT_ASSERT(high - ns <= ns / 8);  /// within 12.5%
+    }
+    CPPUNIT_ASSERT(LatencyHistogram::kBuckets - 1 ==
+                   LatencyHistogram::bucket(~std::uint64_t(0)));
+}
+
+void QueueTestCase::test_push_and_pop_integers_using_unrolled_list() {
+    Queue< int, SmallNodeList > q_of_ints;
+    std::vector<int> out;
+    int next = 0;
+
+    /// interleave pushes and pops so the front and back nodes differ
+    for (int i = 0; i < 1000; ++i) {
+        q_of_ints.push(i);
+        if (i % 3 == 0) {
+            CPPUNIT_ASSERT(next++ == q_of_ints.pop_value());
+        }
+    }
+    CPPUNIT_ASSERT(1000 - next == int(q_of_ints.size()));
+    CPPUNIT_ASSERT(next == q_of_ints.front());
+    CPPUNIT_ASSERT(999 == q_of_ints.back());
+
+    q_of_ints.copy_to(std::back_inserter(out));
+    CPPUNIT_ASSERT(out.size() == q_of_ints.size());
+    CPPUNIT_ASSERT(std::equal(out.begin(), out.end(), q_of_ints.begin()));
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        CPPUNIT_ASSERT(next + int(i) == out[i]);
+    }
+
+    while (!q_of_ints.empty()) {
+        CPPUNIT_ASSERT(next++ == q_of_ints.pop_value());
+    }
+    CPPUNIT_ASSERT(1000 == next);
+}
+
+void QueueTestCase::test_push_and_pop_strings_using_unrolled_list() {
+    Queue< std::string, UnrolledList<std::string> > A, B;
+
+    for (int i = 0; i < 100; ++i) {
+        A.push(std::string(40, 'a' + i % 26));
+    }
+    B = A;
+    CPPUNIT_ASSERT(A == B);
+
+    B.pop();
+    CPPUNIT_ASSERT(A != B);
+    CPPUNIT_ASSERT(A < B);  /// "aaa..." before "bbb..."
+
+    Queue< std::string, UnrolledList<std::string> > C(std::move(A));
+    CPPUNIT_ASSERT(A.empty());
+    CPPUNIT_ASSERT(100 == C.size());
+    CPPUNIT_ASSERT(std::string(40, 'a') == C.pop_value());
+    CPPUNIT_ASSERT(C == B);
+}
+
+void QueueTestCase::test_unrolled_list_moves_payloads() {
+    Payload::reset();
+    {
+        Queue< Payload, UnrolledList<Payload> > q_of_payloads;
+        for (int i = 0; i < 50; ++i) {
+            q_of_payloads.emplace('a' + i % 26);
+        }
+        for (int i = 0; i < 25; ++i) {
+            Payload p = q_of_payloads.pop_value();
+            CPPUNIT_ASSERT('a' + i % 26 == p.data[0]);
+        }
+        CPPUNIT_ASSERT(25 == q_of_payloads.size());
+    }
+    CPPUNIT_ASSERT(50 == Payload::allocations);
+    CPPUNIT_ASSERT(0 == Payload::copies);
+}
+
+void QueueTestCase::test_unrolled_list_recycles_nodes() {
+    typedef UnrolledList< int, 64, CountingAllocator<int> > CountedList;
+    Queue< int, CountedList, CountingAllocator<int> > q_of_ints;
+    counted_allocations = 0;
+
+    for (int i = 0; i < 25; ++i) {
+        q_of_ints.push(i);
+    }
+    /// 26 items span at most 4 nodes of 10 ints
+    for (int i = 25; i < 100; ++i) {
+        q_of_ints.push(i);
+        q_of_ints.pop();
+    }
+    CPPUNIT_ASSERT(4 == counted_allocations);
+
+    /// a queue of steady size keeps moving onto new nodes, which must
+    /// all come back from the ones it emptied
+    for (int i = 100; i < 10000; ++i) {
+        q_of_ints.push(i);
+        CPPUNIT_ASSERT(i - 25 == q_of_ints.pop_value());
+    }
+    CPPUNIT_ASSERT(4 == counted_allocations);
+}
+
+void QueueTestCase::test_push_range_and_pop_n_using_unrolled_list() {
+    Queue< int, SmallNodeList > q_of_ints;
+    std::vector<int> in, out;
+    for (int i = 0; i < 100; ++i) {
+        in.push_back(i);
+    }
+
+    q_of_ints.push_range(in.begin(), in.end());
+    q_of_ints.pop_n(45, std::back_inserter(out));
+    CPPUNIT_ASSERT(std::equal(out.begin(), out.end(), in.begin()));
+    CPPUNIT_ASSERT(45 == q_of_ints.front());
+
+    q_of_ints.drain(std::back_inserter(out));
+    CPPUNIT_ASSERT(in == out);
+    CPPUNIT_ASSERT(q_of_ints.empty());
+}
+
 CppUnit::Test *suite() {
     CppUnit::TestFactoryRegistry &registry =
                       CppUnit::TestFactoryRegistry::getRegistry();
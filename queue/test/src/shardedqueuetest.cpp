@@ -0,0 +1,237 @@
+/** 
+ *  @brief      Sharded queue testsuite
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "shardedqueue.h"
+#include "shardedqueuetest.h"
+
+void ShardedQueueTestCase::setUp() {
+}
+
+void ShardedQueueTestCase::tearDown() {
+}
+
+void ShardedQueueTestCase::test_parse_cpulist() {
+    std::vector<unsigned> cpus = CpuTopology::parse_cpulist("0-3,8,10-11\n");
+    unsigned expected[] = {0, 1, 2, 3, 8, 10, 11};
+    CPPUNIT_ASSERT(7 == cpus.size());
+    for (unsigned i = 0; i < 7; ++i) {
+        CPPUNIT_ASSERT(expected[i] == cpus[i]);
+    }
+    CPPUNIT_ASSERT(CpuTopology::parse_cpulist("").empty());
+    CPPUNIT_ASSERT(1 == CpuTopology::parse_cpulist("5").size());
+
+    CpuTopology topology = CpuTopology::uniform(6, 3);
+    CPPUNIT_ASSERT(3 == topology.nodes);
+    CPPUNIT_ASSERT(0 == topology.node_of_cpu[1]);
+    CPPUNIT_ASSERT(1 == topology.node_of_cpu[2]);
+    CPPUNIT_ASSERT(2 == topology.node_of_cpu[5]);
+    CPPUNIT_ASSERT_THROW(CpuTopology::uniform(2, 3), std::runtime_error);
+}
+
+void ShardedQueueTestCase::test_detected_topology() {
+    CpuTopology topology = CpuTopology::detect();
+    CPPUNIT_ASSERT(topology.nodes >= 1);
+    CPPUNIT_ASSERT(!topology.node_of_cpu.empty());
+    for (unsigned node : topology.node_of_cpu) {
+        CPPUNIT_ASSERT(node < topology.nodes);
+    }
+
+    ShardedQueue<int> queue;
+    CPPUNIT_ASSERT(topology.nodes == queue.shards());
+    CPPUNIT_ASSERT(queue.local_shard() < queue.shards());
+}
+
+void ShardedQueueTestCase::test_shards_per_policy() {
+    CpuTopology topology = CpuTopology::uniform(8, 2);
+
+    ShardedQueue<int> per_node(kShardPerNode, topology);
+    CPPUNIT_ASSERT(2 == per_node.shards());
+    CPPUNIT_ASSERT(0 == per_node.shard_of_cpu(3));
+    CPPUNIT_ASSERT(1 == per_node.shard_of_cpu(4));
+    CPPUNIT_ASSERT(1 == per_node.node_of_shard(1));
+    CPPUNIT_ASSERT(1 == per_node.shard_of_cpu(9));
+
+    ShardedQueue<int> per_cpu(kShardPerCpu, topology);
+    CPPUNIT_ASSERT(8 == per_cpu.shards());
+    CPPUNIT_ASSERT(5 == per_cpu.shard_of_cpu(5));
+    CPPUNIT_ASSERT(0 == per_cpu.node_of_shard(3));
+    CPPUNIT_ASSERT(1 == per_cpu.node_of_shard(4));
+    CPPUNIT_ASSERT(7 == per_cpu.steal_order(0).size());
+}
+
+void ShardedQueueTestCase::test_fifo_per_shard() {
+    ShardedQueue<std::string> queue(kShardPerNode, CpuTopology::uniform(2, 2));
+    for (int i = 0; i < 5; ++i) {
+        queue.push_to(0, "a" + std::to_string(i));
+        queue.push_to(1, "b" + std::to_string(i));
+    }
+    CPPUNIT_ASSERT(10 == queue.size());
+    CPPUNIT_ASSERT(5 == queue.size(1));
+
+    /// shard 0 drains first, in order, then shard 1 in order
+    for (int i = 0; i < 5; ++i) {
+        CPPUNIT_ASSERT("a" + std::to_string(i) == *queue.try_pop_from(0));
+    }
+    for (int i = 0; i < 5; ++i) {
+        CPPUNIT_ASSERT("b" + std::to_string(i) == *queue.try_pop_from(0));
+    }
+    CPPUNIT_ASSERT(!queue.try_pop_from(0));
+    CPPUNIT_ASSERT(queue.empty());
+}
+
+void ShardedQueueTestCase::test_steal_same_node_first() {
+    /// shards 0 and 1 on node 0, 2 and 3 on node 1
+    ShardedQueue<int> queue(kShardPerCpu, CpuTopology::uniform(4, 2));
+    const std::vector<std::size_t>& order = queue.steal_order(0);
+    CPPUNIT_ASSERT(3 == order.size());
+    CPPUNIT_ASSERT(1 == order[0]);
+    CPPUNIT_ASSERT(2 == order[1]);
+    CPPUNIT_ASSERT(3 == order[2]);
+    CPPUNIT_ASSERT(3 == queue.steal_order(2)[0]);
+
+    queue.push_to(3, 30);
+    queue.push_to(1, 10);
+    queue.push_to(0, 0);
+    CPPUNIT_ASSERT(0 == *queue.try_pop_from(0));
+    CPPUNIT_ASSERT(10 == *queue.try_pop_from(0));
+    CPPUNIT_ASSERT(30 == *queue.try_pop_from(0));
+
+    ShardStats stats = queue.stats(0);
+    CPPUNIT_ASSERT(1 == stats.pushes);
+    CPPUNIT_ASSERT(1 == stats.pops);
+    CPPUNIT_ASSERT(0 == stats.stolen);
+    stats = queue.stats(1);
+    CPPUNIT_ASSERT(1 == stats.stolen);
+    CPPUNIT_ASSERT(0 == stats.stolen_remote);
+    stats = queue.stats(3);
+    CPPUNIT_ASSERT(1 == stats.stolen);
+    CPPUNIT_ASSERT(1 == stats.stolen_remote);
+}
+
+void ShardedQueueTestCase::test_local_push_and_pop() {
+    ShardedQueue<int> queue(kShardPerCpu);
+    for (int i = 0; i < 100; ++i) {
+        queue.push(i);
+    }
+    CPPUNIT_ASSERT(100 == queue.size());
+
+    /// wherever the thread ran, local pops and steals find every item
+    std::vector<int> seen;
+    while (std::optional<int> item = queue.try_pop()) {
+        seen.push_back(*item);
+    }
+    CPPUNIT_ASSERT(100 == seen.size());
+    std::uint64_t pushes = 0;
+    for (std::size_t i = 0; i < queue.shards(); ++i) {
+        pushes += queue.stats(i).pushes;
+        CPPUNIT_ASSERT(queue.stats(i).pushes == queue.stats(i).pops);
+    }
+    CPPUNIT_ASSERT(100 == pushes);
+    CPPUNIT_ASSERT(queue.empty());
+}
+
+void ShardedQueueTestCase::test_bad_shard_throws() {
+    ShardedQueue<int> queue(kShardPerNode, CpuTopology::uniform(4, 2));
+    CPPUNIT_ASSERT_THROW(queue.push_to(2, 1), std::out_of_range);
+    CPPUNIT_ASSERT_THROW(queue.try_pop_from(2), std::out_of_range);
+    CPPUNIT_ASSERT_THROW(ShardedQueue<int>(kShardPerNode, CpuTopology()),
+                         std::runtime_error);
+}
+
+void ShardedQueueTestCase::test_concurrent_producers_and_consumers() {
+    const int kProducers = 4, kConsumers = 3, kItems = 5000;
+    ShardedQueue<int> queue(kShardPerCpu, CpuTopology::uniform(4, 2));
+    std::atomic<int> popped(0);
+    std::vector< std::vector<int> > taken(kConsumers);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kProducers; ++p) {
+        threads.emplace_back([&queue, p] {
+            for (int i = 0; i < kItems; ++i) {
+                queue.push_to(p, p * kItems + i);
+            }
+        });
+    }
+    for (int c = 0; c < kConsumers; ++c) {
+        threads.emplace_back([&, c] {
+            while (popped.load() < kProducers * kItems) {
+                if (std::optional<int> item = queue.try_pop_from(c)) {
+                    taken[c].push_back(*item);
+                    ++popped;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    /// every item once, and each consumer saw each shard in order
+    std::vector<int> count(kProducers * kItems, 0);
+    for (int c = 0; c < kConsumers; ++c) {
+        std::vector<int> last(kProducers, -1);
+        for (int item : taken[c]) {
+            ++count[item];
+            CPPUNIT_ASSERT(item > last[item / kItems]);
+            last[item / kItems] = item;
+        }
+    }
+    for (int n : count) {
+        CPPUNIT_ASSERT(1 == n);
+    }
+    CPPUNIT_ASSERT(queue.empty());
+    CPPUNIT_ASSERT(kItems == queue.stats(3).pops);
+    CPPUNIT_ASSERT(kItems == queue.stats(3).stolen);
+}
+
+CppUnit::Test *suite() {
+    CppUnit::TestFactoryRegistry &registry =
+                      CppUnit::TestFactoryRegistry::getRegistry();
+
+    return registry.makeTest();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ShardedQueueTestCase);
+
+int main(int argc, char* argv[]) {
+    CppUnit::TestResult controller;
+
+    CppUnit::TestResultCollector result;
+    controller.addListener(&result);
+
+    CppUnit::BriefTestProgressListener progressListener;
+    controller.addListener(&progressListener);
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite());  /// Add the top suite to the test runner
+
+    /// Run the test
+    runner.run(controller);
+
+    /// Return error code 1 if any tests failed
+    return result.wasSuccessful() ? 0 : 1;
+}
@@ -0,0 +1,254 @@
+/** 
+ *  @brief      Vectorized comparisons testsuite
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "circularqueue.h"
+#include "queue.h"
+#include "simdcompare.h"
+#include "smallring.h"
+#include "unrolledlist.h"
+#include "simdcomparetest.h"
+
+/// Check the kernels of every level this CPU runs against the scalar
+/// loops, on two arrays of the same length
+template < typename T >
+static void check_kernels(const std::vector<T>& a, const std::vector<T>& b) {
+    std::size_t n = a.size();
+    std::size_t unequal =
+        SimdCompare<T>::scalar_first_unequal(a.data(), b.data(), n);
+    std::size_t inequivalent =
+        SimdCompare<T>::scalar_first_inequivalent(a.data(), b.data(), n);
+
+    for (int level = kSimdScalar; level <= simd_level(); ++level) {
+        CPPUNIT_ASSERT_EQUAL(unequal, SimdCompare<T>::first_unequal(
+                                          a.data(), b.data(), n,
+                                          SimdLevel(level)));
+        CPPUNIT_ASSERT_EQUAL(inequivalent, SimdCompare<T>::first_inequivalent(
+                                               a.data(), b.data(), n,
+                                               SimdLevel(level)));
+    }
+}
+
+/// Move a mismatch over every position of arrays of 0 to 150 items;
+/// integers also get one in their most significant byte only
+template < typename T >
+static void check_every_mismatch() {
+    for (std::size_t n = 0; n <= 150; ++n) {
+        std::vector<T> a(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            a[i] = T(i * 7 + 1);
+        }
+        std::vector<T> b(a);
+        check_kernels(a, b);
+
+        for (std::size_t i = 0; i < n; ++i) {
+            b[i] = T(a[i] + 1);
+            check_kernels(a, b);
+            check_kernels(b, a);
+            b[i] = a[i];
+
+            if constexpr (std::is_integral<T>::value) {
+                unsigned char* high =
+                    reinterpret_cast<unsigned char*>(&b[i]) + sizeof(T) - 1;
+                *high ^= 0x80;
+                CPPUNIT_ASSERT_EQUAL(i, SimdCompare<T>::first_unequal(
+                                            a.data(), b.data(), n));
+                check_kernels(a, b);
+                b[i] = a[i];
+            }
+        }
+    }
+}
+
+/// Push to a queue under test and to its deque-backed reference,
+/// dropping the front item of the reference as a full circular queue
+/// would
+template < typename Q, typename R, typename T >
+static void push_both(Q& q, R& ref, T val, std::size_t capacity) {
+    if (ref.size() == capacity) {
+        ref.pop();
+    }
+    ref.push(val);
+    q.push(val);
+}
+
+/// Drive two queues of type Q and two deque-backed ones through the same
+/// random pushes and pops, checking that every comparison agrees
+template < typename Q, typename T >
+static void check_queue_comparisons(std::size_t capacity) {
+    Q a, b;
+    Queue<T> ref_a, ref_b;
+    std::mt19937 rng(42);
+
+    for (int step = 0; step < 20000; ++step) {
+        unsigned op = rng() % 16;
+        T val = T(int(rng() % 4) - 2);
+        if (op < 8) {
+            push_both(a, ref_a, val, capacity);
+            push_both(b, ref_b, val, capacity);
+        } else if (op < 10) {
+            push_both(a, ref_a, val, capacity);
+        } else if (op < 12) {
+            push_both(b, ref_b, val, capacity);
+        } else if (op < 14 && !a.empty()) {
+            a.pop();
+            ref_a.pop();
+        } else if (op < 16 && !b.empty()) {
+            b.pop();
+            ref_b.pop();
+        }
+        if (a.size() > 150 && b.size() > 150) {
+            a.pop();
+            ref_a.pop();
+            b.pop();
+            ref_b.pop();
+        }
+
+        CPPUNIT_ASSERT((ref_a == ref_b) == (a == b));
+        CPPUNIT_ASSERT((ref_a < ref_b) == (a < b));
+        CPPUNIT_ASSERT((ref_b < ref_a) == (b < a));
+        CPPUNIT_ASSERT(a == a);
+    }
+}
+
+void SimdCompareTestCase::setUp() {
+}
+
+void SimdCompareTestCase::tearDown() {
+}
+
+void SimdCompareTestCase::test_kernels_match_scalar_on_integers() {
+    check_every_mismatch<char>();
+    check_every_mismatch<signed char>();
+    check_every_mismatch<std::uint16_t>();
+    check_every_mismatch<int>();
+    check_every_mismatch<unsigned>();
+    check_every_mismatch<long long>();
+}
+
+void SimdCompareTestCase::test_kernels_match_scalar_on_floats() {
+    check_every_mismatch<float>();
+    check_every_mismatch<double>();
+}
+
+void SimdCompareTestCase::test_kernels_handle_nan_and_signed_zero() {
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> a(40, 1.0), b(40, 1.0);
+    a[5] = -0.0;
+    b[5] = 0.0;  /// equal, and equivalent
+    a[17] = nan;
+    b[17] = nan;  /// unequal, yet equivalent
+    a[33] = 2.0;
+    b[33] = 3.0;  /// unequal, and a before b
+
+    for (int level = kSimdScalar; level <= simd_level(); ++level) {
+        SimdLevel l = SimdLevel(level);
+        CPPUNIT_ASSERT(17 == SimdCompare<double>::first_unequal(
+                                 a.data(), b.data(), 40, l));
+        CPPUNIT_ASSERT(33 == SimdCompare<double>::first_inequivalent(
+                                 a.data(), b.data(), 40, l));
+    }
+
+    std::vector<float> c(40, 1.0f), d(40, 1.0f);
+    c[9] = std::numeric_limits<float>::quiet_NaN();
+    d[9] = 4.0f;
+    check_kernels(c, d);
+    check_kernels(d, c);
+}
+
+void SimdCompareTestCase::test_ring_queue_comparisons_match_generic() {
+    CPPUNIT_ASSERT((ContainerSegments< SmallRing<int, 16> >::contiguous));
+    CPPUNIT_ASSERT((ContainerSegments< StaticRing<int, 64> >::contiguous));
+    check_queue_comparisons< Queue< int, SmallRing<int, 16> >, int >(
+        std::size_t(-1));
+    check_queue_comparisons< CircularQueue<int, 64>, int >(64);
+    check_queue_comparisons< CircularQueue<float, 40>, float >(40);
+}
+
+void SimdCompareTestCase::test_unrolled_queue_comparisons_match_generic() {
+    CPPUNIT_ASSERT((ContainerSegments< UnrolledList<int> >::contiguous));
+
+    /// 64-byte nodes, so the runs of two queues rarely line up
+    check_queue_comparisons< Queue< int, UnrolledList<int, 64> >, int >(
+        std::size_t(-1));
+    check_queue_comparisons< Queue< signed char, UnrolledList<signed char> >,
+                             signed char >(std::size_t(-1));
+    check_queue_comparisons< Queue< double, UnrolledList<double> >, double >(
+        std::size_t(-1));
+}
+
+void SimdCompareTestCase::test_float_queue_comparisons_with_nan() {
+    typedef Queue< double, UnrolledList<double, 64> > DoubleQueue;
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    double left[] = {1.0, nan, 1.0, -0.0};
+    double right[] = {1.0, 5.0, 2.0, 0.0};
+    DoubleQueue A, B;
+    Queue<double> ref_a, ref_b;
+
+    for (int round = 0; round < 10; ++round) {  /// across a few nodes
+        A.push_range(left, left + 4);
+        ref_a.push_range(left, left + 4);
+        B.push_range(left, left + 4);
+        ref_b.push_range(left, left + 4);
+    }
+    CPPUNIT_ASSERT(!(A == B));  /// NaN equals nothing
+    CPPUNIT_ASSERT(!(A < B) && !(B < A));  /// but is equivalent
+    CPPUNIT_ASSERT((ref_a < ref_b) == (A < B));
+
+    B.pop_n(4, right);
+    B.push_range(right, right + 4);
+    ref_b.pop_n(4, right);
+    ref_b.push_range(right, right + 4);
+    CPPUNIT_ASSERT((ref_a == ref_b) == (A == B));
+    CPPUNIT_ASSERT((ref_a < ref_b) == (A < B));
+    CPPUNIT_ASSERT((ref_b < ref_a) == (B < A));
+}
+
+CppUnit::Test *suite() {
+    CppUnit::TestFactoryRegistry &registry =
+                      CppUnit::TestFactoryRegistry::getRegistry();
+
+    return registry.makeTest();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SimdCompareTestCase);
+
+int main(int argc, char* argv[]) {
+    CppUnit::TestResult controller;
+
+    CppUnit::TestResultCollector result;
+    controller.addListener(&result);
+
+    CppUnit::BriefTestProgressListener progressListener;
+    controller.addListener(&progressListener);
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite());  /// Add the top suite to the test runner
+
+    /// Run the test
+    runner.run(controller);
+
+    /// Return error code 1 if any tests failed
+    return result.wasSuccessful() ? 0 : 1;
+}
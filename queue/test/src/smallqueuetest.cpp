@@ -0,0 +1,259 @@
+/** 
+ *  @brief      Small queue data structure testsuite
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "smallqueue.h"
+#include "smallqueuetest.h"
+
+/// Item whose move may throw, and whose copy throws once copies run out
+struct Brittle {
+    static int live;
+    static int moves;
+    static int copies_left;
+    int value;
+
+    explicit Brittle(int v) : value(v) { ++live; }
+    Brittle(const Brittle& other) : value(other.value) {
+        if (copies_left-- == 0) {
+            throw std::runtime_error("copy failed");
+        }
+        ++live;
+    }
+    Brittle(Brittle&& other) : value(other.value) { ++moves; ++live; }
+    ~Brittle() { --live; }
+};
+
+int Brittle::live = 0;
+int Brittle::moves = 0;
+int Brittle::copies_left = -1;
+
+void SmallQueueTestCase::setUp() {
+}
+
+void SmallQueueTestCase::tearDown() {
+}
+
+void SmallQueueTestCase::test_push_and_pop_integers() {
+    SmallQueue< int > q_of_ints;
+
+    q_of_ints.push(10);
+    q_of_ints.push(20);
+    q_of_ints.push(30);
+
+    CPPUNIT_ASSERT(10 == q_of_ints.front());
+
+    q_of_ints.pop();
+    CPPUNIT_ASSERT(20 == q_of_ints.front());
+
+    q_of_ints.pop();
+    CPPUNIT_ASSERT(30 == q_of_ints.front());
+    CPPUNIT_ASSERT(30 == q_of_ints.back());
+
+    q_of_ints.push(90);
+    CPPUNIT_ASSERT(90 == q_of_ints.back());
+}
+
+void SmallQueueTestCase::test_push_and_pop_strings() {
+    SmallQueue< std::string, 4 > q_of_strings;
+
+    q_of_strings.push("Red");
+    q_of_strings.push("Green");
+    q_of_strings.push("Blue");
+
+    CPPUNIT_ASSERT("Red" == q_of_strings.front());
+
+    q_of_strings.pop();
+    CPPUNIT_ASSERT("Green" == q_of_strings.front());
+
+    q_of_strings.pop();
+    CPPUNIT_ASSERT("Blue" == q_of_strings.front());
+    CPPUNIT_ASSERT("Blue" == q_of_strings.back());
+
+    q_of_strings.push("Cyan");
+    CPPUNIT_ASSERT("Cyan" == q_of_strings.back());
+}
+
+void SmallQueueTestCase::test_stays_inline_when_small() {
+    SmallRing< int, 4 > items;
+
+    /// wrap around the inline slots many times
+    for (int i = 0; i < 100; ++i) {
+        items.push_back(i);
+        items.push_back(i + 1);
+        items.push_back(i + 2);
+        CPPUNIT_ASSERT(i == items.front());
+        items.pop_front();
+        items.pop_front();
+        items.pop_front();
+    }
+    CPPUNIT_ASSERT(items.is_inline());
+    CPPUNIT_ASSERT(4 == items.capacity());
+}
+
+void SmallQueueTestCase::test_spills_to_heap_in_order() {
+    SmallQueue< int, 4 > q_of_ints;
+
+    q_of_ints.push(-1);
+    q_of_ints.push(-2);
+    q_of_ints.pop();
+    q_of_ints.pop();  /// head is now in the middle of the ring
+
+    for (int i = 0; i < 100; ++i) {
+        q_of_ints.push(i);
+    }
+    for (int i = 0; i < 100; ++i) {
+        CPPUNIT_ASSERT(i == q_of_ints.front());
+        q_of_ints.pop();
+    }
+    CPPUNIT_ASSERT(q_of_ints.empty());
+    CPPUNIT_ASSERT_THROW(q_of_ints.front(), std::runtime_error);
+}
+
+void SmallQueueTestCase::test_copy_move_and_swap() {
+    SmallQueue< std::string, 2 > small, large;
+
+    small.push("Red");
+    for (int i = 0; i < 10; ++i) {
+        large.push(std::string(1, 'a' + i));
+    }
+
+    SmallQueue< std::string, 2 > small_copy(small), large_copy(large);
+    CPPUNIT_ASSERT(small_copy == small);
+    CPPUNIT_ASSERT(large_copy == large);
+
+    SmallQueue< std::string, 2 > small_moved(std::move(small_copy));
+    SmallQueue< std::string, 2 > large_moved(std::move(large_copy));
+    CPPUNIT_ASSERT(small_moved == small);
+    CPPUNIT_ASSERT(large_moved == large);
+
+    small_moved.swap(large_moved);
+    CPPUNIT_ASSERT(small_moved == large);
+    CPPUNIT_ASSERT(large_moved == small);
+
+    large_moved = small_moved;
+    CPPUNIT_ASSERT(large_moved == large);
+    CPPUNIT_ASSERT(10 == large_moved.size());
+}
+
+void SmallQueueTestCase::test_relational_operators() {
+    SmallQueue< int > A, B;
+
+    A.push(10);
+    A.push(20);
+    B.push(10);
+    B.push(20);
+    CPPUNIT_ASSERT(A == B);
+
+    B.push(30);
+    CPPUNIT_ASSERT(A != B);
+    CPPUNIT_ASSERT(A < B);
+    CPPUNIT_ASSERT(A <= B);
+
+    A.push(60);
+    CPPUNIT_ASSERT(A > B);
+    CPPUNIT_ASSERT(A >= B);
+}
+
+void SmallQueueTestCase::test_push_range_and_pop_n_across_wrap() {
+    SmallQueue< int, 8 > q_of_ints;
+    int in[] = {1, 2, 3, 4, 5, 6};
+    int out[32];
+
+    q_of_ints.push_range(in, in + 6);
+    q_of_ints.pop_n(4, out);
+    q_of_ints.push_range(in, in + 6);  /// wraps around the inline slots
+    CPPUNIT_ASSERT(8 == q_of_ints.size());
+
+    q_of_ints.pop_n(8, out);
+    CPPUNIT_ASSERT(5 == out[0] && 6 == out[1] && 1 == out[2] && 6 == out[7]);
+
+    q_of_ints.push_range(in, in + 6);
+    q_of_ints.pop_n(3, out);
+    q_of_ints.push_bulk(in, 6);
+    q_of_ints.push_bulk(in, 6);  /// spills to the heap while wrapped
+    CPPUNIT_ASSERT(15 == q_of_ints.size());
+
+    int* last = q_of_ints.drain(out);
+    CPPUNIT_ASSERT(out + 15 == last);
+    CPPUNIT_ASSERT(4 == out[0] && 6 == out[2] && 1 == out[3] && 6 == out[14]);
+}
+
+void SmallQueueTestCase::test_throwing_relocation_keeps_items() {
+    {
+        SmallRing< Brittle, 4 > ring;
+        Brittle extra[] = {Brittle(6), Brittle(7)};
+
+        for (int i = 0; i < 4; ++i) {
+            ring.emplace_back(i);
+        }
+        ring.pop_front();
+        ring.pop_front();
+        ring.emplace_back(4);
+        ring.emplace_back(5);  /// full and wrapped: 2 3 4 5
+
+        /// items whose move may throw are copied, and a failed copy
+        /// leaves the inline slots as they were
+        Brittle::copies_left = 2;
+        CPPUNIT_ASSERT_THROW(ring.emplace_back(6), std::runtime_error);
+        Brittle::copies_left = 2;
+        CPPUNIT_ASSERT_THROW(ring.append(extra, extra + 2), std::runtime_error);
+        CPPUNIT_ASSERT(0 == Brittle::moves);
+        CPPUNIT_ASSERT(4 == ring.size());
+        CPPUNIT_ASSERT(6 == Brittle::live);
+
+        Brittle::copies_left = -1;
+        ring.append(extra, extra + 2);
+        for (int i = 2; i < 8; ++i) {
+            CPPUNIT_ASSERT(i == ring.front().value);
+            ring.pop_front();
+        }
+        CPPUNIT_ASSERT(ring.empty());
+    }
+    CPPUNIT_ASSERT(0 == Brittle::live);
+}
+
+CppUnit::Test *suite() {
+    CppUnit::TestFactoryRegistry &registry =
+                      CppUnit::TestFactoryRegistry::getRegistry();
+
+    return registry.makeTest();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SmallQueueTestCase);
+
+int main(int argc, char* argv[]) {
+    CppUnit::TestResult controller;
+
+    CppUnit::TestResultCollector result;
+    controller.addListener(&result);
+
+    CppUnit::BriefTestProgressListener progressListener;
+    controller.addListener(&progressListener);
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite());  /// Add the top suite to the test runner
+
+    /// Run the test
+    runner.run(controller);
+
+    /// Return error code 1 if any tests failed
+    return result.wasSuccessful() ? 0 : 1;
+}
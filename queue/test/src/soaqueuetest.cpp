@@ -0,0 +1,313 @@
+/** 
+ *  @brief      Structure-of-arrays queue data structure testsuite
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "allocators.h"
+#include "queue.h"
+#include "soaqueue.h"
+#include "soaqueuetest.h"
+
+/// timestamp, price, quantity, id
+typedef std::tuple<long, double, int, long> Tick;
+typedef SoaQueue<Tick> TickQueue;
+
+static Tick make_tick(int i) {
+    return Tick(1000 + i, 1.5 * i, i % 7, 10 * i);
+}
+
+/// Sum of a column, run by run
+template < std::size_t I, typename Q >
+static double column_sum(const Q& q, std::size_t& items) {
+    typedef typename Q::template field_type<I> F;
+    SplitCursor<F> cursor = q.template column<I>();
+    const F* run;
+    std::size_t n;
+    double sum = 0;
+    items = 0;
+    while (cursor.next(run, n)) {
+        for (std::size_t i = 0; i < n; ++i) {
+            sum += run[i];
+        }
+        items += n;
+    }
+    return sum;
+}
+
+void SoaQueueTestCase::setUp() {
+}
+
+void SoaQueueTestCase::tearDown() {
+}
+
+void SoaQueueTestCase::test_push_and_pop_records() {
+    TickQueue q;
+
+    CPPUNIT_ASSERT(q.empty());
+    CPPUNIT_ASSERT(0 == q.capacity());
+    CPPUNIT_ASSERT(!q.try_pop());
+    CPPUNIT_ASSERT_THROW(q.front(), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(q.back(), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(q.pop(), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(q.pop_value(), std::runtime_error);
+
+    for (int i = 0; i < 5; ++i) {
+        q.push(make_tick(i));
+    }
+    CPPUNIT_ASSERT(5 == q.size());
+    CPPUNIT_ASSERT(TickQueue::kMinCapacity == q.capacity());
+    CPPUNIT_ASSERT(make_tick(0) == Tick(q.front()));
+    CPPUNIT_ASSERT(make_tick(4) == Tick(q.back()));
+    CPPUNIT_ASSERT(1003 == std::get<0>(q[3]));
+
+    q.pop();
+    CPPUNIT_ASSERT(make_tick(1) == q.pop_value());
+    CPPUNIT_ASSERT(make_tick(2) == *q.try_pop());
+    CPPUNIT_ASSERT(2 == q.size());
+    q.clear();
+    CPPUNIT_ASSERT(q.empty());
+    CPPUNIT_ASSERT(TickQueue::kMinCapacity == q.capacity());
+}
+
+void SoaQueueTestCase::test_emplace_and_update_through_front() {
+    TickQueue q;
+
+    q.emplace(1L, 2.5, 3, 4L);
+    q.emplace(5, 6.5f, 7, 8);
+    std::get<1>(q.front()) = 9.25;
+    std::get<2>(q.back()) += 1;
+
+    CPPUNIT_ASSERT(Tick(1, 9.25, 3, 4) == q.pop_value());
+    CPPUNIT_ASSERT(Tick(5, 6.5, 8, 8) == q.pop_value());
+
+    const TickQueue& view = q;
+    q.emplace(1, 2, 3, 4);
+    CPPUNIT_ASSERT(4 == std::get<3>(view.front()));
+}
+
+void SoaQueueTestCase::test_emplace_own_fields_while_growing() {
+    TickQueue q;
+
+    for (int i = 0; i < 16; ++i) {
+        q.push(make_tick(i));
+    }
+    CPPUNIT_ASSERT(q.size() == q.capacity());
+
+    /// grows while reading the front record's fields
+    q.emplace(std::get<0>(q.front()), std::get<1>(q.front()),
+              std::get<2>(q.front()), std::get<3>(q.front()));
+    CPPUNIT_ASSERT(32 == q.capacity());
+    CPPUNIT_ASSERT(make_tick(0) == Tick(q.back()));
+    CPPUNIT_ASSERT(make_tick(0) == q.pop_value());
+}
+
+void SoaQueueTestCase::test_growth_keeps_order_across_wrap() {
+    TickQueue q;
+    int pushed = 0;
+    int popped = 0;
+
+    /// leave the head mid-ring, wrap the tail, then overflow twice
+    for (; pushed < 12; ++pushed) {
+        q.push(make_tick(pushed));
+    }
+    for (; popped < 10; ++popped) {
+        q.pop();
+    }
+    for (; pushed < 70; ++pushed) {
+        q.push(make_tick(pushed));
+    }
+    CPPUNIT_ASSERT(64 == q.capacity());
+    CPPUNIT_ASSERT(60 == q.size());
+    for (; popped < pushed; ++popped) {
+        CPPUNIT_ASSERT(make_tick(popped) == q.pop_value());
+    }
+    CPPUNIT_ASSERT(q.empty());
+}
+
+void SoaQueueTestCase::test_columns_cover_live_records() {
+    TickQueue q;
+    std::size_t items = 0;
+
+    CPPUNIT_ASSERT(0 == column_sum<1>(q, items));
+    CPPUNIT_ASSERT(0 == items);
+
+    /// 16 slots: head at 10 and 12 records, so the rings wrap
+    for (int i = 0; i < 16; ++i) {
+        q.push(make_tick(i));
+    }
+    for (int i = 0; i < 10; ++i) {
+        q.pop();
+    }
+    for (int i = 16; i < 22; ++i) {
+        q.push(make_tick(i));
+    }
+    CPPUNIT_ASSERT(16 == q.capacity());
+
+    SplitCursor<long> ids = q.column<3>();
+    const long* run;
+    std::size_t n;
+    std::vector<long> seen;
+    int runs = 0;
+    while (ids.next(run, n)) {
+        seen.insert(seen.end(), run, run + n);
+        ++runs;
+    }
+    CPPUNIT_ASSERT(2 == runs);
+    CPPUNIT_ASSERT(12 == seen.size());
+    for (int i = 0; i < 12; ++i) {
+        CPPUNIT_ASSERT(10L * (10 + i) == seen[i]);
+    }
+
+    double expected = 0;
+    for (int i = 10; i < 22; ++i) {
+        expected += 1.5 * i;
+    }
+    CPPUNIT_ASSERT(expected == column_sum<1>(q, items));
+    CPPUNIT_ASSERT(12 == items);
+}
+
+void SoaQueueTestCase::test_copy_move_and_swap() {
+    TickQueue a;
+    for (int i = 0; i < 20; ++i) {
+        a.push(make_tick(i));
+    }
+    for (int i = 0; i < 15; ++i) {
+        a.pop();
+    }
+
+    TickQueue b(a);
+    CPPUNIT_ASSERT(a == b);
+    CPPUNIT_ASSERT(TickQueue::kMinCapacity == b.capacity());
+    std::get<0>(b.front()) = -1;
+    CPPUNIT_ASSERT(1015 == std::get<0>(a.front()));
+
+    TickQueue c(std::move(b));
+    CPPUNIT_ASSERT(b.empty());
+    CPPUNIT_ASSERT(0 == b.capacity());
+    CPPUNIT_ASSERT(-1 == std::get<0>(c.front()));
+    b.push(make_tick(99));
+    CPPUNIT_ASSERT(1 == b.size());
+
+    b = a;
+    CPPUNIT_ASSERT(a == b);
+    b = b;
+    CPPUNIT_ASSERT(a == b);
+    c = std::move(b);
+    CPPUNIT_ASSERT(a == c);
+
+    TickQueue d;
+    d.push(make_tick(7));
+    swap(c, d);
+    CPPUNIT_ASSERT(1 == c.size());
+    CPPUNIT_ASSERT(a == d);
+}
+
+void SoaQueueTestCase::test_relational_operators_match_queue() {
+    std::vector< std::vector<int> > contents = {
+        {}, {1}, {2}, {1, 2}, {1, 3}, {2, 1}, {1, 2, 3}
+    };
+    for (const std::vector<int>& x : contents) {
+        for (const std::vector<int>& y : contents) {
+            TickQueue A;
+            TickQueue B;
+            Queue<Tick> C;
+            Queue<Tick> D;
+            for (int i : x) {
+                A.push(make_tick(i));
+                C.push(make_tick(i));
+            }
+            for (int i : y) {
+                B.push(make_tick(i));
+                D.push(make_tick(i));
+            }
+            CPPUNIT_ASSERT((A == B) == (C == D));
+            CPPUNIT_ASSERT((A != B) == (C != D));
+            CPPUNIT_ASSERT((A < B) == (C < D));
+            CPPUNIT_ASSERT((A <= B) == (C <= D));
+            CPPUNIT_ASSERT((A > B) == (C > D));
+            CPPUNIT_ASSERT((A >= B) == (C >= D));
+        }
+    }
+}
+
+void SoaQueueTestCase::test_push_range_pop_n_and_reserve() {
+    TickQueue q;
+    q.reserve(100);
+    CPPUNIT_ASSERT(128 == q.capacity());
+
+    std::vector<Tick> ticks;
+    for (int i = 0; i < 40; ++i) {
+        ticks.push_back(make_tick(i));
+    }
+    q.push_range(ticks.begin(), ticks.end());
+    CPPUNIT_ASSERT(40 == q.size());
+    CPPUNIT_ASSERT(128 == q.capacity());
+
+    std::vector<Tick> out;
+    CPPUNIT_ASSERT_THROW(q.pop_n(41, std::back_inserter(out)),
+                         std::runtime_error);
+    CPPUNIT_ASSERT(40 == q.size());
+    q.pop_n(30, std::back_inserter(out));
+    CPPUNIT_ASSERT(std::vector<Tick>(ticks.begin(), ticks.begin() + 30) == out);
+    CPPUNIT_ASSERT(make_tick(30) == Tick(q.front()));
+}
+
+void SoaQueueTestCase::test_push_and_pop_using_arena_allocator() {
+    Arena arena;
+    typedef std::tuple<int, char, double> Record;
+    SoaQueue< Record, ArenaAllocator<Record> > q((ArenaAllocator<Record>(arena)));
+
+    for (int i = 0; i < 100; ++i) {
+        q.emplace(i, char('a' + i % 26), 0.5 * i);
+    }
+    CPPUNIT_ASSERT(&arena == q.get_allocator().arena);
+    for (int i = 0; i < 100; ++i) {
+        CPPUNIT_ASSERT(Record(i, char('a' + i % 26), 0.5 * i) == q.pop_value());
+    }
+}
+
+CppUnit::Test *suite() {
+    CppUnit::TestFactoryRegistry &registry =
+                      CppUnit::TestFactoryRegistry::getRegistry();
+
+    return registry.makeTest();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SoaQueueTestCase);
+
+int main(int argc, char* argv[]) {
+    CppUnit::TestResult controller;
+
+    CppUnit::TestResultCollector result;
+    controller.addListener(&result);
+
+    CppUnit::BriefTestProgressListener progressListener;
+    controller.addListener(&progressListener);
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite());  /// Add the top suite to the test runner
+
+    /// Run the test
+    runner.run(controller);
+
+    /// Return error code 1 if any tests failed
+    return result.wasSuccessful() ? 0 : 1;
+}
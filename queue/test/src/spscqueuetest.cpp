@@ -0,0 +1,176 @@
+/** 
+ *  @brief      SPSC queue data structure testsuite
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "spscqueue.h"
+#include "spscqueuetest.h"
+
+void SpscQueueTestCase::setUp() {
+}
+
+void SpscQueueTestCase::tearDown() {
+}
+
+void SpscQueueTestCase::test_push_and_pop_integers() {
+    SpscQueue< int > q_of_ints(8);
+    int val = 0;
+
+    CPPUNIT_ASSERT(q_of_ints.try_push(10));
+    CPPUNIT_ASSERT(q_of_ints.try_push(20));
+    CPPUNIT_ASSERT(q_of_ints.try_push(30));
+    CPPUNIT_ASSERT(3 == q_of_ints.size());
+
+    CPPUNIT_ASSERT(10 == *q_of_ints.front());
+
+    CPPUNIT_ASSERT(q_of_ints.try_pop(val));
+    CPPUNIT_ASSERT(10 == val);
+
+    q_of_ints.pop();
+    CPPUNIT_ASSERT(30 == *q_of_ints.front());
+
+    CPPUNIT_ASSERT(q_of_ints.try_pop(val));
+    CPPUNIT_ASSERT(30 == val);
+    CPPUNIT_ASSERT(q_of_ints.empty());
+}
+
+void SpscQueueTestCase::test_push_and_pop_strings() {
+    SpscQueue< std::string > q_of_strings(4);
+    std::string val;
+
+    CPPUNIT_ASSERT(q_of_strings.try_push("Red"));
+    CPPUNIT_ASSERT(q_of_strings.try_push(std::string("Green")));
+
+    CPPUNIT_ASSERT(q_of_strings.try_pop(val));
+    CPPUNIT_ASSERT("Red" == val);
+
+    CPPUNIT_ASSERT("Green" == *q_of_strings.front());
+
+    /// remaining item is destroyed with the queue
+}
+
+void SpscQueueTestCase::test_capacity_rounded_to_power_of_two() {
+    SpscQueue< int > A(1), B(5), C(64);
+
+    CPPUNIT_ASSERT(1 == A.capacity());
+    CPPUNIT_ASSERT(8 == B.capacity());
+    CPPUNIT_ASSERT(64 == C.capacity());
+
+    /// no power of two holds more than half the range of size_t
+    std::size_t top = ~std::size_t(0);
+    CPPUNIT_ASSERT_THROW(SpscQueue< int > D(top), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(SpscQueue< int > E(top / 2 + 2),
+                         std::runtime_error);
+}
+
+void SpscQueueTestCase::test_push_fails_when_full() {
+    SpscQueue< int > q_of_ints(4);
+
+    for (int i = 0; i < 4; ++i) {
+        CPPUNIT_ASSERT(q_of_ints.try_push(i));
+    }
+    CPPUNIT_ASSERT(!q_of_ints.try_push(99));  /// ring is full
+    CPPUNIT_ASSERT(4 == q_of_ints.size());
+
+    q_of_ints.pop();
+    CPPUNIT_ASSERT(q_of_ints.try_push(99));
+}
+
+void SpscQueueTestCase::test_pop_fails_when_empty() {
+    SpscQueue< int > q_of_ints(4);
+    int val = -1;
+
+    CPPUNIT_ASSERT(0 == q_of_ints.front());
+    CPPUNIT_ASSERT(!q_of_ints.try_pop(val));
+    CPPUNIT_ASSERT(-1 == val);  /// untouched
+}
+
+void SpscQueueTestCase::test_wrap_around() {
+    SpscQueue< int > q_of_ints(4);
+    int val = 0;
+
+    for (int i = 0; i < 100; ++i) {
+        CPPUNIT_ASSERT(q_of_ints.try_push(i));
+        CPPUNIT_ASSERT(q_of_ints.try_push(i + 1000));
+        CPPUNIT_ASSERT(q_of_ints.try_pop(val));
+        CPPUNIT_ASSERT(i == val);
+        CPPUNIT_ASSERT(q_of_ints.try_pop(val));
+        CPPUNIT_ASSERT(i + 1000 == val);
+    }
+    CPPUNIT_ASSERT(q_of_ints.empty());
+}
+
+void SpscQueueTestCase::test_producer_consumer_threads() {
+    const int count = 100000;
+    SpscQueue< int > q_of_ints(64);
+    bool in_order = true;
+
+    std::thread consumer([&]() {
+        int expected = 0;
+        int val = 0;
+        while (expected < count) {
+            if (q_of_ints.try_pop(val)) {
+                in_order = in_order && (val == expected);
+                ++expected;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for (int i = 0; i < count; ++i) {
+        while (!q_of_ints.try_push(i)) {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+
+    CPPUNIT_ASSERT(in_order);
+    CPPUNIT_ASSERT(q_of_ints.empty());
+}
+
+CppUnit::Test *suite() {
+    CppUnit::TestFactoryRegistry &registry =
+                      CppUnit::TestFactoryRegistry::getRegistry();
+
+    return registry.makeTest();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SpscQueueTestCase);
+
+int main(int argc, char* argv[]) {
+    CppUnit::TestResult controller;
+
+    CppUnit::TestResultCollector result;
+    controller.addListener(&result);
+
+    CppUnit::BriefTestProgressListener progressListener;
+    controller.addListener(&progressListener);
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite());  /// Add the top suite to the test runner
+
+    /// Run the test
+    runner.run(controller);
+
+    /// Return error code 1 if any tests failed
+    return result.wasSuccessful() ? 0 : 1;
+}
@@ -0,0 +1,248 @@
+/** 
+ *  @brief      Static queue data structure testsuite
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "queue.h"
+#include "staticqueue.h"
+#include "staticqueuetest.h"
+
+/// Item counting the constructions from an int
+struct Counted {
+    static int made;
+    int value;
+
+    Counted() : value(0) {}
+    explicit Counted(int v) : value(v) { ++made; }
+};
+
+int Counted::made = 0;
+
+void StaticQueueTestCase::setUp() {
+}
+
+void StaticQueueTestCase::tearDown() {
+}
+
+void StaticQueueTestCase::test_push_and_pop_integers() {
+    StaticQueue< int, 4 > q_of_ints;
+
+    CPPUNIT_ASSERT(q_of_ints.empty());
+    CPPUNIT_ASSERT(4 == q_of_ints.capacity());
+    CPPUNIT_ASSERT(0 == q_of_ints.try_front());
+    CPPUNIT_ASSERT(!q_of_ints.try_pop());
+    CPPUNIT_ASSERT_THROW(q_of_ints.front(), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(q_of_ints.pop(), std::runtime_error);
+
+    q_of_ints.push(10);
+    q_of_ints.push(20);
+    q_of_ints.emplace(30);
+
+    CPPUNIT_ASSERT(10 == q_of_ints.front());
+    CPPUNIT_ASSERT(30 == q_of_ints.back());
+    CPPUNIT_ASSERT(3 == q_of_ints.size());
+
+    q_of_ints.pop();
+    CPPUNIT_ASSERT(20 == q_of_ints.pop_value());
+    CPPUNIT_ASSERT(30 == *q_of_ints.try_front());
+    CPPUNIT_ASSERT(30 == q_of_ints.front_unchecked());
+    CPPUNIT_ASSERT(30 == *q_of_ints.try_pop());
+    CPPUNIT_ASSERT(q_of_ints.empty());
+}
+
+void StaticQueueTestCase::test_push_and_pop_strings() {
+    StaticQueue< std::string, 3 > q_of_strings;
+
+    /// wrap around the ring many times
+    for (int i = 0; i < 20; ++i) {
+        q_of_strings.push(std::string(1, 'a' + i));
+        q_of_strings.push(std::string(1, 'b' + i));
+        CPPUNIT_ASSERT(std::string(1, 'a' + i) == q_of_strings.pop_value());
+        CPPUNIT_ASSERT(std::string(1, 'b' + i) == q_of_strings.front());
+        q_of_strings.pop();
+    }
+    CPPUNIT_ASSERT(q_of_strings.empty());
+}
+
+void StaticQueueTestCase::test_overflow_returns_false() {
+    StaticQueue< int, 2 > q_of_ints;
+
+    CPPUNIT_ASSERT(q_of_ints.push(1));
+    CPPUNIT_ASSERT(q_of_ints.push(2));
+    CPPUNIT_ASSERT(q_of_ints.full());
+    CPPUNIT_ASSERT(!q_of_ints.push(3));
+    CPPUNIT_ASSERT(!q_of_ints.emplace(3));
+    CPPUNIT_ASSERT(2 == q_of_ints.size());
+    CPPUNIT_ASSERT(1 == q_of_ints.front());
+    CPPUNIT_ASSERT(2 == q_of_ints.back());
+
+    StaticQueue< int, 2, OverflowAssert > checked;
+    CPPUNIT_ASSERT(checked.push(1));
+    CPPUNIT_ASSERT(checked.push(2));
+    CPPUNIT_ASSERT(checked.full());
+}
+
+void StaticQueueTestCase::test_overflow_overwrites_oldest() {
+    StaticQueue< std::string, 3, OverflowOverwrite > recent;
+
+    for (int i = 0; i < 10; ++i) {
+        CPPUNIT_ASSERT(recent.push(std::string(1, 'a' + i)));
+    }
+    CPPUNIT_ASSERT(3 == recent.size());
+    CPPUNIT_ASSERT("h" == recent.pop_value());
+    CPPUNIT_ASSERT("i" == recent.pop_value());
+    CPPUNIT_ASSERT("j" == recent.pop_value());
+    CPPUNIT_ASSERT(recent.empty());
+}
+
+namespace {
+
+/// the sum of the last 4 items of 1..n, computed through a queue
+constexpr int sum_of_last_four(int n) {
+    StaticQueue< int, 4, OverflowOverwrite > window;
+    for (int i = 1; i <= n; ++i) {
+        window.push(i);
+    }
+    int sum = 0;
+    while (!window.empty()) {
+        sum += window.pop_value();
+    }
+    return sum;
+}
+
+}  // namespace
+
+void StaticQueueTestCase::test_rejected_push_constructs_nothing() {
+    StaticQueue< Counted, 2 > q;
+    Counted::made = 0;
+
+    CPPUNIT_ASSERT(q.emplace(1));
+    CPPUNIT_ASSERT(q.emplace(2));
+    CPPUNIT_ASSERT(!q.emplace(3));
+    CPPUNIT_ASSERT(2 == Counted::made);
+    CPPUNIT_ASSERT(1 == q.front().value);
+
+    StaticQueue< Counted, 2, OverflowOverwrite > circular;
+    Counted::made = 0;
+    for (int i = 1; i <= 5; ++i) {
+        CPPUNIT_ASSERT(circular.emplace(i));
+    }
+    CPPUNIT_ASSERT(5 == Counted::made);
+    CPPUNIT_ASSERT(4 == circular.front().value);
+    CPPUNIT_ASSERT(5 == circular.back().value);
+}
+
+void StaticQueueTestCase::test_ring_append_stops_when_full() {
+    int items[] = {1, 2, 3, 4, 5};
+
+    StaticRing< int, 3 > ring;
+    ring.push_back(0);
+    CPPUNIT_ASSERT(2 == ring.append(items, items + 5));
+    CPPUNIT_ASSERT(3 == ring.size());
+    CPPUNIT_ASSERT(0 == ring.front());
+    CPPUNIT_ASSERT(2 == ring.back());
+
+    StaticRing< int, 3, OverflowOverwrite > circular;
+    CPPUNIT_ASSERT(5 == circular.append(items, items + 5));
+    CPPUNIT_ASSERT(3 == circular.front());
+    CPPUNIT_ASSERT(5 == circular.back());
+}
+
+void StaticQueueTestCase::test_queue_over_full_ring_throws() {
+    InstrumentedQueue< int, StaticRing<int, 2> > q_of_ints;
+
+    q_of_ints.push(1);
+    q_of_ints.emplace(2);
+    CPPUNIT_ASSERT_THROW(q_of_ints.push(3), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(q_of_ints.emplace(3), std::runtime_error);
+    CPPUNIT_ASSERT(2 == q_of_ints.size());
+    CPPUNIT_ASSERT(2 == q_of_ints.stats().pushes);  /// not the rejected ones
+    CPPUNIT_ASSERT(1 == q_of_ints.front());
+    CPPUNIT_ASSERT(2 == q_of_ints.back());
+
+    /// overwriting rings take every item
+    Queue< int, StaticRing<int, 2, OverflowOverwrite> > recent;
+    for (int i = 0; i < 5; ++i) {
+        recent.push(i);
+    }
+    CPPUNIT_ASSERT(3 == recent.front());
+}
+
+void StaticQueueTestCase::test_usable_in_constant_expressions() {
+    static_assert(sum_of_last_four(10) == 7 + 8 + 9 + 10, "");
+    static_assert(sum_of_last_four(2) == 1 + 2, "");
+
+    constexpr StaticQueue< int, 2 > empty_queue;
+    static_assert(empty_queue.empty() && empty_queue.capacity() == 2, "");
+
+    CPPUNIT_ASSERT(34 == sum_of_last_four(10));
+}
+
+void StaticQueueTestCase::test_relational_operators() {
+    StaticQueue< int, 4 > A, B;
+
+    A.push(10);
+    A.push(20);
+    B.push(0);
+    B.pop();  /// B wraps at a different slot than A
+    B.push(10);
+    B.push(20);
+    CPPUNIT_ASSERT(A == B);
+
+    B.push(30);
+    CPPUNIT_ASSERT(A != B);
+    CPPUNIT_ASSERT(A < B);
+    CPPUNIT_ASSERT(A <= B);
+
+    A.push(60);
+    CPPUNIT_ASSERT(A > B);
+    CPPUNIT_ASSERT(A >= B);
+
+    A.swap(B);
+    CPPUNIT_ASSERT(A < B);
+    CPPUNIT_ASSERT(60 == B.back());
+}
+
+CppUnit::Test *suite() {
+    CppUnit::TestFactoryRegistry &registry =
+                      CppUnit::TestFactoryRegistry::getRegistry();
+
+    return registry.makeTest();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(StaticQueueTestCase);
+
+int main(int argc, char* argv[]) {
+    CppUnit::TestResult controller;
+
+    CppUnit::TestResultCollector result;
+    controller.addListener(&result);
+
+    CppUnit::BriefTestProgressListener progressListener;
+    controller.addListener(&progressListener);
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite());  /// Add the top suite to the test runner
+
+    /// Run the test
+    runner.run(controller);
+
+    /// Return error code 1 if any tests failed
+    return result.wasSuccessful() ? 0 : 1;
+}
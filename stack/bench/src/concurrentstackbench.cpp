@@ -0,0 +1,67 @@
+/** 
+ *  @brief      Concurrent stack benchmarks against a mutex guarded Stack
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+
+#include "stack.h"
+#include "concurrentstack.h"
+
+/// Stack< int > behind a mutex, the way services share it today
+class LockedStack {
+ private:
+    std::mutex lock_;
+    Stack< int, std::deque<int> > items_;
+
+ public:
+    void push(int val) {
+        std::lock_guard<std::mutex> guard(lock_);
+        items_.push(val);
+    }
+
+    bool try_pop(int& val) {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (items_.empty()) {
+            return false;
+        }
+        val = items_.top();
+        items_.pop();
+        return true;
+    }
+};
+
+static ConcurrentStack< int > concurrent_stack;
+static LockedStack locked_stack;
+
+/// Free-list pattern: every thread takes an item and gives one back
+template < typename S >
+static void push_pop(benchmark::State& state, S& stack) {
+    int val = state.thread_index();
+    for (auto _ : state) {
+        stack.push(val);
+        stack.try_pop(val);
+        benchmark::DoNotOptimize(val);
+    }
+    state.SetItemsProcessed(2 * state.iterations());
+}
+
+static void BM_ConcurrentStack(benchmark::State& state) {
+    push_pop(state, concurrent_stack);
+}
+
+static void BM_LockedStack(benchmark::State& state) {
+    push_pop(state, locked_stack);
+}
+
+BENCHMARK(BM_ConcurrentStack)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(BM_LockedStack)->ThreadRange(1, 32)->UseRealTime();
+
+BENCHMARK_MAIN();
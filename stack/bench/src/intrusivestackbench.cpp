@@ -0,0 +1,62 @@
+/** 
+ *  @brief      Intrusive stack benchmarks against the copying Stack
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <deque>
+#include <list>
+#include <vector>
+
+#include "intrusivestack.h"
+#include "stack.h"
+
+/// Pooled message, the size of a small network frame
+struct Message {
+    char payload[120];
+    IntrusiveHook<Message> hook;
+
+    Message() { payload[0] = 1; }
+};
+
+/// Every iteration stacks range(0) pooled messages and unstacks them;
+/// Stack copies each one into its container, IntrusiveStack links it
+template < typename Container >
+static void BM_copying(benchmark::State& state) {
+    std::vector<Message> pool(state.range(0));
+    Stack< Message, Container > s;
+    for (auto _ : state) {
+        for (Message& message : pool) {
+            s.push(message);
+        }
+        while (!s.empty()) {
+            benchmark::DoNotOptimize(s.top().payload[0]);
+            s.pop();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_intrusive(benchmark::State& state) {
+    std::vector<Message> pool(state.range(0));
+    IntrusiveStack< Message > s;
+    for (auto _ : state) {
+        for (Message& message : pool) {
+            s.push(message);
+        }
+        while (Message* message = s.try_pop()) {
+            benchmark::DoNotOptimize(message->payload[0]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_copying, std::deque<Message>)->Range(8, 8 << 10);
+BENCHMARK_TEMPLATE(BM_copying, std::list<Message>)->Range(8, 8 << 10);
+BENCHMARK(BM_intrusive)->Range(8, 8 << 10);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,93 @@
+/** 
+ *  @brief      Depth-first search keeping a snapshot of its path at every
+ *              branch, with copied stacks and with persistent ones
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <utility>
+#include <vector>
+
+#include "persistentstack.h"
+#include "stack.h"
+
+static const int kFanout = 3;
+static const int kTreeDepth = 7;  /// 3280 nodes, root included
+
+/// Pending branch of the search: the path down to a node and its depth
+template < typename Path >
+struct Branch {
+    Path path;
+    int depth;
+};
+
+/// Seed both kinds of path with state.range(0) items, the part of the
+/// path above the subtree being searched
+template < typename Path >
+static Path make_prefix(int length);
+
+template <>
+Stack<int> make_prefix< Stack<int> >(int length) {
+    Stack<int> path;
+    for (int i = 0; i < length; ++i) {
+        path.push(i);
+    }
+    return path;
+}
+
+template <>
+PersistentStack<int> make_prefix< PersistentStack<int> >(int length) {
+    PersistentStack<int> path;
+    for (int i = 0; i < length; ++i) {
+        path = path.push(i);
+    }
+    return path;
+}
+
+/// Stack of today: every branch copies the whole path and pushes on it
+static Stack<int> extend(const Stack<int>& path, int item) {
+    Stack<int> child(path);
+    child.push(item);
+    return child;
+}
+
+/// Persistent stack: every branch shares the path and adds one node
+static PersistentStack<int> extend(const PersistentStack<int>& path,
+                                   int item) {
+    return path.push(item);
+}
+
+/// Explore a kFanout-ary tree kTreeDepth deep from a worklist, each
+/// pending branch holding its own path
+template < typename Path >
+static void BM_SnapshotDfs(benchmark::State& state) {
+    const Path prefix = make_prefix<Path>(state.range(0));
+    std::vector< Branch<Path> > worklist;
+    long visited = 0;
+    for (auto _ : state) {
+        worklist.push_back(Branch<Path>{prefix, 0});
+        while (!worklist.empty()) {
+            Branch<Path> branch = std::move(worklist.back());
+            worklist.pop_back();
+            ++visited;
+            benchmark::DoNotOptimize(branch.path.top());
+            if (branch.depth == kTreeDepth) {
+                continue;
+            }
+            for (int i = 0; i < kFanout; ++i) {
+                worklist.push_back(
+                    Branch<Path>{extend(branch.path, i), branch.depth + 1});
+            }
+        }
+    }
+    state.SetItemsProcessed(visited);
+}
+
+BENCHMARK_TEMPLATE(BM_SnapshotDfs, Stack<int>)->Arg(1)->Arg(100)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_SnapshotDfs, PersistentStack<int>)->Arg(1)->Arg(100)->Arg(1000);
+
+BENCHMARK_MAIN();
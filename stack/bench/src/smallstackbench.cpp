@@ -0,0 +1,67 @@
+/** 
+ *  @brief      Small stack benchmarks for short-lived per-request stacks
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+/// GCC flags free() on memory from the replaced operator new below
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <deque>
+#include <list>
+#include <vector>
+#include <new>
+
+#include "stack.h"
+#include "smallstack.h"
+
+/// Every heap allocation of the process goes through here and is counted
+static long allocations = 0;
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    void* p = std::malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+/// Construct, push a few items, pop them all and destroy; allocs is
+/// the no. of heap allocations per stack lifetime
+template < typename Container >
+static void BM_ShortLivedStack(benchmark::State& state) {
+    const int items = state.range(0);
+    long before = allocations;
+    for (auto _ : state) {
+        Stack< int, Container > stack;
+        for (int i = 0; i < items; ++i) {
+            stack.push(i);
+        }
+        while (!stack.empty()) {
+            benchmark::DoNotOptimize(stack.top());
+            stack.pop();
+        }
+    }
+    state.counters["allocs"] = double(allocations - before) / state.iterations();
+}
+
+BENCHMARK_TEMPLATE(BM_ShortLivedStack, std::deque<int>)->Arg(8)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_ShortLivedStack, std::list<int>)->Arg(8)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_ShortLivedStack, StackVector<int>)->Arg(8)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_ShortLivedStack, SmallRing<int, 16>)->Arg(8)->Arg(16)->Arg(64);
+
+BENCHMARK_MAIN();
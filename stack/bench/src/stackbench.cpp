@@ -0,0 +1,147 @@
+/** 
+ *  @brief      Stack benchmarks across item types and container backends
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <deque>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "stack.h"
+#include "unrolledlist.h"
+
+static const int kDepth = 1024;
+
+/// Plain 64-byte record, like a message header
+struct Pod64 {
+    long fields[8];
+
+    bool operator==(const Pod64& other) const {
+        return std::memcmp(fields, other.fields, sizeof(fields)) == 0;
+    }
+    bool operator<(const Pod64& other) const {
+        return fields[0] < other.fields[0];
+    }
+};
+
+template < typename T >
+static T make_item(int i);
+
+template <>
+int make_item<int>(int i) {
+    return i;
+}
+
+template <>
+Pod64 make_item<Pod64>(int i) {
+    Pod64 item = {{i, i, i, i, i, i, i, i}};
+    return item;
+}
+
+template <>
+std::string make_item<std::string>(int i) {
+    return std::string(32, 'a' + i % 26);  /// too long for inline storage
+}
+
+/// Grow a fresh stack to kDepth items and tear it down
+template < typename T, typename Container >
+static void BM_Push(benchmark::State& state) {
+    T item = make_item<T>(7);
+    for (auto _ : state) {
+        Stack< T, Container > stack;
+        for (int i = 0; i < kDepth; ++i) {
+            stack.push(item);
+        }
+        benchmark::DoNotOptimize(stack.top());
+    }
+    state.SetItemsProcessed(state.iterations() * kDepth);
+}
+
+/// Push and pop kDepth items on a warm stack, like a DFS would
+template < typename T, typename Container >
+static void BM_PushPop(benchmark::State& state) {
+    T item = make_item<T>(7);
+    Stack< T, Container > stack;
+    for (auto _ : state) {
+        for (int i = 0; i < kDepth; ++i) {
+            stack.push(item);
+        }
+        for (int i = 0; i < kDepth; ++i) {
+            stack.pop();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kDepth * 2);
+}
+
+/// Repeated top() reads, like an expression evaluator peeking
+template < typename T, typename Container >
+static void BM_Top(benchmark::State& state) {
+    Stack< T, Container > stack;
+    for (int i = 0; i < kDepth; ++i) {
+        stack.push(make_item<T>(i));
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(stack.top());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// Repeated size() reads, like a producer checking for backlog
+template < typename T, typename Container >
+static void BM_Size(benchmark::State& state) {
+    Stack< T, Container > stack;
+    for (int i = 0; i < kDepth; ++i) {
+        stack.push(make_item<T>(i));
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(stack.size());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// == and < on two equal stacks of kDepth items, the worst case
+template < typename T, typename Container >
+static void BM_Compare(benchmark::State& state) {
+    Stack< T, Container > lhs, rhs;
+    for (int i = 0; i < kDepth; ++i) {
+        lhs.push(make_item<T>(i));
+        rhs.push(make_item<T>(i));
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lhs == rhs);
+        benchmark::DoNotOptimize(lhs < rhs);
+    }
+    state.SetItemsProcessed(state.iterations() * kDepth * 2);
+}
+
+#define STACK_BENCHMARKS(T, Container)              \
+    BENCHMARK_TEMPLATE(BM_Push, T, Container);      \
+    BENCHMARK_TEMPLATE(BM_PushPop, T, Container);   \
+    BENCHMARK_TEMPLATE(BM_Top, T, Container);       \
+    BENCHMARK_TEMPLATE(BM_Size, T, Container);      \
+    BENCHMARK_TEMPLATE(BM_Compare, T, Container)
+
+STACK_BENCHMARKS(int, std::deque<int>);
+STACK_BENCHMARKS(int, std::list<int>);
+STACK_BENCHMARKS(int, UnrolledList<int>);
+STACK_BENCHMARKS(int, std::vector<int>);
+STACK_BENCHMARKS(int, StackVector<int>);
+STACK_BENCHMARKS(Pod64, std::deque<Pod64>);
+STACK_BENCHMARKS(Pod64, std::list<Pod64>);
+STACK_BENCHMARKS(Pod64, UnrolledList<Pod64>);
+STACK_BENCHMARKS(Pod64, std::vector<Pod64>);
+STACK_BENCHMARKS(Pod64, StackVector<Pod64>);
+STACK_BENCHMARKS(std::string, std::deque<std::string>);
+STACK_BENCHMARKS(std::string, std::list<std::string>);
+STACK_BENCHMARKS(std::string, UnrolledList<std::string>);
+STACK_BENCHMARKS(std::string, std::vector<std::string>);
+STACK_BENCHMARKS(std::string, StackVector<std::string>);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,97 @@
+/** 
+ *  @brief      Stack polling benchmarks, throwing vs non-throwing accessors
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <optional>
+#include <stdexcept>
+
+#include "stack.h"
+
+/// Polls an empty stack the way a consumer loop does between bursts,
+/// relying on top() and pop() to throw
+static void BM_empty_poll_throwing(benchmark::State& state) {
+    Stack< int > s;
+    int val = 0;
+    for (auto _ : state) {
+        try {
+            val = s.top();
+            s.pop();
+        } catch (const std::runtime_error&) {
+        }
+        benchmark::DoNotOptimize(val);
+    }
+}
+
+/// Polls an empty stack checking empty() before top() and pop(),
+/// which still check again inside
+static void BM_empty_poll_checked(benchmark::State& state) {
+    Stack< int > s;
+    int val = 0;
+    for (auto _ : state) {
+        if (!s.empty()) {
+            val = s.top();
+            s.pop();
+        }
+        benchmark::DoNotOptimize(val);
+    }
+}
+
+static void BM_empty_poll_try_pop(benchmark::State& state) {
+    Stack< int > s;
+    for (auto _ : state) {
+        std::optional<int> val = s.try_pop();
+        benchmark::DoNotOptimize(val.has_value());
+    }
+}
+
+/// The same loops on a stack that always holds an item
+static void BM_full_poll_throwing(benchmark::State& state) {
+    Stack< int > s;
+    s.push(1);
+    int val = 0;
+    for (auto _ : state) {
+        try {
+            val = s.top();
+            s.pop();
+        } catch (const std::runtime_error&) {
+        }
+        s.push(val);
+        benchmark::DoNotOptimize(val);
+    }
+}
+
+static void BM_full_poll_try_pop(benchmark::State& state) {
+    Stack< int > s;
+    s.push(1);
+    for (auto _ : state) {
+        std::optional<int> val = s.try_pop();
+        s.push(*val);
+        benchmark::DoNotOptimize(*val);
+    }
+}
+
+static void BM_full_poll_unchecked(benchmark::State& state) {
+    Stack< int > s;
+    s.push(1);
+    for (auto _ : state) {
+        int val = s.top_unchecked();
+        s.pop();
+        s.push(val);
+        benchmark::DoNotOptimize(val);
+    }
+}
+
+BENCHMARK(BM_empty_poll_throwing);
+BENCHMARK(BM_empty_poll_checked);
+BENCHMARK(BM_empty_poll_try_pop);
+BENCHMARK(BM_full_poll_throwing);
+BENCHMARK(BM_full_poll_try_pop);
+BENCHMARK(BM_full_poll_unchecked);
+
+BENCHMARK_MAIN();
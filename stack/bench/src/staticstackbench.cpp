@@ -0,0 +1,57 @@
+/** 
+ *  @brief      Static stack benchmarks against the deque-backed Stack
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <deque>
+#include <string>
+
+#include "stack.h"
+#include "staticstack.h"
+
+/// Construct, push a few items, pop them all and destroy
+template < typename StackType >
+static void BM_ShortLivedStack(benchmark::State& state) {
+    const int items = state.range(0);
+    for (auto _ : state) {
+        StackType s;
+        for (int i = 0; i < items; ++i) {
+            s.push(i);
+        }
+        while (!s.empty()) {
+            benchmark::DoNotOptimize(s.top());
+            s.pop();
+        }
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_ShortLivedStack, Stack<int, std::deque<int> >)->Arg(8)->Arg(64);
+BENCHMARK_TEMPLATE(BM_ShortLivedStack, StaticStack<int, 64>)->Arg(8)->Arg(64);
+
+/// One push and one pop on a long-lived half-full stack
+template < typename T, typename StackType >
+static void BM_SteadyPushPop(benchmark::State& state) {
+    StackType s;
+    T item = T();
+    for (int i = 0; i < 32; ++i) {
+        s.push(item);
+    }
+    for (auto _ : state) {
+        s.push(item);
+        benchmark::DoNotOptimize(s.top());
+        s.pop();
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_SteadyPushPop, int, Stack<int, std::deque<int> >);
+BENCHMARK_TEMPLATE(BM_SteadyPushPop, int, StaticStack<int, 64>);
+BENCHMARK_TEMPLATE(BM_SteadyPushPop, int, StaticStack<int, 64, OverflowOverwrite>);
+BENCHMARK_TEMPLATE(BM_SteadyPushPop, std::string, Stack<std::string, std::deque<std::string> >);
+BENCHMARK_TEMPLATE(BM_SteadyPushPop, std::string, StaticStack<std::string, 64>);
+
+BENCHMARK_MAIN();
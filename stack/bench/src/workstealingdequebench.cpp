@@ -0,0 +1,106 @@
+/** 
+ *  @brief      Work-stealing deque benchmarks against a mutex guarded deque
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <deque>
+#include <mutex>
+
+#include "workstealingdeque.h"
+
+/// std::deque behind a mutex, the way task runtimes share work today
+class LockedDeque {
+ private:
+    mutable std::mutex lock_;
+    std::deque<int> items_;
+
+ public:
+    std::size_t size() const {
+        std::lock_guard<std::mutex> guard(lock_);
+        return items_.size();
+    }
+
+    void push(int val) {
+        std::lock_guard<std::mutex> guard(lock_);
+        items_.push_back(val);
+    }
+
+    bool try_pop(int& val) {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (items_.empty()) {
+            return false;
+        }
+        val = items_.back();
+        items_.pop_back();
+        return true;
+    }
+
+    bool try_steal(int& val) {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (items_.empty()) {
+            return false;
+        }
+        val = items_.front();
+        items_.pop_front();
+        return true;
+    }
+};
+
+/// Owner latency without thieves: push a task and pop it back, on top
+/// of a backlog of range(0) tasks; with none, every pop takes the last
+/// task and the deque must synchronize with would-be thieves
+template < typename D >
+static void BM_OwnerPushPop(benchmark::State& state) {
+    D tasks;
+    int val = 0;
+    for (int i = 0; i < state.range(0); ++i) {
+        tasks.push(i);
+    }
+    for (auto _ : state) {
+        tasks.push(val);
+        tasks.try_pop(val);
+        benchmark::DoNotOptimize(val);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_OwnerPushPop, WorkStealingDeque<int>)->Arg(0)->Arg(64);
+BENCHMARK_TEMPLATE(BM_OwnerPushPop, LockedDeque)->Arg(0)->Arg(64);
+
+/// Thread 0 owns the deque and keeps up to 1024 tasks in it, popping
+/// half of what it pushes; every other thread steals. items_per_second
+/// counts the tasks taken by each role
+template < typename D >
+static void BM_Steal(benchmark::State& state) {
+    static D tasks;
+    int val = 0;
+    long taken = 0;
+    if (state.thread_index() == 0) {
+        for (auto _ : state) {
+            if (tasks.size() < 1024) {
+                tasks.push(val++);
+            }
+            if ((val & 1) && tasks.try_pop(val)) {
+                ++taken;
+            }
+        }
+        while (tasks.try_pop(val)) {
+        }
+    } else {
+        for (auto _ : state) {
+            if (tasks.try_steal(val)) {
+                ++taken;
+            }
+        }
+    }
+    state.SetItemsProcessed(taken);
+}
+
+BENCHMARK_TEMPLATE(BM_Steal, WorkStealingDeque<int>)->ThreadRange(2, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Steal, LockedDeque)->ThreadRange(2, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
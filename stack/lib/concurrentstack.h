@@ -0,0 +1,309 @@
+/**
+ *  @brief      Lock-free concurrent stack (Treiber stack) implementation
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_CONCURRENTSTACK_H_
+#define _INCLUDE_CONCURRENTSTACK_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+ * @brief  Hazard pointers shared by ConcurrentStack and WorkStealingDeque
+ *
+ * Holds the record list and the per-thread state as nested names, so
+ * that including this header adds a single name to the program.
+ */
+class StackHazards {
+ public:
+    /*
+     * @brief  Hazard pointer record, one per thread using a ConcurrentStack
+     *
+     * Records are kept in a global lock-free list and are never freed;
+     * a record is handed to another thread once its owner exits.
+     */
+    struct Record {
+        std::atomic<void*> pointer;
+        std::atomic<bool> active;
+        Record* next;
+    };
+
+    /*
+     * @brief        Head of the global hazard record list
+     */
+    static std::atomic<Record*>& records() {
+        static std::atomic<Record*> head(0);
+        return head;
+    }
+
+    /*
+     * @brief        Claim a free hazard record or append a new one
+     * @param        None
+     * @return       A record owned by the calling thread
+     */
+    static Record* acquire() {
+        for (Record* rec = records().load(std::memory_order_acquire); rec;
+             rec = rec->next) {
+            bool expected = false;
+            if (!rec->active.load(std::memory_order_relaxed) &&
+                rec->active.compare_exchange_strong(expected, true)) {
+                return rec;
+            }
+        }
+        Record* rec = new Record;
+        rec->pointer.store(0);
+        rec->active.store(true);
+        rec->next = records().load(std::memory_order_relaxed);
+        while (!records().compare_exchange_weak(rec->next, rec)) {
+        }
+        return rec;
+    }
+
+    /*
+     * @brief        Test whether any thread currently protects a pointer
+     * @param        Sorted snapshot of all hazard pointers, and the pointer
+     * @return       true if the pointer must not be freed yet
+     */
+    static bool is_protected(const std::vector<void*>& hazards, void* ptr) {
+        return std::binary_search(hazards.begin(), hazards.end(), ptr);
+    }
+
+    /*
+     * @brief  Per-thread state: the thread's hazard record and the nodes it
+     *         has unlinked but could not free yet
+     *
+     * Retired nodes are freed once no hazard pointer refers to them; the
+     * list is scanned again only after it has grown by twice the number of
+     * records, so the cost of a scan is amortized over many pops.
+     */
+    class Thread {
+     private:
+        struct Retired {
+            void* ptr;
+            void (*deleter)(void*);
+        };
+
+        Record* record_;
+        std::vector<Retired> retired_;
+        size_t scan_at_;
+
+        void scan() {
+            std::vector<void*> hazards;
+            size_t count = 0;
+            for (Record* rec = records().load(std::memory_order_acquire);
+                 rec; rec = rec->next) {
+                ++count;
+                void* ptr = rec->pointer.load();
+                if (ptr) {
+                    hazards.push_back(ptr);
+                }
+            }
+            std::sort(hazards.begin(), hazards.end());
+
+            std::vector<Retired> kept;
+            for (size_t i = 0; i < retired_.size(); ++i) {
+                if (is_protected(hazards, retired_[i].ptr)) {
+                    kept.push_back(retired_[i]);
+                } else {
+                    retired_[i].deleter(retired_[i].ptr);
+                }
+            }
+            retired_.swap(kept);
+            scan_at_ = retired_.size() + 2 * count + 16;
+        }
+
+     public:
+        Thread() : record_(acquire()), scan_at_(16) {
+        }
+
+        ~Thread() {
+            record_->pointer.store(0);
+            while (!retired_.empty()) {
+                scan();
+                if (!retired_.empty()) {
+                    std::this_thread::yield();
+                }
+            }
+            record_->active.store(false, std::memory_order_release);
+        }
+
+        std::atomic<void*>& hazard() {
+            return record_->pointer;
+        }
+
+        void retire(void* ptr, void (*deleter)(void*)) {
+            Retired r = { ptr, deleter };
+            retired_.push_back(r);
+            if (retired_.size() >= scan_at_) {
+                scan();
+            }
+        }
+
+        static Thread& self() {
+            static thread_local Thread state;
+            return state;
+        }
+    };
+};
+
+/*
+ * @brief  The concurrent stack implementation class
+ *
+ * A Treiber stack: the top of the stack is a single atomic pointer to
+ * a singly linked list of nodes, updated with CAS. Any number of
+ * threads may push and pop concurrently without a lock.
+ *
+ * Popped nodes are reclaimed with hazard pointers: a popping thread
+ * publishes the node it is about to dereference, and a node is only
+ * freed once no thread publishes it. Since nodes are never reused
+ * while protected, a successful CAS on the top pointer always sees the
+ * node's real successor, which rules out the ABA problem.
+ *
+ * Since another thread may pop the top item at any moment, top and
+ * pop are fused into try_pop(val), which moves the item out.
+ */
+template < typename T >
+class ConcurrentStack {
+ private:
+    struct Node {
+        T value;
+        Node* next;
+
+        explicit Node(const T& val) : value(val), next(0) {}
+        explicit Node(T&& val) : value(std::move(val)), next(0) {}
+    };
+
+    std::atomic<Node*> head_;
+
+    ConcurrentStack(const ConcurrentStack&);
+    ConcurrentStack& operator=(const ConcurrentStack&);
+
+    void link(Node* node);
+    static void destroy(void* node);
+
+ public:
+    ConcurrentStack();
+    ~ConcurrentStack();
+    bool empty() const;
+    void push(const T& val);
+    void push(T&& val);
+    bool try_pop(T& val);
+};
+
+/*
+ * @brief        Default constructor
+ */
+template < typename T >
+ConcurrentStack<T>::ConcurrentStack() : head_(0) {
+}
+
+/*
+ * @brief        Destructor, frees the remaining nodes
+ *
+ * Must not run concurrently with any other member function.
+ */
+template < typename T >
+ConcurrentStack<T>::~ConcurrentStack() {
+    Node* node = head_.load(std::memory_order_relaxed);
+    while (node) {
+        Node* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+/*
+ * @brief        Test whether stack is empty
+ * @param        None
+ * @return       true if stack empty at the time of the call
+ */
+template < typename T >
+bool ConcurrentStack<T>::empty() const {
+    return head_.load(std::memory_order_acquire) == 0;
+}
+
+/*
+ * @brief        Publish a new node at top of stack
+ * @param        The node
+ * @return       Nothing
+ */
+template < typename T >
+void ConcurrentStack<T>::link(Node* node) {
+    node->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(node->next, node,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+    }
+}
+
+/*
+ * @brief        Deleter handed to the hazard pointer retire list
+ * @param        The node
+ * @return       Nothing
+ */
+template < typename T >
+void ConcurrentStack<T>::destroy(void* node) {
+    delete static_cast<Node*>(node);
+}
+
+/*
+ * @brief        Add a new item at top of stack
+ * @param        The item
+ * @return       Nothing
+ */
+template < typename T >
+void ConcurrentStack<T>::push(const T& val) {
+    link(new Node(val));
+}
+
+/*
+ * @brief        Move a new item to top of stack
+ * @param        The item
+ * @return       Nothing
+ */
+template < typename T >
+void ConcurrentStack<T>::push(T&& val) {
+    link(new Node(std::move(val)));
+}
+
+/*
+ * @brief        Move the top item out of stack
+ * @param        Destination of the item
+ * @return       false if the stack is empty
+ */
+template < typename T >
+bool ConcurrentStack<T>::try_pop(T& val) {
+    StackHazards::Thread& self = StackHazards::Thread::self();
+    std::atomic<void*>& hazard = self.hazard();
+    Node* old = head_.load(std::memory_order_acquire);
+    for (;;) {
+        if (!old) {
+            hazard.store(0, std::memory_order_release);
+            return false;
+        }
+        hazard.store(old);
+        Node* current = head_.load();
+        if (current != old) {
+            old = current;
+            continue;
+        }
+        if (head_.compare_exchange_weak(old, old->next)) {
+            break;
+        }
+    }
+    hazard.store(0, std::memory_order_release);
+    val = std::move(old->value);
+    self.retire(old, &ConcurrentStack::destroy);
+    return true;
+}
+
+#endif
@@ -0,0 +1,350 @@
+/**
+ *  @brief      Intrusive stack of items linked through an embedded hook
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_INTRUSIVESTACK_H_
+#define _INCLUDE_INTRUSIVESTACK_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "intrusivehook.h"
+
+/*
+ * @brief  The intrusive stack class
+ *
+ * A LIFO of items which the stack does not own: each item embeds an
+ * IntrusiveHook (see intrusivehook.h), and push links it in by its
+ * address, so items from a pool or an arena are stacked with no
+ * allocation and no copy. size() is O(1), and so is clear.
+ *
+ * The caller keeps every item alive, and at an unchanged address,
+ * while it is stacked, and must not push an item already linked
+ * through the same hook; the stack never destroys items. top and pop
+ * throw runtime_error on an empty stack, try_top and try_pop return a
+ * null pointer instead.
+ *
+ * The stack cannot be copied, as its items cannot be in two stacks
+ * through one hook; it can be moved and swapped. Iteration goes from
+ * the top down, while the relational operators compare the items from
+ * the bottom up, as those of Stack do.
+ */
+template < typename T, IntrusiveHook<T> T::*Hook = &T::hook >
+class IntrusiveStack {
+ public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+
+    /*
+     * @brief  Forward iterator from top to bottom
+     */
+    template < typename Item >
+    class basic_iterator {
+     public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Item value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Item* pointer;
+        typedef Item& reference;
+
+        basic_iterator() : item_(0) {}
+        explicit basic_iterator(Item* item) : item_(item) {}
+
+        /// iterators convert to const_iterator
+        operator basic_iterator<const Item>() const {
+            return basic_iterator<const Item>(item_);
+        }
+
+        reference operator*() const { return *item_; }
+        pointer operator->() const { return item_; }
+        basic_iterator& operator++() {
+            item_ = (item_->*Hook).next;
+            return *this;
+        }
+        basic_iterator operator++(int) {
+            basic_iterator old(*this);
+            ++*this;
+            return old;
+        }
+        bool operator==(const basic_iterator& other) const {
+            return item_ == other.item_;
+        }
+        bool operator!=(const basic_iterator& other) const {
+            return item_ != other.item_;
+        }
+
+     private:
+        Item* item_;
+    };
+
+    typedef basic_iterator<T> iterator;
+    typedef basic_iterator<const T> const_iterator;
+
+ private:
+    T* top_;
+    size_type size_;
+
+    IntrusiveStack(const IntrusiveStack&);
+    IntrusiveStack& operator=(const IntrusiveStack&);
+
+ public:
+    IntrusiveStack();
+    IntrusiveStack(IntrusiveStack&& other) noexcept;
+    IntrusiveStack& operator=(IntrusiveStack&& other) noexcept;
+    bool empty() const;
+    size_type size() const;
+    T& top();
+    const T& top() const;
+    T* try_top();
+    void push(T& item);
+    void pop();
+    T* try_pop();
+    void clear();
+    void swap(IntrusiveStack& other) noexcept;
+    iterator begin() { return iterator(top_); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(top_); }
+    const_iterator end() const { return const_iterator(); }
+};
+
+/*
+ * @brief        Default constructor, makes an empty stack
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+IntrusiveStack<T, Hook>::IntrusiveStack() : top_(0), size_(0) {
+}
+
+/*
+ * @brief        Move constructor, takes over the items of other
+ * @param        The stack to move from, left empty
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+IntrusiveStack<T, Hook>::IntrusiveStack(IntrusiveStack&& other) noexcept
+    : top_(other.top_), size_(other.size_) {
+    other.clear();
+}
+
+/*
+ * @brief        Move assignment, unlinks the items held so far
+ * @param        The stack to move from, left empty
+ * @return       This stack
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+IntrusiveStack<T, Hook>&
+IntrusiveStack<T, Hook>::operator=(IntrusiveStack&& other) noexcept {
+    clear();
+    swap(other);
+    return *this;
+}
+
+/*
+ * @brief        Test whether stack is empty
+ * @param        None
+ * @return       true if stack empty
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+bool IntrusiveStack<T, Hook>::empty() const {
+    return size_ == 0;
+}
+
+/*
+ * @brief        Get size of stack, i.e. no. of items linked in
+ * @param        None
+ * @return       The number of items, kept as items come and go
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+typename IntrusiveStack<T, Hook>::size_type
+IntrusiveStack<T, Hook>::size() const {
+    return size_;
+}
+
+/*
+ * @brief        Access the top item in stack
+ * @param        None
+ * @return       Reference to the top item
+ * @throws       runtime_error - if stack empty
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+T& IntrusiveStack<T, Hook>::top() {
+    if (!top_) {
+        throw std::runtime_error("Stack empty");
+    }
+    return *top_;
+}
+
+template < typename T, IntrusiveHook<T> T::*Hook >
+const T& IntrusiveStack<T, Hook>::top() const {
+    if (!top_) {
+        throw std::runtime_error("Stack empty");
+    }
+    return *top_;
+}
+
+/*
+ * @brief        Access the top item without the empty check throwing
+ * @param        None
+ * @return       Pointer to the top item, or null if stack empty
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+T* IntrusiveStack<T, Hook>::try_top() {
+    return top_;
+}
+
+/*
+ * @brief        Link an item in on top of stack
+ * @param        The item, which must stay alive until popped
+ * @return       Nothing
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+void IntrusiveStack<T, Hook>::push(T& item) {
+    (item.*Hook).next = top_;
+    top_ = &item;
+    ++size_;
+}
+
+/*
+ * @brief        Unlink the top item
+ * @param        None
+ * @return       Nothing
+ * @throws       runtime_error - if stack empty
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+void IntrusiveStack<T, Hook>::pop() {
+    if (!try_pop()) {
+        throw std::runtime_error("Stack empty");
+    }
+}
+
+/*
+ * @brief        Unlink the top item, if any
+ * @param        None
+ * @return       The item, now owned by the caller again, or null if
+ *               stack empty
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+T* IntrusiveStack<T, Hook>::try_pop() {
+    T* item = top_;
+    if (item) {
+        top_ = (item->*Hook).next;
+        (item->*Hook).next = 0;
+        --size_;
+    }
+    return item;
+}
+
+/*
+ * @brief        Unlink all items at once; their hooks are reset when
+ *               they are pushed again
+ * @param        None
+ * @return       Nothing
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+void IntrusiveStack<T, Hook>::clear() {
+    top_ = 0;
+    size_ = 0;
+}
+
+/*
+ * @brief        Exchange the items of two stacks
+ * @param        The other stack
+ * @return       Nothing
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+void IntrusiveStack<T, Hook>::swap(IntrusiveStack& other) noexcept {
+    std::swap(top_, other.top_);
+    std::swap(size_, other.size_);
+}
+
+/*
+ * @brief        Performs the equality test on operands
+ * @param        Two stack objects to be compared
+ * @return       true if they hold equal items in the same order
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+bool operator==(const IntrusiveStack<T, Hook>& lhs,
+                const IntrusiveStack<T, Hook>& rhs) {
+    return lhs.size() == rhs.size() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+/*
+ * @brief        Performs the inequality test on operands
+ * @param        Two stack objects to be compared
+ * @return       true if unequal
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+bool operator!=(const IntrusiveStack<T, Hook>& lhs,
+                const IntrusiveStack<T, Hook>& rhs) {
+    return !(lhs == rhs);
+}
+
+/*
+ * @brief        Performs the less-than test on operands
+ *
+ * Compares the items from the bottom up, as Stack does. The links only
+ * run downwards, so the items are gathered first and compared in
+ * reverse.
+ *
+ * @param        Two stack objects to be compared
+ * @return       true if lhs comes first, bottom to top
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+bool operator<(const IntrusiveStack<T, Hook>& lhs,
+               const IntrusiveStack<T, Hook>& rhs) {
+    std::vector<const T*> left, right;
+    left.reserve(lhs.size());
+    right.reserve(rhs.size());
+    for (const T& item : lhs) {
+        left.push_back(&item);
+    }
+    for (const T& item : rhs) {
+        right.push_back(&item);
+    }
+    return std::lexicographical_compare(
+        left.rbegin(), left.rend(), right.rbegin(), right.rend(),
+        [](const T* x, const T* y) { return *x < *y; });
+}
+
+/*
+ * @brief        Performs the less-than-or-equal test on operands
+ * @param        Two stack objects to be compared
+ * @return       true if lhs does not come after rhs
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+bool operator<=(const IntrusiveStack<T, Hook>& lhs,
+                const IntrusiveStack<T, Hook>& rhs) {
+    return !(rhs < lhs);
+}
+
+/*
+ * @brief        Performs the greater-than-or-equal test on operands
+ * @param        Two stack objects to be compared
+ * @return       true if lhs does not come before rhs
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+bool operator>=(const IntrusiveStack<T, Hook>& lhs,
+                const IntrusiveStack<T, Hook>& rhs) {
+    return !(lhs < rhs);
+}
+
+/*
+ * @brief        Performs the greater-than test on operands
+ * @param        Two stack objects to be compared
+ * @return       true if lhs comes after rhs
+ */
+template < typename T, IntrusiveHook<T> T::*Hook >
+bool operator>(const IntrusiveStack<T, Hook>& lhs,
+               const IntrusiveStack<T, Hook>& rhs) {
+    return rhs < lhs;
+}
+
+#endif
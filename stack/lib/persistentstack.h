@@ -0,0 +1,486 @@
+/**
+ *  @brief      Persistent stack, whose versions share their nodes
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_PERSISTENTSTACK_H_
+#define _INCLUDE_PERSISTENTSTACK_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "allocators.h"
+
+ ///  Forward declaration of class is required for making
+ ///  operators == and < friends of PersistentStack class
+template < typename T, typename Allocator >
+class PersistentStack;
+
+template < typename T, typename Allocator >
+bool operator==(const PersistentStack<T, Allocator>& lhs,
+                const PersistentStack<T, Allocator>& rhs);
+
+template < typename T, typename Allocator >
+bool operator<(const PersistentStack<T, Allocator>& lhs,
+               const PersistentStack<T, Allocator>& rhs);
+
+/*
+ * @brief  The persistent stack class
+ *
+ * An immutable singly linked list: push and pop leave the stack they
+ * are called on as it was and return a new version, which shares all
+ * the nodes below its top with it. Versions are thus snapshots, and
+ * copying one, or keeping it to come back to later as backtracking
+ * searches do, takes constant time whatever its size.
+ *
+ * Nodes are reference counted and freed with the last version using
+ * them. The counts are not atomic, so versions sharing nodes must stay
+ * on one thread. Nodes come from Allocator, by default PoolAllocator,
+ * so that the steady churn of small nodes skips malloc.
+ *
+ * The relational operators compare the items from the bottom up, as
+ * those of Stack do; parts shared by the two versions are skipped.
+ */
+template < typename T, typename Allocator = PoolAllocator<T> >
+class PersistentStack {
+ public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef std::size_t size_type;
+
+ private:
+    struct Node {
+        size_type refs;
+        size_type depth;
+        Node* next;
+        T value;
+
+        template < typename... Args >
+        Node(Node* below, Args&&... args)
+            : refs(1), depth(below ? below->depth + 1 : 1), next(below),
+              value(std::forward<Args>(args)...) {}
+    };
+
+    typedef typename std::allocator_traits<Allocator>::template
+        rebind_alloc<Node> node_allocator;
+    typedef std::allocator_traits<node_allocator> node_traits;
+
+    node_allocator alloc_;
+    Node* top_;
+
+    PersistentStack(Node* top, const node_allocator& alloc)
+        : alloc_(alloc), top_(top) {}
+
+    static Node* acquire(Node* node) {
+        if (node) {
+            ++node->refs;
+        }
+        return node;
+    }
+
+    void release(Node* node);
+
+ public:
+    /// forward iterator from the top item down to the bottom one
+    class const_iterator {
+     public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        const_iterator() : node_(0) {}
+        reference operator*() const { return node_->value; }
+        pointer operator->() const { return &node_->value; }
+
+        const_iterator& operator++() {
+            node_ = node_->next;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old(*this);
+            node_ = node_->next;
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return node_ == other.node_;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return node_ != other.node_;
+        }
+
+     private:
+        friend class PersistentStack;
+
+        explicit const_iterator(Node* node) : node_(node) {}
+
+        Node* node_;
+    };
+
+    PersistentStack();
+    explicit PersistentStack(const Allocator& alloc);
+    template < typename InputIterator >
+    PersistentStack(InputIterator first, InputIterator last,
+                    const Allocator& alloc = Allocator());
+    PersistentStack(const PersistentStack& other);
+    PersistentStack(PersistentStack&& other) noexcept;
+    PersistentStack& operator=(const PersistentStack& other);
+    PersistentStack& operator=(PersistentStack&& other) noexcept;
+    ~PersistentStack();
+
+    bool empty() const;
+    size_type size() const;
+    const T& top() const;
+    const T* try_top() const;
+    [[nodiscard]] PersistentStack push(const T& val) const;
+    [[nodiscard]] PersistentStack push(T&& val) const;
+    template < typename... Args >
+    [[nodiscard]] PersistentStack emplace(Args&&... args) const;
+    [[nodiscard]] PersistentStack pop() const;
+    const_iterator begin() const { return const_iterator(top_); }
+    const_iterator end() const { return const_iterator(); }
+    void swap(PersistentStack& other) noexcept;
+    Allocator get_allocator() const { return Allocator(alloc_); }
+
+    friend bool operator== <> (const PersistentStack& lhs,
+                               const PersistentStack& rhs);
+    friend bool operator< <> (const PersistentStack& lhs,
+                              const PersistentStack& rhs);
+};
+
+/*
+ * @brief        Default constructor, the empty stack
+ */
+template < typename T, typename Allocator >
+PersistentStack<T, Allocator>::PersistentStack() : alloc_(), top_(0) {
+}
+
+/*
+ * @brief        Constructor taking the allocator of the nodes
+ */
+template < typename T, typename Allocator >
+PersistentStack<T, Allocator>::PersistentStack(const Allocator& alloc)
+    : alloc_(alloc), top_(0) {
+}
+
+/*
+ * @brief        Constructor pushing a range of items, the last on top
+ * @param        The range, and the allocator of the nodes
+ */
+template < typename T, typename Allocator >
+template < typename InputIterator >
+PersistentStack<T, Allocator>::PersistentStack(InputIterator first,
+                                               InputIterator last,
+                                               const Allocator& alloc)
+    : alloc_(alloc), top_(0) {
+    for (; first != last; ++first) {
+        *this = push(*first);
+    }
+}
+
+/*
+ * @brief        Copy constructor, shares every node
+ */
+template < typename T, typename Allocator >
+PersistentStack<T, Allocator>::PersistentStack(const PersistentStack& other)
+    : alloc_(other.alloc_), top_(acquire(other.top_)) {
+}
+
+/*
+ * @brief        Move constructor
+ */
+template < typename T, typename Allocator >
+PersistentStack<T, Allocator>::PersistentStack(PersistentStack&& other) noexcept
+    : alloc_(other.alloc_), top_(other.top_) {
+    other.top_ = 0;
+}
+
+/*
+ * @brief        Copy assignment, shares every node
+ */
+template < typename T, typename Allocator >
+PersistentStack<T, Allocator>& PersistentStack<T, Allocator>::operator=(
+        const PersistentStack& other) {
+    Node* old = top_;
+    top_ = acquire(other.top_);  /// before the release, for self-assignment
+    release(old);
+    alloc_ = other.alloc_;
+    return *this;
+}
+
+/*
+ * @brief        Move assignment
+ */
+template < typename T, typename Allocator >
+PersistentStack<T, Allocator>& PersistentStack<T, Allocator>::operator=(
+        PersistentStack&& other) noexcept {
+    swap(other);
+    return *this;
+}
+
+/*
+ * @brief        Destructor, frees the nodes no other version uses
+ */
+template < typename T, typename Allocator >
+PersistentStack<T, Allocator>::~PersistentStack() {
+    release(top_);
+}
+
+/*
+ * @brief        Drop a reference to a node, freeing it and then the
+ *               nodes below it as long as nothing else refers to them
+ * @param        The node, or null
+ * @return       Nothing
+ */
+template < typename T, typename Allocator >
+void PersistentStack<T, Allocator>::release(Node* node) {
+    /// a loop rather than recursion, so long stacks do not overflow
+    while (node && --node->refs == 0) {
+        Node* next = node->next;
+        node->~Node();
+        node_traits::deallocate(alloc_, node, 1);
+        node = next;
+    }
+}
+
+/*
+ * @brief        Test whether stack is empty
+ * @param        None
+ * @return       true if stack empty, false otherwise
+ */
+template < typename T, typename Allocator >
+bool PersistentStack<T, Allocator>::empty() const {
+    return top_ == 0;
+}
+
+/*
+ * @brief        Get size of stack, i.e. no. of items
+ * @param        None
+ * @return       The number of items, kept in the top node
+ */
+template < typename T, typename Allocator >
+typename PersistentStack<T, Allocator>::size_type
+PersistentStack<T, Allocator>::size() const {
+    return top_ ? top_->depth : 0;
+}
+
+/*
+ * @brief        Access the top item in stack
+ * @param        None
+ * @return       Reference to the top item, shared with other versions
+ * @throws       runtime_error if stack is empty
+ */
+template < typename T, typename Allocator >
+const T& PersistentStack<T, Allocator>::top() const {
+    if (!top_) {
+        throw std::runtime_error("Stack empty");
+    }
+    return top_->value;
+}
+
+/*
+ * @brief        Access the top item in stack if there is one
+ * @param        None
+ * @return       Pointer to the top item, or null if stack empty
+ */
+template < typename T, typename Allocator >
+const T* PersistentStack<T, Allocator>::try_top() const {
+    return top_ ? &top_->value : 0;
+}
+
+/*
+ * @brief        Make a version with a new item on top of this one
+ * @param        The item
+ * @return       The new version
+ */
+template < typename T, typename Allocator >
+PersistentStack<T, Allocator> PersistentStack<T, Allocator>::push(
+        const T& val) const {
+    return emplace(val);
+}
+
+/*
+ * @brief        Make a version with a new item moved on top of this one
+ * @param        The item
+ * @return       The new version
+ */
+template < typename T, typename Allocator >
+PersistentStack<T, Allocator> PersistentStack<T, Allocator>::push(
+        T&& val) const {
+    return emplace(std::move(val));
+}
+
+/*
+ * @brief        Make a version with a new item constructed on top of
+ *               this one
+ * @param        Arguments forwarded to the constructor of the item
+ * @return       The new version
+ */
+template < typename T, typename Allocator >
+template < typename... Args >
+PersistentStack<T, Allocator> PersistentStack<T, Allocator>::emplace(
+        Args&&... args) const {
+    node_allocator alloc(alloc_);
+    Node* node = node_traits::allocate(alloc, 1);
+    try {
+        ::new (static_cast<void*>(node)) Node(top_, std::forward<Args>(args)...);
+    } catch (...) {
+        node_traits::deallocate(alloc, node, 1);
+        throw;
+    }
+    acquire(top_);
+    return PersistentStack(node, alloc);
+}
+
+/*
+ * @brief        Make a version without the top item of this one
+ * @param        None
+ * @return       The new version
+ * @throws       runtime_error if stack is empty
+ */
+template < typename T, typename Allocator >
+PersistentStack<T, Allocator> PersistentStack<T, Allocator>::pop() const {
+    if (!top_) {
+        throw std::runtime_error("Stack empty");
+    }
+    return PersistentStack(acquire(top_->next), alloc_);
+}
+
+/*
+ * @brief        Exchange two versions, with their allocators
+ * @param        The other version
+ * @return       Nothing
+ */
+template < typename T, typename Allocator >
+void PersistentStack<T, Allocator>::swap(PersistentStack& other) noexcept {
+    using std::swap;
+    swap(alloc_, other.alloc_);
+    swap(top_, other.top_);
+}
+
+/*
+ * @brief        Exchange two versions, found through ADL
+ * @param        Two stack objects to be swapped
+ * @return       Nothing
+ */
+template < typename T, typename Allocator >
+void swap(PersistentStack<T, Allocator>& lhs,
+          PersistentStack<T, Allocator>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+/*
+ * @brief        Performs the equality test on operands
+ *
+ * Walks both stacks down from the top until they reach a node they
+ * share, below which they are equal.
+ *
+ * @param        Two stack objects to be compared
+ * @return       true if equal
+ */
+template < typename T, typename Allocator >
+bool operator==(const PersistentStack<T, Allocator>& lhs,
+                const PersistentStack<T, Allocator>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    auto a = lhs.top_;
+    auto b = rhs.top_;
+    for (; a != b; a = a->next, b = b->next) {
+        if (!(a->value == b->value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * @brief        Performs the less than test on operands
+ *
+ * Compares the items from the bottom up, as Stack does. The nodes
+ * both stacks share are equal, so only the ones above them are
+ * gathered and compared.
+ *
+ * @param        Two stack objects to be compared
+ * @return       true if left is less than right operand
+ */
+template < typename T, typename Allocator >
+bool operator<(const PersistentStack<T, Allocator>& lhs,
+               const PersistentStack<T, Allocator>& rhs) {
+    auto a = lhs.top_;
+    auto b = rhs.top_;
+    std::vector<const T*> left, right;
+    for (; a && (!b || a->depth > b->depth); a = a->next) {
+        left.push_back(&a->value);
+    }
+    for (; b && (!a || b->depth > a->depth); b = b->next) {
+        right.push_back(&b->value);
+    }
+    for (; a != b; a = a->next, b = b->next) {
+        left.push_back(&a->value);
+        right.push_back(&b->value);
+    }
+    return std::lexicographical_compare(
+        left.rbegin(), left.rend(), right.rbegin(), right.rend(),
+        [](const T* x, const T* y) { return *x < *y; });
+}
+
+/*
+ * @brief        Performs the inequality test on operands
+ * @param        Two stack objects to be compared
+ * @return       true if unequal
+ */
+template < typename T, typename Allocator >
+bool operator!=(const PersistentStack<T, Allocator>& lhs,
+                const PersistentStack<T, Allocator>& rhs) {
+    return !(lhs == rhs);
+}
+
+/*
+ * @brief        Performs the less than or equal to test on operands
+ * @param        Two stack objects to be compared
+ * @return       true if left is less than or equal to right operand
+ */
+template < typename T, typename Allocator >
+bool operator<=(const PersistentStack<T, Allocator>& lhs,
+                const PersistentStack<T, Allocator>& rhs) {
+    return !(rhs < lhs);
+}
+
+/*
+ * @brief        Performs the greater than or equal to test on operands
+ * @param        Two stack objects to be compared
+ * @return       true if left is greater than or equal to right operand
+ */
+template < typename T, typename Allocator >
+bool operator>=(const PersistentStack<T, Allocator>& lhs,
+                const PersistentStack<T, Allocator>& rhs) {
+    return !(lhs < rhs);
+}
+
+/*
+ * @brief        Performs the greater than test on operands
+ * @param        Two stack objects to be compared
+ * @return       true if left is greater than right operand
+ */
+template < typename T, typename Allocator >
+bool operator>(const PersistentStack<T, Allocator>& lhs,
+               const PersistentStack<T, Allocator>& rhs) {
+    return rhs < lhs;
+}
+
+#endif
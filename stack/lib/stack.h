@@ -5,16 +5,24 @@
  *  @version    1.0
  *  Copyright (C) 2015 Ashish, MIT license
  * 
- *     TODO         add more constructors,
- *                 provide emplace method,
- *                   provide swap method
+ *     TODO         add more constructors
  * 
  */
 
-#ifndef _INCLUDE_STACK_H
+#ifndef _INCLUDE_STACK_H_
 #define _INCLUDE_STACK_H_
 
+#include <cassert>
 #include <deque>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "containertraits.h"
+#include "instrumentation.h"
+#include "simdcompare.h"
+#include "stackvector.h"
 
 /*
  * @brief  The stack implementation class
@@ -29,36 +37,129 @@
  *        back
  *        push_back
  *        pop_back
+ *        emplace_back (only if emplace is used)
+ * 
+ * A container of fixed capacity, like StaticRing, may return bool from
+ * push_back and emplace_back, false when full; push and emplace then
+ * throw runtime_error rather than drop the item (see ContainerPush).
+ * 
+ * Items can be moved in with push(T&&) or constructed in place with
+ * emplace, and moved out with pop_value, so that pushing and popping
+ * items which own memory (strings, messages) never copies them.
+ * 
+ * try_top and try_pop report an empty stack with a null pointer and
+ * an empty optional instead of an exception, for polling loops where
+ * empty is the common case; top_unchecked skips the check, which is
+ * then only asserted in debug builds.
+ * 
+ * push_range, push_bulk, pop_n and drain move groups of items with a
+ * single size check; the container grows once per group and copies
+ * trivially copyable items in bulk (see ContainerBulk).
+ * 
+ * == and < compare stacks of numbers with SSE2 or AVX2 kernels, picked
+ * at run time, when the container keeps its items in arrays, as vector,
+ * StackVector and UnrolledList do (see ContainerCompare in
+ * simdcompare.h).
  * 
  * The suitable standard container classes are: vector, deque and list.
+ * StackVector is a contiguous container that additionally supports
+ * reserve, shrink_to_fit with hysteresis and a configurable growth
+ * factor; Stack forwards reserve and shrink_to_fit to the container.
+ * UnrolledList keeps items in cache-line blocks and never moves them,
+ * and recycles emptied blocks; reserve and shrink_to_fit fill and
+ * empty its spare blocks (see unrolledlist.h).
+ * 
+ * By default, if no container class is specified, StackVector is used
+ * for trivially copyable items, for which it relocates with memcpy and
+ * keeps top() a single indexed load, and deque for all other items.
  * 
- * By default, if no container class is specified deque is used.
+ * The Allocator parameter is handed to the container, whose own
+ * allocator is replaced by it (see RebindContainer); it defaults to
+ * the container's allocator, which leaves the container as it is.
+ * Other allocators need a container of the form C<T, Alloc> or one
+ * which specializes RebindContainer. A container without
+ * allocator_type is used as it is and gives the stack no allocator
+ * (see AdaptedContainer). Stateful allocators, like the arena in
+ * allocators.h, are passed to the allocator constructor.
+ * 
+ * The Instrumentation policy is a private base told about every push
+ * and pop. The default, NoInstrumentation, is empty and compiles away;
+ * CountingInstrumentation records counters and the peak size, read
+ * with stats() (see instrumentation.h). InstrumentedStack selects it.
  */
+template < typename T,
+           bool Contiguous = std::is_trivially_copyable<T>::value >
+struct StackDefaultContainer {
+    typedef std::deque<T> type;
+};
+
+template < typename T >
+struct StackDefaultContainer<T, true> {
+    typedef StackVector<T> type;
+};
 
  ///  Forward declaration of class is required for making 
  ///  operators == and < friends of Stack class
-template < typename T, typename Container >
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
 class Stack;
 
-template < typename T, typename Container >
-bool operator==(const Stack<T, Container>& lhs, const Stack<T, Container>& rhs);
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+bool operator==(const Stack<T, Container, Allocator, Instrumentation>& lhs,
+                const Stack<T, Container, Allocator, Instrumentation>& rhs);
 
-template < typename T, typename Container >
-bool operator<(const Stack<T, Container>& lhs, const Stack<T, Container>& rhs);
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+bool operator<(const Stack<T, Container, Allocator, Instrumentation>& lhs,
+               const Stack<T, Container, Allocator, Instrumentation>& rhs);
 
-template < typename T, typename Container = std::deque<T> >
-class Stack {
+template < typename T,
+           typename Container = typename StackDefaultContainer<T>::type,
+           typename Allocator = typename ContainerAllocator<Container>::type,
+           typename Instrumentation = NoInstrumentation >
+class Stack : private Instrumentation {
  private:
     typedef unsigned size_type;
-    Container items_;
+    typedef typename AdaptedContainer<Container, Allocator>::type container_type;
+    container_type items_;
 
  public:
+    typedef Allocator allocator_type;
+
     Stack();
+    explicit Stack(const Allocator& alloc);
+    Stack(const Stack& other);
+    Stack(Stack&& other)
+        noexcept(std::is_nothrow_move_constructible<container_type>::value);
+    Stack& operator=(const Stack& other);
+    Stack& operator=(Stack&& other)
+        noexcept(std::is_nothrow_move_assignable<container_type>::value);
     bool empty() const;
     size_type size() const;
     T& top();
+    T* try_top();
+    T& top_unchecked();
     void push(const T& val);
+    void push(T&& val);
+    template < typename... Args >
+    void emplace(Args&&... args);
     void pop();
+    T pop_value();
+    std::optional<T> try_pop();
+    template < typename InputIterator >
+    void push_range(InputIterator first, InputIterator last);
+    void push_bulk(const T* items, size_type count);
+    template < typename OutputIterator >
+    OutputIterator pop_n(size_type n, OutputIterator out);
+    template < typename OutputIterator >
+    OutputIterator drain(OutputIterator out);
+    void swap(Stack& other);
+    void reserve(size_type n);
+    void shrink_to_fit();
+    Allocator get_allocator() const;
+    InstrumentationSnapshot stats() const;
+    InstrumentationSnapshot reset_stats();
 
     friend bool operator== <> (const Stack& lhs, const Stack& rhs);
     friend bool operator< <> (const Stack& lhs, const Stack& rhs);
@@ -67,8 +168,64 @@ class Stack {
 /*
  * @brief        Default constructor
  */
-template < typename T, typename Container >
-Stack<T, Container>::Stack() {
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+Stack<T, Container, Allocator, Instrumentation>::Stack() {
+}
+
+/*
+ * @brief        Constructor taking the allocator handed to the container
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+Stack<T, Container, Allocator, Instrumentation>::Stack(const Allocator& alloc)
+    : items_(alloc) {
+}
+
+/*
+ * @brief        Copy constructor
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+Stack<T, Container, Allocator, Instrumentation>::Stack(const Stack& other)
+    : Instrumentation(), items_(other.items_) {
+}
+
+/*
+ * @brief        Move constructor, takes over the items of other
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+Stack<T, Container, Allocator, Instrumentation>::Stack(Stack&& other)
+    noexcept(std::is_nothrow_move_constructible<container_type>::value)
+    : items_(std::move(other.items_)) {
+}
+
+/*
+ * @brief        Copy assignment
+ * @param        The stack to copy
+ * @return       Reference to this stack
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+Stack<T, Container, Allocator, Instrumentation>&
+Stack<T, Container, Allocator, Instrumentation>::operator=(const Stack& other) {
+    items_ = other.items_;
+    return *this;
+}
+
+/*
+ * @brief        Move assignment, takes over the items of other
+ * @param        The stack to move from
+ * @return       Reference to this stack
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+Stack<T, Container, Allocator, Instrumentation>&
+Stack<T, Container, Allocator, Instrumentation>::operator=(Stack&& other)
+    noexcept(std::is_nothrow_move_assignable<container_type>::value) {
+    items_ = std::move(other.items_);
+    return *this;
 }
 
 /*
@@ -76,8 +233,9 @@ Stack<T, Container>::Stack() {
  * @param        None
  * @return       true if stack empty
  */
-template < typename T, typename Container >
-bool Stack<T, Container>::empty() const {
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+bool Stack<T, Container, Allocator, Instrumentation>::empty() const {
     return items_.empty();
 }
 
@@ -86,8 +244,10 @@ bool Stack<T, Container>::empty() const {
  * @param        None
  * @return       The number of items in the stack
  */
-template < typename T, typename Container >
-typename Stack<T, Container>::size_type Stack<T, Container>::size() const {
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+typename Stack<T, Container, Allocator, Instrumentation>::size_type
+Stack<T, Container, Allocator, Instrumentation>::size() const {
     return items_.size();
 }
 
@@ -97,8 +257,9 @@ typename Stack<T, Container>::size_type Stack<T, Container>::size() const {
  * @return       Reference to the top item in stack
  * @throws       runtime_error - if stack empty
  */
-template < typename T, typename Container >
-T& Stack<T, Container>::top() {
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+T& Stack<T, Container, Allocator, Instrumentation>::top() {
     if (items_.empty()) {
         throw std::runtime_error("Stack empty");
     } else {
@@ -106,14 +267,75 @@ T& Stack<T, Container>::top() {
     }
 }
 
+/*
+ * @brief        Access the top item in Stack without throwing
+ * @param        None
+ * @return       Pointer to the top item, or null if Stack empty
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+T* Stack<T, Container, Allocator, Instrumentation>::try_top() {
+    return items_.empty() ? 0 : &items_.back();
+}
+
+/*
+ * @brief        Access the top item in Stack, which must exist
+ * @param        None
+ * @return       Reference to the top item in Stack
+ *
+ * Emptiness is only checked, with assert, in debug builds.
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+T& Stack<T, Container, Allocator, Instrumentation>::top_unchecked() {
+    assert(!items_.empty());
+    return items_.back();
+}
+
 /*
  * @brief        Add a new item at top of stack 
  * @param        The item
  * @return       Nothing
+ * @throws       runtime_error - if a container of fixed capacity is full
  */
-template < typename T, typename Container >
-void Stack<T, Container>::push(const T& val) {
-    items_.push_back(val);
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+void Stack<T, Container, Allocator, Instrumentation>::push(const T& val) {
+    if (!ContainerPush::push_back(items_, val)) {
+        throw std::runtime_error("Stack full");
+    }
+    Instrumentation::pushed(1, items_.size());
+}
+
+/*
+ * @brief        Move a new item to top of stack 
+ * @param        The item
+ * @return       Nothing
+ * @throws       runtime_error - if a container of fixed capacity is full
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+void Stack<T, Container, Allocator, Instrumentation>::push(T&& val) {
+    if (!ContainerPush::push_back(items_, std::move(val))) {
+        throw std::runtime_error("Stack full");
+    }
+    Instrumentation::pushed(1, items_.size());
+}
+
+/*
+ * @brief        Construct a new item in place at top of stack 
+ * @param        Arguments forwarded to the constructor of T
+ * @return       Nothing
+ * @throws       runtime_error - if a container of fixed capacity is full
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+template < typename... Args >
+void Stack<T, Container, Allocator, Instrumentation>::emplace(Args&&... args) {
+    if (!ContainerPush::emplace_back(items_, std::forward<Args>(args)...)) {
+        throw std::runtime_error("Stack full");
+    }
+    Instrumentation::pushed(1, items_.size());
 }
 
 /*
@@ -122,24 +344,220 @@ void Stack<T, Container>::push(const T& val) {
  * @return       Nothing
  * @throws       runtime_error - if stack empty
  */
-template < typename T, typename Container >
-void Stack<T, Container>::pop() {
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+void Stack<T, Container, Allocator, Instrumentation>::pop() {
     if (items_.empty()) {
+        Instrumentation::empty_pop();
         throw std::runtime_error("Stack empty");
     } else {
         items_.pop_back();
+        Instrumentation::popped(1);
     }
     return;
 }
 
+/*
+ * @brief        Move the top item out of stack and delete it
+ * @param        None
+ * @return       The top item
+ * @throws       runtime_error - if stack empty
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+T Stack<T, Container, Allocator, Instrumentation>::pop_value() {
+    if (items_.empty()) {
+        Instrumentation::empty_pop();
+        throw std::runtime_error("Stack empty");
+    }
+    T val(std::move(items_.back()));
+    items_.pop_back();
+    Instrumentation::popped(1);
+    return val;
+}
+
+/*
+ * @brief        Move the top item out of Stack and delete it, without
+ *               throwing
+ * @param        None
+ * @return       The top item, or nothing if Stack empty
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+std::optional<T> Stack<T, Container, Allocator, Instrumentation>::try_pop() {
+    if (items_.empty()) {
+        Instrumentation::empty_pop();
+        return std::nullopt;
+    }
+    std::optional<T> val(std::move(items_.back()));
+    items_.pop_back();
+    Instrumentation::popped(1);
+    return val;
+}
+
+/*
+ * @brief        Add a range of items at top of Stack, in order
+ * @param        Iterators to the first and past the last item, which
+ *               must not refer to this stack
+ * @return       Nothing
+ *
+ * The container makes room once for ranges of known length, and copies
+ * trivially copyable items in bulk.
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+template < typename InputIterator >
+void Stack<T, Container, Allocator, Instrumentation>::push_range(
+        InputIterator first, InputIterator last) {
+    std::size_t n = append_counted(items_, first, last);
+    Instrumentation::pushed(n, items_.size());
+}
+
+/*
+ * @brief        Add an array of items at top of Stack, in order
+ * @param        Pointer to the first item, and the no. of items
+ * @return       Nothing
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+void Stack<T, Container, Allocator, Instrumentation>::push_bulk(
+        const T* items, size_type count) {
+    ContainerBulk<container_type>::append(items_, items, items + count);
+    Instrumentation::pushed(count, items_.size());
+}
+
+/*
+ * @brief        Move n items out of Stack, top item first, and delete them
+ * @param        The no. of items, and where to move them
+ * @return       The output iterator past the last item written
+ * @throws       runtime_error - if Stack has fewer than n items, in which
+ *               case nothing is removed
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+template < typename OutputIterator >
+OutputIterator Stack<T, Container, Allocator, Instrumentation>::pop_n(
+        size_type n, OutputIterator out) {
+    if (items_.size() < n) {
+        Instrumentation::empty_pop();
+        throw std::runtime_error("Stack empty");
+    }
+    out = ContainerBulk<container_type>::take_back(items_, n, out);
+    Instrumentation::popped(n);
+    return out;
+}
+
+/*
+ * @brief        Move all items out of Stack, top item first, and delete them
+ * @param        Where to move the items
+ * @return       The output iterator past the last item written
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+template < typename OutputIterator >
+OutputIterator Stack<T, Container, Allocator, Instrumentation>::drain(
+        OutputIterator out) {
+    size_type n = items_.size();
+    out = ContainerBulk<container_type>::take_back(items_, n, out);
+    Instrumentation::popped(n);
+    return out;
+}
+
+/*
+ * @brief        Exchange the contents of two stacks
+ * @param        The other stack
+ * @return       Nothing
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+void Stack<T, Container, Allocator, Instrumentation>::swap(Stack& other) {
+    using std::swap;
+    swap(items_, other.items_);
+}
+
+/*
+ * @brief        Get a copy of the allocator handed to the container
+ * @param        None
+ * @return       The allocator
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+Allocator Stack<T, Container, Allocator, Instrumentation>::get_allocator() const {
+    return items_.get_allocator();
+}
+
+/*
+ * @brief        Read the counters of the instrumentation policy; may be
+ *               called from a metrics thread while the stack is in use
+ * @param        None
+ * @return       The counters since the last reset_stats
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+InstrumentationSnapshot
+Stack<T, Container, Allocator, Instrumentation>::stats() const {
+    return Instrumentation::snapshot();
+}
+
+/*
+ * @brief        Restart the counters of the instrumentation policy
+ * @param        None
+ * @return       The counters since the previous reset_stats; summing
+ *               the results counts every push and pop exactly once
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+InstrumentationSnapshot
+Stack<T, Container, Allocator, Instrumentation>::reset_stats() {
+    return Instrumentation::reset();
+}
+
+/*
+ * @brief        Make room for at least n items, if the container can
+ * @param        The no. of items
+ * @return       Nothing
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+void Stack<T, Container, Allocator, Instrumentation>::reserve(size_type n) {
+    items_.reserve(n);
+}
+
+/*
+ * @brief        Give unused memory back, per the container's policy
+ * @param        None
+ * @return       Nothing
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+void Stack<T, Container, Allocator, Instrumentation>::shrink_to_fit() {
+    items_.shrink_to_fit();
+}
+
+/*
+ * @brief        Exchange the contents of two stacks, found through ADL
+ * @param        Two stack objects to be swapped
+ * @return       Nothing
+ */
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+void swap(Stack<T, Container, Allocator, Instrumentation>& lhs,
+          Stack<T, Container, Allocator, Instrumentation>& rhs) {
+    lhs.swap(rhs);
+}
+
 /*
  * @brief        Performs the equality test on operands
  * @param        Two stack objects to be compared
  * @return       true if equal
  */
-template < typename T, typename Container >
-bool operator==(const Stack<T, Container>& lhs, const Stack<T, Container>& rhs) {
-    return lhs.items_ == rhs.items_;
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+bool operator==(const Stack<T, Container, Allocator, Instrumentation>& lhs,
+                const Stack<T, Container, Allocator, Instrumentation>& rhs) {
+    typedef typename Stack<T, Container, Allocator,
+                           Instrumentation>::container_type container_type;
+    return ContainerCompare<container_type>::equal(lhs.items_, rhs.items_);
 }
 
 /*
@@ -147,8 +565,10 @@ bool operator==(const Stack<T, Container>& lhs, const Stack<T, Container>& rhs)
  * @param        Two stack objects to be compared
  * @return       true if unequal
  */
-template < typename T, typename Container >
-bool operator!=(const Stack<T, Container>& lhs, const Stack<T, Container>& rhs) {
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+bool operator!=(const Stack<T, Container, Allocator, Instrumentation>& lhs,
+                const Stack<T, Container, Allocator, Instrumentation>& rhs) {
     return !(lhs == rhs);
 }
 
@@ -157,9 +577,13 @@ bool operator!=(const Stack<T, Container>& lhs, const Stack<T, Container>& rhs)
  * @param        Two stack objects to be compared
  * @return       true if left is less than right operand
  */
-template < typename T, typename Container >
-bool operator<(const Stack<T, Container>& lhs, const Stack<T, Container>& rhs) {
-    return lhs.items_ < rhs.items_;
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+bool operator<(const Stack<T, Container, Allocator, Instrumentation>& lhs,
+               const Stack<T, Container, Allocator, Instrumentation>& rhs) {
+    typedef typename Stack<T, Container, Allocator,
+                           Instrumentation>::container_type container_type;
+    return ContainerCompare<container_type>::less(lhs.items_, rhs.items_);
 }
 
 /*
@@ -167,8 +591,10 @@ bool operator<(const Stack<T, Container>& lhs, const Stack<T, Container>& rhs) {
  * @param        Two stack objects to be compared
  * @return       true if left is less than or equal to right operand
  */
-template < typename T, typename Container >
-bool operator<=(const Stack<T, Container>& lhs, const Stack<T, Container>& rhs) {
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+bool operator<=(const Stack<T, Container, Allocator, Instrumentation>& lhs,
+                const Stack<T, Container, Allocator, Instrumentation>& rhs) {
     return !(rhs < lhs);  // !(lhs > rhs)
 }
 
@@ -178,8 +604,10 @@ bool operator<=(const Stack<T, Container>& lhs, const Stack<T, Container>& rhs)
  * @param        Two stack objects to be compared
  * @return       true if left is greater than or equal to right operand
  */
-template < typename T, typename Container >
-bool operator>=(const Stack<T, Container>& lhs, const Stack<T, Container>& rhs) {
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+bool operator>=(const Stack<T, Container, Allocator, Instrumentation>& lhs,
+                const Stack<T, Container, Allocator, Instrumentation>& rhs) {
     return !(lhs < rhs);
 }
 
@@ -189,11 +617,22 @@ bool operator>=(const Stack<T, Container>& lhs, const Stack<T, Container>& rhs)
  * @param        Two stack objects to be compared
  * @return       true if left is greater than right operand
  */
-template < typename T, typename Container >
-bool operator>(const Stack<T, Container>& lhs, const Stack<T, Container>& rhs) {
+template < typename T, typename Container, typename Allocator,
+           typename Instrumentation >
+bool operator>(const Stack<T, Container, Allocator, Instrumentation>& lhs,
+               const Stack<T, Container, Allocator, Instrumentation>& rhs) {
     return rhs < lhs;
 }
 
 
 
+/*
+ * @brief        Stack recording counters, see stats()
+ */
+template < typename T,
+           typename Container = typename StackDefaultContainer<T>::type >
+using InstrumentedStack = Stack<T, Container,
+                                typename ContainerAllocator<Container>::type,
+                                CountingInstrumentation>;
+
 #endif
@@ -0,0 +1,546 @@
+/**
+ *  @brief      Contiguous growable container for the generic stack
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_STACKVECTOR_H_
+#define _INCLUDE_STACKVECTOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "containertraits.h"
+
+/*
+ * @brief  The contiguous stack container class
+ *
+ * A vector-like array that supports the operations Stack needs from
+ * its container (empty, size, back, push_back, pop_back), plus explicit
+ * capacity management:
+ *
+ *   GrowthPercent  new capacity in percent of the old one when full,
+ *                  e.g. 150 for 1.5x or 200 for 2x
+ *   ShrinkDivisor  shrink_to_fit only releases memory once fewer than
+ *                  capacity / ShrinkDivisor items are left, and then
+ *                  keeps GrowthPercent headroom above the size
+ *   Allocator      where the buffer comes from; the allocator moves and
+ *                  swaps along with the buffer
+ *
+ * The gap between the grow and the shrink threshold gives hysteresis:
+ * a stack that oscillates around some size never reallocates, while
+ * memory still returns after a spike. shrink_to_fit is a single compare
+ * when there is nothing to release, so it can be called after every
+ * unit of work.
+ *
+ * Trivially copyable items are relocated with memcpy on growth.
+ */
+template < typename T, unsigned GrowthPercent = 200, unsigned ShrinkDivisor = 4,
+           typename Allocator = std::allocator<T> >
+class StackVector {
+    static_assert(GrowthPercent > 100, "StackVector must grow when full");
+    static_assert(ShrinkDivisor * 100 > GrowthPercent,
+                  "StackVector shrink threshold must be below the growth headroom");
+
+ public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef std::size_t size_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+ private:
+    typedef std::allocator_traits<Allocator> traits;
+    static const size_type kInitialCapacity = 8;
+
+    Allocator alloc_;
+    T* data_;
+    size_type size_;
+    size_type capacity_;
+
+    T* allocate(size_type n);
+    void deallocate(T* p, size_type n);
+    static void relocate(T* dst, T* src, size_type n, std::true_type);
+    static void relocate(T* dst, T* src, size_type n, std::false_type);
+    void reallocate(size_type capacity);
+    size_type grown() const;
+    template < typename... Args >
+    void grow_and_emplace_back(Args&&... args);
+    template < typename InputIterator >
+    void append(InputIterator first, InputIterator last, std::input_iterator_tag);
+    template < typename ForwardIterator >
+    void append(ForwardIterator first, ForwardIterator last,
+                std::forward_iterator_tag);
+
+ public:
+    StackVector();
+    explicit StackVector(const Allocator& alloc);
+    StackVector(const StackVector& other);
+    StackVector(StackVector&& other) noexcept;
+    StackVector& operator=(const StackVector& other);
+    StackVector& operator=(StackVector&& other) noexcept;
+    ~StackVector();
+
+    bool empty() const { return size_ == 0; }
+    size_type size() const { return size_; }
+    size_type capacity() const { return capacity_; }
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+    T& operator[](size_type i) { return data_[i]; }
+    const T& operator[](size_type i) const { return data_[i]; }
+    T& back() { return data_[size_ - 1]; }
+    const T& back() const { return data_[size_ - 1]; }
+
+    void push_back(const T& val);
+    void push_back(T&& val);
+    template < typename... Args >
+    void emplace_back(Args&&... args);
+    void pop_back();
+    template < typename InputIterator >
+    void append(InputIterator first, InputIterator last);
+    template < typename OutputIterator >
+    OutputIterator take_back(size_type n, OutputIterator out);
+    void clear();
+    void reserve(size_type n);
+    void shrink_to_fit();
+    void swap(StackVector& other) noexcept;
+    Allocator get_allocator() const { return alloc_; }
+};
+
+/*
+ * @brief        Allocate raw storage for n items
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+T* StackVector<T, G, S, A>::allocate(size_type n) {
+    return n ? traits::allocate(alloc_, n) : 0;
+}
+
+/*
+ * @brief        Free raw storage for n items
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+void StackVector<T, G, S, A>::deallocate(T* p, size_type n) {
+    if (p) {
+        traits::deallocate(alloc_, p, n);
+    }
+}
+
+/*
+ * @brief        Move n items to uninitialized storage, trivially copyable T
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+void StackVector<T, G, S, A>::relocate(T* dst, T* src, size_type n, std::true_type) {
+    if (n) {
+        std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src),
+                    n * sizeof(T));
+    }
+}
+
+/*
+ * @brief        Move n items to uninitialized storage and destroy the source
+ *
+ * Items whose move may throw are copied instead, as std::vector does,
+ * so that if one throws the items built so far are destroyed and the
+ * source is left as it was. dst is not freed.
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+void StackVector<T, G, S, A>::relocate(T* dst, T* src, size_type n, std::false_type) {
+    size_type i = 0;
+    try {
+        for (; i < n; ++i) {
+            ::new (static_cast<void*>(dst + i)) T(std::move_if_noexcept(src[i]));
+        }
+    } catch (...) {
+        while (i) {
+            dst[--i].~T();
+        }
+        throw;
+    }
+    for (i = 0; i < n; ++i) {
+        src[i].~T();
+    }
+}
+
+/*
+ * @brief        Move all items to a new buffer of the given capacity
+ * @param        The new capacity, at least size()
+ * @return       Nothing
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+void StackVector<T, G, S, A>::reallocate(size_type capacity) {
+    T* data = allocate(capacity);
+    try {
+        relocate(data, data_, size_, std::is_trivially_copyable<T>());
+    } catch (...) {
+        deallocate(data, capacity);
+        throw;
+    }
+    deallocate(data_, capacity_);
+    data_ = data;
+    capacity_ = capacity;
+}
+
+/*
+ * @brief        Capacity to use when the buffer is full
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+typename StackVector<T, G, S, A>::size_type StackVector<T, G, S, A>::grown() const {
+    if (capacity_ < kInitialCapacity) {
+        return kInitialCapacity;
+    }
+    size_type capacity = capacity_ / 100 * G + capacity_ % 100 * G / 100;
+    return std::max(capacity, capacity_ + 1);
+}
+
+/*
+ * @brief        Default constructor, does not allocate
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+StackVector<T, G, S, A>::StackVector()
+    : alloc_(), data_(0), size_(0), capacity_(0) {
+}
+
+/*
+ * @brief        Constructor taking the allocator to use, does not allocate
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+StackVector<T, G, S, A>::StackVector(const A& alloc)
+    : alloc_(alloc), data_(0), size_(0), capacity_(0) {
+}
+
+/*
+ * @brief        Copy constructor, allocates exactly other.size() items
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+StackVector<T, G, S, A>::StackVector(const StackVector& other)
+    : alloc_(traits::select_on_container_copy_construction(other.alloc_)),
+      data_(allocate(other.size_)), size_(0), capacity_(other.size_) {
+    try {
+        for (; size_ < other.size_; ++size_) {
+            ::new (static_cast<void*>(data_ + size_)) T(other.data_[size_]);
+        }
+    } catch (...) {
+        clear();
+        deallocate(data_, capacity_);
+        throw;
+    }
+}
+
+/*
+ * @brief        Move constructor, takes over the buffer of other
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+StackVector<T, G, S, A>::StackVector(StackVector&& other) noexcept
+    : alloc_(std::move(other.alloc_)),
+      data_(other.data_), size_(other.size_), capacity_(other.capacity_) {
+    other.data_ = 0;
+    other.size_ = 0;
+    other.capacity_ = 0;
+}
+
+/*
+ * @brief        Copy assignment
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+StackVector<T, G, S, A>& StackVector<T, G, S, A>::operator=(const StackVector& other) {
+    if (this != &other) {
+        StackVector copy(other);
+        swap(copy);
+    }
+    return *this;
+}
+
+/*
+ * @brief        Move assignment, takes over the buffer of other
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+StackVector<T, G, S, A>& StackVector<T, G, S, A>::operator=(StackVector&& other) noexcept {
+    StackVector moved(std::move(other));
+    swap(moved);
+    return *this;
+}
+
+/*
+ * @brief        Destructor
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+StackVector<T, G, S, A>::~StackVector() {
+    clear();
+    deallocate(data_, capacity_);
+}
+
+/*
+ * @brief        Add a new item at the back
+ * @param        The item
+ * @return       Nothing
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+void StackVector<T, G, S, A>::push_back(const T& val) {
+    emplace_back(val);
+}
+
+/*
+ * @brief        Move a new item to the back
+ * @param        The item
+ * @return       Nothing
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+void StackVector<T, G, S, A>::push_back(T&& val) {
+    emplace_back(std::move(val));
+}
+
+/*
+ * @brief        Construct a new item in place at the back
+ * @param        Arguments forwarded to the constructor of T
+ * @return       Nothing
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+template < typename... Args >
+void StackVector<T, G, S, A>::emplace_back(Args&&... args) {
+    if (size_ == capacity_) {
+        grow_and_emplace_back(std::forward<Args>(args)...);
+        return;
+    }
+    ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+    ++size_;
+}
+
+/*
+ * @brief        Slow path of emplace_back when the buffer is full
+ * @param        Arguments forwarded to the constructor of T
+ * @return       Nothing
+ *
+ * The new item is constructed before the old items move, so the
+ * arguments may refer to an item of this container.
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+template < typename... Args >
+void StackVector<T, G, S, A>::grow_and_emplace_back(Args&&... args) {
+    size_type capacity = grown();
+    T* data = allocate(capacity);
+    try {
+        ::new (static_cast<void*>(data + size_)) T(std::forward<Args>(args)...);
+    } catch (...) {
+        deallocate(data, capacity);
+        throw;
+    }
+    try {
+        relocate(data, data_, size_, std::is_trivially_copyable<T>());
+    } catch (...) {
+        data[size_].~T();
+        deallocate(data, capacity);
+        throw;
+    }
+    deallocate(data_, capacity_);
+    data_ = data;
+    capacity_ = capacity;
+    ++size_;
+}
+
+/*
+ * @brief        Delete the back item, which must exist
+ * @param        None
+ * @return       Nothing
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+void StackVector<T, G, S, A>::pop_back() {
+    --size_;
+    data_[size_].~T();
+}
+
+/*
+ * @brief        Add a range of items at the back
+ * @param        Iterators to the first and past the last item, which
+ *               must not refer to this container
+ * @return       Nothing
+ *
+ * Ranges of known length grow the buffer at most once, and ranges of
+ * trivially copyable items are copied with memmove.
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+template < typename InputIterator >
+void StackVector<T, G, S, A>::append(InputIterator first, InputIterator last) {
+    append(first, last,
+           typename std::iterator_traits<InputIterator>::iterator_category());
+}
+
+/*
+ * @brief        append for single pass ranges, one item at a time
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+template < typename InputIterator >
+void StackVector<T, G, S, A>::append(InputIterator first, InputIterator last,
+                                     std::input_iterator_tag) {
+    for (; first != last; ++first) {
+        emplace_back(*first);
+    }
+}
+
+/*
+ * @brief        append for ranges of known length
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+template < typename ForwardIterator >
+void StackVector<T, G, S, A>::append(ForwardIterator first, ForwardIterator last,
+                                     std::forward_iterator_tag) {
+    size_type n = std::distance(first, last);
+    if (size_ + n > capacity_) {
+        reallocate(std::max(size_ + n, grown()));
+    }
+    std::uninitialized_copy(first, last, data_ + size_);
+    size_ += n;
+}
+
+/*
+ * @brief        Move the last n items out, last item first, and delete them
+ * @param        The no. of items, at most size(), and where to move them
+ * @return       The output iterator past the last item written
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+template < typename OutputIterator >
+OutputIterator StackVector<T, G, S, A>::take_back(size_type n, OutputIterator out) {
+    std::reverse_iterator<T*> top(data_ + size_);
+    out = std::move(top, top + n, out);
+    for (size_type i = 0; i < n; ++i) {
+        pop_back();
+    }
+    return out;
+}
+
+/*
+ * @brief        Delete all items, keeping the buffer
+ * @param        None
+ * @return       Nothing
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+void StackVector<T, G, S, A>::clear() {
+    while (size_) {
+        pop_back();
+    }
+}
+
+/*
+ * @brief        Make room for at least n items
+ * @param        The no. of items
+ * @return       Nothing
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+void StackVector<T, G, S, A>::reserve(size_type n) {
+    if (n > capacity_) {
+        reallocate(n);
+    }
+}
+
+/*
+ * @brief        Release memory if the size dropped well below capacity
+ * @param        None
+ * @return       Nothing
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+void StackVector<T, G, S, A>::shrink_to_fit() {
+    if (size_ >= capacity_ / S || capacity_ <= kInitialCapacity) {
+        return;
+    }
+    size_type capacity = size_ / 100 * G + size_ % 100 * G / 100;
+    reallocate(std::max(capacity, size_type(kInitialCapacity)));
+}
+
+/*
+ * @brief        Exchange the contents of two containers
+ * @param        The other container
+ * @return       Nothing
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+void StackVector<T, G, S, A>::swap(StackVector& other) noexcept {
+    using std::swap;
+    swap(alloc_, other.alloc_);
+    swap(data_, other.data_);
+    swap(size_, other.size_);
+    swap(capacity_, other.capacity_);
+}
+
+/*
+ * @brief        Exchange the contents of two containers, found through ADL
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+void swap(StackVector<T, G, S, A>& lhs, StackVector<T, G, S, A>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+/*
+ * @brief        Performs the equality test on operands
+ * @param        Two container objects to be compared
+ * @return       true if equal
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+bool operator==(const StackVector<T, G, S, A>& lhs, const StackVector<T, G, S, A>& rhs) {
+    return lhs.size() == rhs.size() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+/*
+ * @brief        Performs the lexicographical less than test on operands
+ * @param        Two container objects to be compared
+ * @return       true if left is less than right operand
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+bool operator<(const StackVector<T, G, S, A>& lhs, const StackVector<T, G, S, A>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(),
+                                        rhs.begin(), rhs.end());
+}
+
+/*
+ * @brief        StackVector with its allocator replaced
+ */
+template < typename T, unsigned G, unsigned S, typename A, typename Allocator >
+struct RebindContainer< StackVector<T, G, S, A>, Allocator > {
+    typedef StackVector<T, G, S, Allocator> type;
+};
+
+/*
+ * @brief        Bulk operations on StackVector, see ContainerBulk
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+struct ContainerBulk< StackVector<T, G, S, A> > {
+    template < typename InputIterator >
+    static void append(StackVector<T, G, S, A>& c, InputIterator first,
+                       InputIterator last) {
+        c.append(first, last);
+    }
+
+    template < typename OutputIterator >
+    static OutputIterator take_back(StackVector<T, G, S, A>& c, std::size_t n,
+                                    OutputIterator out) {
+        return c.take_back(n, out);
+    }
+};
+
+/*
+ * @brief        StackVector as one run of items, see ContainerSegments
+ */
+template < typename T, unsigned G, unsigned S, typename A >
+struct ContainerSegments< StackVector<T, G, S, A> > {
+    static const bool contiguous = true;
+    typedef SplitCursor<T> cursor;
+
+    static cursor runs(const StackVector<T, G, S, A>& c) {
+        return cursor(c.data(), c.size(), 0, 0);
+    }
+};
+
+#endif
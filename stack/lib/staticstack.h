@@ -0,0 +1,318 @@
+/**
+ *  @brief      Stack with a fixed capacity chosen at compile time
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_STATICSTACK_H_
+#define _INCLUDE_STATICSTACK_H_
+
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include "staticring.h"
+
+/*
+ * @brief  The fixed-capacity stack class
+ *
+ * Mirrors the Stack interface on a StaticRing of N items kept inside
+ * the object: it never allocates, and all of it is constexpr, so it can
+ * be used while building tables at compile time.
+ *
+ * Since it can fill up, push and emplace return whether the item was
+ * added. What a push does on a full stack is up to the Overflow policy:
+ *        OverflowError      return false (the default)
+ *        OverflowAssert     assert, and return false in release builds
+ *        OverflowOverwrite  drop the bottom item, the oldest, and return true
+ */
+
+ ///  Forward declaration of class is required for making
+ ///  operators == and < friends of StaticStack class
+template < typename T, std::size_t N, typename Overflow >
+class StaticStack;
+
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool operator==(const StaticStack<T, N, Overflow>& lhs,
+                          const StaticStack<T, N, Overflow>& rhs);
+
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool operator<(const StaticStack<T, N, Overflow>& lhs,
+                         const StaticStack<T, N, Overflow>& rhs);
+
+template < typename T, std::size_t N, typename Overflow = OverflowError >
+class StaticStack {
+ private:
+    typedef std::size_t size_type;
+    StaticRing<T, N, Overflow> items_;
+
+ public:
+    constexpr StaticStack() {}
+    constexpr bool empty() const;
+    constexpr bool full() const;
+    constexpr size_type size() const;
+    static constexpr size_type capacity();
+    constexpr T& top();
+    constexpr T* try_top();
+    constexpr T& top_unchecked();
+    constexpr bool push(const T& val);
+    constexpr bool push(T&& val);
+    template < typename... Args >
+    constexpr bool emplace(Args&&... args);
+    constexpr void pop();
+    constexpr T pop_value();
+    constexpr std::optional<T> try_pop();
+    constexpr void swap(StaticStack& other);
+
+    friend constexpr bool operator== <> (const StaticStack& lhs,
+                                         const StaticStack& rhs);
+    friend constexpr bool operator< <> (const StaticStack& lhs,
+                                        const StaticStack& rhs);
+};
+
+/*
+ * @brief        Test whether stack is empty
+ * @param        None
+ * @return       true if stack empty, false otherwise
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool StaticStack<T, N, Overflow>::empty() const {
+    return items_.empty();
+}
+
+/*
+ * @brief        Test whether stack holds N items
+ * @param        None
+ * @return       true if the next push overflows
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool StaticStack<T, N, Overflow>::full() const {
+    return items_.full();
+}
+
+/*
+ * @brief        Get size of stack, i.e. no. of items
+ * @param        None
+ * @return       The number of items in the stack
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr typename StaticStack<T, N, Overflow>::size_type
+StaticStack<T, N, Overflow>::size() const {
+    return items_.size();
+}
+
+/*
+ * @brief        Get the fixed capacity of stack
+ * @param        None
+ * @return       N
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr typename StaticStack<T, N, Overflow>::size_type
+StaticStack<T, N, Overflow>::capacity() {
+    return N;
+}
+
+/*
+ * @brief        Access the top item in stack
+ * @param        None
+ * @return       Reference to the top item
+ * @throws       runtime_error if stack is empty
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr T& StaticStack<T, N, Overflow>::top() {
+    if (items_.empty()) {
+        throw std::runtime_error("Stack empty");
+    }
+    return items_.back();
+}
+
+/*
+ * @brief        Access the top item in stack if there is one
+ * @param        None
+ * @return       Pointer to the top item, or null if stack empty
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr T* StaticStack<T, N, Overflow>::try_top() {
+    return items_.empty() ? 0 : &items_.back();
+}
+
+/*
+ * @brief        Access the top item in stack without checking
+ * @param        None
+ * @return       Reference to the top item; stack must not be empty
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr T& StaticStack<T, N, Overflow>::top_unchecked() {
+    assert(!items_.empty() && "Stack empty");
+    return items_.back();
+}
+
+/*
+ * @brief        Add a new item on top of stack
+ * @param        The item
+ * @return       false if stack was full and the policy rejected the item
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool StaticStack<T, N, Overflow>::push(const T& val) {
+    return items_.push_back(val);
+}
+
+/*
+ * @brief        Move a new item on top of stack
+ * @param        The item
+ * @return       false if stack was full and the policy rejected the item
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool StaticStack<T, N, Overflow>::push(T&& val) {
+    return items_.push_back(std::move(val));
+}
+
+/*
+ * @brief        Construct a new item on top of stack
+ * @param        Arguments forwarded to the constructor of the item
+ * @return       false if stack was full and the policy rejected the item
+ */
+template < typename T, std::size_t N, typename Overflow >
+template < typename... Args >
+constexpr bool StaticStack<T, N, Overflow>::emplace(Args&&... args) {
+    return items_.emplace_back(std::forward<Args>(args)...);
+}
+
+/*
+ * @brief        Delete the top item in stack
+ * @param        None
+ * @return       Nothing
+ * @throws       runtime_error if stack is empty
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr void StaticStack<T, N, Overflow>::pop() {
+    if (items_.empty()) {
+        throw std::runtime_error("Stack empty");
+    }
+    items_.pop_back();
+}
+
+/*
+ * @brief        Move the top item out of stack and delete it
+ * @param        None
+ * @return       The top item
+ * @throws       runtime_error if stack is empty
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr T StaticStack<T, N, Overflow>::pop_value() {
+    if (items_.empty()) {
+        throw std::runtime_error("Stack empty");
+    }
+    T val(std::move(items_.back()));
+    items_.pop_back();
+    return val;
+}
+
+/*
+ * @brief        Move the top item out of stack, if any, and delete it
+ * @param        None
+ * @return       The top item, or an empty optional if stack empty
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr std::optional<T> StaticStack<T, N, Overflow>::try_pop() {
+    if (items_.empty()) {
+        return std::nullopt;
+    }
+    std::optional<T> val(std::move(items_.back()));
+    items_.pop_back();
+    return val;
+}
+
+/*
+ * @brief        Exchange the contents of two stacks
+ * @param        The other stack
+ * @return       Nothing
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr void StaticStack<T, N, Overflow>::swap(StaticStack& other) {
+    items_.swap(other.items_);
+}
+
+/*
+ * @brief        Exchange the contents of two stacks, found through ADL
+ * @param        Two stack objects to be swapped
+ * @return       Nothing
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr void swap(StaticStack<T, N, Overflow>& lhs,
+                    StaticStack<T, N, Overflow>& rhs) {
+    lhs.swap(rhs);
+}
+
+/*
+ * @brief        Performs the equality test on operands
+ * @param        Two stack objects to be compared
+ * @return       true if equal
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool operator==(const StaticStack<T, N, Overflow>& lhs,
+                          const StaticStack<T, N, Overflow>& rhs) {
+    return lhs.items_ == rhs.items_;
+}
+
+/*
+ * @brief        Performs the inequality test on operands
+ * @param        Two stack objects to be compared
+ * @return       true if unequal
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool operator!=(const StaticStack<T, N, Overflow>& lhs,
+                          const StaticStack<T, N, Overflow>& rhs) {
+    return !(lhs == rhs);
+}
+
+/*
+ * @brief        Performs the less than test on operands
+ * @param        Two stack objects to be compared
+ * @return       true if left is less than right operand
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool operator<(const StaticStack<T, N, Overflow>& lhs,
+                         const StaticStack<T, N, Overflow>& rhs) {
+    return lhs.items_ < rhs.items_;
+}
+
+/*
+ * @brief        Performs the less than or equal to test on operands
+ * @param        Two stack objects to be compared
+ * @return       true if left is less than or equal to right operand
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool operator<=(const StaticStack<T, N, Overflow>& lhs,
+                          const StaticStack<T, N, Overflow>& rhs) {
+    return !(rhs < lhs);
+}
+
+/*
+ * @brief        Performs the greater than or equal to test on operands
+ * @param        Two stack objects to be compared
+ * @return       true if left is greater than or equal to right operand
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool operator>=(const StaticStack<T, N, Overflow>& lhs,
+                          const StaticStack<T, N, Overflow>& rhs) {
+    return !(lhs < rhs);
+}
+
+/*
+ * @brief        Performs the greater than test on operands
+ * @param        Two stack objects to be compared
+ * @return       true if left is greater than right operand
+ */
+template < typename T, std::size_t N, typename Overflow >
+constexpr bool operator>(const StaticStack<T, N, Overflow>& lhs,
+                         const StaticStack<T, N, Overflow>& rhs) {
+    return rhs < lhs;
+}
+
+#endif
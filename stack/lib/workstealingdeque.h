@@ -0,0 +1,260 @@
+/**
+ *  @brief      Lock-free work-stealing deque (Chase-Lev) implementation
+ *
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ *
+ */
+
+#ifndef _INCLUDE_WORKSTEALINGDEQUE_H_
+#define _INCLUDE_WORKSTEALINGDEQUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include "concurrentstack.h"
+
+/*
+ * @brief  The work-stealing deque class
+ *
+ * A Chase-Lev deque, with the memory orders of Le, Pop, Cohen and
+ * Zappa Nardelli (PPoPP 2013). One thread, the owner, pushes and pops
+ * items at the bottom, like a Stack; any other thread may steal the
+ * oldest item from the top, like a Queue. The owner only contends with
+ * thieves for the last item, so its push and pop are a few plain loads
+ * and stores.
+ *
+ * Items live in a power-of-two circular array which the owner doubles
+ * when it fills up, copying the live items over. Thieves may still be
+ * reading the old array, so it is retired with hazard pointers (see
+ * StackHazards) and freed once no thief publishes it.
+ *
+ * Thieves read a slot before they know whether they won it, so slots
+ * are atomics and T must be trivially copyable: task pointers or
+ * indices, as work-stealing schedulers use.
+ */
+template < typename T >
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "WorkStealingDeque items must be trivially copyable");
+
+ private:
+    typedef std::int64_t index_type;
+    static const std::size_t kCacheLine = 64;
+
+    struct Array {
+        index_type mask;
+        std::atomic<T>* slots;
+
+        explicit Array(index_type capacity)
+            : mask(capacity - 1), slots(new std::atomic<T>[capacity]) {}
+        ~Array() { delete[] slots; }
+
+        T get(index_type i) const {
+            return slots[i & mask].load(std::memory_order_relaxed);
+        }
+        void put(index_type i, T val) {
+            slots[i & mask].store(val, std::memory_order_relaxed);
+        }
+    };
+
+    /// thieves' end: next item to steal
+    alignas(kCacheLine) std::atomic<index_type> top_;
+
+    /// owner's end: next free slot, and the current array
+    alignas(kCacheLine) std::atomic<index_type> bottom_;
+    std::atomic<Array*> array_;
+
+    WorkStealingDeque(const WorkStealingDeque&);
+    WorkStealingDeque& operator=(const WorkStealingDeque&);
+
+    Array* grow(Array* old, index_type top, index_type bottom);
+    static void destroy(void* array);
+
+ public:
+    typedef std::size_t size_type;
+
+    explicit WorkStealingDeque(size_type capacity = 64);
+    ~WorkStealingDeque();
+    bool empty() const;
+    size_type size() const;
+    void push(T val);
+    bool try_pop(T& val);
+    bool try_steal(T& val);
+};
+
+/*
+ * @brief        Constructor, allocates the first array
+ * @param        Initial number of slots, rounded up to a power of two
+ * @throws       runtime_error if no power of two index_type holds
+ *               capacity slots
+ */
+template < typename T >
+WorkStealingDeque<T>::WorkStealingDeque(size_type capacity)
+    : top_(0), bottom_(0), array_(0) {
+    if (capacity > size_type(1) << 62) {
+        throw std::runtime_error("WorkStealingDeque capacity too large");
+    }
+    index_type rounded = 1;
+    while (rounded < index_type(capacity)) {
+        rounded <<= 1;
+    }
+    array_.store(new Array(rounded), std::memory_order_relaxed);
+}
+
+/*
+ * @brief        Destructor, frees the current array
+ *
+ * Must not run concurrently with any other member function. Arrays
+ * retired by growth are freed by the owner's hazard pointer scans.
+ */
+template < typename T >
+WorkStealingDeque<T>::~WorkStealingDeque() {
+    delete array_.load(std::memory_order_relaxed);
+}
+
+/*
+ * @brief        Deleter handed to the hazard pointer retire list
+ * @param        The array
+ * @return       Nothing
+ */
+template < typename T >
+void WorkStealingDeque<T>::destroy(void* array) {
+    delete static_cast<Array*>(array);
+}
+
+/*
+ * @brief        Replace a full array by one twice as large, owner only
+ * @param        The full array and the live range of indices
+ * @return       The new array
+ */
+template < typename T >
+typename WorkStealingDeque<T>::Array* WorkStealingDeque<T>::grow(
+        Array* old, index_type top, index_type bottom) {
+    Array* bigger = new Array(2 * (old->mask + 1));
+    for (index_type i = top; i < bottom; ++i) {
+        bigger->put(i, old->get(i));
+    }
+    /// seq_cst, like the thieves' hazard store and reload, so that the
+    /// scan in retire sees any thief still reading the old array
+    array_.store(bigger);
+    StackHazards::Thread::self().retire(old, &WorkStealingDeque::destroy);
+    return bigger;
+}
+
+/*
+ * @brief        Test whether deque is empty
+ * @param        None
+ * @return       true if deque empty at the time of the call
+ */
+template < typename T >
+bool WorkStealingDeque<T>::empty() const {
+    return size() == 0;
+}
+
+/*
+ * @brief        Get size of deque, i.e. no. of items
+ * @param        None
+ * @return       The number of items at the time of the call
+ */
+template < typename T >
+typename WorkStealingDeque<T>::size_type WorkStealingDeque<T>::size() const {
+    index_type bottom = bottom_.load(std::memory_order_acquire);
+    index_type top = top_.load(std::memory_order_acquire);
+    return bottom > top ? size_type(bottom - top) : 0;
+}
+
+/*
+ * @brief        Add a new item at the bottom, owner only
+ * @param        The item
+ * @return       Nothing
+ */
+template < typename T >
+void WorkStealingDeque<T>::push(T val) {
+    index_type bottom = bottom_.load(std::memory_order_relaxed);
+    index_type top = top_.load(std::memory_order_acquire);
+    Array* array = array_.load(std::memory_order_relaxed);
+    if (bottom - top > array->mask) {
+        array = grow(array, top, bottom);
+    }
+    array->put(bottom, val);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+}
+
+/*
+ * @brief        Take the newest item from the bottom, owner only
+ * @param        Destination of the item
+ * @return       false if the deque is empty, or a thief took the last
+ *               item
+ */
+template < typename T >
+bool WorkStealingDeque<T>::try_pop(T& val) {
+    index_type bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Array* array = array_.load(std::memory_order_relaxed);
+    /// a seq_cst exchange orders the store before the load of top as the
+    /// paper's store and full fence do, but xchg is cheaper than mfence
+    bottom_.exchange(bottom, std::memory_order_seq_cst);
+    index_type top = top_.load(std::memory_order_seq_cst);
+    if (top > bottom) {
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+    T item = array->get(bottom);
+    if (top == bottom) {
+        /// the last item: race the thieves for it
+        bool won = top_.compare_exchange_strong(top, top + 1,
+                                                std::memory_order_seq_cst,
+                                                std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        if (!won) {
+            return false;
+        }
+    }
+    val = item;
+    return true;
+}
+
+/*
+ * @brief        Take the oldest item from the top, any thread
+ * @param        Destination of the item
+ * @return       false if the deque is empty, or another thread took
+ *               the item first; retrying may then succeed
+ */
+template < typename T >
+bool WorkStealingDeque<T>::try_steal(T& val) {
+    index_type top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    index_type bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) {
+        return false;
+    }
+
+    /// publish the array before reading from it, so the owner keeps
+    /// it alive if it grows meanwhile
+    std::atomic<void*>& hazard = StackHazards::Thread::self().hazard();
+    Array* array = array_.load(std::memory_order_acquire);
+    for (;;) {
+        hazard.store(array);
+        Array* current = array_.load();
+        if (current == array) {
+            break;
+        }
+        array = current;
+    }
+    T item = array->get(top);
+    hazard.store(0, std::memory_order_release);
+
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+        return false;
+    }
+    val = item;
+    return true;
+}
+
+#endif
@@ -0,0 +1,39 @@
+/** 
+ *  @brief      Concurrent stack data structure testsuite header
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ * 
+ */
+
+#ifndef _INCLUDE_CONCURRENTSTACKTEST_H_
+#define _INCLUDE_CONCURRENTSTACKTEST_H_
+
+class ConcurrentStackTestCase : public CppUnit::TestCase {
+ private:
+    CPPUNIT_TEST_SUITE(ConcurrentStackTestCase);
+    CPPUNIT_TEST(test_push_and_pop_integers);
+    CPPUNIT_TEST(test_push_and_pop_strings);
+    CPPUNIT_TEST(test_pop_fails_when_empty);
+    CPPUNIT_TEST(test_no_lost_or_duplicated_items);
+    CPPUNIT_TEST_SUITE_END();
+
+    /// method to test the push and pop of integers
+    void test_push_and_pop_integers();
+
+    /// method to test the push and pop of strings
+    void test_push_and_pop_strings();
+
+    /// method to test the empty condition
+    void test_pop_fails_when_empty();
+
+    /// method to stress push and pop from 32 threads
+    void test_no_lost_or_duplicated_items();
+
+ public:
+    void setUp();
+    void tearDown();
+};
+
+#endif
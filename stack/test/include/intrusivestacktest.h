@@ -0,0 +1,57 @@
+/** 
+ *  @brief      Intrusive stack testsuite header
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ * 
+ */
+
+#ifndef _INCLUDE_INTRUSIVESTACKTEST_H_
+#define _INCLUDE_INTRUSIVESTACKTEST_H_
+
+class IntrusiveStackTestCase : public CppUnit::TestCase {
+ private:
+    CPPUNIT_TEST_SUITE(IntrusiveStackTestCase);
+    CPPUNIT_TEST(test_push_and_pop_chars);
+    CPPUNIT_TEST(test_push_and_pop_integers);
+    CPPUNIT_TEST(test_push_and_pop_strings);
+    CPPUNIT_TEST(test_equality_using_stack_of_integers);
+    CPPUNIT_TEST(test_ordering_using_stack_of_integers);
+    CPPUNIT_TEST(test_push_and_pop_do_not_copy_or_allocate);
+    CPPUNIT_TEST(test_try_top_and_try_pop_when_empty);
+    CPPUNIT_TEST(test_move_swap_and_clear);
+    CPPUNIT_TEST(test_item_in_two_stacks);
+    CPPUNIT_TEST_SUITE_END();
+
+    /// method to test the push and pop of chars
+    void test_push_and_pop_chars();
+
+    /// method to test the push and pop of integers
+    void test_push_and_pop_integers();
+
+    /// method to test the push and pop of strings
+    void test_push_and_pop_strings();
+
+    /// methods to test the relational operators on a stack of integers
+    void test_equality_using_stack_of_integers();
+    void test_ordering_using_stack_of_integers();
+
+    /// method to test that items are linked in place
+    void test_push_and_pop_do_not_copy_or_allocate();
+
+    /// method to test the non-throwing accessors and the empty checks
+    void test_try_top_and_try_pop_when_empty();
+
+    /// method to test the O(1) whole-stack operations
+    void test_move_swap_and_clear();
+
+    /// method to test an item with a hook per stack
+    void test_item_in_two_stacks();
+
+ public:
+    void setUp();
+    void tearDown();
+};
+
+#endif
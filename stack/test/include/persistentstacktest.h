@@ -0,0 +1,51 @@
+/** 
+ *  @brief      Persistent stack data structure testsuite header
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ * 
+ */
+
+#ifndef _INCLUDE_PERSISTENTSTACKTEST_H_
+#define _INCLUDE_PERSISTENTSTACKTEST_H_
+
+class PersistentStackTestCase : public CppUnit::TestCase {
+ private:
+    CPPUNIT_TEST_SUITE(PersistentStackTestCase);
+    CPPUNIT_TEST(test_push_and_pop_integers);
+    CPPUNIT_TEST(test_push_and_pop_strings);
+    CPPUNIT_TEST(test_versions_are_independent);
+    CPPUNIT_TEST(test_versions_share_nodes);
+    CPPUNIT_TEST(test_nodes_freed_with_last_version);
+    CPPUNIT_TEST(test_relational_operators_match_stack);
+    CPPUNIT_TEST(test_long_stack_destroyed_without_recursion);
+    CPPUNIT_TEST_SUITE_END();
+
+    /// method to test the push and pop of integers
+    void test_push_and_pop_integers();
+
+    /// method to test the push and pop of strings
+    void test_push_and_pop_strings();
+
+    /// method to test that push and pop leave the old version as it was
+    void test_versions_are_independent();
+
+    /// method to test that copies and new versions do not copy items
+    void test_versions_share_nodes();
+
+    /// method to test that items live exactly as long as some version
+    void test_nodes_freed_with_last_version();
+
+    /// method to test the relational operators against those of Stack
+    void test_relational_operators_match_stack();
+
+    /// method to test dropping a stack of a million items
+    void test_long_stack_destroyed_without_recursion();
+
+ public:
+    void setUp();
+    void tearDown();
+};
+
+#endif
@@ -0,0 +1,49 @@
+/** 
+ *  @brief      Small stack data structure testsuite header
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ * 
+ */
+
+#ifndef _INCLUDE_SMALLSTACKTEST_H_
+#define _INCLUDE_SMALLSTACKTEST_H_
+
+class SmallStackTestCase : public CppUnit::TestCase {
+ private:
+    CPPUNIT_TEST_SUITE(SmallStackTestCase);
+    CPPUNIT_TEST(test_push_and_pop_integers);
+    CPPUNIT_TEST(test_push_and_pop_strings);
+    CPPUNIT_TEST(test_stays_inline_when_small);
+    CPPUNIT_TEST(test_spills_to_heap_in_order);
+    CPPUNIT_TEST(test_copy_move_and_swap);
+    CPPUNIT_TEST(test_relational_operators);
+    CPPUNIT_TEST(test_push_range_and_pop_n);
+    CPPUNIT_TEST_SUITE_END();
+
+    /// method to test the push and pop of integers
+    void test_push_and_pop_integers();
+
+    /// method to test the push and pop of strings
+    void test_push_and_pop_strings();
+
+    /// methods to test the inline storage and the spill to the heap
+    void test_stays_inline_when_small();
+    void test_spills_to_heap_in_order();
+
+    /// method to test copying, moving and swapping inline and spilled stacks
+    void test_copy_move_and_swap();
+
+    /// method to test the relational operators on stacks of integers
+    void test_relational_operators();
+
+    /// method to test the batch push and pop of items
+    void test_push_range_and_pop_n();
+
+ public:
+    void setUp();
+    void tearDown();
+};
+
+#endif
@@ -23,6 +23,33 @@ class StackTestCase : public CppUnit::TestCase {
     CPPUNIT_TEST(test_greater_than_using_stack_of_integers);
     CPPUNIT_TEST(test_less_than_equal_using_stack_of_integers);
     CPPUNIT_TEST(test_less_than_using_stack_of_integers);
+    CPPUNIT_TEST(test_push_rvalue_does_not_copy);
+    CPPUNIT_TEST(test_emplace_constructs_in_place);
+    CPPUNIT_TEST(test_pop_value_moves_out);
+    CPPUNIT_TEST(test_pop_value_throws_when_empty);
+    CPPUNIT_TEST(test_move_and_swap_do_not_copy);
+    CPPUNIT_TEST(test_push_and_pop_using_pool_allocator);
+    CPPUNIT_TEST(test_push_and_pop_using_deque_and_pool_allocator);
+    CPPUNIT_TEST(test_push_and_pop_using_arena_allocator);
+    CPPUNIT_TEST(test_arena_allocator_is_kept_by_move_and_copy);
+    CPPUNIT_TEST(test_container_without_allocator);
+    CPPUNIT_TEST(test_push_range_and_pop_n);
+    CPPUNIT_TEST(test_push_range_and_pop_n_using_deque);
+    CPPUNIT_TEST(test_push_bulk_and_drain);
+    CPPUNIT_TEST(test_pop_n_throws_when_too_few);
+    CPPUNIT_TEST(test_pop_n_moves_out);
+    CPPUNIT_TEST(test_try_top_and_try_pop_when_empty);
+    CPPUNIT_TEST(test_try_top_and_try_pop);
+    CPPUNIT_TEST(test_try_pop_moves_out);
+    CPPUNIT_TEST(test_top_unchecked);
+    CPPUNIT_TEST(test_no_instrumentation_adds_no_size);
+    CPPUNIT_TEST(test_instrumentation_counts);
+    CPPUNIT_TEST(test_instrumentation_reset);
+    CPPUNIT_TEST(test_push_and_pop_integers_using_unrolled_list);
+    CPPUNIT_TEST(test_relational_operators_using_unrolled_list);
+    CPPUNIT_TEST(test_push_and_pop_using_unrolled_list_and_arena);
+    CPPUNIT_TEST(test_push_range_and_pop_n_using_unrolled_list);
+    CPPUNIT_TEST(test_vectorized_comparisons_match_generic);
     CPPUNIT_TEST_SUITE_END();
 
     /// method to test the push and pop of chars
@@ -45,6 +72,49 @@ class StackTestCase : public CppUnit::TestCase {
     void test_less_than_equal_using_stack_of_integers();
     void test_less_than_using_stack_of_integers();
 
+    /// methods to test that moving items in and out never copies them
+    void test_push_rvalue_does_not_copy();
+    void test_emplace_constructs_in_place();
+    void test_pop_value_moves_out();
+    void test_pop_value_throws_when_empty();
+    void test_move_and_swap_do_not_copy();
+
+    /// methods to test stacks using the pool and arena allocators
+    void test_push_and_pop_using_pool_allocator();
+    void test_push_and_pop_using_deque_and_pool_allocator();
+    void test_push_and_pop_using_arena_allocator();
+    void test_arena_allocator_is_kept_by_move_and_copy();
+
+    /// method to test a custom container which declares no allocator
+    void test_container_without_allocator();
+
+    /// methods to test the batch push and pop of items
+    void test_push_range_and_pop_n();
+    void test_push_range_and_pop_n_using_deque();
+    void test_push_bulk_and_drain();
+    void test_pop_n_throws_when_too_few();
+    void test_pop_n_moves_out();
+
+    /// methods to test the non-throwing and unchecked accessors
+    void test_try_top_and_try_pop_when_empty();
+    void test_try_top_and_try_pop();
+    void test_try_pop_moves_out();
+    void test_top_unchecked();
+
+    /// methods to test the instrumentation policies
+    void test_no_instrumentation_adds_no_size();
+    void test_instrumentation_counts();
+    void test_instrumentation_reset();
+
+    /// methods to test stacks using the unrolled list container
+    void test_push_and_pop_integers_using_unrolled_list();
+    void test_relational_operators_using_unrolled_list();
+    void test_push_and_pop_using_unrolled_list_and_arena();
+    void test_push_range_and_pop_n_using_unrolled_list();
+
+    /// method to test the vectorized comparisons against list's
+    void test_vectorized_comparisons_match_generic();
+
  public:
     void setUp();
     void tearDown();
@@ -0,0 +1,59 @@
+/** 
+ *  @brief      Contiguous stack container testsuite header
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ * 
+ */
+
+#ifndef _INCLUDE_STACKVECTORTEST_H_
+#define _INCLUDE_STACKVECTORTEST_H_
+
+class StackVectorTestCase : public CppUnit::TestCase {
+ private:
+    CPPUNIT_TEST_SUITE(StackVectorTestCase);
+    CPPUNIT_TEST(test_default_container_is_contiguous_for_trivial_items);
+    CPPUNIT_TEST(test_push_and_pop_integers);
+    CPPUNIT_TEST(test_push_and_pop_strings);
+    CPPUNIT_TEST(test_push_back_own_item_while_growing);
+    CPPUNIT_TEST(test_reserve);
+    CPPUNIT_TEST(test_growth_factor);
+    CPPUNIT_TEST(test_shrink_to_fit_hysteresis);
+    CPPUNIT_TEST(test_relational_operators);
+    CPPUNIT_TEST(test_append_grows_once);
+    CPPUNIT_TEST(test_throwing_relocation_keeps_items);
+    CPPUNIT_TEST_SUITE_END();
+
+    /// method to test the default container selection of Stack
+    void test_default_container_is_contiguous_for_trivial_items();
+
+    /// method to test the push and pop of integers
+    void test_push_and_pop_integers();
+
+    /// method to test the push and pop of strings, relocated by move
+    void test_push_and_pop_strings();
+
+    /// method to test pushing a reference into the container itself
+    void test_push_back_own_item_while_growing();
+
+    /// methods to test the capacity management
+    void test_reserve();
+    void test_growth_factor();
+    void test_shrink_to_fit_hysteresis();
+
+    /// method to test the relational operators on stacks of integers
+    void test_relational_operators();
+
+    /// method to test that appending a range reallocates at most once
+    void test_append_grows_once();
+
+    /// method to test that a throwing copy leaves the items in place
+    void test_throwing_relocation_keeps_items();
+
+ public:
+    void setUp();
+    void tearDown();
+};
+
+#endif
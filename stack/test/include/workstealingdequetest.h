@@ -0,0 +1,43 @@
+/** 
+ *  @brief      Work-stealing deque data structure testsuite header
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ * 
+ */
+
+#ifndef _INCLUDE_WORKSTEALINGDEQUETEST_H_
+#define _INCLUDE_WORKSTEALINGDEQUETEST_H_
+
+class WorkStealingDequeTestCase : public CppUnit::TestCase {
+ private:
+    CPPUNIT_TEST_SUITE(WorkStealingDequeTestCase);
+    CPPUNIT_TEST(test_owner_pops_lifo);
+    CPPUNIT_TEST(test_thief_steals_fifo);
+    CPPUNIT_TEST(test_pop_and_steal_fail_when_empty);
+    CPPUNIT_TEST(test_grows_keeping_order);
+    CPPUNIT_TEST(test_randomized_owner_and_thieves);
+    CPPUNIT_TEST_SUITE_END();
+
+    /// method to test that the owner takes the newest item
+    void test_owner_pops_lifo();
+
+    /// method to test that thieves take the oldest item
+    void test_thief_steals_fifo();
+
+    /// method to test the empty condition
+    void test_pop_and_steal_fail_when_empty();
+
+    /// method to test growing the array while the items wrap around it
+    void test_grows_keeping_order();
+
+    /// method to check random owner pushes and pops against 4 thieves
+    void test_randomized_owner_and_thieves();
+
+ public:
+    void setUp();
+    void tearDown();
+};
+
+#endif
@@ -0,0 +1,143 @@
+/** 
+ *  @brief      Concurrent stack data structure testsuite
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/HelperMacros.h>
+ 
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrentstack.h"
+#include "concurrentstacktest.h"
+
+void ConcurrentStackTestCase::setUp() {
+}
+
+void ConcurrentStackTestCase::tearDown() {
+}
+
+void ConcurrentStackTestCase::test_push_and_pop_integers() {
+    ConcurrentStack< int > stack_of_ints;
+    int val = 0;
+
+    stack_of_ints.push(10);
+    stack_of_ints.push(20);
+    stack_of_ints.push(30);
+
+    CPPUNIT_ASSERT(stack_of_ints.try_pop(val));
+    CPPUNIT_ASSERT(30 == val);
+
+    CPPUNIT_ASSERT(stack_of_ints.try_pop(val));
+    CPPUNIT_ASSERT(20 == val);
+
+    stack_of_ints.push(90);
+    CPPUNIT_ASSERT(stack_of_ints.try_pop(val));
+    CPPUNIT_ASSERT(90 == val);
+
+    CPPUNIT_ASSERT(stack_of_ints.try_pop(val));
+    CPPUNIT_ASSERT(10 == val);
+    CPPUNIT_ASSERT(stack_of_ints.empty());
+}
+
+void ConcurrentStackTestCase::test_push_and_pop_strings() {
+    ConcurrentStack< std::string > stack_of_strings;
+    std::string val;
+
+    stack_of_strings.push("Red");
+    stack_of_strings.push(std::string("Green"));
+
+    CPPUNIT_ASSERT(stack_of_strings.try_pop(val));
+    CPPUNIT_ASSERT("Green" == val);
+
+    /// remaining item is destroyed with the stack
+}
+
+void ConcurrentStackTestCase::test_pop_fails_when_empty() {
+    ConcurrentStack< int > stack_of_ints;
+    int val = -1;
+
+    CPPUNIT_ASSERT(stack_of_ints.empty());
+    CPPUNIT_ASSERT(!stack_of_ints.try_pop(val));
+    CPPUNIT_ASSERT(-1 == val);  /// untouched
+}
+
+void ConcurrentStackTestCase::test_no_lost_or_duplicated_items() {
+    const int threads = 32;
+    const int per_thread = 5000;
+    ConcurrentStack< int > stack_of_ints;
+    std::vector< std::vector<int> > popped(threads);
+    std::vector<std::thread> workers;
+
+    /// every thread pushes its own values and pops whatever is on top
+    for (int t = 0; t < threads; ++t) {
+        std::vector<int>* out = &popped[t];
+        workers.push_back(std::thread([&stack_of_ints, out, t, per_thread]() {
+            int val = 0;
+            for (int i = 0; i < per_thread; ++i) {
+                stack_of_ints.push(t * per_thread + i);
+                if (i % 2 && stack_of_ints.try_pop(val)) {
+                    out->push_back(val);
+                }
+            }
+        }));
+    }
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+
+    std::vector<int> seen(threads * per_thread, 0);
+    int val = 0;
+    while (stack_of_ints.try_pop(val)) {
+        ++seen[val];
+    }
+    for (int t = 0; t < threads; ++t) {
+        for (size_t i = 0; i < popped[t].size(); ++i) {
+            ++seen[popped[t][i]];
+        }
+    }
+
+    for (size_t i = 0; i < seen.size(); ++i) {
+        CPPUNIT_ASSERT(1 == seen[i]);  /// no loss, no duplicates
+    }
+}
+
+CppUnit::Test *suite() {
+    CppUnit::TestFactoryRegistry &registry =
+                      CppUnit::TestFactoryRegistry::getRegistry();
+
+    return registry.makeTest();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ConcurrentStackTestCase);
+
+int main(int argc, char* argv[]) {
+    CppUnit::TestResult controller;
+
+    CppUnit::TestResultCollector result;
+    controller.addListener(&result);
+
+    CppUnit::BriefTestProgressListener progressListener;
+    controller.addListener(&progressListener);
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite());  /// Add the top suite to the test runner
+
+    /// Run the test
+    runner.run(controller);
+
+    /// Return error code 1 if any tests failed
+    return result.wasSuccessful() ? 0 : 1;
+}
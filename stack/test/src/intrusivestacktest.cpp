@@ -0,0 +1,328 @@
+/** 
+ *  @brief      Intrusive stack testsuite
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "intrusivestack.h"
+#include "intrusivestacktest.h"
+
+/// Count of operator new calls, to show pushes do not allocate
+static std::atomic<long> allocations(0);
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+/// Pooled message embedding its stack hook
+template < typename T >
+struct Item {
+    static int copies;
+    T value;
+    IntrusiveHook<Item> hook;
+
+    explicit Item(const T& v = T()) : value(v) {}
+    Item(const Item& other) : value(other.value), hook(other.hook) {
+        ++copies;
+    }
+
+    bool operator==(const Item& other) const { return value == other.value; }
+    bool operator<(const Item& other) const { return value < other.value; }
+};
+
+template < typename T >
+int Item<T>::copies = 0;
+
+/// Frame which can sit in two stacks at once
+struct Frame {
+    int id;
+    IntrusiveHook<Frame> by_call;
+    IntrusiveHook<Frame> by_unwind;
+};
+
+/// Items with values from first, kept in a vector which never grows
+static std::vector< Item<int> > pool(int n, int first = 0) {
+    std::vector< Item<int> > items;
+    items.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        items.emplace_back(first + i);
+    }
+    return items;
+}
+
+void IntrusiveStackTestCase::setUp() {
+}
+
+void IntrusiveStackTestCase::tearDown() {
+}
+
+void IntrusiveStackTestCase::test_push_and_pop_chars() {
+    Item<char> a('A'), b('B'), c('C'), z('Z');
+    IntrusiveStack< Item<char> > s_of_chars;
+
+    s_of_chars.push(a);
+    s_of_chars.push(b);
+    s_of_chars.push(c);
+
+    CPPUNIT_ASSERT('C' == s_of_chars.top().value);
+
+    s_of_chars.pop();
+    CPPUNIT_ASSERT('B' == s_of_chars.top().value);
+
+    s_of_chars.push(z);
+    CPPUNIT_ASSERT('Z' == s_of_chars.top().value);
+
+    s_of_chars.pop();
+    s_of_chars.pop();
+    CPPUNIT_ASSERT('A' == s_of_chars.top().value);
+    CPPUNIT_ASSERT(1 == s_of_chars.size());
+}
+
+void IntrusiveStackTestCase::test_push_and_pop_integers() {
+    std::vector< Item<int> > items = pool(100);
+    IntrusiveStack< Item<int> > s_of_ints;
+
+    for (Item<int>& item : items) {
+        s_of_ints.push(item);
+    }
+    CPPUNIT_ASSERT(100 == s_of_ints.size());
+
+    for (int i = 99; i >= 0; --i) {
+        CPPUNIT_ASSERT(i == s_of_ints.top().value);
+        CPPUNIT_ASSERT(&items[i] == &s_of_ints.top());
+        s_of_ints.pop();
+    }
+    CPPUNIT_ASSERT(s_of_ints.empty());
+    CPPUNIT_ASSERT_THROW(s_of_ints.pop(), std::runtime_error);
+}
+
+void IntrusiveStackTestCase::test_push_and_pop_strings() {
+    Item<std::string> one("one"), two("two"), three("three");
+    IntrusiveStack< Item<std::string> > s_of_strings;
+
+    s_of_strings.push(one);
+    s_of_strings.push(two);
+    s_of_strings.push(three);
+
+    std::string joined;
+    for (const Item<std::string>& item : s_of_strings) {
+        joined += item.value;
+    }
+    CPPUNIT_ASSERT("threetwoone" == joined);
+
+    s_of_strings.pop();
+    CPPUNIT_ASSERT("two" == s_of_strings.top().value);
+}
+
+void IntrusiveStackTestCase::test_equality_using_stack_of_integers() {
+    std::vector< Item<int> > left = pool(10), right = pool(10);
+    IntrusiveStack< Item<int> > s1, s2;
+
+    CPPUNIT_ASSERT(s1 == s2);
+    for (int i = 0; i < 10; ++i) {
+        s1.push(left[i]);
+        s2.push(right[i]);
+    }
+    CPPUNIT_ASSERT(s1 == s2);
+    CPPUNIT_ASSERT(!(s1 != s2));
+
+    s2.pop();
+    CPPUNIT_ASSERT(s1 != s2);
+    s2.push(right[0]);
+    CPPUNIT_ASSERT(s1 != s2);
+}
+
+void IntrusiveStackTestCase::test_ordering_using_stack_of_integers() {
+    std::vector< Item<int> > left = pool(5), right = pool(5, 1);
+    IntrusiveStack< Item<int> > s1, s2;
+
+    for (int i = 0; i < 5; ++i) {
+        s1.push(left[i]);
+        s2.push(right[i]);
+    }
+    CPPUNIT_ASSERT(s1 < s2);
+    CPPUNIT_ASSERT(s1 <= s2);
+    CPPUNIT_ASSERT(s2 > s1);
+    CPPUNIT_ASSERT(s2 >= s1);
+    CPPUNIT_ASSERT(!(s2 < s1));
+
+    /// compared from the bottom up, as Stack does, even where reading
+    /// from the top down would order the stacks the other way
+    s1.clear();
+    s2.clear();
+    s1.push(right[0]);
+    s1.push(right[1]);
+    s2.push(left[2]);
+    CPPUNIT_ASSERT(s1 < s2);
+    CPPUNIT_ASSERT(!(s2 <= s1));
+    CPPUNIT_ASSERT(s2 > s1);
+
+    /// a stack that is the bottom of the other comes first
+    s2.clear();
+    s2.push(left[1]);
+    CPPUNIT_ASSERT(s2 < s1);
+    s2.push(left[2]);
+    CPPUNIT_ASSERT(!(s2 < s1));
+    CPPUNIT_ASSERT(!(s1 < s2));
+    CPPUNIT_ASSERT(s1 == s2);
+    s1.clear();
+    CPPUNIT_ASSERT(s1 < s2);
+}
+
+void IntrusiveStackTestCase::test_push_and_pop_do_not_copy_or_allocate() {
+    std::vector< Item<std::string> > items;
+    items.reserve(1000);
+    for (int i = 0; i < 1000; ++i) {
+        items.emplace_back(std::string(32, 'a' + i % 26));
+    }
+    Item<std::string>::copies = 0;
+
+    IntrusiveStack< Item<std::string> > s;
+    long before = allocations.load();
+    for (int round = 0; round < 3; ++round) {
+        for (Item<std::string>& item : items) {
+            s.push(item);
+        }
+        while (Item<std::string>* item = s.try_pop()) {
+            CPPUNIT_ASSERT(32 == item->value.size());
+        }
+    }
+    CPPUNIT_ASSERT(before == allocations.load());
+    CPPUNIT_ASSERT(0 == Item<std::string>::copies);
+
+    /// a copy of a stacked item starts unlinked
+    s.push(items[1]);
+    s.push(items[0]);
+    Item<std::string> copy(items[0]);
+    CPPUNIT_ASSERT(!copy.hook.next);
+    CPPUNIT_ASSERT(&items[1] == items[0].hook.next);
+}
+
+void IntrusiveStackTestCase::test_try_top_and_try_pop_when_empty() {
+    IntrusiveStack< Item<int> > s;
+    const IntrusiveStack< Item<int> >& cs = s;
+
+    CPPUNIT_ASSERT(!s.try_top());
+    CPPUNIT_ASSERT(!s.try_pop());
+    CPPUNIT_ASSERT(s.begin() == s.end());
+    CPPUNIT_ASSERT_THROW(s.top(), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(cs.top(), std::runtime_error);
+
+    Item<int> item(7);
+    s.push(item);
+    CPPUNIT_ASSERT(&item == s.try_top());
+    CPPUNIT_ASSERT(7 == cs.top().value);
+    CPPUNIT_ASSERT(&item == s.try_pop());
+    CPPUNIT_ASSERT(!item.hook.next);
+    CPPUNIT_ASSERT(!s.try_pop());
+    CPPUNIT_ASSERT(0 == s.size());
+}
+
+void IntrusiveStackTestCase::test_move_swap_and_clear() {
+    std::vector< Item<int> > items = pool(5);
+    IntrusiveStack< Item<int> > s1, s2;
+    s1.push(items[0]);
+    s1.push(items[1]);
+    s2.push(items[2]);
+    s2.push(items[3]);
+    s2.push(items[4]);
+
+    s1.swap(s2);
+    CPPUNIT_ASSERT(3 == s1.size());
+    CPPUNIT_ASSERT(4 == s1.top().value);
+    CPPUNIT_ASSERT(1 == s2.top().value);
+
+    IntrusiveStack< Item<int> > s3(std::move(s1));
+    CPPUNIT_ASSERT(s1.empty());
+    CPPUNIT_ASSERT(3 == s3.size());
+    s2 = std::move(s3);
+    CPPUNIT_ASSERT(s3.empty());
+    CPPUNIT_ASSERT(4 == s2.top().value);
+    CPPUNIT_ASSERT(3 == s2.size());
+
+    s2.clear();
+    CPPUNIT_ASSERT(s2.empty());
+    s2.push(items[0]);
+    CPPUNIT_ASSERT(1 == s2.size());
+    CPPUNIT_ASSERT(&items[0] == &s2.top());
+    CPPUNIT_ASSERT(!items[0].hook.next);
+}
+
+void IntrusiveStackTestCase::test_item_in_two_stacks() {
+    Frame frames[3] = {{0, {}, {}}, {1, {}, {}}, {2, {}, {}}};
+    IntrusiveStack<Frame, &Frame::by_call> calls;
+    IntrusiveStack<Frame, &Frame::by_unwind> unwinding;
+
+    for (Frame& frame : frames) {
+        calls.push(frame);
+    }
+    unwinding.push(frames[0]);
+    unwinding.push(frames[2]);
+
+    CPPUNIT_ASSERT(2 == calls.top().id);
+    CPPUNIT_ASSERT(2 == unwinding.top().id);
+    unwinding.pop();
+    CPPUNIT_ASSERT(0 == unwinding.top().id);
+    CPPUNIT_ASSERT(3 == calls.size());
+    calls.pop();
+    CPPUNIT_ASSERT(1 == calls.top().id);
+}
+
+CppUnit::Test *suite() {
+    CppUnit::TestFactoryRegistry &registry =
+                      CppUnit::TestFactoryRegistry::getRegistry();
+
+    return registry.makeTest();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(IntrusiveStackTestCase);
+
+int main(int argc, char* argv[]) {
+    CppUnit::TestResult controller;
+
+    CppUnit::TestResultCollector result;
+    controller.addListener(&result);
+
+    CppUnit::BriefTestProgressListener progressListener;
+    controller.addListener(&progressListener);
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite());  /// Add the top suite to the test runner
+
+    /// Run the test
+    runner.run(controller);
+
+    /// Return error code 1 if any tests failed
+    return result.wasSuccessful() ? 0 : 1;
+}
@@ -0,0 +1,229 @@
+/** 
+ *  @brief      Persistent stack data structure testsuite
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "persistentstack.h"
+#include "stack.h"
+#include "persistentstacktest.h"
+
+/// Item counting how many of it are alive and how many were copied
+struct Counted {
+    static int alive;
+    static int copies;
+    int value;
+
+    Counted(int v) : value(v) { ++alive; }
+    Counted(const Counted& other) : value(other.value) {
+        ++alive;
+        ++copies;
+    }
+    ~Counted() { --alive; }
+};
+
+int Counted::alive = 0;
+int Counted::copies = 0;
+
+void PersistentStackTestCase::setUp() {
+    Counted::alive = 0;
+    Counted::copies = 0;
+}
+
+void PersistentStackTestCase::tearDown() {
+}
+
+void PersistentStackTestCase::test_push_and_pop_integers() {
+    PersistentStack<int> s_of_ints;
+
+    CPPUNIT_ASSERT(s_of_ints.empty());
+    CPPUNIT_ASSERT(0 == s_of_ints.size());
+    CPPUNIT_ASSERT(0 == s_of_ints.try_top());
+    CPPUNIT_ASSERT_THROW(s_of_ints.top(), std::runtime_error);
+    CPPUNIT_ASSERT_THROW((void)s_of_ints.pop(), std::runtime_error);
+
+    s_of_ints = s_of_ints.push(10).push(20).emplace(30);
+
+    CPPUNIT_ASSERT(30 == s_of_ints.top());
+    CPPUNIT_ASSERT(3 == s_of_ints.size());
+
+    s_of_ints = s_of_ints.pop();
+    CPPUNIT_ASSERT(20 == *s_of_ints.try_top());
+    s_of_ints = s_of_ints.pop().pop();
+    CPPUNIT_ASSERT(s_of_ints.empty());
+
+    int items[] = {1, 2, 3, 4};
+    PersistentStack<int> from_range(items, items + 4);
+    CPPUNIT_ASSERT(4 == from_range.top());
+    CPPUNIT_ASSERT(4 == from_range.size());
+    std::vector<int> top_down(from_range.begin(), from_range.end());
+    CPPUNIT_ASSERT(std::vector<int>({4, 3, 2, 1}) == top_down);
+}
+
+void PersistentStackTestCase::test_push_and_pop_strings() {
+    PersistentStack<std::string> s_of_strings;
+    std::string blue("Blue");
+
+    s_of_strings = s_of_strings.push("Red").push("Green").push(std::move(blue));
+
+    CPPUNIT_ASSERT(std::string("Blue") == s_of_strings.top());
+    s_of_strings = s_of_strings.pop();
+    CPPUNIT_ASSERT(std::string("Green") == s_of_strings.top());
+    CPPUNIT_ASSERT(2 == s_of_strings.size());
+}
+
+void PersistentStackTestCase::test_versions_are_independent() {
+    PersistentStack<int> base = PersistentStack<int>().push(1).push(2);
+    PersistentStack<int> left = base.push(3);
+    PersistentStack<int> right = base.pop().push(4);
+
+    CPPUNIT_ASSERT(2 == base.size());
+    CPPUNIT_ASSERT(2 == base.top());
+    CPPUNIT_ASSERT(3 == left.top());
+    CPPUNIT_ASSERT(2 == left.pop().top());
+    CPPUNIT_ASSERT(4 == right.top());
+    CPPUNIT_ASSERT(1 == right.pop().top());
+
+    PersistentStack<int> snapshot(left);
+    left = left.pop().pop();
+    CPPUNIT_ASSERT(1 == left.size());
+    CPPUNIT_ASSERT(3 == snapshot.size());
+    CPPUNIT_ASSERT(3 == snapshot.top());
+
+    snapshot.swap(right);
+    CPPUNIT_ASSERT(4 == snapshot.top());
+    CPPUNIT_ASSERT(3 == right.top());
+}
+
+void PersistentStackTestCase::test_versions_share_nodes() {
+    PersistentStack<Counted> base;
+    for (int i = 0; i < 10; ++i) {
+        base = base.emplace(i);
+    }
+    CPPUNIT_ASSERT(10 == Counted::alive);
+    CPPUNIT_ASSERT(0 == Counted::copies);
+
+    PersistentStack<Counted> copy(base);
+    PersistentStack<Counted> popped = base.pop().pop();
+    PersistentStack<Counted> pushed = popped.emplace(100);
+
+    CPPUNIT_ASSERT(11 == Counted::alive);
+    CPPUNIT_ASSERT(0 == Counted::copies);
+    CPPUNIT_ASSERT(&base.top() == &copy.top());
+    CPPUNIT_ASSERT(&popped.top() == &*++pushed.begin());
+}
+
+void PersistentStackTestCase::test_nodes_freed_with_last_version() {
+    {
+        PersistentStack<Counted> base = PersistentStack<Counted>().emplace(1);
+        base = base.emplace(2).emplace(3);
+        PersistentStack<Counted> branch = base.pop().emplace(4);
+        CPPUNIT_ASSERT(4 == Counted::alive);
+
+        base = PersistentStack<Counted>();
+        /// 3 goes, 1 and 2 stay under branch
+        CPPUNIT_ASSERT(3 == Counted::alive);
+        CPPUNIT_ASSERT(4 == branch.top().value);
+
+        branch = branch.pop();
+        CPPUNIT_ASSERT(2 == Counted::alive);
+        branch = branch;
+        CPPUNIT_ASSERT(2 == Counted::alive);
+        CPPUNIT_ASSERT(2 == branch.top().value);
+    }
+    CPPUNIT_ASSERT(0 == Counted::alive);
+}
+
+void PersistentStackTestCase::test_relational_operators_match_stack() {
+    std::vector< std::vector<int> > contents = {
+        {}, {1}, {2}, {1, 2}, {1, 3}, {2, 1}, {1, 2, 3}, {1, 2, 4}, {0, 2, 3}
+    };
+    for (const std::vector<int>& x : contents) {
+        for (const std::vector<int>& y : contents) {
+            PersistentStack<int> A(x.begin(), x.end());
+            PersistentStack<int> B(y.begin(), y.end());
+            Stack<int> C;
+            Stack<int> D;
+            C.push_range(x.begin(), x.end());
+            D.push_range(y.begin(), y.end());
+            CPPUNIT_ASSERT((A == B) == (C == D));
+            CPPUNIT_ASSERT((A != B) == (C != D));
+            CPPUNIT_ASSERT((A < B) == (C < D));
+            CPPUNIT_ASSERT((A <= B) == (C <= D));
+            CPPUNIT_ASSERT((A > B) == (C > D));
+            CPPUNIT_ASSERT((A >= B) == (C >= D));
+        }
+    }
+
+    /// versions sharing a tail, compared above it only
+    PersistentStack<int> base;
+    for (int i = 0; i < 100; ++i) {
+        base = base.push(i);
+    }
+    PersistentStack<int> A = base.push(5).push(7);
+    PersistentStack<int> B = base.push(6);
+    CPPUNIT_ASSERT(A < B);
+    CPPUNIT_ASSERT(A != B);
+    CPPUNIT_ASSERT(base.push(5) < A);
+    CPPUNIT_ASSERT(base.push(5).push(7) == A);
+    CPPUNIT_ASSERT(A == A);
+    CPPUNIT_ASSERT(!(A < A));
+}
+
+void PersistentStackTestCase::test_long_stack_destroyed_without_recursion() {
+    PersistentStack<int> s_of_ints;
+    for (int i = 0; i < 1000000; ++i) {
+        s_of_ints = s_of_ints.push(i);
+    }
+    PersistentStack<int> half = s_of_ints;
+    for (int i = 0; i < 500000; ++i) {
+        half = half.pop();
+    }
+    s_of_ints = PersistentStack<int>();
+    CPPUNIT_ASSERT(500000 == half.size());
+    CPPUNIT_ASSERT(499999 == half.top());
+}
+
+CppUnit::Test *suite() {
+    CppUnit::TestFactoryRegistry &registry =
+                      CppUnit::TestFactoryRegistry::getRegistry();
+
+    return registry.makeTest();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(PersistentStackTestCase);
+
+int main(int argc, char* argv[]) {
+    CppUnit::TestResult controller;
+
+    CppUnit::TestResultCollector result;
+    controller.addListener(&result);
+
+    CppUnit::BriefTestProgressListener progressListener;
+    controller.addListener(&progressListener);
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite());  /// Add the top suite to the test runner
+
+    /// Run the test
+    runner.run(controller);
+
+    /// Return error code 1 if any tests failed
+    return result.wasSuccessful() ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+/** 
+ *  @brief      Small stack data structure testsuite
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/HelperMacros.h>
+ 
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "smallstack.h"
+#include "smallstacktest.h"
+
+void SmallStackTestCase::setUp() {
+}
+
+void SmallStackTestCase::tearDown() {
+}
+
+void SmallStackTestCase::test_push_and_pop_integers() {
+    SmallStack< int > stack_of_ints;
+
+    stack_of_ints.push(10);
+    stack_of_ints.push(20);
+    stack_of_ints.push(30);
+
+    CPPUNIT_ASSERT(30 == stack_of_ints.top());
+
+    stack_of_ints.pop();
+    CPPUNIT_ASSERT(20 == stack_of_ints.top());
+
+    stack_of_ints.pop();
+    CPPUNIT_ASSERT(10 == stack_of_ints.top());
+
+    stack_of_ints.push(90);
+    CPPUNIT_ASSERT(90 == stack_of_ints.top());
+}
+
+void SmallStackTestCase::test_push_and_pop_strings() {
+    SmallStack< std::string, 4 > stack_of_strings;
+
+    stack_of_strings.push("Red");
+    stack_of_strings.push("Green");
+    stack_of_strings.push("Blue");
+
+    CPPUNIT_ASSERT("Blue" == stack_of_strings.top());
+
+    stack_of_strings.pop();
+    CPPUNIT_ASSERT("Green" == stack_of_strings.top());
+
+    stack_of_strings.pop();
+    CPPUNIT_ASSERT("Red" == stack_of_strings.top());
+
+    stack_of_strings.push("Cyan");
+    CPPUNIT_ASSERT("Cyan" == stack_of_strings.top());
+}
+
+void SmallStackTestCase::test_stays_inline_when_small() {
+    SmallRing< int, 4 > items;
+
+    for (int i = 0; i < 100; ++i) {
+        items.push_back(i);
+        items.push_back(i + 1);
+        items.push_back(i + 2);
+        items.push_back(i + 3);
+        CPPUNIT_ASSERT(i + 3 == items.back());
+        items.pop_back();
+        items.pop_back();
+        items.pop_back();
+        items.pop_back();
+    }
+    CPPUNIT_ASSERT(items.is_inline());
+    CPPUNIT_ASSERT(4 == items.capacity());
+}
+
+void SmallStackTestCase::test_spills_to_heap_in_order() {
+    SmallStack< int, 4 > stack_of_ints;
+
+    for (int i = 0; i < 100; ++i) {
+        stack_of_ints.push(i);
+    }
+    for (int i = 99; i >= 0; --i) {
+        CPPUNIT_ASSERT(i == stack_of_ints.top());
+        stack_of_ints.pop();
+    }
+    CPPUNIT_ASSERT(stack_of_ints.empty());
+    CPPUNIT_ASSERT_THROW(stack_of_ints.top(), std::runtime_error);
+}
+
+void SmallStackTestCase::test_copy_move_and_swap() {
+    SmallStack< std::string, 2 > small, large;
+
+    small.push("Red");
+    for (int i = 0; i < 10; ++i) {
+        large.push(std::string(1, 'a' + i));
+    }
+
+    SmallStack< std::string, 2 > small_copy(small), large_copy(large);
+    CPPUNIT_ASSERT(small_copy == small);
+    CPPUNIT_ASSERT(large_copy == large);
+
+    SmallStack< std::string, 2 > small_moved(std::move(small_copy));
+    SmallStack< std::string, 2 > large_moved(std::move(large_copy));
+    CPPUNIT_ASSERT(small_moved == small);
+    CPPUNIT_ASSERT(large_moved == large);
+
+    swap(small_moved, large_moved);
+    CPPUNIT_ASSERT(small_moved == large);
+    CPPUNIT_ASSERT(large_moved == small);
+
+    large_moved = small_moved;
+    CPPUNIT_ASSERT(large_moved == large);
+    CPPUNIT_ASSERT(10 == large_moved.size());
+}
+
+void SmallStackTestCase::test_relational_operators() {
+    SmallStack< int > A, B;
+
+    A.push(10);
+    A.push(20);
+    B.push(10);
+    B.push(20);
+    CPPUNIT_ASSERT(A == B);
+
+    B.push(30);
+    CPPUNIT_ASSERT(A != B);
+    CPPUNIT_ASSERT(A < B);
+    CPPUNIT_ASSERT(A <= B);
+
+    A.push(60);
+    CPPUNIT_ASSERT(A > B);
+    CPPUNIT_ASSERT(A >= B);
+}
+
+void SmallStackTestCase::test_push_range_and_pop_n() {
+    SmallStack< int, 4 > s_of_ints;
+    int in[] = {1, 2, 3, 4, 5, 6};
+    int out[6];
+
+    s_of_ints.push_range(in, in + 3);
+    s_of_ints.push_bulk(in + 3, 3);  /// spills to the heap
+    CPPUNIT_ASSERT(6 == s_of_ints.size());
+
+    s_of_ints.pop_n(2, out);
+    CPPUNIT_ASSERT(6 == out[0] && 5 == out[1]);
+
+    int* last = s_of_ints.drain(out);
+    CPPUNIT_ASSERT(out + 4 == last);
+    CPPUNIT_ASSERT(4 == out[0] && 1 == out[3]);
+}
+
+CppUnit::Test *suite() {
+    CppUnit::TestFactoryRegistry &registry =
+                      CppUnit::TestFactoryRegistry::getRegistry();
+
+    return registry.makeTest();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SmallStackTestCase);
+
+int main(int argc, char* argv[]) {
+    CppUnit::TestResult controller;
+
+    CppUnit::TestResultCollector result;
+    controller.addListener(&result);
+
+    CppUnit::BriefTestProgressListener progressListener;
+    controller.addListener(&progressListener);
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite());  /// Add the top suite to the test runner
+
+    /// Run the test
+    runner.run(controller);
+
+    /// Return error code 1 if any tests failed
+    return result.wasSuccessful() ? 0 : 1;
+}
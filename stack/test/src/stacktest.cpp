@@ -16,16 +16,84 @@
 #include <cppunit/TestResultCollector.h>
 #include <cppunit/extensions/HelperMacros.h>
  
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <vector>
 #include <deque>
 #include <list>
+#include <optional>
+#include <random>
 #include <string>
 #include <exception>
+#include <iterator>
 #include <stdexcept>
+#include <utility>
 
+#include "allocators.h"
 #include "stack.h"
 #include "stacktest.h"
+#include "unrolledlist.h"
+
+/// Item owning a heap buffer, counting buffer allocations and copies
+struct Payload {
+    static int allocations;
+    static int copies;
+    char* data;
+
+    explicit Payload(char c) : data(new char[64]) {
+        ++allocations;
+        data[0] = c;
+    }
+    Payload(char c, int fill) : data(new char[64]) {
+        ++allocations;
+        std::memset(data, fill, 64);
+        data[0] = c;
+    }
+    Payload(const Payload& other) : data(new char[64]) {
+        ++allocations;
+        ++copies;
+        std::memcpy(data, other.data, 64);
+    }
+    Payload(Payload&& other) noexcept : data(other.data) {
+        other.data = 0;
+    }
+    Payload& operator=(const Payload& other) {
+        ++copies;
+        std::memcpy(data, other.data, 64);
+        return *this;
+    }
+    Payload& operator=(Payload&& other) noexcept {
+        std::swap(data, other.data);
+        return *this;
+    }
+    ~Payload() {
+        delete[] data;
+    }
+
+    static void reset() {
+        allocations = 0;
+        copies = 0;
+    }
+};
+
+int Payload::allocations = 0;
+int Payload::copies = 0;
+
+/// Container with only the operations Stack requires, and no allocator
+template < typename T >
+class BareLifo {
+ public:
+    bool empty() const { return items_.empty(); }
+    std::size_t size() const { return items_.size(); }
+    T& back() { return items_.back(); }
+    const T& back() const { return items_.back(); }
+    void push_back(const T& val) { items_.push_back(val); }
+    void pop_back() { items_.pop_back(); }
+
+ private:
+    std::vector<T> items_;
+};
 
 void StackTestCase::setUp() {
 }
@@ -203,6 +271,435 @@ void StackTestCase::test_less_than_using_stack_of_integers() {
     CPPUNIT_ASSERT(stack_A < stack_B);
 }
 
+void StackTestCase::test_push_rvalue_does_not_copy() {
+    Stack< Payload > stack_of_payloads;
+    Payload::reset();
+
+    stack_of_payloads.push(Payload('A'));
+    Payload b('B');
+    stack_of_payloads.push(std::move(b));
+
+    CPPUNIT_ASSERT(2 == Payload::allocations);  /// one per payload
+    CPPUNIT_ASSERT(0 == Payload::copies);
+    CPPUNIT_ASSERT('B' == stack_of_payloads.top().data[0]);
+}
+
+void StackTestCase::test_emplace_constructs_in_place() {
+    Stack< Payload > stack_of_payloads;
+    Payload::reset();
+
+    stack_of_payloads.emplace('A');
+    stack_of_payloads.emplace('B', 0);
+
+    CPPUNIT_ASSERT(2 == Payload::allocations);
+    CPPUNIT_ASSERT(0 == Payload::copies);
+    CPPUNIT_ASSERT('B' == stack_of_payloads.top().data[0]);
+}
+
+void StackTestCase::test_pop_value_moves_out() {
+    Stack< Payload, std::vector<Payload> > stack_of_payloads;
+    stack_of_payloads.emplace('A');
+    stack_of_payloads.emplace('B');
+    Payload::reset();
+
+    Payload b = stack_of_payloads.pop_value();
+    Payload a = stack_of_payloads.pop_value();
+
+    CPPUNIT_ASSERT(0 == Payload::allocations);
+    CPPUNIT_ASSERT(0 == Payload::copies);
+    CPPUNIT_ASSERT('A' == a.data[0]);
+    CPPUNIT_ASSERT('B' == b.data[0]);
+    CPPUNIT_ASSERT(stack_of_payloads.empty());
+}
+
+void StackTestCase::test_pop_value_throws_when_empty() {
+    Stack< int > stack_of_ints;
+
+    CPPUNIT_ASSERT_THROW(stack_of_ints.pop_value(), std::runtime_error);
+}
+
+void StackTestCase::test_move_and_swap_do_not_copy() {
+    Stack< Payload > A, B;
+    A.emplace('A');
+    B.emplace('B');
+    B.emplace('C');
+    Payload::reset();
+
+    Stack< Payload > C(std::move(A));
+    CPPUNIT_ASSERT(1 == C.size());
+
+    C.swap(B);
+    CPPUNIT_ASSERT(2 == C.size());
+    CPPUNIT_ASSERT('C' == C.top().data[0]);
+
+    swap(B, C);  /// found through ADL
+    CPPUNIT_ASSERT('A' == C.top().data[0]);
+
+    A = std::move(B);
+    CPPUNIT_ASSERT('C' == A.top().data[0]);
+
+    CPPUNIT_ASSERT(0 == Payload::allocations);
+    CPPUNIT_ASSERT(0 == Payload::copies);
+}
+
+void StackTestCase::test_push_and_pop_using_pool_allocator() {
+    Stack< int, StackVector<int>, PoolAllocator<int> > s_of_ints;
+
+    for (int i = 0; i < 10000; ++i) {  /// outgrows the pooled sizes
+        s_of_ints.push(i);
+    }
+    for (int i = 9999; i >= 0; --i) {
+        CPPUNIT_ASSERT(i == s_of_ints.pop_value());
+    }
+    CPPUNIT_ASSERT(s_of_ints.empty());
+}
+
+void StackTestCase::test_push_and_pop_using_deque_and_pool_allocator() {
+    Stack< std::string, std::deque<std::string>,
+           PoolAllocator<std::string> > s_of_strings;
+
+    s_of_strings.push("Red");
+    s_of_strings.push("Green");
+
+    CPPUNIT_ASSERT("Green" == s_of_strings.pop_value());
+    CPPUNIT_ASSERT("Red" == s_of_strings.top());
+}
+
+void StackTestCase::test_container_without_allocator() {
+    Stack< int, BareLifo<int> > stack_of_ints;
+    InstrumentedStack< int, BareLifo<int> > counted;
+
+    stack_of_ints.push(10);
+    stack_of_ints.push(20);
+    CPPUNIT_ASSERT(2 == stack_of_ints.size());
+    CPPUNIT_ASSERT(20 == stack_of_ints.top());
+    stack_of_ints.pop();
+    CPPUNIT_ASSERT(10 == stack_of_ints.top());
+
+    counted.push(1);
+    counted.pop();
+    CPPUNIT_ASSERT(1 == counted.stats().pushes);
+    CPPUNIT_ASSERT(counted.empty());
+}
+
+void StackTestCase::test_push_and_pop_using_arena_allocator() {
+    Arena arena(64);  /// small enough to need several chunks
+    Stack< int, StackVector<int>, ArenaAllocator<int> >
+        s_of_ints((ArenaAllocator<int>(arena)));
+
+    for (int i = 0; i < 1000; ++i) {
+        s_of_ints.push(i);
+    }
+    for (int i = 999; i >= 0; --i) {
+        CPPUNIT_ASSERT(i == s_of_ints.pop_value());
+    }
+}
+
+void StackTestCase::test_arena_allocator_is_kept_by_move_and_copy() {
+    typedef Stack< int, std::vector<int>, ArenaAllocator<int> > ArenaStack;
+    Arena arena;
+    ArenaStack A((ArenaAllocator<int>(arena)));
+
+    A.push(10);
+    A.push(20);
+
+    ArenaStack B(A);
+    ArenaStack C(std::move(A));
+
+    CPPUNIT_ASSERT(B.get_allocator().arena == &arena);
+    CPPUNIT_ASSERT(C.get_allocator().arena == &arena);
+    CPPUNIT_ASSERT(B == C);
+    CPPUNIT_ASSERT(20 == C.top());
+}
+
+void StackTestCase::test_push_range_and_pop_n() {
+    Stack< int > s_of_ints;
+    std::vector<int> in, out;
+    for (int i = 0; i < 1000; ++i) {
+        in.push_back(i);
+    }
+
+    s_of_ints.push_range(in.begin(), in.end());
+    CPPUNIT_ASSERT(1000 == s_of_ints.size());
+    CPPUNIT_ASSERT(999 == s_of_ints.top());
+
+    s_of_ints.pop_n(600, std::back_inserter(out));
+    CPPUNIT_ASSERT(std::equal(out.begin(), out.end(), in.rbegin()));
+    CPPUNIT_ASSERT(400 == s_of_ints.size());
+    CPPUNIT_ASSERT(399 == s_of_ints.top());
+}
+
+void StackTestCase::test_push_range_and_pop_n_using_deque() {
+    Stack< int, std::deque<int> > s_of_ints;
+    int in[] = {10, 20, 30, 40};
+    int out[3];
+
+    s_of_ints.push_range(in, in + 4);
+    int* last = s_of_ints.pop_n(3, out);
+
+    CPPUNIT_ASSERT(out + 3 == last);
+    CPPUNIT_ASSERT(40 == out[0] && 30 == out[1] && 20 == out[2]);
+    CPPUNIT_ASSERT(10 == s_of_ints.top());
+}
+
+void StackTestCase::test_push_bulk_and_drain() {
+    Stack< std::string, std::vector<std::string> > s_of_strings;
+    std::string in[] = {"Red", "Green", "Blue"};
+    std::vector<std::string> out;
+
+    s_of_strings.push_bulk(in, 3);
+    s_of_strings.drain(std::back_inserter(out));
+
+    CPPUNIT_ASSERT(s_of_strings.empty());
+    CPPUNIT_ASSERT(3 == out.size());
+    CPPUNIT_ASSERT("Blue" == out[0] && "Red" == out[2]);
+}
+
+void StackTestCase::test_pop_n_throws_when_too_few() {
+    Stack< int > s_of_ints;
+    std::vector<int> out;
+
+    s_of_ints.push(10);
+    s_of_ints.push(20);
+
+    CPPUNIT_ASSERT_THROW(s_of_ints.pop_n(3, std::back_inserter(out)),
+                         std::runtime_error);
+    CPPUNIT_ASSERT(2 == s_of_ints.size());  /// nothing removed
+    CPPUNIT_ASSERT(out.empty());
+}
+
+void StackTestCase::test_pop_n_moves_out() {
+    Stack< Payload > s_of_payloads;
+    std::vector<Payload> out;
+    out.reserve(2);
+    s_of_payloads.emplace('A');
+    s_of_payloads.emplace('B');
+    s_of_payloads.emplace('C');
+    Payload::reset();
+
+    s_of_payloads.pop_n(2, std::back_inserter(out));
+
+    CPPUNIT_ASSERT(0 == Payload::copies);
+    CPPUNIT_ASSERT('C' == out[0].data[0]);
+    CPPUNIT_ASSERT('B' == out[1].data[0]);
+    CPPUNIT_ASSERT('A' == s_of_payloads.top().data[0]);
+}
+
+void StackTestCase::test_try_top_and_try_pop_when_empty() {
+    Stack< int > s_of_ints;
+
+    CPPUNIT_ASSERT(0 == s_of_ints.try_top());
+    CPPUNIT_ASSERT(!s_of_ints.try_pop());
+}
+
+void StackTestCase::test_try_top_and_try_pop() {
+    Stack< std::string > s_of_strings;
+
+    s_of_strings.push("Red");
+    s_of_strings.push("Green");
+
+    CPPUNIT_ASSERT("Green" == *s_of_strings.try_top());
+    *s_of_strings.try_top() = "Cyan";
+
+    std::optional<std::string> val = s_of_strings.try_pop();
+    CPPUNIT_ASSERT(val && "Cyan" == *val);
+    CPPUNIT_ASSERT("Red" == *s_of_strings.try_pop());
+    CPPUNIT_ASSERT(!s_of_strings.try_pop());
+}
+
+void StackTestCase::test_try_pop_moves_out() {
+    Stack< Payload > s_of_payloads;
+    s_of_payloads.emplace('A');
+    Payload::reset();
+
+    std::optional<Payload> a = s_of_payloads.try_pop();
+
+    CPPUNIT_ASSERT(0 == Payload::allocations);
+    CPPUNIT_ASSERT(0 == Payload::copies);
+    CPPUNIT_ASSERT('A' == a->data[0]);
+}
+
+void StackTestCase::test_top_unchecked() {
+    Stack< int > s_of_ints;
+
+    s_of_ints.push(10);
+    s_of_ints.push(20);
+    s_of_ints.top_unchecked() = 30;
+
+    CPPUNIT_ASSERT(30 == s_of_ints.pop_value());
+    CPPUNIT_ASSERT(10 == s_of_ints.top_unchecked());
+}
+
+void StackTestCase::test_no_instrumentation_adds_no_size() {
+    CPPUNIT_ASSERT(sizeof(Stack< int >) == sizeof(StackVector<int>));
+    CPPUNIT_ASSERT(sizeof(Stack< std::string >) ==
+                   sizeof(std::deque<std::string>));
+}
+
+void StackTestCase::test_instrumentation_counts() {
+    InstrumentedStack< int > s_of_ints;
+    int in[] = {1, 2, 3, 4};
+    std::vector<int> out;
+
+    s_of_ints.push(10);
+    s_of_ints.emplace(20);
+    s_of_ints.push_range(in, in + 4);  /// peak of 6
+    s_of_ints.pop();
+    s_of_ints.pop_value();
+    s_of_ints.pop_n(2, std::back_inserter(out));
+    s_of_ints.drain(std::back_inserter(out));
+
+    CPPUNIT_ASSERT(!s_of_ints.try_pop());  /// empty pops
+    CPPUNIT_ASSERT_THROW(s_of_ints.pop_value(), std::runtime_error);
+
+    InstrumentationSnapshot stats = s_of_ints.stats();
+    CPPUNIT_ASSERT(6 == stats.pushes);
+    CPPUNIT_ASSERT(6 == stats.pops);
+    CPPUNIT_ASSERT(2 == stats.empty_pops);
+    CPPUNIT_ASSERT(6 == stats.peak_size);
+    CPPUNIT_ASSERT(0 == stats.latency.count());  /// queues only
+}
+
+void StackTestCase::test_instrumentation_reset() {
+    InstrumentedStack< std::string, std::vector<std::string> > s_of_strings;
+
+    s_of_strings.push("Red");
+    s_of_strings.push("Green");
+    s_of_strings.reset_stats();
+    s_of_strings.pop();
+
+    InstrumentationSnapshot stats = s_of_strings.stats();
+    CPPUNIT_ASSERT(0 == stats.pushes);
+    CPPUNIT_ASSERT(1 == stats.pops);
+    CPPUNIT_ASSERT(0 == stats.peak_size);  /// restarts with the next push
+}
+
+void StackTestCase::test_push_and_pop_integers_using_unrolled_list() {
+    /// 64-byte nodes of 10 ints, so that pushes cross node boundaries
+    Stack< int, UnrolledList<int, 64> > s_of_ints;
+
+    s_of_ints.reserve(1000);
+    for (int i = 0; i < 1000; ++i) {
+        s_of_ints.push(i);
+    }
+    CPPUNIT_ASSERT(1000 == s_of_ints.size());
+
+    /// push and pop around a node boundary, where nodes are recycled
+    for (int i = 0; i < 100; ++i) {
+        CPPUNIT_ASSERT(999 == s_of_ints.pop_value());
+        s_of_ints.push(999);
+        s_of_ints.push(1000);
+        s_of_ints.pop();
+    }
+
+    for (int i = 999; i >= 0; --i) {
+        CPPUNIT_ASSERT(i == s_of_ints.pop_value());
+    }
+    CPPUNIT_ASSERT(s_of_ints.empty());
+
+    s_of_ints.shrink_to_fit();
+    s_of_ints.push(7);
+    CPPUNIT_ASSERT(7 == s_of_ints.top());
+}
+
+void StackTestCase::test_relational_operators_using_unrolled_list() {
+    Stack< std::string, UnrolledList<std::string> > A, B;
+
+    for (int i = 0; i < 100; ++i) {
+        A.push(std::string(40, 'a' + i % 26));
+    }
+    B = A;
+    CPPUNIT_ASSERT(A == B);
+
+    B.pop();
+    CPPUNIT_ASSERT(A != B);
+    CPPUNIT_ASSERT(B < A);  /// a prefix of A
+    CPPUNIT_ASSERT(A >= B);
+
+    Stack< std::string, UnrolledList<std::string> > C(std::move(A));
+    CPPUNIT_ASSERT(A.empty());
+    CPPUNIT_ASSERT(100 == C.size());
+    C.pop();
+    CPPUNIT_ASSERT(C == B);
+}
+
+void StackTestCase::test_push_and_pop_using_unrolled_list_and_arena() {
+    typedef Stack< int, UnrolledList<int>, ArenaAllocator<int> > ArenaStack;
+    Arena arena;
+    ArenaStack A((ArenaAllocator<int>(arena)));
+
+    for (int i = 0; i < 500; ++i) {
+        A.push(i);
+    }
+    ArenaStack B(A);
+
+    CPPUNIT_ASSERT(B.get_allocator().arena == &arena);
+    CPPUNIT_ASSERT(A == B);
+    CPPUNIT_ASSERT(499 == B.pop_value());
+    CPPUNIT_ASSERT(498 == B.top());
+}
+
+void StackTestCase::test_push_range_and_pop_n_using_unrolled_list() {
+    Stack< int, UnrolledList<int, 64> > s_of_ints;
+    std::vector<int> in, out;
+    for (int i = 0; i < 100; ++i) {
+        in.push_back(i);
+    }
+
+    s_of_ints.push_range(in.begin(), in.end());
+    s_of_ints.pop_n(45, std::back_inserter(out));
+    CPPUNIT_ASSERT(std::equal(out.begin(), out.end(), in.rbegin()));
+    CPPUNIT_ASSERT(54 == s_of_ints.top());
+
+    s_of_ints.drain(std::back_inserter(out));
+    CPPUNIT_ASSERT(std::equal(out.begin(), out.end(), in.rbegin()));
+    CPPUNIT_ASSERT(s_of_ints.empty());
+}
+
+void StackTestCase::test_vectorized_comparisons_match_generic() {
+    /// StackVector and vector of numbers compare with simdcompare.h,
+    /// list with its own operators
+    Stack< int > A, B;
+    Stack< double, std::vector<double> > C, D;
+    Stack< int, std::list<int> > ref_a, ref_b;
+    std::mt19937 rng(7);
+
+    for (int step = 0; step < 20000; ++step) {
+        unsigned op = rng() % 8;
+        int val = int(rng() % 4);
+        if (op < 4) {
+            A.push(val);
+            C.push(val);
+            ref_a.push(val);
+            B.push(val);
+            D.push(val);
+            ref_b.push(val);
+        } else if (op == 4) {
+            A.push(val);
+            C.push(val);
+            ref_a.push(val);
+        } else if (op == 5) {
+            B.push(val);
+            D.push(val);
+            ref_b.push(val);
+        } else if (op == 6 && !A.empty()) {
+            A.pop();
+            C.pop();
+            ref_a.pop();
+        } else if (op == 7 && !B.empty()) {
+            B.pop();
+            D.pop();
+            ref_b.pop();
+        }
+
+        CPPUNIT_ASSERT((ref_a == ref_b) == (A == B));
+        CPPUNIT_ASSERT((ref_a < ref_b) == (A < B));
+        CPPUNIT_ASSERT((ref_b < ref_a) == (B < A));
+        CPPUNIT_ASSERT((ref_a == ref_b) == (C == D));
+        CPPUNIT_ASSERT((ref_a < ref_b) == (C < D));
+    }
+}
+
 CppUnit::Test *suite() {
     CppUnit::TestFactoryRegistry &registry =
                       CppUnit::TestFactoryRegistry::getRegistry();
@@ -0,0 +1,240 @@
+/** 
+ *  @brief      Contiguous stack container testsuite
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/HelperMacros.h>
+ 
+#include <deque>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "stack.h"
+#include "stackvectortest.h"
+
+/// Item whose move may throw, and whose copy throws once copies run out
+struct Brittle {
+    static int live;
+    static int moves;
+    static int copies_left;
+    int value;
+
+    explicit Brittle(int v) : value(v) { ++live; }
+    Brittle(const Brittle& other) : value(other.value) {
+        if (copies_left-- == 0) {
+            throw std::runtime_error("copy failed");
+        }
+        ++live;
+    }
+    Brittle(Brittle&& other) : value(other.value) { ++moves; ++live; }
+    ~Brittle() { --live; }
+};
+
+int Brittle::live = 0;
+int Brittle::moves = 0;
+int Brittle::copies_left = -1;
+
+void StackVectorTestCase::setUp() {
+}
+
+void StackVectorTestCase::tearDown() {
+}
+
+void StackVectorTestCase::test_default_container_is_contiguous_for_trivial_items() {
+    CPPUNIT_ASSERT((std::is_same< StackDefaultContainer<int>::type,
+                                  StackVector<int> >::value));
+    CPPUNIT_ASSERT((std::is_same< StackDefaultContainer<std::string>::type,
+                                  std::deque<std::string> >::value));
+}
+
+void StackVectorTestCase::test_push_and_pop_integers() {
+    Stack< int > stack_of_ints;
+
+    for (int i = 0; i < 100; ++i) {
+        stack_of_ints.push(i);
+    }
+    CPPUNIT_ASSERT(100 == stack_of_ints.size());
+
+    for (int i = 99; i >= 0; --i) {
+        CPPUNIT_ASSERT(i == stack_of_ints.top());
+        stack_of_ints.pop();
+    }
+    CPPUNIT_ASSERT(stack_of_ints.empty());
+    CPPUNIT_ASSERT_THROW(stack_of_ints.top(), std::runtime_error);
+}
+
+void StackVectorTestCase::test_push_and_pop_strings() {
+    Stack< std::string, StackVector<std::string> > stack_of_strings;
+
+    for (int i = 0; i < 100; ++i) {
+        stack_of_strings.push(std::string(40, 'a' + i % 26));
+    }
+    for (int i = 99; i >= 0; --i) {
+        CPPUNIT_ASSERT(std::string(40, 'a' + i % 26) == stack_of_strings.top());
+        stack_of_strings.pop();
+    }
+    CPPUNIT_ASSERT(stack_of_strings.empty());
+}
+
+void StackVectorTestCase::test_push_back_own_item_while_growing() {
+    StackVector< std::string > items;
+
+    items.push_back("Red");
+    while (items.size() < items.capacity()) {
+        items.push_back("Green");
+    }
+    items.push_back(items[0]);  /// reallocates while reading items[0]
+
+    CPPUNIT_ASSERT("Red" == items.back());
+}
+
+void StackVectorTestCase::test_reserve() {
+    Stack< int > stack_of_ints;
+    StackVector< int > items;
+
+    stack_of_ints.reserve(1000);  /// forwarded to the container
+    items.reserve(1000);
+    CPPUNIT_ASSERT(1000 == items.capacity());
+
+    for (int i = 0; i < 1000; ++i) {
+        items.push_back(i);
+    }
+    CPPUNIT_ASSERT(1000 == items.capacity());  /// no growth needed
+}
+
+void StackVectorTestCase::test_growth_factor() {
+    StackVector< int, 150 > items;
+    items.reserve(100);
+
+    for (int i = 0; i <= 100; ++i) {
+        items.push_back(i);
+    }
+    CPPUNIT_ASSERT(150 == items.capacity());
+}
+
+void StackVectorTestCase::test_shrink_to_fit_hysteresis() {
+    StackVector< int > items;
+    items.reserve(1024);
+    for (int i = 0; i < 300; ++i) {
+        items.push_back(i);
+    }
+
+    items.shrink_to_fit();  /// above a quarter, keeps the memory
+    CPPUNIT_ASSERT(1024 == items.capacity());
+
+    while (items.size() > 100) {
+        items.pop_back();
+    }
+    items.shrink_to_fit();  /// below a quarter, shrinks with headroom
+    CPPUNIT_ASSERT(200 == items.capacity());
+    CPPUNIT_ASSERT(99 == items.back());
+
+    items.shrink_to_fit();  /// no thrashing
+    CPPUNIT_ASSERT(200 == items.capacity());
+}
+
+void StackVectorTestCase::test_relational_operators() {
+    Stack< int > A, B;
+
+    A.push(10);
+    A.push(20);
+    B.push(10);
+    B.push(20);
+    CPPUNIT_ASSERT(A == B);
+
+    B.push(30);
+    CPPUNIT_ASSERT(A != B);
+    CPPUNIT_ASSERT(A < B);
+    CPPUNIT_ASSERT(B > A);
+
+    A.pop();
+    A.push(60);
+    CPPUNIT_ASSERT(A > B);
+    CPPUNIT_ASSERT(A >= B);
+}
+
+void StackVectorTestCase::test_append_grows_once() {
+    StackVector< int > v;
+    std::vector<int> in(100, 7);
+
+    v.push_back(1);
+    v.append(in.begin(), in.end());
+    CPPUNIT_ASSERT(101 == v.size());
+    CPPUNIT_ASSERT(101 == v.capacity());  /// exactly what is needed
+
+    v.append(in.begin(), in.begin() + 1);
+    CPPUNIT_ASSERT(202 == v.capacity());  /// geometric growth continues
+    CPPUNIT_ASSERT(7 == v.back());
+}
+
+void StackVectorTestCase::test_throwing_relocation_keeps_items() {
+    {
+        StackVector< Brittle > v;
+        for (int i = 0; i < 8; ++i) {
+            v.emplace_back(i);
+        }
+        CPPUNIT_ASSERT(8 == v.capacity());
+
+        /// items whose move may throw are copied, and a failed copy
+        /// leaves the old buffer as it was
+        Brittle::copies_left = 3;
+        CPPUNIT_ASSERT_THROW(v.emplace_back(8), std::runtime_error);
+        Brittle::copies_left = 3;
+        CPPUNIT_ASSERT_THROW(v.reserve(100), std::runtime_error);
+        CPPUNIT_ASSERT(0 == Brittle::moves);
+        CPPUNIT_ASSERT(8 == v.size());
+        CPPUNIT_ASSERT(8 == v.capacity());
+        CPPUNIT_ASSERT(8 == Brittle::live);
+        for (int i = 0; i < 8; ++i) {
+            CPPUNIT_ASSERT(i == v[i].value);
+        }
+
+        Brittle::copies_left = -1;
+        v.emplace_back(8);
+        CPPUNIT_ASSERT(9 == v.size());
+        CPPUNIT_ASSERT(8 == v.back().value);
+        CPPUNIT_ASSERT(0 == v[0].value);
+    }
+    CPPUNIT_ASSERT(0 == Brittle::live);
+}
+
+CppUnit::Test *suite() {
+    CppUnit::TestFactoryRegistry &registry =
+                      CppUnit::TestFactoryRegistry::getRegistry();
+
+    return registry.makeTest();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(StackVectorTestCase);
+
+int main(int argc, char* argv[]) {
+    CppUnit::TestResult controller;
+
+    CppUnit::TestResultCollector result;
+    controller.addListener(&result);
+
+    CppUnit::BriefTestProgressListener progressListener;
+    controller.addListener(&progressListener);
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite());  /// Add the top suite to the test runner
+
+    /// Run the test
+    runner.run(controller);
+
+    /// Return error code 1 if any tests failed
+    return result.wasSuccessful() ? 0 : 1;
+}
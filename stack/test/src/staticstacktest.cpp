@@ -0,0 +1,201 @@
+/** 
+ *  @brief      Static stack data structure testsuite
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "stack.h"
+#include "staticstack.h"
+#include "staticstacktest.h"
+
+void StaticStackTestCase::setUp() {
+}
+
+void StaticStackTestCase::tearDown() {
+}
+
+void StaticStackTestCase::test_push_and_pop_integers() {
+    StaticStack< int, 4 > s_of_ints;
+
+    CPPUNIT_ASSERT(s_of_ints.empty());
+    CPPUNIT_ASSERT(4 == s_of_ints.capacity());
+    CPPUNIT_ASSERT(0 == s_of_ints.try_top());
+    CPPUNIT_ASSERT(!s_of_ints.try_pop());
+    CPPUNIT_ASSERT_THROW(s_of_ints.top(), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(s_of_ints.pop(), std::runtime_error);
+
+    s_of_ints.push(10);
+    s_of_ints.push(20);
+    s_of_ints.emplace(30);
+
+    CPPUNIT_ASSERT(30 == s_of_ints.top());
+    CPPUNIT_ASSERT(3 == s_of_ints.size());
+
+    s_of_ints.pop();
+    CPPUNIT_ASSERT(20 == s_of_ints.pop_value());
+    CPPUNIT_ASSERT(10 == *s_of_ints.try_top());
+    CPPUNIT_ASSERT(10 == s_of_ints.top_unchecked());
+    CPPUNIT_ASSERT(10 == *s_of_ints.try_pop());
+    CPPUNIT_ASSERT(s_of_ints.empty());
+}
+
+void StaticStackTestCase::test_push_and_pop_strings() {
+    StaticStack< std::string, 3 > s_of_strings;
+
+    s_of_strings.push("Red");
+    s_of_strings.push("Green");
+    s_of_strings.push("Blue");
+
+    CPPUNIT_ASSERT("Blue" == s_of_strings.pop_value());
+    CPPUNIT_ASSERT("Green" == s_of_strings.top());
+
+    s_of_strings.pop();
+    CPPUNIT_ASSERT("Red" == s_of_strings.top());
+
+    s_of_strings.push("Cyan");
+    CPPUNIT_ASSERT("Cyan" == s_of_strings.top());
+    CPPUNIT_ASSERT(2 == s_of_strings.size());
+}
+
+void StaticStackTestCase::test_overflow_returns_false() {
+    StaticStack< int, 2 > s_of_ints;
+
+    CPPUNIT_ASSERT(s_of_ints.push(1));
+    CPPUNIT_ASSERT(s_of_ints.push(2));
+    CPPUNIT_ASSERT(s_of_ints.full());
+    CPPUNIT_ASSERT(!s_of_ints.push(3));
+    CPPUNIT_ASSERT(!s_of_ints.emplace(3));
+    CPPUNIT_ASSERT(2 == s_of_ints.size());
+    CPPUNIT_ASSERT(2 == s_of_ints.top());
+
+    StaticStack< int, 2, OverflowAssert > checked;
+    CPPUNIT_ASSERT(checked.push(1));
+    CPPUNIT_ASSERT(checked.push(2));
+    CPPUNIT_ASSERT(checked.full());
+}
+
+void StaticStackTestCase::test_overflow_overwrites_oldest() {
+    StaticStack< std::string, 3, OverflowOverwrite > recent;
+
+    for (int i = 0; i < 10; ++i) {
+        CPPUNIT_ASSERT(recent.push(std::string(1, 'a' + i)));
+    }
+    CPPUNIT_ASSERT(3 == recent.size());
+    CPPUNIT_ASSERT("j" == recent.pop_value());
+    CPPUNIT_ASSERT("i" == recent.pop_value());
+    recent.push("k");  /// the bottom item, "h", is still there
+    CPPUNIT_ASSERT("k" == recent.pop_value());
+    CPPUNIT_ASSERT("h" == recent.pop_value());
+    CPPUNIT_ASSERT(recent.empty());
+}
+
+void StaticStackTestCase::test_stack_over_full_ring_throws() {
+    InstrumentedStack< int, StaticRing<int, 2> > stack_of_ints;
+
+    stack_of_ints.push(1);
+    stack_of_ints.emplace(2);
+    CPPUNIT_ASSERT_THROW(stack_of_ints.push(3), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(stack_of_ints.emplace(3), std::runtime_error);
+    CPPUNIT_ASSERT(2 == stack_of_ints.size());
+    CPPUNIT_ASSERT(2 == stack_of_ints.stats().pushes);  /// not the rejected ones
+    CPPUNIT_ASSERT(2 == stack_of_ints.top());
+}
+
+namespace {
+
+/// checks that a string of brackets is balanced, nesting at most 8 deep
+constexpr bool balanced(const char* text) {
+    StaticStack< char, 8 > open;
+    for (; *text; ++text) {
+        if (*text == '(' || *text == '[') {
+            if (!open.push(*text)) {
+                return false;
+            }
+        } else if (*text == ')' || *text == ']') {
+            char expected = *text == ')' ? '(' : '[';
+            if (open.empty() || open.pop_value() != expected) {
+                return false;
+            }
+        }
+    }
+    return open.empty();
+}
+
+}  // namespace
+
+void StaticStackTestCase::test_usable_in_constant_expressions() {
+    static_assert(balanced("([()[]])()"), "");
+    static_assert(!balanced("([)]"), "");
+    static_assert(!balanced("(((((((((())))))))))"), "");
+
+    constexpr StaticStack< int, 2 > empty_stack;
+    static_assert(empty_stack.empty() && empty_stack.capacity() == 2, "");
+
+    CPPUNIT_ASSERT(balanced("[()]"));
+}
+
+void StaticStackTestCase::test_relational_operators() {
+    StaticStack< int, 4 > A, B;
+
+    A.push(10);
+    A.push(20);
+    B.push(10);
+    B.push(20);
+    CPPUNIT_ASSERT(A == B);
+
+    B.push(30);
+    CPPUNIT_ASSERT(A != B);
+    CPPUNIT_ASSERT(A < B);
+    CPPUNIT_ASSERT(A <= B);
+
+    A.push(60);
+    CPPUNIT_ASSERT(A > B);
+    CPPUNIT_ASSERT(A >= B);
+
+    A.swap(B);
+    CPPUNIT_ASSERT(A < B);
+    CPPUNIT_ASSERT(60 == B.top());
+}
+
+CppUnit::Test *suite() {
+    CppUnit::TestFactoryRegistry &registry =
+                      CppUnit::TestFactoryRegistry::getRegistry();
+
+    return registry.makeTest();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(StaticStackTestCase);
+
+int main(int argc, char* argv[]) {
+    CppUnit::TestResult controller;
+
+    CppUnit::TestResultCollector result;
+    controller.addListener(&result);
+
+    CppUnit::BriefTestProgressListener progressListener;
+    controller.addListener(&progressListener);
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite());  /// Add the top suite to the test runner
+
+    /// Run the test
+    runner.run(controller);
+
+    /// Return error code 1 if any tests failed
+    return result.wasSuccessful() ? 0 : 1;
+}
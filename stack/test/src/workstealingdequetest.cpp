@@ -0,0 +1,195 @@
+/** 
+ *  @brief      Work-stealing deque data structure testsuite
+ * 
+ *  @author     Ashish
+ *  @version    1.0
+ *  Copyright (C) 2015 Ashish, MIT license
+ */
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "workstealingdeque.h"
+#include "workstealingdequetest.h"
+
+void WorkStealingDequeTestCase::setUp() {
+}
+
+void WorkStealingDequeTestCase::tearDown() {
+}
+
+void WorkStealingDequeTestCase::test_owner_pops_lifo() {
+    WorkStealingDeque< int > tasks;
+    int val = 0;
+
+    tasks.push(10);
+    tasks.push(20);
+    tasks.push(30);
+    CPPUNIT_ASSERT(3 == tasks.size());
+
+    CPPUNIT_ASSERT(tasks.try_pop(val) && 30 == val);
+    CPPUNIT_ASSERT(tasks.try_pop(val) && 20 == val);
+    tasks.push(40);
+    CPPUNIT_ASSERT(tasks.try_pop(val) && 40 == val);
+    CPPUNIT_ASSERT(tasks.try_pop(val) && 10 == val);
+    CPPUNIT_ASSERT(tasks.empty());
+}
+
+void WorkStealingDequeTestCase::test_thief_steals_fifo() {
+    WorkStealingDeque< int > tasks;
+    int val = 0;
+
+    tasks.push(10);
+    tasks.push(20);
+    tasks.push(30);
+
+    std::thread thief([&tasks]() {
+        int stolen = 0;
+        CPPUNIT_ASSERT(tasks.try_steal(stolen) && 10 == stolen);
+        CPPUNIT_ASSERT(tasks.try_steal(stolen) && 20 == stolen);
+    });
+    thief.join();
+
+    CPPUNIT_ASSERT(tasks.try_pop(val) && 30 == val);
+    CPPUNIT_ASSERT(tasks.empty());
+}
+
+void WorkStealingDequeTestCase::test_pop_and_steal_fail_when_empty() {
+    WorkStealingDeque< int > tasks;
+    int val = 7;
+
+    CPPUNIT_ASSERT(!tasks.try_pop(val));
+    CPPUNIT_ASSERT(!tasks.try_steal(val));
+    CPPUNIT_ASSERT(7 == val);
+
+    tasks.push(1);
+    CPPUNIT_ASSERT(tasks.try_steal(val) && 1 == val);
+    CPPUNIT_ASSERT(!tasks.try_pop(val));
+    CPPUNIT_ASSERT(0 == tasks.size());
+}
+
+void WorkStealingDequeTestCase::test_grows_keeping_order() {
+    WorkStealingDeque< int > tasks(2);
+    int val = 0;
+
+    /// move the live range around the ring before it grows
+    for (int i = 0; i < 5; ++i) {
+        tasks.push(-1);
+        tasks.try_steal(val);
+    }
+    for (int i = 0; i < 100; ++i) {
+        tasks.push(i);
+    }
+    CPPUNIT_ASSERT(100 == tasks.size());
+    for (int i = 0; i < 50; ++i) {
+        CPPUNIT_ASSERT(tasks.try_steal(val) && i == val);
+    }
+    for (int i = 99; i >= 50; --i) {
+        CPPUNIT_ASSERT(tasks.try_pop(val) && i == val);
+    }
+    CPPUNIT_ASSERT(tasks.empty());
+
+    /// the initial capacity must fit a signed 64-bit index
+    CPPUNIT_ASSERT_THROW(WorkStealingDeque< int > huge(~std::size_t(0)),
+                         std::runtime_error);
+}
+
+void WorkStealingDequeTestCase::test_randomized_owner_and_thieves() {
+    const int thieves = 4;
+    const int items = 200000;
+
+    for (unsigned seed = 1; seed <= 3; ++seed) {
+        WorkStealingDeque< int > tasks(4);
+        std::vector< std::atomic<int> > taken(items);
+        std::atomic<bool> done(false);
+        std::atomic<bool> fifo(true);
+        std::vector<std::thread> workers;
+
+        /// each thief checks that its own steals come out oldest first
+        for (int t = 0; t < thieves; ++t) {
+            workers.push_back(std::thread([&]() {
+                int last = -1;
+                int val = 0;
+                while (!done.load() || !tasks.empty()) {
+                    if (tasks.try_steal(val)) {
+                        taken[val].fetch_add(1);
+                        if (val <= last) {
+                            fifo.store(false);
+                        }
+                        last = val;
+                    }
+                }
+            }));
+        }
+
+        /// the owner pushes every item once, popping at random
+        std::mt19937 rng(seed);
+        int val = 0;
+        for (int next = 0; next < items;) {
+            unsigned dice = rng() % 192;
+            if (dice == 0) {
+                std::this_thread::yield();  /// let thieves in on few cores
+            } else if (dice % 3 == 0) {
+                if (tasks.try_pop(val)) {
+                    taken[val].fetch_add(1);
+                }
+            } else {
+                tasks.push(next++);
+            }
+        }
+        while (tasks.try_pop(val)) {
+            taken[val].fetch_add(1);
+        }
+        done.store(true);
+        for (size_t t = 0; t < workers.size(); ++t) {
+            workers[t].join();
+        }
+
+        for (int i = 0; i < items; ++i) {
+            CPPUNIT_ASSERT(1 == taken[i].load());
+        }
+        CPPUNIT_ASSERT(fifo.load());
+    }
+}
+
+CppUnit::Test *suite() {
+    CppUnit::TestFactoryRegistry &registry =
+                      CppUnit::TestFactoryRegistry::getRegistry();
+
+    return registry.makeTest();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(WorkStealingDequeTestCase);
+
+int main(int argc, char* argv[]) {
+    CppUnit::TestResult controller;
+
+    CppUnit::TestResultCollector result;
+    controller.addListener(&result);
+
+    CppUnit::BriefTestProgressListener progressListener;
+    controller.addListener(&progressListener);
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite());  /// Add the top suite to the test runner
+
+    /// Run the test
+    runner.run(controller);
+
+    /// Return error code 1 if any tests failed
+    return result.wasSuccessful() ? 0 : 1;
+}